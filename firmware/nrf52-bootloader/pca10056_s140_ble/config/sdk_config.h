@@ -1299,8 +1299,11 @@
 // <i> the bootloader. This area will not be erased by the bootloader during a
 // <i> firmware upgrade. The size must be a multiple of the flash page size.
 
+// <i> Covers the application flash log and FDS pages, 0x80000 to the bootloader,
+// <i> so application updates are single bank (no room is left for a second bank).
+
 #ifndef NRF_DFU_APP_DATA_AREA_SIZE
-#define NRF_DFU_APP_DATA_AREA_SIZE 12288
+#define NRF_DFU_APP_DATA_AREA_SIZE 491520
 #endif
 
 // <q> NRF_DFU_IN_APP  - Specifies that this code is in the app, not the bootloader, so some settings are off-limits.
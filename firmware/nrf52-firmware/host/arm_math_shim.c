@@ -0,0 +1,259 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST ARM MATH SHIM
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Portable implementation of the CMSIS-DSP functions used
+ * by the EDA DSP, so that eda_dsp.c can be built and measured
+ * on a host computer
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <math.h>
+#include <string.h>
+
+/* Project includes */
+
+#include "arm_math.h"
+#include "nrf52840.h"
+
+/*
+ * Public variables
+ */
+
+static uint32_t host_fpu_stack[32];
+FPU_Type host_fpu = { .FPCAR = (uintptr_t)host_fpu_stack };
+
+/*
+ * Local variables
+ */
+
+static int64_t fixed_work[2 * ARM_RFFT_SHIM_MAX_SIZE];                         /**< complex work area of the fixed point FFT */
+
+/*
+ * Local functions
+ */
+
+static void cfft_radix2(float32_t * buffer, uint16_t length, const float32_t * twiddle, uint16_t twiddle_stride);
+static arm_status rfft_fixed_check(uint32_t fftLenReal, uint32_t ifftFlagR);
+static void cfft_fixed(int64_t * buffer, uint32_t length, uint8_t frac_bits);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+
+/**
+ * @brief Initialize real FFT instance, fftLen must be a power of 2
+ */
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 * S, uint16_t fftLen)
+{
+    uint16_t k;
+
+    if ((fftLen < 4) || (fftLen > ARM_RFFT_SHIM_MAX_SIZE) || ((fftLen & (fftLen - 1)) != 0))
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+
+    S->fftLenRFFT = fftLen;
+    for (k = 0; k < (fftLen / 2); k++)
+    {
+        double arg = 2.0 * M_PI * (double)k / (double)fftLen;
+        S->twiddle[(2*k)] = (float32_t)cos(arg);
+        S->twiddle[(2*k)+1] = (float32_t)-sin(arg);
+    }
+    return ARM_MATH_SUCCESS;
+}
+
+
+/**
+ * @brief Forward real FFT with CMSIS output packing (pOut[1] holds the Nyquist real part),
+ * input buffer is used as work area and modified, as with CMSIS-DSP
+ */
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 * S, float32_t * p, float32_t * pOut, uint8_t ifftFlag)
+{
+    uint16_t n = S->fftLenRFFT;
+    uint16_t half = n / 2;
+    uint16_t k;
+
+    (void)ifftFlag;
+
+    /* Even/odd samples as real/imaginary parts of a half length complex sequence */
+    cfft_radix2(p, half, S->twiddle, 2);
+
+    /* Split the half length spectrum into the real sequence spectrum */
+    pOut[0] = p[0] + p[1];
+    pOut[1] = p[0] - p[1];
+    for (k = 1; k < half; k++)
+    {
+        float32_t zr = p[(2*k)], zi = p[(2*k)+1];
+        float32_t cr = p[2*(half-k)], ci = -p[(2*(half-k))+1];
+        float32_t er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        float32_t or = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+        float32_t wr = S->twiddle[(2*k)], wi = S->twiddle[(2*k)+1];
+        pOut[(2*k)] = er + (wr * or) - (wi * oi);
+        pOut[(2*k)+1] = ei + (wr * oi) + (wi * or);
+    }
+}
+
+
+/**
+ * @brief Initialize Q31 real FFT instance, only forward transforms are supported
+ */
+arm_status arm_rfft_init_q31(arm_rfft_instance_q31 * S, uint32_t fftLenReal, uint32_t ifftFlagR, uint32_t bitReverseFlag)
+{
+    (void)bitReverseFlag;
+    S->fftLenReal = fftLenReal;
+    return rfft_fixed_check(fftLenReal, ifftFlagR);
+}
+
+
+/**
+ * @brief Forward Q31 real FFT, full complex spectrum downscaled by fftLenReal as with CMSIS-DSP
+ */
+void arm_rfft_q31(const arm_rfft_instance_q31 * S, q31_t * pSrc, q31_t * pDst)
+{
+    uint32_t n;
+
+    for (n = 0; n < S->fftLenReal; n++)
+    {
+        fixed_work[(2*n)] = pSrc[n];
+        fixed_work[(2*n)+1] = 0;
+    }
+    cfft_fixed(fixed_work, S->fftLenReal, 31);
+    for (n = 0; n < (2 * S->fftLenReal); n++)
+    {
+        pDst[n] = (q31_t)fixed_work[n];
+    }
+}
+
+
+/*
+ * Local functions
+ */
+
+static arm_status rfft_fixed_check(uint32_t fftLenReal, uint32_t ifftFlagR)
+{
+    if ((ifftFlagR != 0) || (fftLenReal < 4) || (fftLenReal > ARM_RFFT_SHIM_MAX_SIZE) || ((fftLenReal & (fftLenReal - 1)) != 0))
+    {
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+    return ARM_MATH_SUCCESS;
+}
+
+/**
+ * @brief In-place radix-2 complex FFT emulating fixed point arithmetic: twiddles and
+ * products are rounded to frac_bits and each stage halves its outputs, so that data
+ * keeps the range, and about the rounding noise, of the CMSIS-DSP fixed point FFTs
+ */
+static void cfft_fixed(int64_t * buffer, uint32_t length, uint8_t frac_bits)
+{
+    const int64_t one = ((int64_t)1 << frac_bits) - 1;
+    uint32_t i, j, k, span;
+
+    /* Bit reversal permutation */
+    for (i = 1, j = 0; i < length; i++)
+    {
+        uint32_t bit = length >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            int64_t tr = buffer[(2*i)], ti = buffer[(2*i)+1];
+            buffer[(2*i)] = buffer[(2*j)];
+            buffer[(2*i)+1] = buffer[(2*j)+1];
+            buffer[(2*j)] = tr;
+            buffer[(2*j)+1] = ti;
+        }
+    }
+
+    /* Butterflies with 1/2 scaling per stage */
+    for (span = 1; span < length; span <<= 1)
+    {
+        for (k = 0; k < span; k++)
+        {
+            double arg = M_PI * (double)k / (double)span;
+            int64_t wr = llround(cos(arg) * (double)one);
+            int64_t wi = llround(-sin(arg) * (double)one);
+
+            for (i = k; i < length; i += (2 * span))
+            {
+                int64_t * a = &buffer[2 * i];
+                int64_t * b = &buffer[2 * (i + span)];
+                int64_t tr = ((wr * b[0]) - (wi * b[1])) >> frac_bits;
+                int64_t ti = ((wr * b[1]) + (wi * b[0])) >> frac_bits;
+                b[0] = (a[0] - tr) >> 1;
+                b[1] = (a[1] - ti) >> 1;
+                a[0] = (a[0] + tr) >> 1;
+                a[1] = (a[1] + ti) >> 1;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief In-place iterative radix-2 complex FFT on interleaved real/imaginary data
+ */
+static void cfft_radix2(float32_t * buffer, uint16_t length, const float32_t * twiddle, uint16_t twiddle_stride)
+{
+    uint16_t i, j, k, span, step;
+
+    /* Bit reversal permutation */
+    for (i = 1, j = 0; i < length; i++)
+    {
+        uint16_t bit = length >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            float32_t tr = buffer[(2*i)], ti = buffer[(2*i)+1];
+            buffer[(2*i)] = buffer[(2*j)];
+            buffer[(2*i)+1] = buffer[(2*j)+1];
+            buffer[(2*j)] = tr;
+            buffer[(2*j)+1] = ti;
+        }
+    }
+
+    /* Butterflies */
+    for (span = 1, step = length / 2; span < length; span <<= 1, step >>= 1)
+    {
+        for (i = 0; i < length; i += (2 * span))
+        {
+            for (k = 0; k < span; k++)
+            {
+                const float32_t * w = &twiddle[2 * k * step * twiddle_stride];
+                float32_t * a = &buffer[2 * (i + k)];
+                float32_t * b = &buffer[2 * (i + k + span)];
+                float32_t tr = (w[0] * b[0]) - (w[1] * b[1]);
+                float32_t ti = (w[0] * b[1]) + (w[1] * b[0]);
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+/* END OF FILE */
@@ -0,0 +1,481 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST EDA DSP BENCHMARK
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Feed eda_dsp.c with synthetic SAADC buffers, generated
+ * from the IDAC waveform (YPOS_Array/YNEG_Array) applied to known
+ * loads, check the impedance it returns against the loads and
+ * against golden vectors, and report the time spent per frame
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project includes */
+
+#include "eda_calib.h"
+#include "eda_cfg.h"
+#include "eda_dsp.h"
+#include "idac_array.h"
+
+/*
+ * Local constants
+ */
+
+#define BENCH_DELAY                 EDA_CALIB_DELAY_DEFAULT                     /**< delay compensated by EDA_DSP_GetImpedance (s) */
+#define BENCH_SAADC_MAX             8191                                        /**< 14-bit signed SAADC range */
+
+#define BENCH_FRAME_NUM             (IDAC_ARRAY_LENGTH / EDA_ADC_BUFFER_SIZE)   /**< frames in one period of the IDAC waveform */
+#define BENCH_WARMUP_NUM            (EDA_DSP_GetWindowSize() / EDA_ADC_BUFFER_SIZE)   /**< frames needed to fill the analysis window */
+
+#ifndef BENCH_MAX_ERROR
+#define BENCH_MAX_ERROR             1.0e-2                                      /**< maximum relative error on Z against the load */
+#endif
+
+#ifndef BENCH_GOLDEN_TOLERANCE
+#define BENCH_GOLDEN_TOLERANCE      1.0e-4                                      /**< maximum relative deviation of Z from golden vectors */
+#endif
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS            20000                                       /**< frames processed for timing */
+#endif
+
+/*
+ * Local types
+ */
+
+typedef struct
+{
+    const char * name;
+    double rs;                                                                  /**< series resistance (ohm) */
+    double rp;                                                                  /**< parallel resistance (ohm) */
+    double cp;                                                                  /**< parallel capacitance (F), 0 if none */
+} load_t;
+
+/*
+ * Local variables
+ */
+
+static const uint16_t frequency_list[EDA_FREQUENCY_NUM] = EDA_FREQUENCY_LIST;
+
+static const load_t loads[] =
+{
+    { "r_50k",       0.0,  50.0e3,   0.0     },
+    { "rc_100k_100n", 0.0, 100.0e3, 100.0e-9 },
+    { "skin",        2.0e3, 330.0e3,  47.0e-9 },                                /**< electrode/skin like model: Rs + (Rp // Cp) */
+};
+#define LOAD_NUM                    (sizeof(loads) / sizeof(loads[0]))
+
+static int16_t frames[LOAD_NUM][BENCH_FRAME_NUM][2 * EDA_ADC_BUFFER_SIZE];     /**< interleaved voltage/current samples, as written by SAADC */
+static int16_t work[2 * EDA_ADC_BUFFER_SIZE];                                   /**< copy handed to the DSP, which may modify it */
+
+static Impedance results[LOAD_NUM][BENCH_FRAME_NUM][EDA_FREQUENCY_NUM];         /**< output for each window position over the waveform period */
+static Impedance golden[LOAD_NUM][BENCH_FRAME_NUM][EDA_FREQUENCY_NUM];
+
+static int verbose;
+
+/*
+ * Local functions
+ */
+
+static double complex load_impedance(const load_t * load, double frequency);
+static void generate_frames(const load_t * load, int16_t (* out)[2 * EDA_ADC_BUFFER_SIZE]);
+static void run_load(uint16_t l);
+static double check_load(uint16_t l);
+static double check_golden(void);
+static double check_profiles(void);
+static int read_golden(const char * path);
+static int write_golden(const char * path);
+static double time_frames(void);
+static double elapsed_ns(const struct timespec * from, const struct timespec * to);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/**
+ * @brief usage: eda_dsp_bench [-v] [--golden FILE | --write-golden FILE]
+ */
+int main(int argc, char ** argv)
+{
+    const char * golden_path = NULL;
+    int write = 0;
+    double error, deviation = 0.0, profile_error, ns;
+    uint16_t l;
+    int n;
+
+    for (n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "-v") == 0)
+        {
+            verbose = 1;
+        }
+        else if (((strcmp(argv[n], "--golden") == 0) || (strcmp(argv[n], "--write-golden") == 0)) && ((n + 1) < argc))
+        {
+            write = (strcmp(argv[n], "--write-golden") == 0);
+            golden_path = argv[++n];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-v] [--golden FILE | --write-golden FILE]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("engine %d:\n", EDA_DSP_ENGINE);
+    EDA_CALIB_Init();
+
+    /* Accuracy against the loads */
+    error = 0.0;
+    for (l = 0; l < LOAD_NUM; l++)
+    {
+        double load_error;
+
+        generate_frames(&loads[l], frames[l]);
+        run_load(l);
+        load_error = check_load(l);
+        printf("  %-14s max Z error %.3f %%\n", loads[l].name, 100.0 * load_error);
+        if (load_error > error)
+        {
+            error = load_error;
+        }
+    }
+
+    /* Regression against golden vectors */
+    if ((golden_path != NULL) && write)
+    {
+        if (write_golden(golden_path) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+        printf("  golden vectors written to %s\n", golden_path);
+    }
+    else if (golden_path != NULL)
+    {
+        if (read_golden(golden_path) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+        deviation = check_golden();
+        printf("  max deviation from golden vectors %.4f %%\n", 100.0 * deviation);
+    }
+
+    /* Accuracy of the other profiles, on the frequencies they select */
+    profile_error = check_profiles();
+    if (profile_error > error)
+    {
+        error = profile_error;
+    }
+
+    ns = time_frames();
+    printf("  %.0f ns/frame\n", ns);
+
+    if ((error > BENCH_MAX_ERROR) || (deviation > BENCH_GOLDEN_TOLERANCE))
+    {
+        printf("  FAILED (limits: %.3f %% against loads, %.4f %% against golden vectors)\n",
+               100.0 * BENCH_MAX_ERROR, 100.0 * BENCH_GOLDEN_TOLERANCE);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static double complex load_impedance(const load_t * load, double frequency)
+{
+    double w = 2.0 * M_PI * frequency;
+
+    return load->rs + (load->rp / (1.0 + (I * w * load->rp * load->cp)));
+}
+
+/**
+ * @brief Generate one period of the SAADC samples: current is the IDAC waveform,
+ * voltage is its periodic steady state response through the load, computed by DFT
+ */
+static void generate_frames(const load_t * load, int16_t (* out)[2 * EDA_ADC_BUFFER_SIZE])
+{
+    static double complex twiddle[IDAC_ARRAY_LENGTH];
+    static double complex spectrum[IDAC_ARRAY_LENGTH];
+    double current[IDAC_ARRAY_LENGTH];
+    uint32_t t, k;
+
+    for (t = 0; t < IDAC_ARRAY_LENGTH; t++)
+    {
+        twiddle[t] = cexp(-I * 2.0 * M_PI * (double)t / (double)IDAC_ARRAY_LENGTH);
+        current[t] = EDA_CURRENT_RESOLUTION * ((double)YPOS_Array[t] - (double)YNEG_Array[t]);
+    }
+
+    /* Current spectrum times load impedance */
+    for (k = 0; k <= (IDAC_ARRAY_LENGTH / 2); k++)
+    {
+        double complex acc = 0.0;
+        for (t = 0; t < IDAC_ARRAY_LENGTH; t++)
+        {
+            acc += current[t] * twiddle[(k * t) % IDAC_ARRAY_LENGTH];
+        }
+        spectrum[k] = acc * load_impedance(load, (double)k * EDA_SAMPLING_RATE / IDAC_ARRAY_LENGTH);
+    }
+
+    /* Back to time domain, then SAADC codes */
+    for (t = 0; t < IDAC_ARRAY_LENGTH; t++)
+    {
+        double voltage = creal(spectrum[0]);
+        long v, i;
+
+        for (k = 1; k < (IDAC_ARRAY_LENGTH / 2); k++)
+        {
+            voltage += 2.0 * creal(spectrum[k] * conj(twiddle[(k * t) % IDAC_ARRAY_LENGTH]));
+        }
+        voltage += creal(spectrum[IDAC_ARRAY_LENGTH / 2] * conj(twiddle[((IDAC_ARRAY_LENGTH / 2) * t) % IDAC_ARRAY_LENGTH]));
+        voltage /= (double)IDAC_ARRAY_LENGTH;
+
+        v = lrint(voltage / EDA_VOLTAGE_SCALE);
+        i = lrint(current[t] / EDA_CURRENT_SCALE);
+        v = (v > BENCH_SAADC_MAX) ? BENCH_SAADC_MAX : ((v < -BENCH_SAADC_MAX) ? -BENCH_SAADC_MAX : v);
+        i = (i > BENCH_SAADC_MAX) ? BENCH_SAADC_MAX : ((i < -BENCH_SAADC_MAX) ? -BENCH_SAADC_MAX : i);
+
+        out[t / EDA_ADC_BUFFER_SIZE][(2 * (t % EDA_ADC_BUFFER_SIZE))] = (int16_t)v;
+        out[t / EDA_ADC_BUFFER_SIZE][(2 * (t % EDA_ADC_BUFFER_SIZE)) + 1] = (int16_t)i;
+    }
+}
+
+/**
+ * @brief Fill the analysis window, then record the output of each frame over one waveform period
+ */
+static void run_load(uint16_t l)
+{
+    Impedance out[EDA_FREQUENCY_NUM];
+    uint32_t n;
+
+    EDA_DSP_Init();
+    for (n = 0; n < (BENCH_WARMUP_NUM + BENCH_FRAME_NUM); n++)
+    {
+        memcpy(work, frames[l][n % BENCH_FRAME_NUM], sizeof(work));
+        if (EDA_DSP_GetImpedance(work, out) != 0)
+        {
+            memset(out, 0, sizeof(out));
+        }
+        if (n >= BENCH_WARMUP_NUM)
+        {
+            memcpy(results[l][n % BENCH_FRAME_NUM], out, sizeof(out));
+        }
+    }
+    EDA_DSP_Deinit();
+}
+
+/**
+ * @brief Return the largest relative error between returned and expected impedance of a load,
+ * expected impedance includes the delay compensation of the DSP
+ */
+static double check_load(uint16_t l)
+{
+    double max_error = 0.0;
+    uint16_t f, k;
+
+    for (k = 0; k < EDA_DSP_GetFrequencyNum(); k++)
+    {
+        double w = 2.0 * M_PI * (double)EDA_DSP_GetFrequency(k);
+        double complex expected = load_impedance(&loads[l], (double)EDA_DSP_GetFrequency(k)) * cexp(I * w * BENCH_DELAY);
+        double freq_error = 0.0;
+
+        for (f = 0; f < BENCH_FRAME_NUM; f++)
+        {
+            double complex actual = results[l][f][k].real + (I * results[l][f][k].imag);
+            double error = cabs(actual - expected) / cabs(expected);
+
+            if (error > freq_error)
+            {
+                freq_error = error;
+            }
+        }
+        if (verbose)
+        {
+            printf("    %4u Hz: Z error %.3f %%\n", EDA_DSP_GetFrequency(k), 100.0 * freq_error);
+        }
+        if (freq_error > max_error)
+        {
+            max_error = freq_error;
+        }
+    }
+    return max_error;
+}
+
+/**
+ * @brief Return the largest relative error against the loads of the profiles other than the default one,
+ * golden vectors only cover the default profile
+ */
+static double check_profiles(void)
+{
+    double max_error = 0.0;
+    uint16_t l;
+    uint8_t p;
+
+    for (p = 0; p < EDA_DSP_PROFILE_NUM; p++)
+    {
+        if (p == EDA_DSP_PROFILE_DEFAULT)
+        {
+            continue;
+        }
+        EDA_DSP_SetProfile(p);
+        for (l = 0; l < LOAD_NUM; l++)
+        {
+            double load_error;
+
+            run_load(l);
+            load_error = check_load(l);
+            printf("  profile %u %-4u %-14s max Z error %.3f %%\n", p, EDA_DSP_GetWindowSize(), loads[l].name, 100.0 * load_error);
+            if (load_error > max_error)
+            {
+                max_error = load_error;
+            }
+        }
+    }
+    EDA_DSP_SetProfile(EDA_DSP_PROFILE_DEFAULT);
+    return max_error;
+}
+
+/**
+ * @brief Return the largest relative deviation between returned impedance and golden vectors
+ */
+static double check_golden(void)
+{
+    double max_deviation = 0.0;
+    uint16_t l, f, k;
+
+    for (l = 0; l < LOAD_NUM; l++)
+    {
+        for (f = 0; f < BENCH_FRAME_NUM; f++)
+        {
+            for (k = 0; k < EDA_FREQUENCY_NUM; k++)
+            {
+                double complex actual = results[l][f][k].real + (I * results[l][f][k].imag);
+                double complex expected = golden[l][f][k].real + (I * golden[l][f][k].imag);
+                double deviation = cabs(actual - expected) / cabs(expected);
+
+                if (deviation > max_deviation)
+                {
+                    max_deviation = deviation;
+                }
+            }
+        }
+    }
+    return max_deviation;
+}
+
+/**
+ * @brief Golden vectors file: one "load frame frequency real imag" line per impedance
+ */
+static int read_golden(const char * path)
+{
+    FILE * file = fopen(path, "r");
+    char line[128];
+    uint32_t count = 0;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char name[32];
+        unsigned int f, frequency;
+        float real, imag;
+        uint16_t l, k;
+
+        if ((line[0] == '#') || (sscanf(line, "%31s %u %u %f %f", name, &f, &frequency, &real, &imag) != 5))
+        {
+            continue;
+        }
+        for (l = 0; (l < LOAD_NUM) && (strcmp(loads[l].name, name) != 0); l++);
+        for (k = 0; (k < EDA_FREQUENCY_NUM) && (frequency_list[k] != frequency); k++);
+        if ((l == LOAD_NUM) || (k == EDA_FREQUENCY_NUM) || (f >= BENCH_FRAME_NUM))
+        {
+            fprintf(stderr, "%s: unexpected entry: %s", path, line);
+            fclose(file);
+            return -1;
+        }
+        golden[l][f][k].real = real;
+        golden[l][f][k].imag = imag;
+        count++;
+    }
+    fclose(file);
+
+    if (count != (LOAD_NUM * BENCH_FRAME_NUM * EDA_FREQUENCY_NUM))
+    {
+        fprintf(stderr, "%s: %u entries, expected %u\n", path, count, (unsigned int)(LOAD_NUM * BENCH_FRAME_NUM * EDA_FREQUENCY_NUM));
+        return -1;
+    }
+    return 0;
+}
+
+static int write_golden(const char * path)
+{
+    FILE * file = fopen(path, "w");
+    uint16_t l, f, k;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return -1;
+    }
+
+    fprintf(file, "# EDA DSP golden vectors, written by eda_dsp_bench with engine %d\n", EDA_DSP_ENGINE);
+    fprintf(file, "# load frame frequency real imag\n");
+    for (l = 0; l < LOAD_NUM; l++)
+    {
+        for (f = 0; f < BENCH_FRAME_NUM; f++)
+        {
+            for (k = 0; k < EDA_FREQUENCY_NUM; k++)
+            {
+                fprintf(file, "%s %u %u %.9g %.9g\n", loads[l].name, f, frequency_list[k], results[l][f][k].real, results[l][f][k].imag);
+            }
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+/**
+ * @brief Time the whole EDA_DSP_GetImpedance call, as seen by the application
+ */
+static double time_frames(void)
+{
+    Impedance out[EDA_FREQUENCY_NUM];
+    struct timespec from, to;
+    uint32_t n;
+
+    EDA_DSP_Init();
+    clock_gettime(CLOCK_MONOTONIC, &from);
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+    {
+        memcpy(work, frames[0][n % BENCH_FRAME_NUM], sizeof(work));
+        EDA_DSP_GetImpedance(work, out);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &to);
+    EDA_DSP_Deinit();
+
+    return elapsed_ns(&from, &to) / (double)BENCH_ITERATIONS;
+}
+
+static double elapsed_ns(const struct timespec * from, const struct timespec * to)
+{
+    return ((double)(to->tv_sec - from->tv_sec) * 1.0e9) + (double)(to->tv_nsec - from->tv_nsec);
+}
+
+/* END OF FILE */
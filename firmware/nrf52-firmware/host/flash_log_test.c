@@ -0,0 +1,375 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST FLASH LOG TEST
+ *
+ *---------------------------------------------------------------
+ * @brief Run flash_log.c on a simulated flash mapped at the log
+ * address: records must be read back in order after the ring
+ * wrapped, after resets and after power losses in the middle of
+ * a flash operation, and pages must wear evenly
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* Project includes */
+
+#include "flash_log/flash_log.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+
+/*
+ * Local constants
+ */
+
+#define TEST_RECORD_MAX     20000
+#define TEST_FLASH_SIZE     (FLOG_END_ADDR - FLOG_START_ADDR)
+
+/*
+ * Local types
+ */
+
+struct nrf_fstorage_api_s {
+    int unused;
+};
+
+typedef struct {
+    uint32_t time;
+    uint16_t length;
+} test_record_t;
+
+/*
+ * Local variables
+ */
+
+nrf_fstorage_api_t nrf_fstorage_sd;
+
+static uint8_t * flash;
+static nrf_fstorage_t * fstorage;
+static struct {
+    bool pending;
+    nrf_fstorage_evt_id_t id;
+    uint32_t address;
+    const uint8_t * data;
+    uint32_t length;
+} operation;
+static unsigned erase_count[FLOG_PAGE_NUM];
+static unsigned erased_events;
+
+static test_record_t records[TEST_RECORD_MAX];      /**< Records appended, oldest first */
+static unsigned record_num;
+static uint32_t time_next = 1000;
+static int failures;
+
+/*
+ * Simulated flash: writes only clear bits, one operation at a time
+ */
+
+ret_code_t nrf_fstorage_init(nrf_fstorage_t * p_fs, nrf_fstorage_api_t const * p_api, void * p_param)
+{
+    fstorage = p_fs;
+    operation.pending = false;
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_write(nrf_fstorage_t const * p_fs, uint32_t dest, void const * p_src, uint32_t len, void * p_param)
+{
+    if (operation.pending || (dest % 4) || (len % 4) || (dest < FLOG_START_ADDR) || (dest + len > FLOG_END_ADDR)) {
+        printf("write of %u bytes at 0x%x refused\n", len, dest);
+        failures++;
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    operation = (typeof(operation)){ true, NRF_FSTORAGE_EVT_WRITE_RESULT, dest, p_src, len };
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_fstorage_erase(nrf_fstorage_t const * p_fs, uint32_t page_addr, uint32_t len, void * p_param)
+{
+    if (operation.pending || (page_addr % FLOG_PAGE_SIZE) || (page_addr < FLOG_START_ADDR) ||
+        (page_addr + len * FLOG_PAGE_SIZE > FLOG_END_ADDR)) {
+        printf("erase of %u pages at 0x%x refused\n", len, page_addr);
+        failures++;
+        return NRF_ERROR_INVALID_ADDR;
+    }
+    operation = (typeof(operation)){ true, NRF_FSTORAGE_EVT_ERASE_RESULT, page_addr, NULL, len * FLOG_PAGE_SIZE };
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Execute the pending operation, only part of it if power is lost
+ */
+static void flash_execute(bool power_lost)
+{
+    uint32_t offset = operation.address - FLOG_START_ADDR;
+    uint32_t length = power_lost ? (operation.length / 2) & ~3UL : operation.length;
+
+    operation.pending = false;
+    if (operation.id == NRF_FSTORAGE_EVT_ERASE_RESULT) {
+        memset(&flash[offset], 0xFF, length);
+        for (uint32_t page = offset / FLOG_PAGE_SIZE; page < (offset + length) / FLOG_PAGE_SIZE; page++) {
+            erase_count[page]++;
+        }
+    }
+    else {
+        for (uint32_t n = 0; n < length; n++) {
+            if ((flash[offset + n] & operation.data[n]) != operation.data[n]) {
+                printf("write at 0x%x over programmed flash\n", operation.address + n);
+                failures++;
+                break;
+            }
+            flash[offset + n] &= operation.data[n];
+        }
+    }
+    if (power_lost == false) {
+        nrf_fstorage_evt_t evt = { .id = operation.id, .result = NRF_SUCCESS, .addr = operation.address, .len = operation.length };
+        fstorage->evt_handler(&evt);
+    }
+}
+
+static void flash_run(void)
+{
+    while (operation.pending) {
+        flash_execute(false);
+    }
+}
+
+/*
+ * Local functions
+ */
+
+static void event_handler(flog_event_t flog_event)
+{
+    if (flog_event == FLOG_EVENT_ERASED) {
+        erased_events++;
+    }
+}
+
+/* Records carry their time in their first bytes, then a pattern */
+static uint8_t record_byte(uint32_t time, unsigned n)
+{
+    return (n < sizeof(time)) ? (uint8_t)(time >> (8 * n)) : (uint8_t)((time * 31) + (n * 7));
+}
+
+static bool record_append(void)
+{
+    static uint8_t data[FLOG_PAYLOAD_MAX];
+    uint16_t length = (uint16_t)(sizeof(time_next) + rand() % (FLOG_PAYLOAD_MAX - sizeof(time_next) + 1));
+    uint32_t time = time_next;
+
+    time_next += 1 + rand() % 3;
+    for (unsigned n = 0; n < length; n++) {
+        data[n] = record_byte(time, n);
+    }
+    if (FLOG_Append(time, data, length) == false) {
+        return false;
+    }
+    records[record_num].time = time;
+    records[record_num].length = length;
+    record_num++;
+    return true;
+}
+
+/**
+ * @brief Records read must be the newest ones appended, in order, and
+ * from the first one recorded at or after since
+ */
+static void log_check(const char * what, uint32_t since, bool expect_newest)
+{
+    flog_reader_t reader;
+    flog_status_t status;
+    const uint8_t * data;
+    uint16_t length;
+    unsigned first = 0;
+    unsigned count = 0;
+    unsigned r = 0;
+
+    FLOG_ReadBegin(&reader, since);
+    while (FLOG_Read(&reader, &data, &length)) {
+        uint32_t time = (length < sizeof(uint32_t)) ? 0 : data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+        if (count == 0) {
+            while ((r < record_num) && (records[r].time != time)) {
+                r++;
+            }
+            first = r;
+        }
+        if ((r >= record_num) || (records[r].time != time) || (records[r].length != length)) {
+            printf("%s: record %u at time %u not expected\n", what, count, time);
+            failures++;
+            return;
+        }
+        for (unsigned n = 0; n < length; n++) {
+            if (data[n] != record_byte(time, n)) {
+                printf("%s: record at time %u corrupted\n", what, time);
+                failures++;
+                return;
+            }
+        }
+        FLOG_ReadNext(&reader);
+        count++;
+        r++;
+    }
+
+    if (expect_newest && (r != record_num)) {
+        printf("%s: %u records read, newest one missing\n", what, count);
+        failures++;
+    }
+    if ((count > 0) && (records[first].time < since)) {
+        printf("%s: record at %u read, before %u\n", what, records[first].time, since);
+        failures++;
+    }
+    if ((count > 0) && (first > 0) && (records[first - 1].time >= since) && (since > 0)) {
+        printf("%s: record at %u skipped, since %u\n", what, records[first - 1].time, since);
+        failures++;
+    }
+    FLOG_GetStatus(&status);
+    if ((since == 0) && (status.record_count != count)) {
+        printf("%s: status gives %u records, %u read\n", what, status.record_count, count);
+        failures++;
+    }
+    if (status.used > status.size) {
+        printf("%s: %u bytes used out of %u\n", what, status.used, status.size);
+        failures++;
+    }
+}
+
+static void test_wrap(void)
+{
+    /* Ring wraps a few times, records of any size */
+    for (unsigned i = 0; i < 3000; i++) {
+        record_append();
+        flash_run();
+        if ((i % 250) == 0) {
+            log_check("wrap", 0, true);
+        }
+    }
+    log_check("wrap", 0, true);
+
+    /* Only one record at a time */
+    if ((record_append() == false) || (record_append() != false)) {
+        printf("busy: second record not dropped\n");
+        failures++;
+    }
+    flash_run();
+
+    /* Reset */
+    FLOG_Init(event_handler);
+    log_check("reset", 0, true);
+
+    for (unsigned i = 0; i < 20; i++) {
+        uint32_t since = records[record_num - 1 - (unsigned)rand() % 600].time + (unsigned)rand() % 2;
+        log_check("since", since, true);
+    }
+}
+
+static void test_power_loss(void)
+{
+    for (unsigned i = 0; i < 200; i++) {
+        unsigned steps = (unsigned)rand() % 4;
+
+        for (unsigned n = (unsigned)rand() % 8; n > 0; n--) {
+            record_append();
+            flash_run();
+        }
+        /* Power lost in the middle of one of the operations of an append */
+        if (record_append() == false) {
+            continue;
+        }
+        for (unsigned n = 0; (n < steps) && operation.pending; n++) {
+            flash_execute(false);
+        }
+        if (operation.pending) {
+            flash_execute(true);
+            record_num--;
+        }
+        FLOG_Init(event_handler);
+        log_check("power loss", 0, true);
+
+        record_append();
+        flash_run();
+        log_check("after power loss", 0, true);
+    }
+}
+
+static void test_erase(void)
+{
+    unsigned events = erased_events;
+    flog_status_t status;
+
+    if (FLOG_Erase() == false) {
+        printf("erase: refused\n");
+        failures++;
+    }
+    flash_run();
+    FLOG_GetStatus(&status);
+    if ((erased_events != events + 1) || (status.record_count != 0) || (status.used != 0)) {
+        printf("erase: log not empty\n");
+        failures++;
+    }
+    record_num = 0;
+    log_check("erase", 0, true);
+
+    for (unsigned i = 0; i < 1000; i++) {
+        record_append();
+        flash_run();
+    }
+    log_check("after erase", 0, true);
+    FLOG_Init(event_handler);
+    log_check("reset after erase", 0, true);
+}
+
+static void test_wear(void)
+{
+    unsigned min = erase_count[0];
+    unsigned max = erase_count[0];
+
+    for (unsigned page = 1; page < FLOG_PAGE_NUM; page++) {
+        min = (erase_count[page] < min) ? erase_count[page] : min;
+        max = (erase_count[page] > max) ? erase_count[page] : max;
+    }
+    printf("%u records, page erase count %u to %u\n", record_num, min, max);
+    if (max > min + 2) {
+        printf("wear: pages not used in turn\n");
+        failures++;
+    }
+}
+
+/*
+ * Main
+ */
+
+int main(void)
+{
+    flash = mmap((void *)FLOG_START_ADDR, TEST_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (flash != (uint8_t *)FLOG_START_ADDR) {
+        printf("flash_log: cannot map flash at 0x%x, SKIPPED\n", FLOG_START_ADDR);
+        return EXIT_SUCCESS;
+    }
+    memset(flash, 0xFF, TEST_FLASH_SIZE);
+
+    srand(1);
+    FLOG_Init(event_handler);
+    log_check("empty", 0, true);
+    test_wrap();
+    test_power_loss();
+    test_erase();
+    test_wear();
+
+    if (failures != 0) {
+        printf("FAILED (%d)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("flash_log: OK\n");
+    return EXIT_SUCCESS;
+}
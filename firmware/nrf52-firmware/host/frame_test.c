@@ -0,0 +1,307 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST FRAME TEST
+ *
+ *---------------------------------------------------------------
+ * @brief Check that frame.c streams the same bytes as nanocobs
+ * cobs_encode, whatever the packet size, that a truncated
+ * frame is dropped by the receiver, and that the receiver side
+ * gets frames back whatever the writes they are split in
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+
+#include "frame/frame.h"
+#include "nanocobs/cobs.h"
+#include "protocol.pb.h"
+
+/*
+ * Local constants
+ */
+
+#define TEST_PAYLOAD_MAX    4096
+#define TEST_OUTPUT_MAX     (2 * COBS_ENCODE_MAX(TEST_PAYLOAD_MAX))
+#define TEST_ITERATIONS     2000
+
+/*
+ * Local variables
+ */
+
+static const uint16_t packet_sizes[] = { 1, 7, 20, 244, 255, 300 };
+
+static uint8_t output[TEST_OUTPUT_MAX];
+static unsigned output_length;
+static uint16_t packet_size;
+static unsigned packets_sent;
+static int packets_left;            /**< Sink fails once it reaches 0, never if negative */
+static int failures;
+
+/*
+ * Local functions
+ */
+
+static bool sink(uint8_t * data, uint16_t length)
+{
+    if (packets_left == 0) {
+        return false;
+    }
+    if (packets_left > 0) {
+        packets_left--;
+    }
+    if (length > packet_size) {
+        printf("packet of %u bytes, max %u\n", length, packet_size);
+        failures++;
+    }
+    memcpy(&output[output_length], data, length);
+    output_length += length;
+    packets_sent++;
+    return true;
+}
+
+static void fill_payload(uint8_t * payload, unsigned length, unsigned zero_one_in)
+{
+    for (unsigned n = 0; n < length; n++) {
+        payload[n] = ((unsigned)rand() % zero_one_in == 0) ? 0 : (uint8_t)(1 + rand() % 255);
+    }
+}
+
+static void check_frame(const uint8_t * payload, unsigned length, const char * what)
+{
+    static uint8_t expected[COBS_ENCODE_MAX(TEST_PAYLOAD_MAX)];
+    unsigned expected_length;
+
+    if (cobs_encode(payload, length, expected, sizeof(expected), &expected_length) != COBS_RET_SUCCESS) {
+        printf("%s: cobs_encode failed\n", what);
+        failures++;
+        return;
+    }
+    if ((output_length != expected_length) || (memcmp(output, expected, expected_length) != 0)) {
+        printf("%s: %u bytes payload, %u bytes packets: got %u bytes, expected %u\n",
+               what, length, packet_size, output_length, expected_length);
+        failures++;
+    }
+}
+
+static void test_raw(void)
+{
+    static uint8_t payload[TEST_PAYLOAD_MAX];
+    static uint8_t packet[300];
+    frame_stream_t stream = { 0 };
+    static const unsigned zero_rates[] = { 2, 16, 300, 100000 };
+    static const unsigned lengths[] = { 0, 1, 253, 254, 255, 508, 509 };
+
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        unsigned length = (i < 7 * 4) ? lengths[i % 7] : (unsigned)rand() % TEST_PAYLOAD_MAX;
+        fill_payload(payload, length, zero_rates[(i / 7) % 4]);
+        packet_size = packet_sizes[i % (sizeof(packet_sizes) / sizeof(packet_sizes[0]))];
+        output_length = 0;
+        packets_left = -1;
+
+        FRAME_Begin(&stream, sink, packet, packet_size);
+        /* Write in uneven chunks, as pb_encode does */
+        unsigned offset = 0;
+        while (offset < length) {
+            unsigned chunk = 1 + (unsigned)rand() % 40;
+            if (chunk > length - offset) {
+                chunk = length - offset;
+            }
+            FRAME_Write(&stream, &payload[offset], chunk);
+            offset += chunk;
+        }
+        if (FRAME_End(&stream) == false) {
+            printf("raw: FRAME_End failed\n");
+            failures++;
+        }
+        check_frame(payload, length, "raw");
+    }
+}
+
+static void test_truncated(void)
+{
+    static uint8_t payload[1000];
+    static uint8_t packet[20];
+    frame_stream_t stream = { 0 };
+
+    packet_size = sizeof(packet);
+    fill_payload(payload, sizeof(payload), 16);
+
+    /* Sink fails in the middle of the first frame */
+    output_length = 0;
+    packets_left = 3;
+    FRAME_Begin(&stream, sink, packet, packet_size);
+    if ((FRAME_Write(&stream, payload, sizeof(payload)) != false) || (FRAME_End(&stream) != false)) {
+        printf("truncated: sink failure not reported\n");
+        failures++;
+    }
+
+    /* Next frame starts with a delimiter, then is complete */
+    output_length = 0;
+    packets_left = -1;
+    FRAME_Begin(&stream, sink, packet, packet_size);
+    FRAME_Write(&stream, payload, sizeof(payload));
+    FRAME_End(&stream);
+    if (output[0] != 0) {
+        printf("truncated: next frame does not start with a delimiter\n");
+        failures++;
+    }
+    memmove(output, &output[1], --output_length);
+    check_frame(payload, sizeof(payload), "truncated");
+}
+
+static void test_message(void)
+{
+    static DeviceMessage message = DeviceMessage_init_zero;
+    static uint8_t encoded[DeviceMessage_size];
+    static uint8_t packet[244];
+    frame_stream_t stream = { 0 };
+    EdaBatch * batch = &message.payload.eda_batch;
+
+    message.which_payload = DeviceMessage_eda_batch_tag;
+    batch->has_timestamp = true;
+    batch->timestamp.time = 1700000000;
+    batch->timestamp.us = 123456;
+    batch->spectra_count = pb_arraysize(EdaBatch, spectra);
+    for (unsigned s = 0; s < batch->spectra_count; s++) {
+        batch->spectra[s].delta_us = 125000 * s;
+        batch->spectra[s].data_count = 16;
+        for (unsigned n = 0; n < 16; n++) {
+            batch->spectra[s].data[n].real = 1.0e5f / (float)(n + 1 + s);
+            batch->spectra[s].data[n].imag = (n % 4 == 0) ? 0.0f : -1.0e4f * (float)n;
+        }
+    }
+
+    pb_ostream_t ostream = pb_ostream_from_buffer(encoded, sizeof(encoded));
+    pb_encode(&ostream, DeviceMessage_fields, &message);
+
+    packet_size = sizeof(packet);
+    output_length = 0;
+    packets_sent = 0;
+    packets_left = -1;
+    if (FRAME_SendMessage(&stream, sink, packet, packet_size, DeviceMessage_fields, &message) == false) {
+        printf("message: FRAME_SendMessage failed\n");
+        failures++;
+    }
+    check_frame(encoded, (unsigned)ostream.bytes_written, "message");
+    printf("EdaBatch of %u spectra: %u bytes, %u bytes framed in %u packets\n",
+           (unsigned)batch->spectra_count, (unsigned)ostream.bytes_written, output_length, packets_sent);
+}
+
+static void test_receive(void)
+{
+    static uint8_t payload[3][TEST_PAYLOAD_MAX / 8];
+    static unsigned lengths[3];
+    static uint8_t stream_bytes[3 * COBS_ENCODE_MAX(TEST_PAYLOAD_MAX / 8) + 4];
+    static uint8_t buffer[TEST_PAYLOAD_MAX / 8];
+    static uint8_t packet[20];
+    frame_stream_t stream = { 0 };
+    frame_rx_t rx;
+
+    FRAME_RxInit(&rx, buffer, sizeof(buffer));
+    packet_size = sizeof(packet);
+    for (unsigned i = 0; i < TEST_ITERATIONS; i++) {
+        unsigned stream_length = 0;
+        unsigned received = 0;
+
+        /* Three frames back to back, the last one too long for the receiver once in a while */
+        for (unsigned f = 0; f < 3; f++) {
+            lengths[f] = (unsigned)rand() % (sizeof(payload[f]) - 1);
+            if ((f == 2) && (i % 8 == 0)) {
+                lengths[f] = sizeof(payload[f]);
+            }
+            fill_payload(payload[f], lengths[f], 2 + (unsigned)rand() % 300);
+            output_length = 0;
+            packets_left = -1;
+            FRAME_Begin(&stream, sink, packet, packet_size);
+            FRAME_Write(&stream, payload[f], lengths[f]);
+            FRAME_End(&stream);
+            memcpy(&stream_bytes[stream_length], output, output_length);
+            stream_length += output_length;
+        }
+        if (i % 8 == 0) {
+            /* Frame of one more byte than the buffer holds */
+            FRAME_RxInit(&rx, buffer, (uint16_t)(lengths[2] - 1));
+        }
+
+        /* Received in writes of any size, frames are taken as they complete */
+        unsigned offset = 0;
+        while (offset < stream_length) {
+            unsigned chunk = 1 + (unsigned)rand() % 64;
+            if (chunk > stream_length - offset) {
+                chunk = stream_length - offset;
+            }
+            while (chunk > 0) {
+                bool complete;
+                uint16_t used = FRAME_RxPush(&rx, &stream_bytes[offset], (uint16_t)chunk, &complete);
+                offset += used;
+                chunk -= used;
+                if (complete == false) {
+                    continue;
+                }
+                if ((received >= 3) || (rx.length != lengths[received]) ||
+                    (memcmp(rx.buffer, payload[received], rx.length) != 0)) {
+                    printf("receive: frame %u of %u bytes does not match\n", received, rx.length);
+                    failures++;
+                }
+                received++;
+            }
+        }
+        if ((i % 8 == 0) ? ((received != 2) || (rx.dropped != 1)) : (received != 3)) {
+            printf("receive: %u frames received, %u dropped\n", received, (unsigned)rx.dropped);
+            failures++;
+        }
+        if (i % 8 == 0) {
+            FRAME_RxInit(&rx, buffer, sizeof(buffer));
+        }
+    }
+
+    /* Block announcing more bytes than the frame has, followed by a good frame */
+    static const uint8_t malformed[] = { 0x00, 0x05, 0x11, 0x22, 0x00, 0x03, 0x33, 0x44, 0x00 };
+    unsigned offset = 0;
+    unsigned received = 0;
+    while (offset < sizeof(malformed)) {
+        bool complete;
+        offset += FRAME_RxPush(&rx, &malformed[offset], (uint16_t)(sizeof(malformed) - offset), &complete);
+        if (complete && ((rx.length != 2) || (rx.buffer[0] != 0x33) || (rx.buffer[1] != 0x44))) {
+            printf("malformed: wrong frame kept\n");
+            failures++;
+        }
+        received += complete;
+    }
+    if ((received != 1) || (rx.dropped != 1)) {
+        printf("malformed: %u frames received, %u dropped\n", received, (unsigned)rx.dropped);
+        failures++;
+    }
+}
+
+/*
+ * Main
+ */
+
+int main(void)
+{
+    srand(1);
+    test_raw();
+    test_truncated();
+    test_message();
+    test_receive();
+
+    if (failures != 0) {
+        printf("FAILED (%d)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("frame: OK\n");
+    return EXIT_SUCCESS;
+}
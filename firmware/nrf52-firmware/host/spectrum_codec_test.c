@@ -0,0 +1,310 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST SPECTRUM CODEC TEST
+ *
+ *---------------------------------------------------------------
+ * @brief Check that spectrum_codec.c gives back the spectra it was
+ * given, within its quantization step, with their exact times,
+ * that it does not choke on corrupted records, and print how much
+ * flash it saves over half float EdaBatch messages
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+
+#include "flash_log/flash_log.h"
+#include "flash_log/spectrum_codec.h"
+#include "nanopb/pb_encode.h"
+#include "protocol.pb.h"
+
+/*
+ * Local constants
+ */
+
+#define TEST_FREQUENCY_NUM  16
+#define TEST_SPECTRA        4000            /**< 500 s at 8 Hz */
+#define TEST_PERIOD_US      125000
+#define TEST_START_US       1700000000000000ULL
+
+/*
+ * Local variables
+ */
+
+static const float frequencies[TEST_FREQUENCY_NUM] = { 12, 28, 32, 36, 44, 68, 84, 108, 136, 196, 256, 324, 400, 484, 576, 724 };
+
+static Impedance spectra[TEST_SPECTRA][TEST_FREQUENCY_NUM];
+static uint64_t times[TEST_SPECTRA];
+static int failures;
+
+/*
+ * Local functions
+ */
+
+static float noise(float amplitude)
+{
+    return amplitude * (((float)rand() / (float)RAND_MAX) - 0.5f);
+}
+
+/**
+ * @brief Skin like Rs + (Rp // Cp) load whose Rp drifts slowly, with
+ * measurement noise and timing jitter
+ */
+static void spectra_generate(void)
+{
+    float rp = 200000.0f;
+
+    for (unsigned s = 0; s < TEST_SPECTRA; s++) {
+        rp *= 1.0f + noise(0.002f);
+        times[s] = TEST_START_US + (uint64_t)s * TEST_PERIOD_US + (uint64_t)(rand() % 200);
+        for (unsigned n = 0; n < TEST_FREQUENCY_NUM; n++) {
+            float w = 2.0f * (float)M_PI * frequencies[n];
+            float cp = 50.0e-9f;
+            float d = 1.0f + (w * rp * cp) * (w * rp * cp);
+            spectra[s][n].real = (1000.0f + rp / d) * (1.0f + noise(1.0e-3f));
+            spectra[s][n].imag = (-w * rp * rp * cp / d) * (1.0f + noise(1.0e-3f));
+        }
+    }
+}
+
+/**
+ * @brief Size of the spectra as half float EdaBatch messages, as logged before
+ */
+static unsigned half_size_get(void)
+{
+    static EdaBatch batch = EdaBatch_init_zero;
+    size_t size;
+
+    batch.has_timestamp = true;
+    batch.timestamp.time = TEST_START_US / 1000000;
+    batch.timestamp.us = 999999;
+    batch.spectra_count = pb_arraysize(EdaBatch, spectra);
+    for (unsigned s = 0; s < batch.spectra_count; s++) {
+        batch.spectra[s].delta_us = TEST_PERIOD_US * s;
+        batch.spectra[s].half_exponent = 3;
+        batch.spectra[s].data_half.size = 4 * TEST_FREQUENCY_NUM;
+        memset(batch.spectra[s].data_half.bytes, 0x55, 4 * TEST_FREQUENCY_NUM);
+    }
+    pb_get_encoded_size(&size, EdaBatch_fields, &batch);
+    return (unsigned)size * (TEST_SPECTRA / batch.spectra_count);
+}
+
+static void test_round_trip(void)
+{
+    static uint8_t records[TEST_SPECTRA][FLOG_PAYLOAD_MAX];
+    static uint16_t lengths[TEST_SPECTRA];
+    scodec_encoder_t encoder;
+    scodec_decoder_t decoder;
+    unsigned record_num = 0;
+    unsigned total = 0;
+    unsigned s = 0;
+
+    /* Encode as the firmware does: store the record once full and start a new one */
+    SCODEC_EncodeBegin(&encoder, records[0], FLOG_PAYLOAD_MAX);
+    while (s < TEST_SPECTRA) {
+        if (SCODEC_EncodeSpectrum(&encoder, times[s], spectra[s], TEST_FREQUENCY_NUM)) {
+            s++;
+            continue;
+        }
+        if (encoder.spectrum_count == 0) {
+            printf("round trip: first spectrum of a record refused\n");
+            failures++;
+            return;
+        }
+        lengths[record_num++] = encoder.length;
+        SCODEC_EncodeBegin(&encoder, records[record_num], FLOG_PAYLOAD_MAX);
+    }
+    lengths[record_num++] = encoder.length;
+
+    s = 0;
+    for (unsigned r = 0; r < record_num; r++) {
+        Impedance data[TEST_FREQUENCY_NUM];
+        uint64_t time_us;
+        uint16_t count;
+
+        total += lengths[r];
+        if (lengths[r] > FLOG_PAYLOAD_MAX) {
+            printf("round trip: record of %u bytes\n", lengths[r]);
+            failures++;
+        }
+        if (SCODEC_DecodeBegin(&decoder, records[r], lengths[r]) == false) {
+            printf("round trip: record %u header rejected\n", r);
+            failures++;
+            return;
+        }
+        const float step = ldexpf(1.0f, decoder.exponent);
+        while (SCODEC_DecodeSpectrum(&decoder, &time_us, data, TEST_FREQUENCY_NUM, &count)) {
+            if ((s >= TEST_SPECTRA) || (count != TEST_FREQUENCY_NUM) || (time_us != times[s])) {
+                printf("round trip: spectrum %u time or count mismatch\n", s);
+                failures++;
+                return;
+            }
+            for (unsigned n = 0; n < TEST_FREQUENCY_NUM; n++) {
+                float error = fmaxf(fabsf(data[n].real - spectra[s][n].real), fabsf(data[n].imag - spectra[s][n].imag));
+                if (error > 0.5f * step * 1.001f) {
+                    printf("round trip: spectrum %u at %g Hz off by %g, step %g\n", s, frequencies[n], error, step);
+                    failures++;
+                    return;
+                }
+            }
+            s++;
+        }
+        if (decoder.offset != decoder.length) {
+            printf("round trip: record %u not decoded to its end\n", r);
+            failures++;
+        }
+    }
+    if (s != TEST_SPECTRA) {
+        printf("round trip: %u spectra decoded out of %u\n", s, TEST_SPECTRA);
+        failures++;
+    }
+
+    unsigned half = half_size_get();
+    printf("%u spectra: %u records, %.1f bytes per spectrum, half float EdaBatch %.1f (x%.1f)\n",
+           TEST_SPECTRA, record_num, (float)total / TEST_SPECTRA, (float)half / TEST_SPECTRA, (float)half / (float)total);
+    if (total >= half) {
+        printf("round trip: no smaller than half float batches\n");
+        failures++;
+    }
+}
+
+static void test_record_breaks(void)
+{
+    static uint8_t record[FLOG_PAYLOAD_MAX];
+    scodec_encoder_t encoder;
+    scodec_decoder_t decoder;
+    Impedance zero[TEST_FREQUENCY_NUM] = { 0 };
+    Impedance odd[TEST_FREQUENCY_NUM];
+    Impedance data[TEST_FREQUENCY_NUM];
+    uint64_t time_us;
+    uint16_t count;
+
+    /* Time going back a lot or frequency count change end the record */
+    SCODEC_EncodeBegin(&encoder, record, sizeof(record));
+    if ((SCODEC_EncodeSpectrum(&encoder, times[0], spectra[0], TEST_FREQUENCY_NUM) == false) ||
+        (SCODEC_EncodeSpectrum(&encoder, times[0] - 3600000000ULL, spectra[1], TEST_FREQUENCY_NUM) != false) ||
+        (SCODEC_EncodeSpectrum(&encoder, times[1], spectra[1], TEST_FREQUENCY_NUM - 1) != false)) {
+        printf("breaks: time jump or count change not refused\n");
+        failures++;
+    }
+
+    /* Unchanged, zero and non finite values */
+    memcpy(odd, spectra[0], sizeof(odd));
+    odd[3].real = NAN;
+    odd[4].imag = INFINITY;
+    SCODEC_EncodeBegin(&encoder, record, sizeof(record));
+    if ((SCODEC_EncodeSpectrum(&encoder, times[0], zero, TEST_FREQUENCY_NUM) == false) ||
+        (SCODEC_EncodeSpectrum(&encoder, times[1], zero, TEST_FREQUENCY_NUM) == false) ||
+        (SCODEC_EncodeSpectrum(&encoder, times[2], odd, TEST_FREQUENCY_NUM) == false)) {
+        printf("breaks: spectrum refused\n");
+        failures++;
+        return;
+    }
+    if (encoder.length > SCODEC_HEADER_MAX + 2 * SCODEC_SPECTRUM_MAX(0) + SCODEC_SPECTRUM_MAX(TEST_FREQUENCY_NUM)) {
+        printf("breaks: unchanged spectra take %u bytes\n", encoder.length);
+        failures++;
+    }
+
+    /* Values too large for the step of the record end it, and are kept whole in the next one */
+    for (unsigned n = 0; n < TEST_FREQUENCY_NUM; n++) {
+        odd[n].real = spectra[1][n].real * 1.0e7f;
+        odd[n].imag = spectra[1][n].imag * -1.0e7f;
+    }
+    SCODEC_EncodeBegin(&encoder, record, sizeof(record));
+    if ((SCODEC_EncodeSpectrum(&encoder, times[0], spectra[0], TEST_FREQUENCY_NUM) == false) ||
+        (SCODEC_EncodeSpectrum(&encoder, times[1], odd, TEST_FREQUENCY_NUM) != false) ||
+        (encoder.spectrum_count != 1)) {
+        printf("breaks: value out of the record range not refused\n");
+        failures++;
+        return;
+    }
+    SCODEC_EncodeBegin(&encoder, record, sizeof(record));
+    if ((SCODEC_EncodeSpectrum(&encoder, times[1], odd, TEST_FREQUENCY_NUM) == false) ||
+        (SCODEC_DecodeBegin(&decoder, record, encoder.length) == false) ||
+        (SCODEC_DecodeSpectrum(&decoder, &time_us, data, TEST_FREQUENCY_NUM, &count) == false)) {
+        printf("breaks: large spectrum not decoded\n");
+        failures++;
+        return;
+    }
+    /* Half a step of the largest value */
+    float tolerance = 0.0f;
+    for (unsigned n = 0; n < TEST_FREQUENCY_NUM; n++) {
+        tolerance = fmaxf(tolerance, fmaxf(fabsf(odd[n].real), fabsf(odd[n].imag)));
+    }
+    tolerance = ldexpf(tolerance, -SCODEC_PRECISION_BITS);
+    for (unsigned n = 0; n < TEST_FREQUENCY_NUM; n++) {
+        if ((fabsf(data[n].real - odd[n].real) > tolerance) ||
+            (fabsf(data[n].imag - odd[n].imag) > tolerance)) {
+            printf("breaks: large spectrum decoded as %g %g for %g %g\n", data[n].real, data[n].imag, odd[n].real, odd[n].imag);
+            failures++;
+            return;
+        }
+    }
+}
+
+static void test_corrupted(void)
+{
+    static uint8_t record[FLOG_PAYLOAD_MAX];
+    scodec_encoder_t encoder;
+    scodec_decoder_t decoder;
+    Impedance data[TEST_FREQUENCY_NUM];
+    uint64_t time_us;
+    uint16_t count;
+
+    SCODEC_EncodeBegin(&encoder, record, sizeof(record));
+    for (unsigned s = 0; SCODEC_EncodeSpectrum(&encoder, times[s], spectra[s], TEST_FREQUENCY_NUM); s++) {
+    }
+
+    /* Random bit flips and truncations must end decoding, whatever the output */
+    for (unsigned i = 0; i < 2000; i++) {
+        static uint8_t corrupted[FLOG_PAYLOAD_MAX];
+        uint16_t length = (uint16_t)(rand() % (encoder.length + 1));
+        unsigned spectra_decoded = 0;
+        memcpy(corrupted, record, encoder.length);
+        for (unsigned n = 0; n < 4; n++) {
+            corrupted[rand() % encoder.length] ^= (uint8_t)(1 << (rand() % 8));
+        }
+        if (SCODEC_DecodeBegin(&decoder, corrupted, length) == false) {
+            continue;
+        }
+        while (SCODEC_DecodeSpectrum(&decoder, &time_us, data, TEST_FREQUENCY_NUM, &count)) {
+            if ((count > TEST_FREQUENCY_NUM) || (++spectra_decoded > encoder.length)) {
+                printf("corrupted: decoder does not stop\n");
+                failures++;
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Main
+ */
+
+int main(void)
+{
+    srand(1);
+    spectra_generate();
+    test_round_trip();
+    test_record_breaks();
+    test_corrupted();
+
+    if (failures != 0) {
+        printf("FAILED (%d)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("spectrum_codec: OK\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,24 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Minimal stand-in for SDK header app_error.h: errors abort
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef APP_ERROR_H__
+#define APP_ERROR_H__
+
+#include <stdlib.h>
+
+#include "sdk_errors.h"
+
+#define APP_ERROR_CHECK(err_code)   do { if ((err_code) != NRF_SUCCESS) { abort(); } } while (0)
+
+#endif /* APP_ERROR_H__ */
+
+/* END OF FILE */
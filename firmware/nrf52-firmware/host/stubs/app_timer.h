@@ -0,0 +1,20 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Empty stand-in for SDK header app_timer.h
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef APP_TIMER_H
+#define APP_TIMER_H
+
+#include "arm_math.h"
+
+#endif /* APP_TIMER_H */
+
+/* END OF FILE */
@@ -0,0 +1,20 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Minimal stand-in for SDK header app_util.h
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef APP_UTIL_H__
+#define APP_UTIL_H__
+
+#define STATIC_ASSERT(expr)         _Static_assert(expr, #expr)
+
+#endif /* APP_UTIL_H__ */
+
+/* END OF FILE */
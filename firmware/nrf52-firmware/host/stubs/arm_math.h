@@ -0,0 +1,71 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Subset of CMSIS-DSP arm_math.h used by the EDA DSP,
+ * implemented by arm_math_shim.c for host builds
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef ARM_MATH_H
+#define ARM_MATH_H
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Public constants
+ */
+
+#define PI                          3.14159265358979f
+
+#define ARM_RFFT_SHIM_MAX_SIZE      4096                                        /**< largest real FFT length supported by the shim */
+
+/*
+ * Public types
+ */
+
+typedef float float32_t;
+typedef int32_t q31_t;
+
+typedef enum
+{
+    ARM_MATH_SUCCESS = 0,
+    ARM_MATH_ARGUMENT_ERROR = -1
+} arm_status;
+
+typedef struct
+{
+    uint16_t fftLenRFFT;                                                        /**< length of the real sequence */
+    float32_t twiddle[ARM_RFFT_SHIM_MAX_SIZE];                                  /**< cos/sin pairs of exp(-j.2.pi.k/fftLenRFFT) */
+} arm_rfft_fast_instance_f32;
+
+typedef struct
+{
+    uint32_t fftLenReal;                                                        /**< length of the real sequence */
+} arm_rfft_instance_q31;
+
+/*
+ * Public functions
+ */
+
+arm_status arm_rfft_fast_init_f32(arm_rfft_fast_instance_f32 * S, uint16_t fftLen);
+void arm_rfft_fast_f32(arm_rfft_fast_instance_f32 * S, float32_t * p, float32_t * pOut, uint8_t ifftFlag);
+
+arm_status arm_rfft_init_q31(arm_rfft_instance_q31 * S, uint32_t fftLenReal, uint32_t ifftFlagR, uint32_t bitReverseFlag);
+void arm_rfft_q31(const arm_rfft_instance_q31 * S, q31_t * pSrc, q31_t * pDst);
+
+#endif /* ARM_MATH_H */
+
+/* END OF FILE */
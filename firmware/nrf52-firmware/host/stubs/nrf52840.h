@@ -0,0 +1,38 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief Minimal stand-in for the nRF52840 device header: NVIC
+ * and FPU accesses of the EDA DSP become no-ops on host
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef NRF52840_H
+#define NRF52840_H
+
+#include <stdint.h>
+
+#define APP_IRQ_PRIORITY_LOWEST     7
+#define FPU_IRQn                    6
+
+typedef struct
+{
+    uintptr_t FPCAR;                                                            /**< points to a dummy FPU stack frame on host */
+} FPU_Type;
+
+extern FPU_Type host_fpu;                                                       /**< defined in arm_math_shim.c */
+#define FPU                         (&host_fpu)
+
+static inline void NVIC_SetPriority(int irq, uint32_t priority) { (void)irq; (void)priority; }
+static inline void NVIC_ClearPendingIRQ(int irq) { (void)irq; }
+static inline void NVIC_EnableIRQ(int irq) { (void)irq; }
+static inline void NVIC_DisableIRQ(int irq) { (void)irq; }
+static inline uint32_t __get_FPSCR(void) { return 0; }
+
+#endif /* NRF52840_H */
+
+/* END OF FILE */
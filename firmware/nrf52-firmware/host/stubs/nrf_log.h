@@ -0,0 +1,38 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST STUBS
+ * Author: Bertrand Massot
+ * Mail: bertrand.massot@insa-lyon.fr
+ *
+ *---------------------------------------------------------------
+ * @brief NRF_LOG macros redirected to stderr for host builds
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+#ifndef NRF_LOG_H
+#define NRF_LOG_H
+
+#include <stdio.h>
+
+#ifndef NRF_LOG_HOST_VERBOSE
+#define NRF_LOG_HOST_VERBOSE        0                                           /**< Print logs to stderr, set by "make VERBOSE=1" */
+#endif
+
+#if (NRF_LOG_HOST_VERBOSE == 1)
+/* Arguments are dropped: NRF_LOG formats (e.g. NRF_LOG_FLOAT) do not match printf ones */
+#define NRF_LOG_HOST(level, fmt, ...) fprintf(stderr, "%s: %s\n", level, fmt)
+#else
+#define NRF_LOG_HOST(level, ...)    do { } while (0)
+#endif
+
+#define NRF_LOG_ERROR(...)          NRF_LOG_HOST("E", __VA_ARGS__)
+#define NRF_LOG_WARNING(...)        NRF_LOG_HOST("W", __VA_ARGS__)
+#define NRF_LOG_INFO(...)           NRF_LOG_HOST("I", __VA_ARGS__)
+#define NRF_LOG_DEBUG(...)          do { } while (0)
+
+#define NRF_LOG_MODULE_REGISTER()   extern int nrf_log_module_unused
+
+#endif /* NRF_LOG_H */
+
+/* END OF FILE */
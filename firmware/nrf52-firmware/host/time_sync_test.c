@@ -0,0 +1,164 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: HOST TIME SYNC TEST
+ *
+ *---------------------------------------------------------------
+ * @brief Check that time_sync.c recovers the offset and drift of a
+ * simulated device clock from requests with jittery BLE latency and
+ * some late replies, and that its model holds between requests
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Project includes */
+
+#include "time_sync/time_sync.h"
+
+/*
+ * Local constants
+ */
+
+#define TEST_DRIFT_PPM          40.0        /**< Device clock runs slow by this */
+#define TEST_HOST_START_US      1700000000000000ULL
+#define TEST_DEVICE_START_US    5000000ULL
+#define TEST_INTERVAL_US        30000000ULL /**< Between two requests, as the web app */
+#define TEST_REQUESTS           120         /**< One hour */
+#define TEST_LATENCY_MIN_US     5000        /**< One way BLE latency range */
+#define TEST_LATENCY_MAX_US     15000
+#define TEST_LATE_US            100000      /**< Extra latency of a late reply, one request in ten */
+#define TEST_DRIFT_TOLERANCE    5.0
+#define TEST_OFFSET_TOLERANCE   5000        /**< Model error at a request, and 10 min after the last one */
+
+/*
+ * Local variables
+ */
+
+static int failures;
+
+/*
+ * Local functions
+ */
+
+static uint32_t latency(void)
+{
+    uint32_t us = TEST_LATENCY_MIN_US + (uint32_t)(rand() % (TEST_LATENCY_MAX_US - TEST_LATENCY_MIN_US));
+
+    if ((rand() % 10) == 0) {
+        us += TEST_LATE_US;
+    }
+    return us;
+}
+
+/**
+ * @brief Device clock at a host time
+ */
+static uint64_t device_clock(uint64_t host_us)
+{
+    double elapsed = (double)(host_us - TEST_HOST_START_US);
+
+    return TEST_DEVICE_START_US + (uint64_t)llround(elapsed / (1.0 + (TEST_DRIFT_PPM * 1.0e-6)));
+}
+
+/**
+ * @brief Host time given by the model at a device clock, as the calendar does
+ */
+static int64_t model_error(const tsync_model_t * model, uint64_t host_us)
+{
+    uint64_t device_us = device_clock(host_us);
+    double correction = (double)(int64_t)(device_us - model->ref_us) * model->drift_ppm * 1.0e-6;
+    int64_t model_us = (int64_t)device_us + model->offset_us + (int64_t)llround(correction);
+
+    return model_us - (int64_t)host_us;
+}
+
+static void test_fit(void)
+{
+    tsync_t sync;
+    tsync_model_t model;
+    uint64_t host_us = TEST_HOST_START_US;
+    int64_t error_max = 0;
+
+    TSYNC_Init(&sync);
+
+    for (unsigned r = 0; r < TEST_REQUESTS; r++) {
+        uint32_t up = latency();
+        uint32_t down = latency();
+        uint64_t received_us = host_us + up;
+
+        /* Host takes its midpoint as the time the device received the request */
+        if (TSYNC_AddSample(&sync, device_clock(received_us), host_us + ((up + down) / 2), up + down, &model) == false) {
+            printf("fit: sample %u refused\n", r);
+            failures++;
+            return;
+        }
+        if ((r == 0) && (model.drift_fitted || (model.drift_ppm != 0.0f))) {
+            printf("fit: drift from a single sample\n");
+            failures++;
+        }
+        /* Window spans enough for the drift, model holds at the requests */
+        if ((r * TEST_INTERVAL_US) >= (2 * TSYNC_DRIFT_SPAN_US)) {
+            int64_t error = llabs(model_error(&model, received_us));
+            if (error > error_max) {
+                error_max = error;
+            }
+        }
+        host_us += TEST_INTERVAL_US;
+    }
+
+    printf("fit: drift %.2f ppm for %.2f, %u samples used, max error %lld us\n",
+           model.drift_ppm, TEST_DRIFT_PPM, model.samples, (long long)error_max);
+    if ((model.drift_fitted == false) || (fabs(model.drift_ppm - TEST_DRIFT_PPM) > TEST_DRIFT_TOLERANCE)) {
+        printf("fit: drift off\n");
+        failures++;
+    }
+    if (error_max > TEST_OFFSET_TOLERANCE) {
+        printf("fit: offset off\n");
+        failures++;
+    }
+    if (llabs(model_error(&model, host_us + 600000000ULL)) > TEST_OFFSET_TOLERANCE) {
+        printf("fit: model off 10 min later\n");
+        failures++;
+    }
+
+    /* Device clock going back is a sample of another boot or host */
+    if (TSYNC_AddSample(&sync, device_clock(host_us) - TEST_INTERVAL_US, host_us, TEST_LATENCY_MIN_US, &model)) {
+        printf("fit: past sample accepted\n");
+        failures++;
+    }
+
+    /* Another host: offset from its first sample, drift kept */
+    TSYNC_Reset(&sync);
+    host_us += 3600000000ULL;
+    if ((TSYNC_AddSample(&sync, device_clock(host_us + 10000), host_us + 10000, 20000, &model) == false) ||
+        model.drift_fitted || (fabs(model.drift_ppm - TEST_DRIFT_PPM) > TEST_DRIFT_TOLERANCE) ||
+        (llabs(model_error(&model, host_us + 10000)) > 1)) {
+        printf("fit: reset lost the drift, or offset off\n");
+        failures++;
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    test_fit();
+
+    if (failures != 0) {
+        printf("FAILED (%d)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("time_sync: OK\n");
+    return EXIT_SUCCESS;
+}
+
+/* END OF FILE */
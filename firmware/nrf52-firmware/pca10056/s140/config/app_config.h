@@ -62,7 +62,7 @@
 
 /*** EDA AFE CONFIGURATION ***/
 #define TIMER1_ENABLED                          1
-#define EDA_CLK_TIMER_INSTANCE                  1
+#define EDA_CLK_TIMER_INSTANCE                  1       /**< Counts EDA clock edges, to stop the waveform at zero current and date SAADC buffers */
 
 /*** FUEL GAUGE ***/
 #define TWI0_ENABLED                            1
@@ -23,12 +23,16 @@
 /* Standard C library includes */
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* NRF SDK includes */
 
 // Macro APP_TIMER_TICKS
 #include "app_timer.h"
 
+// Critical regions around TX queue
+#include "app_util_platform.h"
+
 // Generic BLE includes
 #include "ble_advertising.h"
 #include "ble_conn_params.h"
@@ -68,6 +72,7 @@ NRF_LOG_MODULE_REGISTER();
 
 /* Application includes */
 #include "bluetooth.h"
+#include "latency/latency.h"
 
 /*
  * Local constants
@@ -109,6 +114,22 @@ NRF_LOG_MODULE_REGISTER();
 
 #define NUS_SERVICE_UUID_TYPE BLE_UUID_TYPE_VENDOR_BEGIN /**< UUID type for the Nordic UART Service (vendor specific). */
 
+#define NUS_TX_QUEUE_SIZE BLE_UART_TX_QUEUE_SIZE
+#define NUS_TX_MESSAGE_TIMEOUT_MS 50   /**< Maximum wait for room in the TX queue per message, less than one SAADC buffer */
+#define NUS_HVN_TX_QUEUE_SIZE 8        /**< Notifications the SoftDevice can queue per connection (default is 1).
+                                            WARNING : SD RAM size must be increased in linker file accordingly */
+
+#define DIAG_SERVICE_UUID 0x0010       /**< Diagnostics service, on the NUS base UUID so that no vendor UUID is added */
+#define DIAG_LATENCY_CHAR_UUID 0x0011  /**< Latency report characteristic (LatencyReport message, read only) */
+
+#define THROUGHPUT_TIMER_MS 5000                                                        /**< Period of throughput measurement and connection parameters tuning. */
+#define THROUGHPUT_MARGIN 2                                                             /**< Link capacity kept above the required throughput. */
+#define THROUGHPUT_MIN_CONN_INTERVAL MSEC_TO_UNITS(15, UNIT_1_25_MS)                    /**< Shortest connection interval requested (shortest accepted by iOS). */
+#define THROUGHPUT_MAX_CONN_INTERVAL MSEC_TO_UNITS(120, UNIT_1_25_MS)                   /**< Longest connection interval requested. */
+#define THROUGHPUT_MAX_SLEEP MSEC_TO_UNITS(480, UNIT_1_25_MS)                           /**< Longest time without listening to the central, interval x (slave latency + 1). */
+#define THROUGHPUT_MAX_SLAVE_LATENCY 30                                                 /**< Highest slave latency accepted by iOS. */
+#define THROUGHPUT_HYSTERESIS_PERCENT 25                                                /**< Connection interval is only updated beyond this change. */
+
 /*
  * Local macros
  */
@@ -118,6 +139,7 @@ NRF_LOG_MODULE_REGISTER();
 /*
  * Public variables
  */
+APP_TIMER_DEF(m_throughput_timer_id);             /**< Throughput measurement and connection parameters tuning. */
 BLE_NUS_DEF(m_nus, NRF_SDH_BLE_TOTAL_LINK_COUNT); /**< Nordic uart service instance. */
 BLE_BAS_DEF(m_bas);                               /**< Structure used to identify the battery service. */
 NRF_BLE_GATT_DEF(m_gatt);                         /**< GATT module instance. */
@@ -128,6 +150,14 @@ BLE_ADVERTISING_DEF(m_advertising);               /**< Advertising module instan
  * Local types
  */
 
+/**@brief Packet waiting to be notified through NUS TX */
+typedef struct
+{
+    uint16_t length;
+    uint32_t ticks;                     /**< app_timer counter when the packet was queued */
+    uint8_t  data[BLE_NUS_MAX_DATA_LEN];
+} nus_tx_packet_t;
+
 /*
  * Local variables
  */
@@ -141,20 +171,39 @@ static ble_uuid_t   m_adv_uuids[] =                             /**< Universally
 static uint8_t dfu_request = 0;
 static uint8_t m_mtu = 27 - OPCODE_LENGTH - HANDLE_LENGTH;
 static uint8_t m_phy = BLE_GAP_PHY_1MBPS;
+static uint8_t m_data_length = BLE_GAP_DATA_LENGTH_DEFAULT;   /**< Link layer payload size negotiated (DLE) */
+static uint16_t m_conn_interval = 0;                          /**< Current connection interval (1.25 ms units) */
+static uint16_t m_slave_latency = 0;                          /**< Current slave latency */
+static bool     m_conn_params_negotiated = false;             /**< Connection Parameters Module is done with its own update, throughput tuning may start */
 
 static ble_connection_callback_t    m_connection_event_callback = NULL;     /**< Pointer to user application callback for handling connection events */
 static ble_advertising_callback_t   m_advertising_event_callback = NULL;    /**< Pointer to user application callback for handling advertising events */
 static ble_uart_rx_callback_t       m_nus_event_callback = NULL;            /**< Pointer to user application callback for handling RX data from BLE UART */
+static ble_diagnostics_read_callback_t m_diag_read_callback = NULL;         /**< Pointer to user application callback giving the diagnostics value */
 
 static uint8_t  m_stop_adv_after_disconnect = 0;    /**< Store request for not starting advetising after next BLE disconnection */
 static uint8_t  m_stop_adv_after_idle = 0;          /**< Prevent from restarting advertising after timeout */
-static uint8_t  m_tx_busy = 0;                      /**< Store if the module is actually sending a buffer through TX nus */
-static uint8_t  * m_tx_buffer = NULL;               /**< The buffer being sent */
-static uint16_t m_tx_buffer_bytes_left = 0;         /**< The remaining number of bytes to be sent */ 
-static uint16_t m_tx_buffer_size = 0;               /**< The total number of bytes to send */
 static uint8_t  m_tx_notifications_enabled = 0;     /**< Store if remote suscribed to TX notifications */
 static uint8_t  m_bas_notifications_enabled = 0;    /**< Store if remote suscribed to battery level notifications */
 
+static nus_tx_packet_t   m_tx_queue[NUS_TX_QUEUE_SIZE];  /**< Packets not yet accepted by the SoftDevice */
+static uint16_t          m_tx_queue_head = 0;            /**< Oldest packet in queue */
+static volatile uint16_t m_tx_queue_count = 0;           /**< Packets in queue */
+static ble_uart_tx_stats_t m_tx_stats;                   /**< TX queue counters */
+static uint32_t          m_tx_message_start;             /**< Ticks at BLE_UartBeginMessage, packets wait for room until NUS_TX_MESSAGE_TIMEOUT_MS after it */
+static uint32_t          m_tx_sent_ticks[NUS_HVN_TX_QUEUE_SIZE]; /**< Queuing time of the packets given to the SoftDevice, oldest first */
+static uint16_t          m_tx_sent_head = 0;
+static uint16_t          m_tx_sent_count = 0;
+
+static uint16_t                 m_diag_service_handle;                  /**< Diagnostics service handle */
+static ble_gatts_char_handles_t m_diag_latency_handles;                 /**< Latency report characteristic handles */
+static uint8_t                  m_diag_value[BLE_DIAGNOSTICS_MAX_LEN];  /**< Latency report value, in application RAM */
+
+static uint32_t m_throughput_required = 0;          /**< Throughput requested by the application (bytes/s) */
+static uint32_t m_throughput = 0;                   /**< Throughput achieved over the last THROUGHPUT_TIMER_MS (bytes/s) */
+static uint32_t m_throughput_bytes_sent = 0;        /**< m_tx_stats.bytes_sent at last measurement */
+static uint32_t m_throughput_packets_dropped = 0;   /**< m_tx_stats.packets_dropped at last measurement */
+
 /*
  * Local functions
  */
@@ -180,7 +229,16 @@ static void delete_bonds(void);
 static void whitelist_set(pm_peer_id_list_skip_t skip);
 static void disconnect(uint16_t conn_handle, void *p_context);
 
-static void nus_send_next_packet(void);
+static void nus_tx_queue_process(void);
+static void nus_tx_queue_flush(void);
+static void nus_tx_queue_push(uint8_t *data, uint16_t length);
+static void nus_tx_sent_complete(uint8_t count);
+
+static void diagnostics_service_init(void);
+static void diagnostics_on_authorize(ble_gatts_evt_t const *p_gatts_evt);
+
+static void throughput_timer_handler(void *p_context);
+static void throughput_tune(uint32_t throughput);
 
 static void on_bas_evt(ble_bas_t * p_bas, ble_bas_evt_t * p_evt);
 
@@ -214,6 +272,7 @@ void BLE_Init()
         services_init();
         advertising_init();
         conn_params_init();
+        APP_ERROR_CHECK(app_timer_create(&m_throughput_timer_id, APP_TIMER_MODE_REPEATED, throughput_timer_handler));
     }
 }
 
@@ -325,7 +384,11 @@ void BLE_SetPhy2M(void)
         .tx_phys = BLE_GAP_PHY_2MBPS,
     };
     err_code = sd_ble_gap_phy_update(m_conn_handle, &phys);
-    APP_ERROR_CHECK(err_code);   
+    if (err_code != NRF_SUCCESS)
+    {
+        // Peer may be updating PHY already, or be gone
+        NRF_LOG_WARNING("PHY update request failed (0x%x)", err_code);
+    }
 }
 
 /**
@@ -336,6 +399,26 @@ uint8_t BLE_GetPhy(void)
     return m_phy;
 }
 
+/**
+ * @brief Function setting the throughput the application needs
+ */
+void BLE_SetRequiredThroughput(uint32_t bytes_per_s)
+{
+    m_throughput_required = bytes_per_s;
+    if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+    {
+        throughput_tune(m_throughput);
+    }
+}
+
+/**
+ * @brief Function returning the throughput achieved over the last measurement period
+ */
+uint32_t BLE_GetThroughput(void)
+{
+    return m_throughput;
+}
+
 /**
  * @brief Function for updating the Battery Level characteristic
  *        in Battery Service.
@@ -385,28 +468,106 @@ void BLE_SetUartRXCallback(void *callback)
     m_nus_event_callback = callback;
 }
 
+/**
+ * @brief Function to assign the callback giving the value of the latency
+ *        diagnostics characteristic
+ */
+void BLE_SetDiagnosticsReadCallback(void *callback)
+{
+    m_diag_read_callback = callback;
+}
+
 /**
  * @brief Function to send data over Nordic Uart Service
  */
-void BLE_UartSendArray(uint8_t *data, uint16_t length)
+bool BLE_UartSendArray(uint8_t *data, uint16_t length)
 {
+    uint16_t mtu = m_mtu;
+    uint16_t packets = (length + mtu - 1) / mtu;
+
     /* Don't send data if notifications are not enabled */
     if (m_tx_notifications_enabled == 0)
     {
-        return;
+        return false;
     }
 
-    /* Don't send data if already sending another buffer */
-    if (m_tx_busy != 0)
+    /* Queue the whole buffer or nothing, a partial buffer is useless to the receiver */
+    if (packets > (NUS_TX_QUEUE_SIZE - m_tx_queue_count))
     {
-        return;
+        m_tx_stats.packets_dropped += packets;
+        NRF_LOG_WARNING("NUS TX queue full, %u bytes dropped", length);
+        return false;
+    }
+
+    while (length > 0)
+    {
+        uint16_t to_send = (length > mtu) ? mtu : length;
+        nus_tx_queue_push(data, to_send);
+        data += to_send;
+        length -= to_send;
     }
+    nus_tx_queue_process();
+    return true;
+}
 
-    /* Start sending the first packet, others will be sent automatically */
-    m_tx_buffer = data;
-    m_tx_buffer_bytes_left = length;
-    m_tx_buffer_size = length;
-    nus_send_next_packet();
+/**
+ * @brief Function to start the TX deadline of a message sent by packets
+ */
+void BLE_UartBeginMessage(void)
+{
+    m_tx_message_start = app_timer_cnt_get();
+}
+
+/**
+ * @brief Function to send one packet over Nordic Uart Service, waiting for
+ *        room in the TX queue until the deadline of the message
+ */
+bool BLE_UartSendPacket(uint8_t *data, uint16_t length)
+{
+    if ((m_tx_notifications_enabled == 0) || (length > m_mtu))
+    {
+        return false;
+    }
+
+    /* Queue is emptied from BLE events, dispatched from interrupt, so just sleep */
+    while (m_tx_queue_count >= NUS_TX_QUEUE_SIZE)
+    {
+        if ((m_tx_notifications_enabled == 0) ||
+            (app_timer_cnt_diff_compute(app_timer_cnt_get(), m_tx_message_start) > APP_TIMER_TICKS(NUS_TX_MESSAGE_TIMEOUT_MS)))
+        {
+            m_tx_stats.packets_dropped++;
+            NRF_LOG_WARNING("NUS TX packet dropped");
+            return false;
+        }
+        sd_app_evt_wait();
+    }
+
+    nus_tx_queue_push(data, length);
+    nus_tx_queue_process();
+    return true;
+}
+
+/**
+ * @brief Function returning the room left in the NUS TX queue, in packets
+ */
+uint16_t BLE_UartGetTxQueueFree(void)
+{
+    if (m_tx_notifications_enabled == 0)
+    {
+        return 0;
+    }
+    return NUS_TX_QUEUE_SIZE - m_tx_queue_count;
+}
+
+/**
+ * @brief Function returning NUS TX queue counters
+ */
+void BLE_UartGetTxStats(ble_uart_tx_stats_t *p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_tx_stats;
+    p_stats->queue_depth = m_tx_queue_count;
+    CRITICAL_REGION_EXIT();
 }
 
 /*
@@ -527,6 +688,10 @@ static void gatt_init(void)
 {
     ret_code_t err_code = nrf_ble_gatt_init(&m_gatt, gatt_evt_handler);
     APP_ERROR_CHECK(err_code);
+
+    // Request the longest link layer payload on each connection, so that an MTU fits in one packet
+    err_code = nrf_ble_gatt_data_length_set(&m_gatt, BLE_CONN_HANDLE_INVALID, NRF_SDH_BLE_GAP_DATA_LENGTH);
+    APP_ERROR_CHECK(err_code);
 }
 
 /**@brief Function for handling Queued Write Module errors.
@@ -608,6 +773,9 @@ static void services_init(void)
     err_code = ble_nus_init(&m_nus, &nus_init);
     APP_ERROR_CHECK(err_code);
 
+    // Initialize Diagnostics Service, uses the UUID base registered by NUS.
+    diagnostics_service_init();
+
     // Initialize DFU Service.
     memset(&dfus_init, 0, sizeof(dfus_init));
 
@@ -665,6 +833,14 @@ static void ble_stack_init(void)
     err_code = nrf_sdh_ble_default_cfg_set(APP_BLE_CONN_CFG_TAG, &ram_start);
     APP_ERROR_CHECK(err_code);
 
+    // Let the SoftDevice queue several notifications, to send them in a single connection event.
+    ble_cfg_t ble_cfg;
+    memset(&ble_cfg, 0, sizeof(ble_cfg));
+    ble_cfg.conn_cfg.conn_cfg_tag = APP_BLE_CONN_CFG_TAG;
+    ble_cfg.conn_cfg.params.gatts_conn_cfg.hvn_tx_queue_size = NUS_HVN_TX_QUEUE_SIZE;
+    err_code = sd_ble_cfg_set(BLE_CONN_CFG_GATTS, &ble_cfg, ram_start);
+    APP_ERROR_CHECK(err_code);
+
     // Enable BLE stack.
     err_code = nrf_sdh_ble_enable(&ram_start);
     APP_ERROR_CHECK(err_code);
@@ -1043,6 +1219,13 @@ static void on_conn_params_evt(ble_conn_params_evt_t *p_evt)
 {
     //ret_code_t err_code;
 
+    if (m_conn_params_negotiated)
+    {
+        // Module reacts to the parameters requested by throughput_tune, which are outside its preferred ones
+        NRF_LOG_DEBUG("Parameters module event %u after tuning", p_evt->evt_type);
+        return;
+    }
+
     if (p_evt->evt_type == BLE_CONN_PARAMS_EVT_FAILED)
     {
         NRF_LOG_ERROR("Parameters update failed !");
@@ -1053,6 +1236,13 @@ static void on_conn_params_evt(ble_conn_params_evt_t *p_evt)
     {
         NRF_LOG_DEBUG("Parameters successfully updated");  
     }
+
+    // First update is over, tuning no longer races it
+    m_conn_params_negotiated = true;
+    if (m_conn_handle != BLE_CONN_HANDLE_INVALID)
+    {
+        throughput_tune(m_throughput);
+    }
 }
 
 /**@brief GATT module event handler.
@@ -1066,6 +1256,13 @@ static void gatt_evt_handler(nrf_ble_gatt_t *p_gatt, nrf_ble_gatt_evt_t const *p
                      p_evt->params.att_mtu_effective - OPCODE_LENGTH - HANDLE_LENGTH);
         m_mtu = p_evt->params.att_mtu_effective - OPCODE_LENGTH - HANDLE_LENGTH;
     }
+    else if (p_evt->evt_id == NRF_BLE_GATT_EVT_DATA_LENGTH_UPDATED)
+    {
+        NRF_LOG_DEBUG("Data length on connection 0x%x changed to %d",
+                     p_evt->conn_handle,
+                     p_evt->params.data_length);
+        m_data_length = p_evt->params.data_length;
+    }
 }
 
 /**@brief Function for handling BLE events.
@@ -1086,6 +1283,22 @@ static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context)
         APP_ERROR_CHECK(err_code);
         memcpy(&conn_params, &(p_ble_evt->evt.gap_evt.params.connected.conn_params), sizeof(ble_gap_conn_params_t));
         NRF_LOG_INFO("Connected with param. %u, %u, %u, %u", conn_params.min_conn_interval, conn_params.max_conn_interval, conn_params.slave_latency, conn_params.conn_sup_timeout);
+        m_conn_interval = conn_params.max_conn_interval;
+        m_slave_latency = conn_params.slave_latency;
+        m_conn_params_negotiated = false;
+        // 2M PHY halves radio on time for the same data, central may refuse it
+        BLE_SetPhy2M();
+        m_throughput = 0;
+        m_throughput_bytes_sent = m_tx_stats.bytes_sent;
+        m_throughput_packets_dropped = m_tx_stats.packets_dropped;
+        APP_ERROR_CHECK(app_timer_start(m_throughput_timer_id, APP_TIMER_TICKS(THROUGHPUT_TIMER_MS), NULL));
+        break;
+
+    case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+        memcpy(&conn_params, &(p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params), sizeof(ble_gap_conn_params_t));
+        NRF_LOG_INFO("Connection param. updated %u, %u, %u", conn_params.max_conn_interval, conn_params.slave_latency, conn_params.conn_sup_timeout);
+        m_conn_interval = conn_params.max_conn_interval;
+        m_slave_latency = conn_params.slave_latency;
         break;
 
     case BLE_GAP_EVT_DISCONNECTED:
@@ -1093,8 +1306,15 @@ static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context)
                      p_ble_evt->evt.gap_evt.params.disconnected.reason);
         m_tx_notifications_enabled = 0;
         m_bas_notifications_enabled = 0;
-        m_tx_busy = 0;
         m_conn_handle = BLE_CONN_HANDLE_INVALID;
+        nus_tx_queue_flush();
+        app_timer_stop(m_throughput_timer_id);
+        m_phy = BLE_GAP_PHY_1MBPS;
+        m_data_length = BLE_GAP_DATA_LENGTH_DEFAULT;
+        // Next connection starts from the preferred parameters, tuning waits for its first update again
+        m_conn_interval = 0;
+        m_slave_latency = 0;
+        m_conn_params_negotiated = false;
         if (m_stop_adv_after_disconnect == 1)
         {
             sd_ble_gap_adv_stop(m_advertising.adv_handle);
@@ -1122,6 +1342,17 @@ static void ble_evt_handler(ble_evt_t const *p_ble_evt, void *p_context)
     }
     break;
 
+    case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+        // SoftDevice has room again, give it the packets left in queue
+        m_tx_stats.notifications_sent += p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count;
+        nus_tx_sent_complete(p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+        nus_tx_queue_process();
+        break;
+
+    case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+        diagnostics_on_authorize(&p_ble_evt->evt.gatts_evt);
+        break;
+
     case BLE_GATTC_EVT_TIMEOUT:
         // Disconnect on GATT Client timeout event.
         NRF_LOG_ERROR("ATT Client Timeout");
@@ -1184,12 +1415,6 @@ static void nus_data_handler(ble_nus_evt_t *p_evt)
     case BLE_NUS_EVT_RX_DATA:
         NRF_LOG_DEBUG("NUS RX %d bytes received", p_evt->params.rx_data.length);
         break;
-    case BLE_NUS_EVT_TX_RDY:
-        if (m_tx_buffer_bytes_left > 0)
-        {
-            nus_send_next_packet();
-        }
-        break;
     case BLE_NUS_EVT_COMM_STARTED:
         NRF_LOG_DEBUG("NUS TX notifications enabled");
         m_tx_notifications_enabled = 1;
@@ -1197,7 +1422,7 @@ static void nus_data_handler(ble_nus_evt_t *p_evt)
     case BLE_NUS_EVT_COMM_STOPPED:
         NRF_LOG_DEBUG("NUS TX notification disabled");
         m_tx_notifications_enabled = 0;
-        m_tx_busy = 0;
+        nus_tx_queue_flush();
         break;
     default:
         break;
@@ -1209,32 +1434,256 @@ static void nus_data_handler(ble_nus_evt_t *p_evt)
     }
 }
 
-static void nus_send_next_packet(void)
+/**@brief Copy a packet at the end of the TX queue, which must not be full.
+ */
+static void nus_tx_queue_push(uint8_t *data, uint16_t length)
+{
+    // Queue can be emptied by BLE events at any time, which moves its tail
+    CRITICAL_REGION_ENTER();
+    uint16_t tail = (m_tx_queue_head + m_tx_queue_count) % NUS_TX_QUEUE_SIZE;
+    memcpy(m_tx_queue[tail].data, data, length);
+    m_tx_queue[tail].length = length;
+    m_tx_queue[tail].ticks = LAT_GetTicks();
+    m_tx_queue_count++;
+    if (m_tx_queue_count > m_tx_stats.queue_depth_max)
+    {
+        m_tx_stats.queue_depth_max = m_tx_queue_count;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Give queued packets to the SoftDevice until all its TX buffers are used.
+ *
+ * @details Called from the application when packets are queued, and from the BLE
+ *          event handler when notifications have been sent.
+ */
+static void nus_tx_queue_process(void)
 {
     ret_code_t err_code;
-    uint16_t to_send;
 
-    if (m_tx_buffer_bytes_left > m_mtu)
+    CRITICAL_REGION_ENTER();
+    while (m_tx_queue_count > 0)
     {
-        to_send = m_mtu;
+        nus_tx_packet_t *packet = &m_tx_queue[m_tx_queue_head];
+        uint16_t length = packet->length;
+
+        err_code = ble_nus_data_send(&m_nus, packet->data, &length, m_conn_handle);
+        if (err_code == NRF_ERROR_RESOURCES)
+        {
+            // Retried on next BLE_GATTS_EVT_HVN_TX_COMPLETE
+            m_tx_stats.retries++;
+            break;
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            if ((err_code != NRF_ERROR_INVALID_STATE) &&
+                (err_code != NRF_ERROR_NOT_FOUND))
+            {
+                APP_ERROR_CHECK(err_code);
+            }
+            m_tx_stats.packets_dropped += m_tx_queue_count;
+            m_tx_queue_count = 0;
+            break;
+        }
+        m_tx_stats.bytes_sent += length;
+        if (m_tx_sent_count < NUS_HVN_TX_QUEUE_SIZE)
+        {
+            m_tx_sent_ticks[(m_tx_sent_head + m_tx_sent_count) % NUS_HVN_TX_QUEUE_SIZE] = packet->ticks;
+            m_tx_sent_count++;
+        }
+        m_tx_queue_head = (m_tx_queue_head + 1) % NUS_TX_QUEUE_SIZE;
+        m_tx_queue_count--;
     }
-    else
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Drop packets left in TX queue, on disconnection or when notifications are disabled.
+ */
+static void nus_tx_queue_flush(void)
+{
+    CRITICAL_REGION_ENTER();
+    if (m_tx_queue_count > 0)
+    {
+        NRF_LOG_WARNING("%u NUS TX packets dropped", m_tx_queue_count);
+    }
+    m_tx_stats.packets_dropped += m_tx_queue_count;
+    m_tx_queue_count = 0;
+    m_tx_sent_count = 0;
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Record the queue to acknowledgment time of the oldest packets given to the SoftDevice.
+ *
+ * @details Notifications complete in order. Battery level notifications share the SoftDevice
+ *          queue and are counted as NUS ones, which only shifts a few samples.
+ */
+static void nus_tx_sent_complete(uint8_t count)
+{
+    CRITICAL_REGION_ENTER();
+    while ((count > 0) && (m_tx_sent_count > 0))
+    {
+        LAT_RecordTicks(LAT_STAGE_TX, m_tx_sent_ticks[m_tx_sent_head]);
+        m_tx_sent_head = (m_tx_sent_head + 1) % NUS_HVN_TX_QUEUE_SIZE;
+        m_tx_sent_count--;
+        count--;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**@brief Add the diagnostics service and its latency report characteristic.
+ *
+ * @details The value is kept in application RAM (no room in the SoftDevice attribute table)
+ *          and refreshed on read authorization.
+ */
+static void diagnostics_service_init(void)
+{
+    ret_code_t err_code;
+    ble_uuid_t service_uuid;
+    ble_add_char_params_t add_char_params;
+
+    service_uuid.type = m_nus.uuid_type;
+    service_uuid.uuid = DIAG_SERVICE_UUID;
+    err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &service_uuid, &m_diag_service_handle);
+    APP_ERROR_CHECK(err_code);
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid = DIAG_LATENCY_CHAR_UUID;
+    add_char_params.uuid_type = m_nus.uuid_type;
+    add_char_params.max_len = sizeof(m_diag_value);
+    add_char_params.init_len = 0;
+    add_char_params.p_init_value = m_diag_value;
+    add_char_params.is_var_len = true;
+    add_char_params.is_value_user = true;
+    add_char_params.is_defered_read = true;
+    add_char_params.char_props.read = 1;
+    add_char_params.read_access = SEC_OPEN;
+    err_code = characteristic_add(m_diag_service_handle, &add_char_params, &m_diag_latency_handles);
+    APP_ERROR_CHECK(err_code);
+}
+
+/**@brief Refresh the latency report when a read starts.
+ *
+ * @details Long reads come back with a non zero offset for each further part, those
+ *          are answered from the value stored on the first request.
+ */
+static void diagnostics_on_authorize(ble_gatts_evt_t const *p_gatts_evt)
+{
+    ble_gatts_evt_rw_authorize_request_t const *p_request = &p_gatts_evt->params.authorize_request;
+    ble_gatts_rw_authorize_reply_params_t reply;
+    uint8_t const *p_data = NULL;
+    uint16_t length = 0;
+    ret_code_t err_code;
+
+    if ((p_request->type != BLE_GATTS_AUTHORIZE_TYPE_READ) ||
+        (p_request->request.read.handle != m_diag_latency_handles.value_handle))
     {
-        to_send = m_tx_buffer_bytes_left;
+        return;
     }
 
-    err_code = ble_nus_data_send(&m_nus, &m_tx_buffer[m_tx_buffer_size - m_tx_buffer_bytes_left], &to_send, m_conn_handle);
-    if ((err_code != NRF_ERROR_INVALID_STATE) &&
-        (err_code != NRF_ERROR_RESOURCES) &&
-        (err_code != NRF_ERROR_NOT_FOUND))
+    memset(&reply, 0, sizeof(reply));
+    reply.type = BLE_GATTS_AUTHORIZE_TYPE_READ;
+    reply.params.read.gatt_status = BLE_GATT_STATUS_SUCCESS;
+    if (p_request->request.read.offset == 0)
+    {
+        if (m_diag_read_callback != NULL)
+        {
+            length = m_diag_read_callback(&p_data);
+        }
+        if (length > sizeof(m_diag_value))
+        {
+            length = sizeof(m_diag_value);
+        }
+        reply.params.read.update = 1;
+        reply.params.read.offset = 0;
+        reply.params.read.len = length;
+        reply.params.read.p_data = p_data;
+    }
+    err_code = sd_ble_gatts_rw_authorize_reply(p_gatts_evt->conn_handle, &reply);
+    if ((err_code != NRF_ERROR_INVALID_STATE) && (err_code != BLE_ERROR_INVALID_CONN_HANDLE))
     {
         APP_ERROR_CHECK(err_code);
     }
-    m_tx_buffer_bytes_left -= to_send;
-    if (m_tx_buffer_bytes_left == 0)
+}
+
+/**@brief Measure the throughput achieved and tune connection parameters accordingly.
+ */
+static void throughput_timer_handler(void *p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    uint32_t bytes_sent = m_tx_stats.bytes_sent - m_throughput_bytes_sent;
+    uint32_t packets_dropped = m_tx_stats.packets_dropped - m_throughput_packets_dropped;
+    m_throughput_bytes_sent += bytes_sent;
+    m_throughput_packets_dropped += packets_dropped;
+    m_throughput = (uint32_t)(((uint64_t)bytes_sent * 1000) / THROUGHPUT_TIMER_MS);
+
+    NRF_LOG_DEBUG("Throughput %u B/s, interval %u, latency %u, PHY %u, DL %u",
+                  m_throughput, m_conn_interval, m_slave_latency, m_phy, m_data_length);
+
+    // Throughput measured is capped by the link when packets are dropped, ask for more
+    throughput_tune((packets_dropped > 0) ? (THROUGHPUT_MARGIN * m_throughput) + 1 : m_throughput);
+}
+
+/**@brief Request the longest connection interval that still carries the throughput needed.
+ *
+ * @details Capacity per connection event is NUS_HVN_TX_QUEUE_SIZE packets of one MTU, the
+ *          interval keeps it THROUGHPUT_MARGIN times above the throughput. Slave latency is
+ *          then set so that the device only listens every THROUGHPUT_MAX_SLEEP when it has
+ *          nothing to send, which does not limit throughput.
+ *
+ *          The request goes straight to the SoftDevice, so that the preferred parameters (PPCP)
+ *          and the Connection Parameters Module settings stay the defaults for next connections.
+ *          Nothing is requested until the module is done with its first update. If the module
+ *          then brings the preferred parameters back, the next measurement tunes them again.
+ *
+ * @param[in] throughput  Throughput measured (bytes/s), m_throughput_required is used if higher.
+ */
+static void throughput_tune(uint32_t throughput)
+{
+    ret_code_t err_code;
+    ble_gap_conn_params_t conn_params;
+    uint32_t interval = THROUGHPUT_MAX_CONN_INTERVAL;
+
+    if (m_conn_params_negotiated == false)
+    {
+        return;
+    }
+    if (throughput < m_throughput_required)
+    {
+        throughput = m_throughput_required;
+    }
+    if (throughput > 0)
+    {
+        // Event capacity (bytes) x 800 events per second at 1.25 ms units
+        interval = ((uint32_t)NUS_HVN_TX_QUEUE_SIZE * m_mtu * 800) / (THROUGHPUT_MARGIN * throughput);
+    }
+    if (interval > THROUGHPUT_MAX_CONN_INTERVAL)
+    {
+        interval = THROUGHPUT_MAX_CONN_INTERVAL;
+    }
+    if (interval < THROUGHPUT_MIN_CONN_INTERVAL)
+    {
+        interval = THROUGHPUT_MIN_CONN_INTERVAL;
+    }
+
+    if ((m_conn_interval != 0) &&
+        ((abs((int32_t)interval - (int32_t)m_conn_interval) * 100) <= (THROUGHPUT_HYSTERESIS_PERCENT * m_conn_interval)))
+    {
+        return;
+    }
+
+    memset(&conn_params, 0, sizeof(conn_params));
+    conn_params.max_conn_interval = interval;
+    conn_params.min_conn_interval = MAX(THROUGHPUT_MIN_CONN_INTERVAL, interval - (interval / 4));
+    conn_params.slave_latency = MIN(THROUGHPUT_MAX_SLAVE_LATENCY, (THROUGHPUT_MAX_SLEEP / interval) - 1);
+    conn_params.conn_sup_timeout = CONN_SUP_TIMEOUT;
+
+    NRF_LOG_INFO("Throughput %u B/s needed, request interval %u-%u, latency %u",
+                 throughput, conn_params.min_conn_interval, conn_params.max_conn_interval, conn_params.slave_latency);
+    err_code = sd_ble_gap_conn_param_update(m_conn_handle, &conn_params);
+    if (err_code != NRF_SUCCESS)
     {
-        m_tx_busy = 0;
-        //NRF_LOG_RAW_INFO("t2\n");
+        NRF_LOG_WARNING("Connection parameters update request failed (0x%x)", err_code);
     }
 }
 
@@ -31,6 +31,9 @@
  * Public constants
  */
 
+#define BLE_UART_TX_QUEUE_SIZE  16      /**< Packets waiting for the SoftDevice (BLE_NUS_MAX_DATA_LEN bytes each) */
+#define BLE_DIAGNOSTICS_MAX_LEN 512     /**< Longest diagnostics value (longest GATT attribute) */
+
 /*
  * Public macros
  */
@@ -48,6 +51,20 @@ typedef void (*ble_advertising_callback_t)(ble_adv_evt_t ble_adv_evt);
 /**@brief Nordic Uart Service RX data callback type */
 typedef void (*ble_uart_rx_callback_t)(ble_nus_evt_t *p_evt);
 
+/**@brief Diagnostics read callback type, points p_data to the value to be read and returns its length */
+typedef uint16_t (*ble_diagnostics_read_callback_t)(uint8_t const **p_data);
+
+/**@brief Nordic Uart Service TX queue counters, since boot */
+typedef struct
+{
+    uint32_t bytes_sent;            /**< Bytes accepted by the SoftDevice */
+    uint32_t notifications_sent;    /**< Notifications sent on air (NUS and battery level) */
+    uint32_t packets_dropped;       /**< Packets lost: queue full, disconnection or notifications disabled */
+    uint32_t retries;               /**< Times the SoftDevice had no TX buffer left for a queued packet */
+    uint16_t queue_depth;           /**< Packets in queue now */
+    uint16_t queue_depth_max;       /**< Highest number of packets in queue */
+} ble_uart_tx_stats_t;
+
 /*
  * Public variables
  */
@@ -94,6 +111,20 @@ void BLE_SetPhy2M(void);
  */
 uint8_t BLE_GetPhy(void);
 
+/**
+ * @brief Function setting the throughput the application needs. Connection
+ *        interval and slave latency are tuned for the highest of this value and
+ *        the throughput measured, with the lowest radio duty cycle.
+ * @param[in] bytes_per_s is the throughput needed, 0 to rely on measurement only
+ */
+void BLE_SetRequiredThroughput(uint32_t bytes_per_s);
+
+/**
+ * @brief Function returning the NUS throughput achieved over the last
+ *        measurement period (bytes/s)
+ */
+uint32_t BLE_GetThroughput(void);
+
 /**
  * @brief Return true if there is an active connection
  *
@@ -132,8 +163,45 @@ void BLE_BatteryLevelUpdate(uint8_t battery_level);
 void BLE_SetUartRXCallback(void *callback);
 
 /**
- * @brief Function to send data over Nordic Uart Service
+ * @brief Function to assign the callback giving the value of the latency
+ *        diagnostics characteristic, called from the BLE event handler on
+ *        each read (the first request of a long read)
+ */
+void BLE_SetDiagnosticsReadCallback(void *callback);
+
+/**
+ * @brief Function to send data over Nordic Uart Service. Data is split in
+ *        MTU sized packets and copied to the TX queue.
+ * @return false if the queue could not take the whole buffer, which is then dropped
+ */
+bool BLE_UartSendArray(uint8_t *data, uint16_t length);
+
+/**
+ * @brief Function to start a message sent with BLE_UartSendPacket. Its packets
+ *        wait for room in the TX queue for a fixed time in all, so that a slow
+ *        link never holds the caller longer than that per message.
+ */
+void BLE_UartBeginMessage(void);
+
+/**
+ * @brief Function to send one packet of at most BLE_GetMtu() bytes over Nordic
+ *        Uart Service. Waits for room in the TX queue until the deadline set by
+ *        BLE_UartBeginMessage, so it must not be called from an interrupt handler.
+ * @return false if the packet was not queued (no notifications, disconnection or deadline passed)
+ */
+bool BLE_UartSendPacket(uint8_t *data, uint16_t length);
+
+/**
+ * @brief Function returning the number of packets the Nordic Uart Service TX
+ *        queue can take without waiting
+ * @return 0 if notifications are not enabled
+ */
+uint16_t BLE_UartGetTxQueueFree(void);
+
+/**
+ * @brief Function returning Nordic Uart Service TX queue counters
+ * @param[out] p_stats is filled with the counters
  */
-void BLE_UartSendArray(uint8_t *data, uint16_t length);
+void BLE_UartGetTxStats(ble_uart_tx_stats_t *p_stats);
 
 #endif /* BLUETOOTH_H_ */
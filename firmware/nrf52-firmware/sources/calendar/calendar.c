@@ -23,6 +23,7 @@
 #include "nrfx_rtc.h"
 #include "nrf_error.h"
 #include "app_error.h"
+#include "app_util_platform.h"
 
 #define NRF_LOG_MODULE_NAME CAL
 #define NRF_LOG_INFO_COLOR  3
@@ -60,6 +61,12 @@ static void rtc_init(void);
 static void rtc_deinit(void);
 static void rtc_set_time(const uint64_t timestamp, const uint32_t us);
 static void rtc_get_time(uint64_t * p_timestamp, uint32_t * p_us);
+static void rtc_set_model(uint64_t ref_us, int64_t offset_us, float drift_ppm);
+static uint64_t rtc_get_uptime(void);
+static uint64_t rtc_counter_to_uptime(uint32_t counter);
+static void rtc_uptime_to_time(uint64_t uptime_us, uint64_t * p_timestamp, uint32_t * p_us);
+static int64_t rtc_drift_correction(uint64_t uptime_us);
+static uint64_t rtc_ticks_get(uint32_t * p_counter);
 static void rtc_evt_handler(nrfx_rtc_int_type_t type);
 static nrfx_rtc_t * rtc_get_instance(void);
 
@@ -109,6 +116,39 @@ void CAL_GetTime(uint64_t * p_timestamp, uint32_t * p_us)
     rtc_get_time(p_timestamp, p_us);
 }
 
+/**
+ * @brief Return calendar time at a past value of the RTC counter
+ */
+void CAL_GetCounterTime(uint32_t counter, uint64_t * p_timestamp, uint32_t * p_us)
+{
+    rtc_uptime_to_time(rtc_counter_to_uptime(counter), p_timestamp, p_us);
+}
+
+/**
+ * @brief Return the device clock, microseconds of RTC ticks since init
+ */
+uint64_t CAL_GetUptime(void)
+{
+    return rtc_get_uptime();
+}
+
+/**
+ * @brief Return calendar time at a past value of the device clock
+ */
+void CAL_GetUptimeTime(uint64_t uptime_us, uint64_t * p_timestamp, uint32_t * p_us)
+{
+    rtc_uptime_to_time(uptime_us, p_timestamp, p_us);
+}
+
+/**
+ * @brief Apply a model of the device clock fitted against the host
+ */
+void CAL_SetClockModel(uint64_t ref_us, int64_t offset_us, float drift_ppm)
+{
+    rtc_set_model(ref_us, offset_us, drift_ppm);
+    NRF_LOG_INFO("Clock drift " NRF_LOG_FLOAT_MARKER " ppm", NRF_LOG_FLOAT(drift_ppm));
+}
+
 /**
  * @brief Return rtc instance to get event address
  */
@@ -127,11 +167,14 @@ nrfx_rtc_t * CAL_GetRtcInstance(void) {
 static nrfx_rtc_t rtc = NRFX_RTC_INSTANCE(CAL_RTC_INSTANCE);        /**< RTC instance */
 #define POWER2_PRESCALER        (12)//(15)                                 /**< Power of 2 for RTC frequency (15 is 32768 Hz */
 #define RTC_COUNTER_FREQUENCY   (1 << POWER2_PRESCALER)             /**< RTC counter frequency in Hz (8 - 32768) */
-#define COUNTER_TO_SECS(counts) (counts >> POWER2_PRESCALER)        /**< Macro to convert RTC counter value in seconds */
-#define SECS_TO_COUNTER(secs)   (secs << POWER2_PRESCALER)          /**< Macro to convert seconds to RTC counter value */
+#define RTC_COUNTER_BITS        (24)                                /**< RTC counter width, it wraps every 4096 s at 4096 Hz */
+#define RTC_COUNTER_MASK        ((1UL << RTC_COUNTER_BITS) - 1)
+#define TICKS_TO_US(ticks)      (((ticks) * 1000000ULL) >> POWER2_PRESCALER)    /**< Macro to convert RTC ticks in microseconds */
 
-static int64_t time_offset;        /**< UNIX 64 bit epoch in seconds - Current time is time_offset + (RTC counter value converted in seconds) */
-static uint32_t tick_offset;        /**< initial microseconds offset converted to tick to be added at each timestamp */
+static int64_t time_offset;         /**< UNIX 64 bit epoch in microseconds at tick 0 - Current time is time_offset + (RTC ticks since init converted in microseconds) + drift correction */
+static uint64_t drift_ref_us;       /**< Device clock the drift correction is counted from */
+static float drift_ppm_used;        /**< Rate correction of the device clock, positive if it runs slow */
+static volatile uint32_t overflow_count;    /**< RTC counter wraps since init, upper bits of the tick count */
 
 static void rtc_init(void)
 {
@@ -140,7 +183,9 @@ static void rtc_init(void)
 
     // re-init time offset at boot
     time_offset = 0;
-    tick_offset = 0;
+    drift_ref_us = 0;
+    drift_ppm_used = 0.0f;
+    overflow_count = 0;
     // configure and enable RTC instance with 1 Hertz tick
     nrfx_rtc_config_t rtc_config = 
     {
@@ -151,7 +196,8 @@ static void rtc_init(void)
     };
     APP_ERROR_CHECK(nrfx_rtc_init(&rtc, &rtc_config, rtc_evt_handler));
     nrfx_rtc_overflow_enable(&rtc, true);
-    nrfx_rtc_tick_enable(&rtc, true);
+    // tick event drives the EDA clock through PPI, its interrupt is not needed
+    nrfx_rtc_tick_enable(&rtc, false);
     nrfx_rtc_enable(&rtc);
     nrfx_rtc_counter_clear(&rtc);
 }
@@ -165,21 +211,83 @@ static void rtc_deinit(void)
 
 static void rtc_set_time(const uint64_t time, const uint32_t us)
 {
-    nrfx_rtc_counter_clear(&rtc);
-    time_offset = time;
-
-    float usecs = (float)(us);
-    float freq  = (float)(RTC_COUNTER_FREQUENCY);
-    tick_offset = (uint32_t)(usecs* freq * 0.000001f);
+    /* Counter is not cleared: it drives the EDA clock, and past counter values keep their meaning */
+    /* Drift correction goes on, from the time set */
+    uint64_t uptime_us = TICKS_TO_US(rtc_ticks_get(NULL));
+    CRITICAL_REGION_ENTER();
+    time_offset = (int64_t)((time * 1000000ULL) + us) - (int64_t)uptime_us - rtc_drift_correction(uptime_us);
+    CRITICAL_REGION_EXIT();
 }
 
 static void rtc_get_time(uint64_t * p_timestamp, uint32_t * p_us)
 {
-    uint32_t counter_value = nrfx_rtc_counter_get(&rtc);
-    uint32_t sec = COUNTER_TO_SECS(counter_value);
-    *p_timestamp = time_offset + sec;
-    uint64_t mod = counter_value - SECS_TO_COUNTER(sec);
-    *p_us = (uint32_t)(mod * 1000000ULL / RTC_COUNTER_FREQUENCY);
+    rtc_uptime_to_time(rtc_get_uptime(), p_timestamp, p_us);
+}
+
+static void rtc_set_model(uint64_t ref_us, int64_t offset_us, float drift_ppm)
+{
+    CRITICAL_REGION_ENTER();
+    time_offset = offset_us;
+    drift_ref_us = ref_us;
+    drift_ppm_used = drift_ppm;
+    CRITICAL_REGION_EXIT();
+}
+
+static uint64_t rtc_get_uptime(void)
+{
+    return TICKS_TO_US(rtc_ticks_get(NULL));
+}
+
+static uint64_t rtc_counter_to_uptime(uint32_t counter)
+{
+    uint32_t counter_now;
+    uint64_t ticks = rtc_ticks_get(&counter_now);
+
+    /* Counter wrapped at most once since then */
+    ticks -= (counter_now - counter) & RTC_COUNTER_MASK;
+    return TICKS_TO_US(ticks);
+}
+
+static void rtc_uptime_to_time(uint64_t uptime_us, uint64_t * p_timestamp, uint32_t * p_us)
+{
+    uint64_t time_us;
+
+    CRITICAL_REGION_ENTER();
+    time_us = (uint64_t)(time_offset + (int64_t)uptime_us + rtc_drift_correction(uptime_us));
+    CRITICAL_REGION_EXIT();
+    *p_timestamp = time_us / 1000000ULL;
+    *p_us = (uint32_t)(time_us % 1000000ULL);
+}
+
+/**
+ * @brief Return the drift correction at a device clock value, before or after its reference
+ */
+static int64_t rtc_drift_correction(uint64_t uptime_us)
+{
+    return (int64_t)((double)(int64_t)(uptime_us - drift_ref_us) * (double)drift_ppm_used * 1.0e-6);
+}
+
+/**
+ * @brief Return RTC ticks since init, the counter extended with its wraps
+ */
+static uint64_t rtc_ticks_get(uint32_t * p_counter)
+{
+    uint32_t counter;
+    uint32_t overflows;
+
+    /* Wrap not handled yet by the interrupt is pending in the overflow event */
+    CRITICAL_REGION_ENTER();
+    counter = nrfx_rtc_counter_get(&rtc);
+    overflows = overflow_count;
+    if (nrf_rtc_event_pending(rtc.p_reg, NRF_RTC_EVENT_OVERFLOW) && (counter < (RTC_COUNTER_MASK / 2))) {
+        overflows++;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (p_counter != NULL) {
+        *p_counter = counter;
+    }
+    return ((uint64_t)overflows << RTC_COUNTER_BITS) | counter;
 }
 
 static void rtc_evt_handler(nrfx_rtc_int_type_t type)
@@ -188,7 +296,7 @@ static void rtc_evt_handler(nrfx_rtc_int_type_t type)
     if (type == NRFX_RTC_INT_OVERFLOW)
     {
         //NRF_LOG_DEBUG("RTC Overflow");
-        time_offset += COUNTER_TO_SECS((1<<24));
+        overflow_count++;
     }
 }
 
@@ -67,6 +67,38 @@ void CAL_SetTime(const uint64_t timestamp, const uint32_t us);
  */
 void CAL_GetTime(uint64_t * p_timestamp, uint32_t * p_us);
 
+/**
+ * @brief Return calendar time at a past value of the RTC counter, such as one
+ * latched when a peripheral event occurred
+ * @param[in] counter RTC counter value, less than 4096 s old
+ * @param[out] timestamp a pointer provided to store the Unix epoch
+ * @param[out] us a pointer provided to store the microseconds elapsed
+ */
+void CAL_GetCounterTime(uint32_t counter, uint64_t * p_timestamp, uint32_t * p_us);
+
+/**
+ * @brief Return the device clock: microseconds of RTC ticks since init, not changed
+ * by CAL_SetTime or CAL_SetClockModel
+ */
+uint64_t CAL_GetUptime(void);
+
+/**
+ * @brief Return calendar time at a past value of the device clock
+ * @param[in] uptime_us device clock value, from CAL_GetUptime
+ * @param[out] timestamp a pointer provided to store the Unix epoch
+ * @param[out] us a pointer provided to store the microseconds elapsed
+ */
+void CAL_GetUptimeTime(uint64_t uptime_us, uint64_t * p_timestamp, uint32_t * p_us);
+
+/**
+ * @brief Apply a model of the device clock fitted against the host, calendar time becomes
+ * uptime + offset_us + (uptime - ref_us) * drift_ppm / 1e6. CAL_SetTime keeps the drift.
+ * @param[in] ref_us device clock the drift is counted from
+ * @param[in] offset_us host time minus device clock at ref_us
+ * @param[in] drift_ppm rate correction, positive if the device clock runs slow
+ */
+void CAL_SetClockModel(uint64_t ref_us, int64_t offset_us, float drift_ppm);
+
 /**
  * @brief Return rtc instance to get event address
  */
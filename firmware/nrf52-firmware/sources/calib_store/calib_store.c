@@ -0,0 +1,258 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: CALIBRATION STORE
+ *
+ *---------------------------------------------------------------
+ * @brief Per-device calibration record kept in flash
+ *
+ * A write that finds FDS pages full starts a garbage collection,
+ * and is retried once it is done.
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <string.h>
+
+/* SDK includes */
+#include "app_error.h"
+#include "app_util.h"
+#include "fds.h"
+
+#define NRF_LOG_MODULE_NAME CSTORE
+#define NRF_LOG_INFO_COLOR  3
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/* Project includes */
+#include "calib_store.h"
+
+/*
+ * Local constants
+ */
+
+#define CSTORE_FILE_ID          0x0CA1          /**< Below the peer manager file IDs (0xC000 and up) */
+#define CSTORE_RECORD_KEY       0x0001
+#define CSTORE_VERSION          1               /**< Change with the layout of eda_calib_t */
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local types
+ */
+
+typedef struct {
+    uint32_t version;
+    eda_calib_t calib;
+} cstore_record_t;
+
+/*
+ * Local variables
+ */
+
+static cstore_event_handler_t m_event_handler;
+static cstore_record_t m_record;                /**< Record read or being written, FDS writes from there */
+static bool m_record_valid;
+static volatile bool m_busy;                    /**< Write or erase pending */
+static bool m_gc_pending;                       /**< Write waits for a garbage collection */
+
+STATIC_ASSERT((sizeof(cstore_record_t) % sizeof(uint32_t)) == 0);
+
+/*
+ * Local functions
+ */
+
+static void record_load(void);
+static ret_code_t record_write(void);
+static void fds_evt_handler(fds_evt_t const * p_evt);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Register to FDS events, must be called before the peer manager
+ * initializes FDS so that the record is read once it is ready
+ */
+void CSTORE_Init(cstore_event_handler_t event_handler)
+{
+    m_event_handler = event_handler;
+    APP_ERROR_CHECK(fds_register(fds_evt_handler));
+}
+
+/**
+ * @brief Return the calibration of the record
+ */
+bool CSTORE_Get(eda_calib_t * p_calib)
+{
+    if ((m_record_valid == false) || m_busy) {
+        return false;
+    }
+    *p_calib = m_record.calib;
+    return true;
+}
+
+/**
+ * @brief Start writing the record, CSTORE_EVENT_WRITTEN is sent once done
+ */
+bool CSTORE_Write(const eda_calib_t * p_calib)
+{
+    ret_code_t ret;
+
+    if (m_busy) {
+        return false;
+    }
+    m_busy = true;
+    m_record.version = CSTORE_VERSION;
+    m_record.calib = *p_calib;
+    m_record_valid = false;
+
+    ret = record_write();
+    if (ret == FDS_ERR_NO_SPACE_IN_FLASH) {
+        m_gc_pending = true;
+        ret = fds_gc();
+    }
+    if (ret != NRF_SUCCESS) {
+        NRF_LOG_WARNING("Write refused (%u)", ret);
+        m_gc_pending = false;
+        m_busy = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Start erasing the record, CSTORE_EVENT_ERASED is sent once done
+ */
+bool CSTORE_Erase(void)
+{
+    ret_code_t ret;
+
+    if (m_busy) {
+        return false;
+    }
+    m_busy = true;
+    /* Whole file, so that a stale record of another version goes too */
+    ret = fds_file_delete(CSTORE_FILE_ID);
+    if (ret != NRF_SUCCESS) {
+        NRF_LOG_WARNING("Erase refused (%u)", ret);
+        m_busy = false;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Local functions
+ */
+
+/**
+ * @brief Read the record, if there is a valid one
+ */
+static void record_load(void)
+{
+    fds_record_desc_t desc = { 0 };
+    fds_find_token_t token = { 0 };
+    fds_flash_record_t flash_record;
+
+    m_record_valid = false;
+    if (fds_record_find(CSTORE_FILE_ID, CSTORE_RECORD_KEY, &desc, &token) != NRF_SUCCESS) {
+        return;
+    }
+    if (fds_record_open(&desc, &flash_record) != NRF_SUCCESS) {
+        return;
+    }
+    if ((flash_record.p_header->length_words == (sizeof(cstore_record_t) / sizeof(uint32_t))) &&
+        (((const cstore_record_t *)flash_record.p_data)->version == CSTORE_VERSION)) {
+        memcpy(&m_record, flash_record.p_data, sizeof(cstore_record_t));
+        m_record_valid = true;
+    }
+    fds_record_close(&desc);
+}
+
+/**
+ * @brief Update the record, or write it if there is none yet
+ */
+static ret_code_t record_write(void)
+{
+    fds_record_desc_t desc = { 0 };
+    fds_find_token_t token = { 0 };
+    fds_record_t record = {
+        .file_id = CSTORE_FILE_ID,
+        .key = CSTORE_RECORD_KEY,
+        .data.p_data = &m_record,
+        .data.length_words = sizeof(cstore_record_t) / sizeof(uint32_t),
+    };
+
+    if (fds_record_find(CSTORE_FILE_ID, CSTORE_RECORD_KEY, &desc, &token) == NRF_SUCCESS) {
+        return fds_record_update(&desc, &record);
+    }
+    return fds_record_write(NULL, &record);
+}
+
+/**
+ * @brief Handle FDS events, peer manager ones included
+ */
+static void fds_evt_handler(fds_evt_t const * p_evt)
+{
+    switch (p_evt->id) {
+        case FDS_EVT_INIT:
+            if (p_evt->result == NRF_SUCCESS) {
+                record_load();
+                if (m_record_valid) {
+                    m_event_handler(CSTORE_EVENT_LOADED);
+                }
+            }
+            break;
+
+        case FDS_EVT_WRITE:
+        case FDS_EVT_UPDATE:
+            if (p_evt->write.file_id != CSTORE_FILE_ID) {
+                break;
+            }
+            m_record_valid = (p_evt->result == NRF_SUCCESS);
+            m_busy = false;
+            m_event_handler(m_record_valid ? CSTORE_EVENT_WRITTEN : CSTORE_EVENT_ERROR);
+            break;
+
+        case FDS_EVT_DEL_FILE:
+            if (p_evt->del.file_id != CSTORE_FILE_ID) {
+                break;
+            }
+            m_record_valid = false;
+            m_busy = false;
+            m_event_handler((p_evt->result == NRF_SUCCESS) ? CSTORE_EVENT_ERASED : CSTORE_EVENT_ERROR);
+            break;
+
+        case FDS_EVT_GC:
+            if (m_gc_pending == false) {
+                break;
+            }
+            m_gc_pending = false;
+            if ((p_evt->result != NRF_SUCCESS) || (record_write() != NRF_SUCCESS)) {
+                m_busy = false;
+                m_event_handler(CSTORE_EVENT_ERROR);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* END OF FILE */
@@ -0,0 +1,96 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: CALIBRATION STORE
+ *
+ *---------------------------------------------------------------
+ * @brief Per-device calibration record kept in flash
+ *
+ * The record is a Flash Data Storage (FDS) record, in the pages
+ * shared with the peer manager bonding data. It is read once FDS
+ * is initialized, and rewritten as a whole. A record of another
+ * version or size is ignored, default calibration is used then.
+ *
+ * Dependencies : fds (initialized by the peer manager), eda_calib
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef CALIB_STORE_H_
+#define CALIB_STORE_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Project includes */
+#include "eda_toolbox/eda_calib.h"
+
+/*
+ * Public constants
+ */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Enumeration of events sent to cstore_event_handler
+ */
+typedef enum {
+    CSTORE_EVENT_LOADED = 0,        /**< Record found at startup, CSTORE_Get returns it */
+    CSTORE_EVENT_WRITTEN,
+    CSTORE_EVENT_ERASED,
+    CSTORE_EVENT_ERROR,             /**< Write or erase failed */
+    CSTORE_MAX_EVENT_NUM
+} cstore_event_t;
+
+/**
+ * @brief Callback format for calibration store events, called from interrupt
+ */
+typedef void (*cstore_event_handler_t)(cstore_event_t cstore_event);
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Register to FDS events, must be called before the peer manager
+ * initializes FDS so that the record is read once it is ready
+ */
+void CSTORE_Init(cstore_event_handler_t event_handler);
+
+/**
+ * @brief Return the calibration of the record
+ * @return false if there is no valid record in flash
+ */
+bool CSTORE_Get(eda_calib_t * p_calib);
+
+/**
+ * @brief Start writing the record, CSTORE_EVENT_WRITTEN is sent once done
+ * @param[in] p_calib is copied
+ * @return false if a write or an erase is pending, or FDS refused it
+ */
+bool CSTORE_Write(const eda_calib_t * p_calib);
+
+/**
+ * @brief Start erasing the record, CSTORE_EVENT_ERASED is sent once done
+ * @return false if a write or an erase is pending, or FDS refused it
+ */
+bool CSTORE_Erase(void);
+
+#endif /* CALIB_STORE_H_ */
+
+/* END OF FILE */
@@ -18,6 +18,8 @@
 
 /* Standard C library includes */
 
+#include <string.h>
+
 /* SDK includes */
 
 #define NRF_LOG_MODULE_NAME EDA
@@ -27,6 +29,8 @@ NRF_LOG_MODULE_REGISTER();
 #include "nrf_log_ctrl.h"
 #include "nrf_log_default_backends.h"
 
+#include "app_util_platform.h"
+
 #include "nrfx_gpiote.h"
 #include "nrfx_ppi.h"
 #include "nrfx_saadc.h"
@@ -36,6 +40,8 @@ NRF_LOG_MODULE_REGISTER();
 /* Project includes */
 
 #include "calendar/calendar.h"
+#include "energy/energy.h"
+#include "latency/latency.h"
 #include "eda_cfg.h"
 #include "eda_afe.h"
 
@@ -45,6 +51,9 @@ NRF_LOG_MODULE_REGISTER();
 
 #define EDA_CLK_FREQ                    EDA_SAMPLING_RATE           /**< EDA clock frequency in Hz */
 #define SAADC_MAX_SAMPLES_NUMBER        (EDA_ADC_BUFFER_SIZE * 2)   /**< Number of samples in SAADC buffer. Contains both V and I samples */
+#define SAADC_SAMPLE_US                 (4 * (3 + 2))               /**< SAADC busy time per sample: 4x oversampling of 3 us acquisition and 2 us conversion */
+#define EDA_CLK_STOP_PHASE              1                           /**< Clock edges modulo IDAC_ARRAY_LENGTH at stop: the PSoC last applied sample 0 of the waveform, where both IDACs are off */
+#define EDA_CLK_STOP_MARGIN             256                         /**< Clock edges left at least when EDA_Stop sets the compare value (62 ms), against SoftDevice preemption */
 
 /*
  * Local macros
@@ -58,14 +67,34 @@ NRF_LOG_MODULE_REGISTER();
  * Local types
  */
 
+typedef enum {
+    BUFFER_FREE = 0,            /**< In the pool */
+    BUFFER_SAADC,               /**< Being filled, or next to be filled, by the SAADC */
+    BUFFER_APP,                 /**< Sent to the application, not released yet */
+} buffer_owner_t;
+
 /*
  * Local variables
  */
 
-static nrfx_timer_t eda_clk_timer = NRFX_TIMER_INSTANCE(EDA_CLK_TIMER_INSTANCE);
-static nrf_saadc_value_t saadc_buffer_pool[2][SAADC_MAX_SAMPLES_NUMBER];
+static nrfx_timer_t eda_clk_timer = NRFX_TIMER_INSTANCE(EDA_CLK_TIMER_INSTANCE);   /**< Counts clock edges since EDA_Init */
+static nrf_ppi_channel_t eda_clk_channel;                           /**< RTC tick to clock pin toggle, forked to SAADC sampling */
+static nrf_ppi_channel_t eda_count_channel;                         /**< RTC tick to edge counter */
+static nrf_ppi_channel_t eda_stop_channel;                          /**< Edge counter compare to clock group disable */
+static nrf_ppi_channel_t eda_end_channel;                           /**< SAADC end of buffer to edge counter capture */
+static nrf_ppi_channel_group_t eda_clk_group;                       /**< Clock and counter channels, enabled and disabled on the same tick */
+static bool eda_clk_pin_init;
+static volatile eda_state_t eda_state = EDA_STATE_OFF;
+static uint16_t eda_clk_phase;                                      /**< Clock edges since boot modulo IDAC_ARRAY_LENGTH, up to the last stop */
+static uint32_t eda_clk_edges;                                      /**< Clock edges since boot, up to the last stop */
+static nrf_saadc_value_t saadc_buffer_pool[EDA_ADC_POOL_SIZE][SAADC_MAX_SAMPLES_NUMBER];
 
-static eda_buffer_t eda_buffer;
+static eda_buffer_t eda_buffers[EDA_ADC_POOL_SIZE];                 /**< Descriptor of each buffer of the pool, valid while the application holds it */
+static volatile buffer_owner_t buffer_owner[EDA_ADC_POOL_SIZE];
+static volatile uint8_t saadc_buffer_count;                         /**< Buffers given to the SAADC, two while sampling */
+static volatile eda_overrun_policy_t overrun_policy = EDA_OVERRUN_SKIP;
+static bool samples_lost;                                           /**< Next buffer sent does not follow the previous one */
+static eda_stats_t eda_stats;
 static eda_event_handler_t eda_event_handler = NULL;
 
 /*
@@ -73,6 +102,9 @@ static eda_event_handler_t eda_event_handler = NULL;
  */
 
 static void saadc_event_handler(nrfx_saadc_evt_t const *p_event);
+static bool saadc_buffer_give(void);
+static void saadc_buffer_time(eda_buffer_t * buffer);
+static void eda_clk_timer_handler(nrf_timer_event_t event_type, void * p_context);
 
 /****************************************************************
  * IMPLEMENTATION
@@ -84,20 +116,57 @@ static void saadc_event_handler(nrfx_saadc_evt_t const *p_event);
 
 
 /**
- * @brief Initialize pheripherals and start AFE control
+ * @brief Initialize pheripherals and start AFE control, again after EDA_Deinit.
+ * The PSoC steps through the waveform on each clock edge and has no other link,
+ * so the waveform phase is only known by counting edges: it is assumed to start
+ * with the first edge after boot, as for the simulated current of the DSP.
  */
 void EDA_Init(eda_event_handler_t event_handler)
 {
+    uint8_t held = 0;
+
+    if (eda_state != EDA_STATE_OFF) {
+        return;
+    }
+
     /* Store event handler for callbacks */
     eda_event_handler = event_handler;
 
-    /* Initialize EDA clock pin for toggling task from timer using ppi */
-    if (nrfx_gpiote_is_init() != true) {
-        APP_ERROR_CHECK(nrfx_gpiote_init());
+    /* Buffers of the pool are free, but the ones the application still holds from before EDA_Deinit */
+    for (uint8_t n = 0; n < EDA_ADC_POOL_SIZE; n++) {
+        if (buffer_owner[n] == BUFFER_APP) {
+            held++;
+        }
+        else {
+            buffer_owner[n] = BUFFER_FREE;
+        }
+    }
+    saadc_buffer_count = 0;
+    samples_lost = false;
+    memset(&eda_stats, 0, sizeof(eda_stats));
+    eda_stats.held = held;
+    eda_stats.held_max = held;
+
+    /* Initialize EDA clock pin for toggling task from timer using ppi, kept across EDA_Deinit so that
+     * the pin level does not change in between */
+    if (eda_clk_pin_init == false) {
+        if (nrfx_gpiote_is_init() != true) {
+            APP_ERROR_CHECK(nrfx_gpiote_init());
+        }
+        nrfx_gpiote_out_config_t eda_clk_pin_config = NRFX_GPIOTE_CONFIG_OUT_TASK_TOGGLE(false);
+        APP_ERROR_CHECK(nrfx_gpiote_out_init(EDA_CLK_PIN, &eda_clk_pin_config));
+        nrfx_gpiote_out_task_enable(EDA_CLK_PIN);
+        eda_clk_pin_init = true;
     }
-    nrfx_gpiote_out_config_t eda_clk_pin_config = NRFX_GPIOTE_CONFIG_OUT_TASK_TOGGLE(false);
-    APP_ERROR_CHECK(nrfx_gpiote_out_init(EDA_CLK_PIN, &eda_clk_pin_config));
-    nrfx_gpiote_out_task_enable(EDA_CLK_PIN);
+
+    /* Count clock edges, to stop the clock at a known point of the waveform */
+    nrfx_timer_config_t timer_config = NRFX_TIMER_DEFAULT_CONFIG;
+    timer_config.mode = NRF_TIMER_MODE_LOW_POWER_COUNTER;
+    timer_config.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    timer_config.interrupt_priority = APP_IRQ_PRIORITY_LOW;
+    APP_ERROR_CHECK(nrfx_timer_init(&eda_clk_timer, &timer_config, eda_clk_timer_handler));
+    nrfx_timer_clear(&eda_clk_timer);
+    nrfx_timer_enable(&eda_clk_timer);
 
     /* Initialize adc for sampling voltage and current channels using ppi */
     nrfx_saadc_config_t saadc_config = NRFX_SAADC_DEFAULT_CONFIG;
@@ -133,31 +202,151 @@ void EDA_Init(eda_event_handler_t event_handler)
     APP_ERROR_CHECK(nrfx_saadc_channel_init(1, &saadc_channel_config_i));
 
     /* Preload double buffering */
-    APP_ERROR_CHECK(nrfx_saadc_buffer_convert(saadc_buffer_pool[0], SAADC_MAX_SAMPLES_NUMBER));
-    APP_ERROR_CHECK(nrfx_saadc_buffer_convert(saadc_buffer_pool[1], SAADC_MAX_SAMPLES_NUMBER));
+    saadc_buffer_give();
+    saadc_buffer_give();
 
-    /* Set up PPI channel to connect timer event to pin task and adc task */
-    static nrf_ppi_channel_t eda_clk_rtc_to_pin;
+    /* Set up PPI channels to connect RTC tick to pin task, adc task and edge counter */
     uint32_t eda_clk_rtc_tick_event_addr = nrfx_rtc_event_address_get(CAL_GetRtcInstance(), NRF_RTC_EVENT_TICK);
     uint32_t eda_clk_pin_task_addr = nrfx_gpiote_out_task_addr_get(EDA_CLK_PIN);
     uint32_t adc_task_addr = nrfx_saadc_sample_task_get();
-    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&eda_clk_rtc_to_pin));
-    APP_ERROR_CHECK(nrfx_ppi_channel_assign(eda_clk_rtc_to_pin, eda_clk_rtc_tick_event_addr, eda_clk_pin_task_addr));
-    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(eda_clk_rtc_to_pin, adc_task_addr));
-    APP_ERROR_CHECK(nrfx_ppi_channel_enable(eda_clk_rtc_to_pin));
+    uint32_t count_task_addr = nrfx_timer_task_address_get(&eda_clk_timer, NRF_TIMER_TASK_COUNT);
+    uint32_t compare_event_addr = nrfx_timer_compare_event_address_get(&eda_clk_timer, NRF_TIMER_CC_CHANNEL0);
+    uint32_t end_event_addr = nrf_saadc_event_address_get(NRF_SAADC_EVENT_END);
+    uint32_t capture_task_addr = nrfx_timer_capture_task_address_get(&eda_clk_timer, NRF_TIMER_CC_CHANNEL2);
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&eda_clk_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(eda_clk_channel, eda_clk_rtc_tick_event_addr, eda_clk_pin_task_addr));
+    APP_ERROR_CHECK(nrfx_ppi_channel_fork_assign(eda_clk_channel, adc_task_addr));
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&eda_count_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(eda_count_channel, eda_clk_rtc_tick_event_addr, count_task_addr));
+    APP_ERROR_CHECK(nrfx_ppi_group_alloc(&eda_clk_group));
+    APP_ERROR_CHECK(nrfx_ppi_channel_include_in_group(eda_clk_channel, eda_clk_group));
+    APP_ERROR_CHECK(nrfx_ppi_channel_include_in_group(eda_count_channel, eda_clk_group));
+    /* Enabled by EDA_Stop, the edge that reaches the compare value is the last one */
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&eda_stop_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(eda_stop_channel, compare_event_addr,
+                                            nrfx_ppi_task_addr_group_disable_get(eda_clk_group)));
+    /* Edge of the last sample of each buffer, read from the SAADC interrupt whatever its latency */
+    APP_ERROR_CHECK(nrfx_ppi_channel_alloc(&eda_end_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_assign(eda_end_channel, end_event_addr, capture_task_addr));
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(eda_end_channel));
+
+    eda_state = EDA_STATE_RUNNING;
+    nrfx_ppi_group_enable(eda_clk_group);
+}
+
+
+/**
+ * @brief Stop the clock once the waveform is back to zero current, EDA_EVENT_STOPPED
+ * is sent then (up to one waveform period later)
+ */
+void EDA_Stop(void)
+{
+    uint32_t count;
+    uint32_t remaining;
+
+    if (eda_state != EDA_STATE_RUNNING) {
+        return;
+    }
+    eda_state = EDA_STATE_STOPPING;
+
+    /* Edges left until the PSoC applies sample 0 of the waveform, with time to set the compare value first */
+    count = nrfx_timer_capture(&eda_clk_timer, NRF_TIMER_CC_CHANNEL1);
+    remaining = (EDA_CLK_STOP_PHASE + IDAC_ARRAY_LENGTH - ((eda_clk_phase + count) % IDAC_ARRAY_LENGTH)) % IDAC_ARRAY_LENGTH;
+    if (remaining < EDA_CLK_STOP_MARGIN) {
+        remaining += IDAC_ARRAY_LENGTH;
+    }
+    nrfx_timer_compare(&eda_clk_timer, NRF_TIMER_CC_CHANNEL0, count + remaining, true);
+    APP_ERROR_CHECK(nrfx_ppi_channel_enable(eda_stop_channel));
 }
 
 
 /**
- * @brief Stop acquisition and deinit peripherals
+ * @brief Stop acquisition and deinit peripherals. Clock stops at once if
+ * EDA_EVENT_STOPPED was not waited for, wherever the waveform is.
  */
 void EDA_Deinit(void)
 {
-    nrfx_timer_disable(&eda_clk_timer);
-    nrfx_ppi_free_all();
-    nrfx_saadc_uninit();
-    nrfx_gpiote_out_uninit(EDA_CLK_PIN);
+    if (eda_state == EDA_STATE_OFF) {
+        return;
+    }
+    /* Compare interrupt of a stop in progress would count the edges twice */
+    CRITICAL_REGION_ENTER();
+    nrfx_ppi_group_disable(eda_clk_group);
+    if (eda_state != EDA_STATE_STOPPED) {
+        uint32_t count = nrfx_timer_capture(&eda_clk_timer, NRF_TIMER_CC_CHANNEL1);
+        eda_clk_phase = (eda_clk_phase + count) % IDAC_ARRAY_LENGTH;
+        eda_clk_edges += count;
+    }
+    /* SAADC done event of the abort below is ignored */
+    eda_state = EDA_STATE_OFF;
+    CRITICAL_REGION_EXIT();
+
+    APP_ERROR_CHECK(nrfx_ppi_channel_free(eda_end_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_free(eda_stop_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_free(eda_count_channel));
+    APP_ERROR_CHECK(nrfx_ppi_channel_free(eda_clk_channel));
+    APP_ERROR_CHECK(nrfx_ppi_group_free(eda_clk_group));
     nrfx_timer_uninit(&eda_clk_timer);
+    nrfx_saadc_uninit();
+
+    /* Buffers the SAADC had go back to the pool, the ones the application holds are released as usual */
+    CRITICAL_REGION_ENTER();
+    for (uint8_t n = 0; n < EDA_ADC_POOL_SIZE; n++) {
+        if (buffer_owner[n] == BUFFER_SAADC) {
+            buffer_owner[n] = BUFFER_FREE;
+        }
+    }
+    saadc_buffer_count = 0;
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**
+ * @brief Return the state of the frontend clock and peripherals
+ */
+eda_state_t EDA_GetState(void)
+{
+    return eda_state;
+}
+
+
+/**
+ * @brief Give a buffer received with EDA_EVENT_BUFFER_FULL back to the SAADC,
+ * or to the pool once the peripherals are released
+ */
+void EDA_ReleaseBuffer(eda_buffer_t * buffer)
+{
+    uint8_t n = (uint8_t)(buffer - eda_buffers);
+
+    CRITICAL_REGION_ENTER();
+    if ((n < EDA_ADC_POOL_SIZE) && (buffer_owner[n] == BUFFER_APP)) {
+        buffer_owner[n] = BUFFER_FREE;
+        eda_stats.held--;
+        /* SAADC is short of buffers with EDA_OVERRUN_BLOCK, and restarts if it had none left */
+        while ((eda_state != EDA_STATE_OFF) && (saadc_buffer_count < 2) && saadc_buffer_give()) {
+        }
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**
+ * @brief Choose what happens when the application holds too many buffers
+ */
+void EDA_SetOverrunPolicy(eda_overrun_policy_t policy)
+{
+    overrun_policy = policy;
+}
+
+
+/**
+ * @brief Return acquisition counters
+ */
+void EDA_GetStats(eda_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = eda_stats;
+    CRITICAL_REGION_EXIT();
 }
 
 /*
@@ -166,18 +355,113 @@ void EDA_Deinit(void)
 
 static void saadc_event_handler(nrfx_saadc_evt_t const *p_event)
 {
+    /* Partial buffer of nrfx_saadc_uninit */
+    if (eda_state == EDA_STATE_OFF) {
+        return;
+    }
     if (p_event->type == NRFX_SAADC_EVT_DONE)
     {
-        /* Reload next buffer (double buffering is internal) */
-        APP_ERROR_CHECK(nrfx_saadc_buffer_convert(p_event->data.done.p_buffer, SAADC_MAX_SAMPLES_NUMBER));
+        uint8_t n = (uint8_t)((p_event->data.done.p_buffer - saadc_buffer_pool[0]) / SAADC_MAX_SAMPLES_NUMBER);
+        eda_buffer_t * buffer = &eda_buffers[n];
+
+        saadc_buffer_count--;
+        eda_stats.buffers++;
+        NRG_AddActiveTime(NRG_SUBSYSTEM_SAADC, SAADC_MAX_SAMPLES_NUMBER * SAADC_SAMPLE_US);
+
+        /* Reload next buffer (double buffering is internal), the buffer just filled is never overwritten while the application holds it */
+        if (saadc_buffer_give() == false) {
+            if (overrun_policy == EDA_OVERRUN_SKIP) {
+                /* Application holds all other buffers, its samples are kept and these ones are lost */
+                eda_stats.overruns++;
+                samples_lost = true;
+                saadc_buffer_count++;
+                APP_ERROR_CHECK(nrfx_saadc_buffer_convert(p_event->data.done.p_buffer, SAADC_MAX_SAMPLES_NUMBER));
+                return;
+            }
+            if (saadc_buffer_count == 0) {
+                /* SAADC stops until EDA_ReleaseBuffer, samples are lost meanwhile */
+                eda_stats.stalls++;
+            }
+        }
+
+        buffer_owner[n] = BUFFER_APP;
+        buffer->samples = p_event->data.done.p_buffer;
+        buffer->length = p_event->data.done.size;
+        buffer->sequence = eda_stats.buffers - 1;
+        buffer->contiguous = (samples_lost == false);
+        buffer->ticks = LAT_GetTicks();
+        saadc_buffer_time(buffer);
+        samples_lost = (saadc_buffer_count == 0);
+        eda_stats.held++;
+        if (eda_stats.held > eda_stats.held_max) {
+            eda_stats.held_max = eda_stats.held;
+        }
+
         /* Call callback with event */
-        eda_buffer.length = p_event->data.done.size;
-        eda_buffer.samples = p_event->data.done.p_buffer;
         if (eda_event_handler != NULL)
         {
-            eda_event_handler(EDA_EVENT_BUFFER_FULL, &eda_buffer);
+            eda_event_handler(EDA_EVENT_BUFFER_FULL, buffer);
+        }
+        else
+        {
+            EDA_ReleaseBuffer(buffer);
+        }
+    }
+}
+
+/**
+ * @brief Clock group was disabled on the compare edge, the waveform is at zero current
+ */
+static void eda_clk_timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    if ((event_type != NRF_TIMER_EVENT_COMPARE0) || (eda_state != EDA_STATE_STOPPING)) {
+        return;
+    }
+    uint32_t count = nrfx_timer_capture_get(&eda_clk_timer, NRF_TIMER_CC_CHANNEL0);
+    eda_clk_phase = (eda_clk_phase + count) % IDAC_ARRAY_LENGTH;
+    eda_clk_edges += count;
+    eda_state = EDA_STATE_STOPPED;
+    if (eda_event_handler != NULL) {
+        eda_event_handler(EDA_EVENT_STOPPED, NULL);
+    }
+}
+
+/**
+ * @brief Date the last sample pair of a buffer just filled. The edge counter was
+ * captured by the SAADC end event, and the RTC counter at that edge is the current
+ * one minus the edges counted since: RTC ticks and clock edges are the same events.
+ */
+static void saadc_buffer_time(eda_buffer_t * buffer)
+{
+    uint32_t end_count = nrfx_timer_capture_get(&eda_clk_timer, NRF_TIMER_CC_CHANNEL2);
+    uint32_t count;
+    uint32_t rtc_counter;
+
+    /* Read both counters between the same two edges, channel 1 is left to the other contexts */
+    do {
+        count = nrfx_timer_capture(&eda_clk_timer, NRF_TIMER_CC_CHANNEL3);
+        rtc_counter = nrfx_rtc_counter_get(CAL_GetRtcInstance());
+    } while (nrfx_timer_capture(&eda_clk_timer, NRF_TIMER_CC_CHANNEL3) != count);
+
+    buffer->frame = eda_clk_edges + end_count - 1;
+    buffer->rtc_counter = (rtc_counter - (count - end_count)) & RTC_COUNTER_COUNTER_Msk;
+}
+
+/**
+ * @brief Give a free buffer of the pool to the SAADC, with SAADC interrupt
+ * masked or from it
+ */
+static bool saadc_buffer_give(void)
+{
+    for (uint8_t n = 0; n < EDA_ADC_POOL_SIZE; n++) {
+        if (buffer_owner[n] == BUFFER_FREE) {
+            buffer_owner[n] = BUFFER_SAADC;
+            saadc_buffer_count++;
+            APP_ERROR_CHECK(nrfx_saadc_buffer_convert(saadc_buffer_pool[n], SAADC_MAX_SAMPLES_NUMBER));
+            return true;
         }
     }
+    return false;
 }
 
 /* END OF FILE */
\ No newline at end of file
@@ -20,6 +20,8 @@
  */
 
 /* Standard C library includes */
+#include <stdbool.h>
+#include <stdint.h>
 
 /* SDK includes */
 
@@ -42,17 +44,54 @@
  */
 typedef enum {
     EDA_EVENT_BUFFER_FULL = 0,
+    EDA_EVENT_STOPPED,          /**< Clock stopped after EDA_Stop, from interrupt */
     EDA_MAX_EVENT_NUM
 } eda_event_t;
 
 /**
- * @brief Buffer of SAADC data sent to eda_event_handler
+ * @brief State of the frontend clock and peripherals
+ */
+typedef enum {
+    EDA_STATE_OFF = 0,          /**< Peripherals released, before EDA_Init or after EDA_Deinit */
+    EDA_STATE_RUNNING,
+    EDA_STATE_STOPPING,         /**< Clock runs until the waveform is back to zero current */
+    EDA_STATE_STOPPED,          /**< Clock stopped at zero current, EDA_Deinit releases the peripherals */
+} eda_state_t;
+
+/**
+ * @brief Buffer of SAADC data sent to eda_event_handler, owned by the
+ * application until given back with EDA_ReleaseBuffer
  */
 typedef struct {
     int16_t * samples;
     uint16_t length;
+    uint32_t sequence;          /**< Buffers filled since EDA_Init, skipped ones included */
+    bool contiguous;            /**< false if samples were lost between the previous buffer and this one */
+    uint32_t ticks;             /**< LAT_GetTicks() when the SAADC was done with the buffer */
+    uint32_t frame;             /**< Clock edges since boot before the last sample pair, across EDA_Init and lost buffers */
+    uint32_t rtc_counter;       /**< Calendar RTC counter at the last sample pair, see CAL_GetCounterTime */
 } eda_buffer_t;
 
+/**
+ * @brief What to do when the SAADC fills a buffer and all the others are
+ * held by the application
+ */
+typedef enum {
+    EDA_OVERRUN_SKIP = 0,       /**< Drop the buffer just filled and keep sampling into it */
+    EDA_OVERRUN_BLOCK,          /**< Let the SAADC fill its last buffer then pause until one is released */
+} eda_overrun_policy_t;
+
+/**
+ * @brief Acquisition counters, since EDA_Init
+ */
+typedef struct {
+    uint32_t buffers;           /**< Buffers filled by the SAADC, skipped ones included */
+    uint32_t overruns;          /**< Buffers dropped by EDA_OVERRUN_SKIP */
+    uint32_t stalls;            /**< Pauses of the SAADC by EDA_OVERRUN_BLOCK, samples are lost for each */
+    uint8_t held;               /**< Buffers held by the application */
+    uint8_t held_max;           /**< Most buffers held by the application at once */
+} eda_stats_t;
+
 /**
  * @brief Callback format for eda events to be sent to application
  */
@@ -67,15 +106,44 @@ typedef void (*eda_event_handler_t)(eda_event_t eda_event, void * data);
  */
 
 /**
- * @brief Initialize pheripherals and start AFE control
+ * @brief Initialize pheripherals and start AFE control, again after EDA_Deinit.
+ * The waveform resumes where it was stopped.
  */
 void EDA_Init(eda_event_handler_t event_handler);
 
 /**
- * @brief Stop acquisition and deinit peripherals
+ * @brief Stop the clock once the waveform is back to zero current, EDA_EVENT_STOPPED
+ * is sent then (up to one waveform period later)
+ */
+void EDA_Stop(void);
+
+/**
+ * @brief Stop acquisition and deinit peripherals. Clock stops at once if
+ * EDA_EVENT_STOPPED was not waited for, wherever the waveform is.
  */
 void EDA_Deinit(void);
 
+/**
+ * @brief Return the state of the frontend clock and peripherals
+ */
+eda_state_t EDA_GetState(void);
+
+/**
+ * @brief Give a buffer received with EDA_EVENT_BUFFER_FULL back to the SAADC,
+ * or to the pool once the peripherals are released
+ */
+void EDA_ReleaseBuffer(eda_buffer_t * buffer);
+
+/**
+ * @brief Choose what happens when the application holds too many buffers
+ */
+void EDA_SetOverrunPolicy(eda_overrun_policy_t policy);
+
+/**
+ * @brief Return acquisition counters
+ */
+void EDA_GetStats(eda_stats_t * p_stats);
+
 #endif /* EDA_AFE_H */
 
 /* END OF FILE */
\ No newline at end of file
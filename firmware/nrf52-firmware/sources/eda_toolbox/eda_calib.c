@@ -0,0 +1,153 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: EDA CALIB
+ *
+ *---------------------------------------------------------------
+ * @brief Per-frequency complex correction applied to the
+ * impedance, computed once from the calibration parameters
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <complex.h>
+#include <math.h>
+
+/* SDK includes */
+
+#include "arm_math.h"
+
+/* Project includes */
+
+#include "eda_calib.h"
+
+/*
+ * Local constants
+ */
+
+static const uint16_t frequency_list[EDA_FREQUENCY_NUM] = EDA_FREQUENCY_LIST;
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local types
+ */
+
+/*
+ * Local variables
+ */
+
+static eda_calib_t calib;
+static float complex correction[EDA_FREQUENCY_NUM];
+static float complex offset[EDA_FREQUENCY_NUM];
+
+/*
+ * Local functions
+ */
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Compute the correction table from default parameters
+ */
+void EDA_CALIB_Init(void)
+{
+    eda_calib_t defaults = {
+        .delay = EDA_CALIB_DELAY_DEFAULT,
+        .skew = EDA_CALIB_SKEW_DEFAULT,
+        .tia_resistance = EDA_TIA_RESISTANCE,
+    };
+    uint16_t n;
+
+    for (n = 0; n < EDA_FREQUENCY_NUM; n++)
+    {
+        defaults.gain[n] = 1.0f;
+        defaults.offset[n] = 0.0f;
+    }
+    EDA_CALIB_Load(&defaults);
+}
+
+/**
+ * @brief Compute the correction table from calibration parameters
+ */
+void EDA_CALIB_Load(const eda_calib_t * p_calib)
+{
+    uint16_t n;
+    float gain = p_calib->tia_resistance / EDA_TIA_RESISTANCE;
+
+    calib = *p_calib;
+    for (n = 0; n < EDA_FREQUENCY_NUM; n++)
+    {
+        float arg = 2.0f * PI * (float)frequency_list[n] * (calib.delay + calib.skew);
+        correction[n] = gain * cexpf(I * arg) * calib.gain[n];
+        offset[n] = calib.offset[n];
+    }
+}
+
+/**
+ * @brief Return the calibration parameters in use
+ */
+void EDA_CALIB_Get(eda_calib_t * p_calib)
+{
+    *p_calib = calib;
+}
+
+/**
+ * @brief Check calibration parameters before they are loaded
+ */
+bool EDA_CALIB_IsValid(const eda_calib_t * p_calib)
+{
+    uint16_t n;
+
+    if (!isfinite(p_calib->delay) || !isfinite(p_calib->skew) ||
+        !isfinite(p_calib->tia_resistance) || (p_calib->tia_resistance <= 0.0f))
+    {
+        return false;
+    }
+    for (n = 0; n < EDA_FREQUENCY_NUM; n++)
+    {
+        if (!isfinite(crealf(p_calib->gain[n])) || !isfinite(cimagf(p_calib->gain[n])) ||
+            (p_calib->gain[n] == 0.0f) ||
+            !isfinite(crealf(p_calib->offset[n])) || !isfinite(cimagf(p_calib->offset[n])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Return the correction table, one factor per frequency of EDA_FREQUENCY_LIST
+ */
+const float complex * EDA_CALIB_GetTable(void)
+{
+    return correction;
+}
+
+/**
+ * @brief Return the offset table, added to the corrected impedance of each frequency
+ */
+const float complex * EDA_CALIB_GetOffsetTable(void)
+{
+    return offset;
+}
+
+/* END OF FILE */
@@ -0,0 +1,105 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: EDA CALIB
+ *
+ *---------------------------------------------------------------
+ * @brief Per-frequency complex correction applied to the
+ * impedance, computed once from the calibration parameters
+ *
+ * The correction of each frequency of EDA_FREQUENCY_LIST gathers
+ * the delay of the current path, the sampling skew between the
+ * SAADC voltage (channel 0) and current (channel 1) inputs, the
+ * actual TIA resistance against EDA_TIA_RESISTANCE, and the gain
+ * and offset measured on a reference load:
+ *   Z = V / I . (R_tia / EDA_TIA_RESISTANCE) . exp(j.2.pi.f.(delay + skew)) . gain + offset
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef EDA_CALIB_H
+#define EDA_CALIB_H
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <complex.h>
+#include <stdbool.h>
+
+/* SDK includes */
+
+/* Project includes */
+
+#include "eda_cfg.h"
+
+/*
+ * Public constants
+ */
+
+#define EDA_CALIB_DELAY_DEFAULT     -2.8e-5f            /**< Delay compensated before per-device calibration (s) */
+#define EDA_CALIB_SKEW_DEFAULT      0.0f                /**< Included in the default delay, which was measured as a whole (s) */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Calibration parameters the correction table is computed from
+ */
+typedef struct {
+    float delay;                /**< Delay compensated on the current path (s) */
+    float skew;                 /**< Sampling time of the current input after the voltage input (s) */
+    float tia_resistance;       /**< Actual resistance of the TIA (Ohm) */
+    float complex gain[EDA_FREQUENCY_NUM];      /**< Gain measured on a reference load, 1 by default */
+    float complex offset[EDA_FREQUENCY_NUM];    /**< Offset measured on a reference load (Ohm), 0 by default */
+} eda_calib_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Compute the correction table from default parameters
+ */
+void EDA_CALIB_Init(void);
+
+/**
+ * @brief Compute the correction table from calibration parameters
+ */
+void EDA_CALIB_Load(const eda_calib_t * p_calib);
+
+/**
+ * @brief Return the calibration parameters in use
+ */
+void EDA_CALIB_Get(eda_calib_t * p_calib);
+
+/**
+ * @brief Check calibration parameters before they are loaded
+ * @return false if a value is not finite, or the TIA resistance or a gain would cancel the impedance
+ */
+bool EDA_CALIB_IsValid(const eda_calib_t * p_calib);
+
+/**
+ * @brief Return the correction table, one factor per frequency of EDA_FREQUENCY_LIST
+ */
+const float complex * EDA_CALIB_GetTable(void);
+
+/**
+ * @brief Return the offset table, added to the corrected impedance of each frequency
+ */
+const float complex * EDA_CALIB_GetOffsetTable(void);
+
+#endif /* EDA_CALIB_H */
+
+/* END OF FILE */
@@ -39,8 +39,25 @@
 #define EDA_CURRENT_RESOLUTION      37.5e-9f                                    /**< as defined in the AFE, for use with theoretical current waveform */
 extern const int8_t i_waveform[4096];                                           /**< the current waveform itself */
 
-#define FFT_CPU_SIZE                1024
-#define FFT_BIN_RATIO               4
+#define FFT_CPU_SIZE                1024                                        /**< analysis window of the default DSP profile */
+#define FFT_CPU_SIZE_MAX            2048                                        /**< longest analysis window of the DSP profiles, sizes the DSP buffers */
+
+#define EDA_DSP_ENGINE_FFT          0                                           /**< real FFT over the whole window, then pick EDA_FREQUENCY_LIST bins */
+#define EDA_DSP_ENGINE_GOERTZEL     1                                           /**< Goertzel on EDA_FREQUENCY_LIST bins only, updated per SAADC buffer */
+#define EDA_DSP_ENGINE_FFT_Q31      3                                           /**< arm_rfft_q31 over the whole window, float only for the final V/I division (same accuracy as float) */
+/* Value 2 was arm_rfft_q15, dropped for its 10 % error on low voltage bins. Q31 uses 32 KB of DSP RAM
+ * against 40 KB for float: 20 % saved, not the half that was aimed at (see host/Readme.md). */
+#ifndef EDA_DSP_ENGINE
+#define EDA_DSP_ENGINE              EDA_DSP_ENGINE_FFT                          /**< DSP engine used by EDA_DSP_GetImpedance */
+#endif
+
+#ifndef EDA_ADC_POOL_SIZE
+#define EDA_ADC_POOL_SIZE           4                                           /**< SAADC buffers: two are filled in turn by the SAADC, the others wait for or are held by the application */
+#endif
+#if (EDA_ADC_POOL_SIZE < 3)
+#error "EDA_ADC_POOL_SIZE must be at least 3 so that the application can hold a buffer while the SAADC fills the next ones"
+#endif
+
 /*
  * Public macros
  */
@@ -19,19 +19,24 @@
 /* Standard C library includes */
 
 #include <complex.h>
+#include <stdbool.h>
+#include <string.h>
 
 /* SDK includes */
 
 #include "nrf52840.h"
 #include "app_timer.h"
+#include "app_util.h"
 #include "app_util_platform.h"
 #include "arm_const_structs.h"
 #include "nrf_log.h"
 
 /* Project includes */
 
+#include "eda_calib.h"
 #include "eda_cfg.h"
 #include "eda_dsp.h"
+#include "latency/latency.h"
 
 /*
  * Local constants
@@ -40,12 +45,43 @@
 #define FPU_EXCEPTION_MASK               0x0000009F     /**< FPU exception mask used to clear exceptions in FPSCR register. */
 #define FPU_FPSCR_REG_STACK_OFF          0x40           /**< Offset of FPSCR register stacked during interrupt handling in FPU part stack. */
 
+#define DSP_STEP_IDLE                    0xFF           /**< No computation in progress */
+#define DSP_STEP_IMPEDANCE               0xFE           /**< Bins are ready, impedance is the last step */
+
 static const uint16_t frequency_list[EDA_FREQUENCY_NUM] = EDA_FREQUENCY_LIST;
-static float32_t v_tmp[EDA_FFT_BUFFER_SIZE];
-static float32_t v_cfft[EDA_FFT_BUFFER_SIZE];
 
-static float32_t i_tmp[EDA_FFT_BUFFER_SIZE];
-static float32_t i_cfft[EDA_FFT_BUFFER_SIZE];
+#define EDA_DSP_ALL_FREQUENCIES          0xFFFF                                 /**< Every frequency of the waveform the window is coherent with */
+
+STATIC_ASSERT(EDA_FREQUENCY_NUM <= 16);                                         /* Frequencies are selected by a 16 bit mask */
+STATIC_ASSERT((FFT_CPU_SIZE_MAX % EDA_ADC_BUFFER_SIZE) == 0);
+
+#if (USE_WAVEFORM == 1)
+#define CURRENT_SCALE                    EDA_CURRENT_RESOLUTION                 /**< Current samples are replaced by i_waveform values */
+#else
+#define CURRENT_SCALE                    EDA_CURRENT_SCALE                      /**< Current samples are raw SAADC values */
+#endif
+
+#define EDA_DSP_ENGINE_IS_FIXED          (EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT_Q31)
+
+#if (EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT)
+static float32_t v_tmp[FFT_CPU_SIZE_MAX];
+static float32_t v_cfft[FFT_CPU_SIZE_MAX];
+
+static float32_t i_tmp[FFT_CPU_SIZE_MAX];
+static float32_t i_cfft[FFT_CPU_SIZE_MAX];
+#elif EDA_DSP_ENGINE_IS_FIXED
+#define FIXED_VOLTAGE_SHIFT              18                                     /**< 14-bit SAADC samples to Q31 full scale */
+#if (USE_WAVEFORM == 1)
+#define FIXED_CURRENT_SHIFT              (FIXED_VOLTAGE_SHIFT + 6)              /**< 8-bit i_waveform values to full scale */
+#else
+#define FIXED_CURRENT_SHIFT              FIXED_VOLTAGE_SHIFT
+#endif
+#define FIXED_FFT_GAIN                   ((float32_t)fft_size)                  /**< arm_rfft_q31 output is downscaled by the FFT length */
+#elif (EDA_DSP_ENGINE == EDA_DSP_ENGINE_GOERTZEL)
+#define GOERTZEL_BLOCK_MAX               (FFT_CPU_SIZE_MAX / EDA_ADC_BUFFER_SIZE)   /**< Number of SAADC buffers spanned by the longest analysis window */
+#else
+#error "Unknown EDA_DSP_ENGINE"
+#endif
 
 /*
  * Local macros
@@ -59,22 +95,94 @@ static float32_t i_cfft[EDA_FFT_BUFFER_SIZE];
  * Local types
  */
 
+/**
+ * @brief Analysis window and frequencies computed
+ */
+typedef struct {
+    uint16_t fft_size;                                                          /**< Window length, multiple of EDA_ADC_BUFFER_SIZE up to FFT_CPU_SIZE_MAX */
+    uint16_t frequency_mask;                                                    /**< Bit n selects frequency n of EDA_FREQUENCY_LIST, if the window is coherent with it */
+} eda_dsp_profile_t;
+
+#if (EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT_Q31)
+typedef q31_t fixed_t;
+typedef arm_rfft_instance_q31 fixed_rfft_instance_t;
+#define fixed_rfft_init                  arm_rfft_init_q31
+#define fixed_rfft                       arm_rfft_q31
+#endif
+
 /*
  * Local variables
  */
 
+#if (EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT)
 static arm_rfft_fast_instance_f32 m_arm_rfft_fast_instance_f32;
-
-static float32_t v_buffer[EDA_FFT_BUFFER_SIZE] = {0};
-static float32_t i_buffer[EDA_FFT_BUFFER_SIZE] = {0};
+#elif EDA_DSP_ENGINE_IS_FIXED
+static fixed_rfft_instance_t m_fixed_rfft_instance;
+
+static fixed_t fixed_tmp[FFT_CPU_SIZE_MAX];                                     /**< Window of one channel, modified by fft function */
+static fixed_t fixed_cfft[2 * FFT_CPU_SIZE_MAX];                                /**< Full complex spectrum of one channel */
+#endif
+
+#if ((EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT) || EDA_DSP_ENGINE_IS_FIXED)
+static int16_t v_ring[FFT_CPU_SIZE_MAX];                                        /**< Raw voltage samples of the analysis window, used as a ring */
+static int16_t i_ring[FFT_CPU_SIZE_MAX];                                        /**< Raw current samples of the analysis window, used as a ring */
+static uint16_t ring_index;                                                     /**< Oldest sample of the window, also next write position */
+#elif (EDA_DSP_ENGINE == EDA_DSP_ENGINE_GOERTZEL)
+static float32_t v_block[EDA_ADC_BUFFER_SIZE];                                  /**< Scaled voltage samples of the incoming SAADC buffer */
+static float32_t i_block[EDA_ADC_BUFFER_SIZE];                                  /**< Scaled current samples of the incoming SAADC buffer */
+
+static float32_t goertzel_coeff[EDA_FREQUENCY_NUM];                             /**< 2.cos(w) recursion coefficient of each bin */
+static float complex goertzel_twiddle[EDA_FREQUENCY_NUM];                       /**< exp(-jw) used to close the recursion */
+static float complex goertzel_align[EDA_FREQUENCY_NUM];                         /**< exp(-jw(N-1)) to refer the result to the first sample of the block */
+static float complex goertzel_shift[EDA_FREQUENCY_NUM];                         /**< exp(-jwN) phase advance between two consecutive blocks */
+
+static float complex v_block_bins[GOERTZEL_BLOCK_MAX][EDA_FREQUENCY_NUM];       /**< Partial DFT of the last blocks, used as a ring */
+static float complex i_block_bins[GOERTZEL_BLOCK_MAX][EDA_FREQUENCY_NUM];
+static uint16_t block_index;
+static uint16_t block_num;                                                      /**< Number of SAADC buffers spanned by the analysis window */
+#endif
+
+/* Windows shorter than FFT_CPU_SIZE do not hold whole periods of the 4 Hz spaced tones of the waveform, which then leak into every bin */
+static const eda_dsp_profile_t profile_list[EDA_DSP_PROFILE_NUM] = {
+    { FFT_CPU_SIZE, EDA_DSP_ALL_FREQUENCIES },                                  /* 4 Hz bins, every frequency of the waveform */
+    { 2048,         EDA_DSP_ALL_FREQUENCIES },                                  /* 2 Hz bins, 0.5 s window: more averaging, slower to follow changes */
+    { FFT_CPU_SIZE, 0x5555 },                                                   /* Every other frequency, halves the spectrum payload and the Goertzel load */
+};
+
+static uint8_t profile = EDA_DSP_PROFILE_DEFAULT;
+static uint16_t fft_size;                                                       /**< Analysis window of the profile */
+static uint8_t frequency_num;                                                   /**< Frequencies computed */
+static uint8_t frequency_index[EDA_FREQUENCY_NUM];                              /**< Waveform frequency of each computed one */
+
+static float complex v_bins[EDA_FREQUENCY_NUM];                                 /**< Computed frequencies only, in frequency_index order */
+static float complex i_bins[EDA_FREQUENCY_NUM];
 
 static uint16_t i_buffer_index;
+static uint32_t window_frame;                                                   /**< Frame index of the last sample pair pushed */
+
+static uint8_t dsp_step = DSP_STEP_IDLE;                                        /**< Next engine step of the computation in progress */
+static uint32_t scaling_cycles;                                                 /**< Cycles spent by the engine on its input samples */
+static uint32_t transform_cycles;                                               /**< Cycles spent by the engine steps, scaling excluded */
 
 /*
  * Local functions
  */
 
-static void simulated_current(float32_t * i_buffer);
+static void simulated_current(int16_t * raw_buffer);
+static uint8_t profile_frequencies(uint8_t p, uint8_t * index);
+static void dsp_engine_init(void);
+static void dsp_engine_push(int16_t * raw_buffer);
+static bool dsp_engine_step(uint8_t step);
+static int impedance_get(Impedance * out_array);
+#if ((EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT) || EDA_DSP_ENGINE_IS_FIXED)
+static void window_push(int16_t * raw_buffer);
+#endif
+#if EDA_DSP_ENGINE_IS_FIXED
+static void fixed_get_bins(const int16_t * ring, uint8_t shift, float32_t scale, float complex * bins);
+#endif
+#if (EDA_DSP_ENGINE == EDA_DSP_ENGINE_GOERTZEL)
+static void goertzel_block(float complex * v_out, float complex * i_out);
+#endif
 
 /****************************************************************
  * IMPLEMENTATION
@@ -96,8 +204,65 @@ void EDA_DSP_Init(void)
     NVIC_ClearPendingIRQ(FPU_IRQn);
     NVIC_EnableIRQ(FPU_IRQn);
 
-    arm_rfft_fast_init_f32(&m_arm_rfft_fast_instance_f32, FFT_CPU_SIZE);
+    fft_size = profile_list[profile].fft_size;
+    frequency_num = profile_frequencies(profile, frequency_index);
+
+    dsp_engine_init();
     i_buffer_index = 0;
+    dsp_step = DSP_STEP_IDLE;
+}
+
+
+/**
+ * @brief Select the analysis window and frequencies, the window is emptied
+ */
+bool EDA_DSP_SetProfile(uint8_t new_profile)
+{
+    uint8_t index[EDA_FREQUENCY_NUM];
+
+    if ((new_profile >= EDA_DSP_PROFILE_NUM) || (profile_frequencies(new_profile, index) == 0))
+    {
+        return false;
+    }
+    profile = new_profile;
+    EDA_DSP_Init();
+    return true;
+}
+
+
+/**
+ * @brief Return the profile in use
+ */
+uint8_t EDA_DSP_GetProfile(void)
+{
+    return profile;
+}
+
+
+/**
+ * @brief Return the analysis window length in samples
+ */
+uint16_t EDA_DSP_GetWindowSize(void)
+{
+    return fft_size;
+}
+
+
+/**
+ * @brief Return the number of impedance values written by EDA_DSP_GetImpedance and EDA_DSP_Step
+ */
+uint8_t EDA_DSP_GetFrequencyNum(void)
+{
+    return frequency_num;
+}
+
+
+/**
+ * @brief Return the frequency of an impedance value, in Hz
+ */
+uint16_t EDA_DSP_GetFrequency(uint8_t n)
+{
+    return frequency_list[frequency_index[n]];
 }
 
 
@@ -117,75 +282,394 @@ void EDA_DSP_Deinit(void)
  */
 int EDA_DSP_GetImpedance(int16_t * raw_buffer, Impedance * out_array)
 {
-    //uint32_t ticks_from = app_timer_cnt_get();
+    eda_dsp_status_t status;
 
-    uint16_t n;
+    EDA_DSP_Begin(raw_buffer, window_frame + EDA_ADC_BUFFER_SIZE);
+    do
+    {
+        status = EDA_DSP_Step(out_array);
+    } while (status == EDA_DSP_PENDING);
 
-    /* Shift buffers */
-    memmove(&v_buffer[0], &v_buffer[EDA_ADC_BUFFER_SIZE], (EDA_FFT_BUFFER_SIZE - EDA_ADC_BUFFER_SIZE) * sizeof(float32_t));
-    memmove(&i_buffer[0], &i_buffer[EDA_ADC_BUFFER_SIZE], (EDA_FFT_BUFFER_SIZE - EDA_ADC_BUFFER_SIZE) * sizeof(float32_t));
+    return (status == EDA_DSP_DONE) ? 0 : -1;
+}
 
-    /* Extract voltage and current values from raw data buffer */
-    for (n = 0; n < EDA_ADC_BUFFER_SIZE; n++)
-    {
-        v_buffer[(EDA_FFT_BUFFER_SIZE - EDA_ADC_BUFFER_SIZE) + n] = EDA_VOLTAGE_SCALE * (float32_t)raw_buffer[2*n];
-        i_buffer[(EDA_FFT_BUFFER_SIZE - EDA_ADC_BUFFER_SIZE) + n] = EDA_CURRENT_SCALE * (float32_t)raw_buffer[(2*n)+1];
-    }
+
+/**
+ * @brief Push voltage and current raw data into the analysis window and start the computation of impedance
+ */
+void EDA_DSP_Begin(int16_t * raw_buffer, uint32_t frame)
+{
+    uint32_t cycles_from;
+
+    window_frame = frame;
 
     /* Replace current values by theoretical values, might reduce noise */
     if (USE_WAVEFORM == 1)
     {
-        simulated_current(&i_buffer[EDA_FFT_BUFFER_SIZE - EDA_ADC_BUFFER_SIZE]);
+        simulated_current(raw_buffer);
     }
 
-    /* Copy to a temporary buffer which is modified by fft function */
-    memcpy(v_tmp, v_buffer, EDA_FFT_BUFFER_SIZE * sizeof(float32_t));
-    memcpy(i_tmp, i_buffer, EDA_FFT_BUFFER_SIZE * sizeof(float32_t));
+    cycles_from = LAT_GetCycles();
+    dsp_engine_push(raw_buffer);
+    scaling_cycles = LAT_GetCycles() - cycles_from;
+    transform_cycles = 0;
+    dsp_step = 0;
+}
+
 
-    /* Compute voltage FFT on temporary buffer because IT IS MODIFIED BY FFT FUNCTION */
-    arm_rfft_fast_f32(&m_arm_rfft_fast_instance_f32, v_tmp, v_cfft, 0);
+/**
+ * @brief Return the frame index of the sample pair just before the centre of the analysis window
+ */
+uint32_t EDA_DSP_GetFrame(void)
+{
+    return window_frame - (fft_size / 2);
+}
+
+
+/**
+ * @brief Run the next step of the computation started by EDA_DSP_Begin
+ */
+eda_dsp_status_t EDA_DSP_Step(Impedance * out_array)
+{
+    uint32_t cycles_from;
+    uint32_t scaling_from;
 
-    /* Compute current FFT (also modified, we know that now) */
-    arm_rfft_fast_f32(&m_arm_rfft_fast_instance_f32, i_tmp, i_cfft, 0);
+    if (dsp_step == DSP_STEP_IDLE)
+    {
+        return EDA_DSP_IDLE;
+    }
+
+    if (dsp_step == DSP_STEP_IMPEDANCE)
+    {
+        dsp_step = DSP_STEP_IDLE;
+        LAT_Record(LAT_STAGE_SCALING, LAT_CyclesToUs(scaling_cycles));
+        LAT_Record(LAT_STAGE_TRANSFORM, LAT_CyclesToUs(transform_cycles));
+        return (impedance_get(out_array) == 0) ? EDA_DSP_DONE : EDA_DSP_FAILED;
+    }
+
+    /* Get voltage and current spectra at the frequencies of interest, one part at a time */
+    scaling_from = scaling_cycles;
+    cycles_from = LAT_GetCycles();
+    if (dsp_engine_step(dsp_step))
+    {
+        dsp_step = DSP_STEP_IMPEDANCE;
+    }
+    else
+    {
+        dsp_step ++;
+    }
+    transform_cycles += (LAT_GetCycles() - cycles_from) - (scaling_cycles - scaling_from);
+
+    return EDA_DSP_PENDING;
+}
+
+
+/*
+ * Local functions
+ */
+
+/**
+ * @brief Divide voltage bins by current bins and apply calibration correction
+ */
+static int impedance_get(Impedance * out_array)
+{
+    uint16_t n;
+    uint32_t cycles_from = LAT_GetCycles();
+    const float complex * correction = EDA_CALIB_GetTable();
+    const float complex * offset = EDA_CALIB_GetOffsetTable();
 
     /* Export impedance real and imaginary parts*/
-    int index;
-    for (n = 0; n < EDA_FREQUENCY_NUM; n ++)
-    {
-        index = (2*frequency_list[n]/FFT_BIN_RATIO);
-        float complex v = v_cfft[index] + v_cfft[index+1] * I;
-        float complex i = i_cfft[index] + i_cfft[index+1] * I;       
-        float complex y = v / i;
-        // apply delay compensation
-        float delay_arg = 2.0f * PI * (float) frequency_list[n] * -2.8e-5f;
-        float complex delay = cexpf(I * delay_arg);
-        y = y * delay;
+    for (n = 0; n < frequency_num; n ++)
+    {
+        uint8_t k = frequency_index[n];
+        float complex v = v_bins[n];
+        float complex i = i_bins[n];
+        // V / I = V.conj(I) / |I|^2, corrected by the calibration tables (delay, TIA gain, skew, reference load)
+        float complex y = (v * conjf(i) * (correction[k] / ((crealf(i) * crealf(i)) + (cimagf(i) * cimagf(i))))) + offset[k];
         out_array[n].real = crealf(y);
         out_array[n].imag = cimag(y);
         if (isnan(out_array[n].real) || isnan(out_array[n].imag)) {
-            NRF_LOG_WARNING("NaN value for freq. %u (v:%f, i:%f)", frequency_list[n], v, i);
+            NRF_LOG_WARNING("NaN value for freq. %u (v:%f, i:%f)", frequency_list[k], v, i);
             return -1;
         }
     }
 
-    //uint32_t ticks_to = app_timer_cnt_get();
-    //uint32_t delta = app_timer_cnt_diff_compute(ticks_to, ticks_from);
-    //NRF_LOG_DEBUG("%lu", delta);
+    LAT_RecordCycles(LAT_STAGE_IMPEDANCE, cycles_from);
     return 0;
 }
 
+#if (EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT)
 
-/*
- * Local functions
+static void dsp_engine_init(void)
+{
+    arm_rfft_fast_init_f32(&m_arm_rfft_fast_instance_f32, fft_size);
+    memset(v_ring, 0, sizeof(v_ring));
+    memset(i_ring, 0, sizeof(i_ring));
+    ring_index = 0;
+}
+
+static void dsp_engine_push(int16_t * raw_buffer)
+{
+    window_push(raw_buffer);
+}
+
+/**
+ * @brief Gather and scale the window, then one FFT per step, return true once bins are ready
+ */
+static bool dsp_engine_step(uint8_t step)
+{
+    uint16_t n, k;
+    int index;
+    uint32_t cycles_from;
+
+    switch (step)
+    {
+    case 0:
+        /* Gather the window from oldest to newest sample into temporary buffers, which are modified by fft function */
+        cycles_from = LAT_GetCycles();
+        k = 0;
+        for (n = ring_index; n < fft_size; n++, k++)
+        {
+            v_tmp[k] = EDA_VOLTAGE_SCALE * (float32_t)v_ring[n];
+            i_tmp[k] = CURRENT_SCALE * (float32_t)i_ring[n];
+        }
+        for (n = 0; n < ring_index; n++, k++)
+        {
+            v_tmp[k] = EDA_VOLTAGE_SCALE * (float32_t)v_ring[n];
+            i_tmp[k] = CURRENT_SCALE * (float32_t)i_ring[n];
+        }
+        scaling_cycles += LAT_GetCycles() - cycles_from;
+        return false;
+
+    case 1:
+        /* Compute voltage FFT on temporary buffer because IT IS MODIFIED BY FFT FUNCTION */
+        arm_rfft_fast_f32(&m_arm_rfft_fast_instance_f32, v_tmp, v_cfft, 0);
+        return false;
+
+    default:
+        /* Compute current FFT (also modified, we know that now) */
+        arm_rfft_fast_f32(&m_arm_rfft_fast_instance_f32, i_tmp, i_cfft, 0);
+
+        /* Pick bins of interest */
+        for (n = 0; n < frequency_num; n ++)
+        {
+            index = 2 * ((frequency_list[frequency_index[n]] * fft_size) / EDA_SAMPLING_RATE);
+            v_bins[n] = v_cfft[index] + v_cfft[index+1] * I;
+            i_bins[n] = i_cfft[index] + i_cfft[index+1] * I;
+        }
+        return true;
+    }
+}
+
+#elif EDA_DSP_ENGINE_IS_FIXED
+
+static void dsp_engine_init(void)
+{
+    fixed_rfft_init(&m_fixed_rfft_instance, fft_size, 0, 1);
+    memset(v_ring, 0, sizeof(v_ring));
+    memset(i_ring, 0, sizeof(i_ring));
+    ring_index = 0;
+}
+
+static void dsp_engine_push(int16_t * raw_buffer)
+{
+    window_push(raw_buffer);
+}
+
+/**
+ * @brief One channel per step, to share the fixed point buffers, return true once bins are ready
+ */
+static bool dsp_engine_step(uint8_t step)
+{
+    if (step == 0)
+    {
+        fixed_get_bins(v_ring, FIXED_VOLTAGE_SHIFT, EDA_VOLTAGE_SCALE, v_bins);
+        return false;
+    }
+    fixed_get_bins(i_ring, FIXED_CURRENT_SHIFT, CURRENT_SCALE, i_bins);
+    return true;
+}
+
+/**
+ * @brief Run fixed point FFT over the window of one channel, and convert bins of interest to float
  */
+static void fixed_get_bins(const int16_t * ring, uint8_t shift, float32_t scale, float complex * bins)
+{
+    uint16_t n, k;
+    int index;
+    uint32_t cycles_from = LAT_GetCycles();
 
-static void simulated_current(float32_t * i_buffer)
+    /* Gather the window from oldest to newest sample, scaled to fixed point full scale */
+    k = 0;
+    for (n = ring_index; n < fft_size; n++, k++)
+    {
+        fixed_tmp[k] = (fixed_t)((int32_t)ring[n] * (1L << shift));
+    }
+    for (n = 0; n < ring_index; n++, k++)
+    {
+        fixed_tmp[k] = (fixed_t)((int32_t)ring[n] * (1L << shift));
+    }
+    scaling_cycles += LAT_GetCycles() - cycles_from;
+
+    fixed_rfft(&m_fixed_rfft_instance, fixed_tmp, fixed_cfft);
+
+    /* Pick bins of interest, back to the units of the float engines */
+    scale = scale * FIXED_FFT_GAIN / (float32_t)(1L << shift);
+    for (n = 0; n < frequency_num; n ++)
+    {
+        index = 2 * ((frequency_list[frequency_index[n]] * fft_size) / EDA_SAMPLING_RATE);
+        bins[n] = scale * ((float32_t)fixed_cfft[index] + (float32_t)fixed_cfft[index+1] * I);
+    }
+}
+
+#elif (EDA_DSP_ENGINE == EDA_DSP_ENGINE_GOERTZEL)
+
+static void dsp_engine_init(void)
+{
+    uint16_t n;
+
+    for (n = 0; n < frequency_num; n++)
+    {
+        /* Same bin as the one picked in a fft_size points FFT */
+        float32_t w = 2.0f * PI * (float32_t)((frequency_list[frequency_index[n]] * fft_size) / EDA_SAMPLING_RATE) / (float32_t)fft_size;
+        goertzel_coeff[n] = 2.0f * cosf(w);
+        goertzel_twiddle[n] = cexpf(-I * w);
+        goertzel_align[n] = cexpf(-I * w * (float32_t)(EDA_ADC_BUFFER_SIZE - 1));
+        goertzel_shift[n] = cexpf(-I * w * (float32_t)EDA_ADC_BUFFER_SIZE);
+    }
+    memset(v_block_bins, 0, sizeof(v_block_bins));
+    memset(i_block_bins, 0, sizeof(i_block_bins));
+    block_index = 0;
+    block_num = fft_size / EDA_ADC_BUFFER_SIZE;
+}
+
+static void dsp_engine_push(int16_t * raw_buffer)
+{
+    uint16_t n;
+
+    /* Extract voltage and current values from raw data buffer */
+    for (n = 0; n < EDA_ADC_BUFFER_SIZE; n++)
+    {
+        v_block[n] = EDA_VOLTAGE_SCALE * (float32_t)raw_buffer[2*n];
+        i_block[n] = CURRENT_SCALE * (float32_t)raw_buffer[(2*n)+1];
+    }
+}
+
+/**
+ * @brief Single step, Goertzel recursion of the new block is shorter than one FFT
+ */
+static bool dsp_engine_step(uint8_t step)
+{
+    uint16_t n, b, k;
+
+    (void)step;
+
+    /* Partial DFT of the new block replaces the oldest one */
+    goertzel_block(v_block_bins[block_index], i_block_bins[block_index]);
+    block_index ++;
+    if (block_index >= block_num)
+    {
+        block_index = 0;
+    }
+
+    /* Sum partial DFTs over the window, from newest to oldest block (Horner) */
+    for (n = 0; n < frequency_num; n++)
+    {
+        v_bins[n] = 0.0f;
+        i_bins[n] = 0.0f;
+        for (k = 0; k < block_num; k++)
+        {
+            /* block_index now points to the oldest block */
+            b = (block_index + block_num - 1 - k) % block_num;
+            v_bins[n] = v_bins[n] * goertzel_shift[n] + v_block_bins[b][n];
+            i_bins[n] = i_bins[n] * goertzel_shift[n] + i_block_bins[b][n];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Run Goertzel recursion of each bin over one block of voltage and current samples
+ */
+static void goertzel_block(float complex * v_out, float complex * i_out)
+{
+    uint16_t n, k;
+
+    for (k = 0; k < frequency_num; k++)
+    {
+        float32_t coeff = goertzel_coeff[k];
+        float32_t v_s0, v_s1 = 0.0f, v_s2 = 0.0f;
+        float32_t i_s0, i_s1 = 0.0f, i_s2 = 0.0f;
+
+        for (n = 0; n < EDA_ADC_BUFFER_SIZE; n++)
+        {
+            v_s0 = v_block[n] + (coeff * v_s1) - v_s2;
+            v_s2 = v_s1;
+            v_s1 = v_s0;
+            i_s0 = i_block[n] + (coeff * i_s1) - i_s2;
+            i_s2 = i_s1;
+            i_s1 = i_s0;
+        }
+
+        /* y = s[N-1] - exp(-jw).s[N-2], X = exp(-jw(N-1)).y */
+        v_out[k] = (v_s1 - (goertzel_twiddle[k] * v_s2)) * goertzel_align[k];
+        i_out[k] = (i_s1 - (goertzel_twiddle[k] * i_s2)) * goertzel_align[k];
+    }
+}
+
+#endif
+
+#if ((EDA_DSP_ENGINE == EDA_DSP_ENGINE_FFT) || EDA_DSP_ENGINE_IS_FIXED)
+/**
+ * @brief Extract voltage and current values from raw data buffer, overwriting the oldest samples of the window
+ */
+static void window_push(int16_t * raw_buffer)
+{
+    uint16_t n;
+
+    for (n = 0; n < EDA_ADC_BUFFER_SIZE; n++)
+    {
+        v_ring[ring_index + n] = raw_buffer[2*n];
+        i_ring[ring_index + n] = raw_buffer[(2*n)+1];
+    }
+    ring_index += EDA_ADC_BUFFER_SIZE;
+    if (ring_index >= fft_size)
+    {
+        ring_index = 0;
+    }
+}
+#endif
+
+/**
+ * @brief List the frequencies of a profile, those of its mask that fall on a bin of its window
+ * @return number of frequencies written to index
+ */
+static uint8_t profile_frequencies(uint8_t p, uint8_t * index)
+{
+    uint8_t n, num = 0;
+    uint32_t window = profile_list[p].fft_size;
+
+    for (n = 0; n < EDA_FREQUENCY_NUM; n++)
+    {
+        if (((profile_list[p].frequency_mask & (1U << n)) != 0) &&
+            ((((uint32_t)frequency_list[n] * window) % EDA_SAMPLING_RATE) == 0))
+        {
+            index[num++] = n;
+        }
+    }
+    return num;
+}
+
+/**
+ * @brief Overwrite current samples of a raw data buffer with i_waveform values (scaled by CURRENT_SCALE)
+ */
+static void simulated_current(int16_t * raw_buffer)
 {
     uint16_t n;
 
     for (n = 0; n < EDA_ADC_BUFFER_SIZE; n++)
     {
-        i_buffer[n] = EDA_CURRENT_RESOLUTION * (float32_t)i_waveform[(i_buffer_index * EDA_ADC_BUFFER_SIZE) + n];
+        raw_buffer[(2*n)+1] = (int16_t)i_waveform[(i_buffer_index * EDA_ADC_BUFFER_SIZE) + n];
     }
     i_buffer_index ++;
     if (i_buffer_index >= EDA_ADC_BUFFER_NUM)
@@ -21,6 +21,9 @@
 
 /* Standard C library includes */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 /* SDK includes */
 
 #include "arm_math.h"
@@ -33,6 +36,9 @@
  * Public constants
  */
 
+#define EDA_DSP_PROFILE_NUM         3       /**< Analysis window and frequency sets selectable by EDA_DSP_SetProfile */
+#define EDA_DSP_PROFILE_DEFAULT     0       /**< FFT_CPU_SIZE window, every frequency of EDA_FREQUENCY_LIST */
+
 /*
  * Public macros
  */
@@ -41,6 +47,16 @@
  * Public types
  */
 
+/**
+ * @brief Progress of the computation started by EDA_DSP_Begin
+ */
+typedef enum {
+    EDA_DSP_DONE = 0,       /**< Impedance written to the output array */
+    EDA_DSP_PENDING,        /**< Step done, call EDA_DSP_Step again */
+    EDA_DSP_FAILED,         /**< Impedance is not a number, output array is not valid */
+    EDA_DSP_IDLE            /**< No computation in progress */
+} eda_dsp_status_t;
+
 /*
  * Public variables
  */
@@ -60,11 +76,58 @@ void EDA_DSP_Init(void);
  */
 void EDA_DSP_Deinit(void);
 
+/**
+ * @brief Select the analysis window and frequencies, the window is emptied.
+ * A computation in progress is dropped. Profiles only pick among the frequencies of the
+ * waveform played by the AFE, the ones coherent with their window.
+ * @return false if the profile does not exist
+ */
+bool EDA_DSP_SetProfile(uint8_t new_profile);
+
+/**
+ * @brief Return the profile in use
+ */
+uint8_t EDA_DSP_GetProfile(void);
+
+/**
+ * @brief Return the analysis window length in samples, a multiple of EDA_ADC_BUFFER_SIZE
+ */
+uint16_t EDA_DSP_GetWindowSize(void);
+
+/**
+ * @brief Return the number of impedance values written by EDA_DSP_GetImpedance and EDA_DSP_Step
+ */
+uint8_t EDA_DSP_GetFrequencyNum(void);
+
+/**
+ * @brief Return the frequency of an impedance value, in Hz
+ */
+uint16_t EDA_DSP_GetFrequency(uint8_t n);
+
 /**
  * @brief Compute impedance at specific frequencies from voltage and current raw data
  */
 int EDA_DSP_GetImpedance(int16_t * raw_buffer, Impedance * out_array);
 
+/**
+ * @brief Push voltage and current raw data into the analysis window and start the computation of impedance.
+ * Raw data buffer is no longer used on return. A computation still in progress must be completed first,
+ * its samples would otherwise be lost by the Goertzel engine.
+ * @param[in] frame index of the last sample pair of the buffer, counted by the caller
+ */
+void EDA_DSP_Begin(int16_t * raw_buffer, uint32_t frame);
+
+/**
+ * @brief Return the frame index of the sample pair just before the centre of the analysis
+ * window of the computation started last, the centre is half a sample later
+ */
+uint32_t EDA_DSP_GetFrame(void);
+
+/**
+ * @brief Run the next step of the computation started by EDA_DSP_Begin, each step is one FFT at most
+ */
+eda_dsp_status_t EDA_DSP_Step(Impedance * out_array);
+
 void FPU_IRQHandler(void);
 
 
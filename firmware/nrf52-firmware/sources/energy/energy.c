@@ -0,0 +1,263 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: ENERGY
+ *
+ *---------------------------------------------------------------
+ * @brief Charge budget of the main subsystems, to compare the
+ * battery runtime of firmware versions
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+
+/* SDK includes */
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "ble_radio_notification.h"
+
+#define NRF_LOG_MODULE_NAME NRG
+#define NRF_LOG_INFO_COLOR  3
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/* Project includes */
+#include "energy.h"
+#include "fuel_gauge/fuel_gauge.h"
+
+/*
+ * Local constants
+ */
+
+#define NRG_SAMPLE_MS               10000                                   /**< Fuel gauge sampling, also keeps the 32 bit DWT counter (67 s at 64 MHz) from wrapping unnoticed */
+#define RADIO_NOTIFICATION_DISTANCE NRF_RADIO_NOTIFICATION_DISTANCE_800US   /**< Shortest notification distance, the ACTIVE signal comes this early */
+#define RADIO_NOTIFICATION_DISTANCE_US  800
+#define CYCLES_PER_US               (SystemCoreClock / 1000000UL)
+
+/*
+ * Local macros
+ */
+
+#define TICKS_TO_US(ticks)          (((uint64_t)(ticks) * 1000000ULL) / APP_TIMER_CLOCK_FREQ)
+
+/*
+ * Public variables
+ */
+
+APP_TIMER_DEF(nrg_timer_id);
+
+/*
+ * Local variables
+ */
+
+static const uint32_t subsystem_current_ua[NRG_SUBSYSTEM_NUM] = {
+    NRG_CPU_CURRENT_UA,
+    NRG_RADIO_CURRENT_UA,
+    NRG_SAADC_CURRENT_UA,
+};
+
+static const char * const subsystem_names[NRG_SUBSYSTEM_NUM] = {
+    "cpu",
+    "radio",
+    "saadc",
+};
+
+static uint32_t last_ticks;         /**< app_timer counter at last update */
+static uint32_t last_cycles;        /**< DWT counter at last update */
+static uint64_t period_ticks;       /**< Ticks since NRG_Reset */
+static uint64_t cpu_cycles;         /**< CPU cycles since NRG_Reset, the counter stops while sleeping */
+static volatile uint32_t wakeups;
+
+static bool radio_active_now;
+static uint32_t radio_start_ticks;
+static uint64_t radio_ticks;        /**< Radio notification ACTIVE to INACTIVE time, notification distance included */
+static uint32_t radio_events;
+
+static uint64_t saadc_us;
+
+static uint32_t gauge_ticks;        /**< app_timer counter at last fuel gauge sample */
+static int64_t measured_uas;        /**< Discharge measured by the fuel gauge, in uA.s */
+static uint16_t remaining_mah;
+
+/*
+ * Local functions
+ */
+
+static void accounting_update(void);
+static void radio_notification_handler(bool radio_active);
+static void nrg_timer_handler(void * p_context);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start accounting, once the SoftDevice and the fuel gauge are initialized
+ */
+void NRG_Init(void)
+{
+    /* Cycle counter may already run for latency measurement, it is not reset here */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    NRG_Reset();
+    remaining_mah = FGA_GetRemainingCapacity();
+
+    APP_ERROR_CHECK(ble_radio_notification_init(APP_IRQ_PRIORITY_LOW, RADIO_NOTIFICATION_DISTANCE,
+                                                radio_notification_handler));
+    APP_ERROR_CHECK(app_timer_create(&nrg_timer_id, APP_TIMER_MODE_REPEATED, nrg_timer_handler));
+    APP_ERROR_CHECK(app_timer_start(nrg_timer_id, APP_TIMER_TICKS(NRG_SAMPLE_MS), NULL));
+}
+
+/**
+ * @brief Restart accounting from now
+ */
+void NRG_Reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    last_ticks = app_timer_cnt_get();
+    last_cycles = DWT->CYCCNT;
+    gauge_ticks = last_ticks;
+    period_ticks = 0;
+    cpu_cycles = 0;
+    wakeups = 0;
+    radio_ticks = 0;
+    radio_events = 0;
+    saadc_us = 0;
+    measured_uas = 0;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Count a wakeup of the main loop, to be called after nrf_pwr_mgmt_run
+ */
+void NRG_CountWakeup(void)
+{
+    wakeups++;
+}
+
+/**
+ * @brief Add active time of a subsystem that is not measured by the module
+ */
+void NRG_AddActiveTime(nrg_subsystem_t subsystem, uint32_t us)
+{
+    if (subsystem == NRG_SUBSYSTEM_SAADC) {
+        CRITICAL_REGION_ENTER();
+        saadc_us += us;
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+/**
+ * @brief Return the accounting since boot or NRG_Reset
+ */
+void NRG_GetReport(nrg_report_t * p_report)
+{
+    uint64_t radio_us;
+    uint64_t radio_distance_us;
+
+    accounting_update();
+
+    CRITICAL_REGION_ENTER();
+    p_report->period_ms = (uint32_t)((period_ticks * 1000ULL) / APP_TIMER_CLOCK_FREQ);
+    p_report->wakeups = wakeups;
+    p_report->radio_events = radio_events;
+    p_report->active_us[NRG_SUBSYSTEM_CPU] = cpu_cycles / CYCLES_PER_US;
+    radio_us = TICKS_TO_US(radio_ticks);
+    radio_distance_us = (uint64_t)radio_events * RADIO_NOTIFICATION_DISTANCE_US;
+    p_report->active_us[NRG_SUBSYSTEM_RADIO] = (radio_us > radio_distance_us) ? (radio_us - radio_distance_us) : 0;
+    p_report->active_us[NRG_SUBSYSTEM_SAADC] = saadc_us;
+    p_report->measured_uah = (int32_t)(measured_uas / 3600);
+    p_report->remaining_mah = remaining_mah;
+    CRITICAL_REGION_EXIT();
+
+    for (uint8_t n = 0; n < NRG_SUBSYSTEM_NUM; n++) {
+        p_report->estimated_uah[n] = (uint32_t)((p_report->active_us[n] * subsystem_current_ua[n]) / 3600000000ULL);
+    }
+}
+
+/**
+ * @brief Log the accounting, one line per subsystem
+ */
+void NRG_Log(void)
+{
+    nrg_report_t report;
+
+    NRG_GetReport(&report);
+    NRF_LOG_INFO("%u s, %u wakeups, %u radio events, %d uAh measured",
+                 report.period_ms / 1000, report.wakeups, report.radio_events, report.measured_uah);
+    for (uint8_t n = 0; n < NRG_SUBSYSTEM_NUM; n++) {
+        NRF_LOG_INFO("%s: %u ms active, %u uAh", subsystem_names[n],
+                     (uint32_t)(report.active_us[n] / 1000), report.estimated_uah[n]);
+    }
+}
+
+/*
+ * Local functions
+ */
+
+/**
+ * @brief Add time and CPU cycles elapsed since last update
+ */
+static void accounting_update(void)
+{
+    CRITICAL_REGION_ENTER();
+    uint32_t ticks = app_timer_cnt_get();
+    uint32_t cycles = DWT->CYCCNT;
+    period_ticks += app_timer_cnt_diff_compute(ticks, last_ticks);
+    cpu_cycles += cycles - last_cycles;
+    last_ticks = ticks;
+    last_cycles = cycles;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Time radio events, from the SoftDevice radio notification interrupt
+ */
+static void radio_notification_handler(bool radio_active)
+{
+    uint32_t ticks = app_timer_cnt_get();
+
+    if (radio_active) {
+        radio_start_ticks = ticks;
+        radio_active_now = true;
+    }
+    else if (radio_active_now) {
+        radio_ticks += app_timer_cnt_diff_compute(ticks, radio_start_ticks);
+        radio_events++;
+        radio_active_now = false;
+    }
+}
+
+/**
+ * @brief Integrate fuel gauge average current, and read the cycle counter before it wraps
+ */
+static void nrg_timer_handler(void * p_context)
+{
+    int16_t current_ma = FGA_GetAverageCurrent();
+    uint16_t capacity = FGA_GetRemainingCapacity();
+    uint32_t ticks = app_timer_cnt_get();
+
+    accounting_update();
+
+    /* Gauge averages over the last second, taken as the average of the whole interval */
+    CRITICAL_REGION_ENTER();
+    measured_uas -= ((int64_t)current_ma * 1000 * app_timer_cnt_diff_compute(ticks, gauge_ticks)) / APP_TIMER_CLOCK_FREQ;
+    gauge_ticks = ticks;
+    remaining_mah = capacity;
+    CRITICAL_REGION_EXIT();
+}
+
+/* END OF FILE */
@@ -0,0 +1,119 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: ENERGY
+ *
+ *---------------------------------------------------------------
+ * @brief Charge budget of the main subsystems, to compare the
+ * battery runtime of firmware versions
+ *
+ * Active time of the CPU (DWT cycle counter, which stops while
+ * the CPU sleeps), of the radio (SoftDevice radio notifications)
+ * and of the SAADC (reported by the frontend) is turned into an
+ * estimated charge with typical currents. The charge measured by
+ * the fuel gauge over the same period gives what is left for the
+ * analog frontend and the sleep floor.
+ *
+ * Dependencies : app_timer, DWT (Cortex-M4), ble_radio_notification,
+ * fuel_gauge
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef ENERGY_H_
+#define ENERGY_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdint.h>
+
+/*
+ * Public constants
+ */
+
+/* Typical currents, nRF52840 product specification with the LDO regulator (no DC/DC on this board) */
+#ifndef NRG_CPU_CURRENT_UA
+#define NRG_CPU_CURRENT_UA          6300    /**< CPU running from flash at 64 MHz, cache enabled */
+#endif
+#ifndef NRG_RADIO_CURRENT_UA
+#define NRG_RADIO_CURRENT_UA        11000   /**< Radio event at 0 dBm, TX and RX together, HFXO included */
+#endif
+#ifndef NRG_SAADC_CURRENT_UA
+#define NRG_SAADC_CURRENT_UA        1300    /**< SAADC converting, HFCLK and EasyDMA included */
+#endif
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Subsystems whose active time is accounted
+ */
+typedef enum {
+    NRG_SUBSYSTEM_CPU = 0,
+    NRG_SUBSYSTEM_RADIO,
+    NRG_SUBSYSTEM_SAADC,
+    NRG_SUBSYSTEM_NUM
+} nrg_subsystem_t;
+
+/**
+ * @brief Energy accounting since boot or NRG_Reset
+ */
+typedef struct {
+    uint32_t period_ms;                             /**< Accounting period */
+    uint32_t wakeups;                               /**< Main loop wakeups */
+    uint32_t radio_events;                          /**< Radio events (connection, advertising) */
+    uint64_t active_us[NRG_SUBSYSTEM_NUM];          /**< Active time of each subsystem */
+    uint32_t estimated_uah[NRG_SUBSYSTEM_NUM];      /**< Active time at the typical current of each subsystem */
+    int32_t measured_uah;                           /**< Fuel gauge average current integrated, negative while charging */
+    uint16_t remaining_mah;                         /**< Fuel gauge remaining capacity, at last sample */
+} nrg_report_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start accounting, once the SoftDevice and the fuel gauge are initialized
+ */
+void NRG_Init(void);
+
+/**
+ * @brief Restart accounting from now
+ */
+void NRG_Reset(void);
+
+/**
+ * @brief Count a wakeup of the main loop, to be called after nrf_pwr_mgmt_run
+ */
+void NRG_CountWakeup(void);
+
+/**
+ * @brief Add active time of a subsystem that is not measured by the module
+ */
+void NRG_AddActiveTime(nrg_subsystem_t subsystem, uint32_t us);
+
+/**
+ * @brief Return the accounting since boot or NRG_Reset
+ */
+void NRG_GetReport(nrg_report_t * p_report);
+
+/**
+ * @brief Log the accounting, one line per subsystem
+ */
+void NRG_Log(void);
+
+#endif /* ENERGY_H_ */
+
+/* END OF FILE */
@@ -0,0 +1,579 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: FLASH LOG
+ *
+ *---------------------------------------------------------------
+ * @brief Ring of flash pages holding time stamped records
+ *
+ * Page layout: a header (magic, sequence number) followed by
+ * records. Each record is a header followed by the data, padded
+ * to a whole number of words. The record header holds the time of
+ * the record and the data length twice (once inverted) so that
+ * erased or torn flash is not taken for a record. The data is
+ * written first and the header last: a record whose write was cut
+ * has no valid header.
+ *
+ * Pages of the log have consecutive sequence numbers and follow
+ * each other in the ring, the newest one being the head. After a
+ * reset the head is the page with the highest sequence number,
+ * and the log goes back from there as long as sequence numbers
+ * follow. A record torn by a power loss ends its page.
+ *
+ * Only one flash operation is pending at a time: starting a page
+ * takes an erase (if the page was used), a header write and the
+ * two record writes, chained from the fstorage event handler. The
+ * record stays in a RAM buffer until the SoftDevice is done.
+ *
+ * Dependencies : nrf_fstorage (SoftDevice backend)
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <string.h>
+
+/* SDK includes */
+#include "app_error.h"
+#include "app_util.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+
+#define NRF_LOG_MODULE_NAME FLOG
+#define NRF_LOG_INFO_COLOR  3
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/* Project includes */
+#include "flash_log.h"
+
+/*
+ * Local constants
+ */
+
+#define FLOG_BLANK_WORD         0xFFFFFFFFUL
+#define FLOG_PAGE_MAGIC         0x474F4C45UL    /**< "ELOG" */
+#define FLOG_NO_TIME            0xFFFFFFFFUL    /**< Page index entry of a page without records */
+#define FLOG_SEQUENCE_BLANK     0xFFFFFFFFUL    /**< Page index entry of an erased page */
+#define FLOG_SEQUENCE_DIRTY     0xFFFFFFFEUL    /**< Page index entry of a page out of the log, to erase before use */
+
+/*
+ * Local macros
+ */
+
+#define PAGE_START(address)     ((address) & ~(FLOG_PAGE_SIZE - 1UL))
+#define PAGE_ADDRESS(page)      (FLOG_START_ADDR + ((page) * FLOG_PAGE_SIZE))
+#define PAGE_INDEX(address)     (((address) - FLOG_START_ADDR) / FLOG_PAGE_SIZE)
+#define FIRST_RECORD(page)      (PAGE_ADDRESS(page) + sizeof(flog_page_header_t))
+#define RECORD_SIZE(length)     (sizeof(flog_header_t) + (((length) + 3UL) & ~3UL))   /**< Whole words are written */
+
+/*
+ * Local types
+ */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;          /**< Incremented for each page started */
+} flog_page_header_t;
+
+typedef struct {
+    uint32_t time;              /**< POSIX time of the record */
+    uint16_t length;            /**< Data length */
+    uint16_t length_inv;        /**< ~length, to tell a record from erased or torn flash, written last */
+} flog_header_t;
+
+typedef enum {
+    FLOG_STEP_PAGE_ERASE,       /**< Erasing the page the record goes to */
+    FLOG_STEP_PAGE_HEADER,      /**< Writing the header of the page the record goes to */
+    FLOG_STEP_RECORD_DATA,      /**< Writing the record data */
+    FLOG_STEP_RECORD_HEADER,    /**< Writing the record header, the record is valid once done */
+    FLOG_STEP_LOG_ERASE,        /**< Erasing all pages, FLOG_Erase */
+} flog_step_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local variables
+ */
+
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt);
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t flog_fstorage) =
+{
+    .evt_handler = fstorage_evt_handler,
+    .start_addr = FLOG_START_ADDR,
+    .end_addr = FLOG_END_ADDR,
+};
+
+static flog_event_handler_t flog_event_handler;
+static uint32_t first_sequence;                 /**< Oldest page of the log */
+static uint32_t next_sequence;                  /**< Sequence of the next page started, log is empty if equal to first_sequence */
+static uint32_t first_page;                     /**< Index of the oldest page, or of the next page started if the log is empty */
+static uint32_t write_address;                  /**< Where the next record goes in the head page */
+static volatile uint32_t end_address;           /**< End of the records written to the head page, readers stop there */
+static volatile bool busy;                      /**< A write or an erase is pending */
+static flog_step_t step;
+static uint32_t record_address;                 /**< Where the pending record goes */
+static uint32_t record_size;
+static uint32_t record_count;
+static uint32_t dropped;
+static uint32_t overwritten;
+static uint32_t page_sequence[FLOG_PAGE_NUM];
+static uint32_t page_time[FLOG_PAGE_NUM];       /**< Time of the first record of each page */
+static uint16_t page_records[FLOG_PAGE_NUM];
+static flog_page_header_t page_header;          /**< Header of the page being started */
+static uint32_t write_buffer[RECORD_SIZE(FLOG_PAYLOAD_MAX) / sizeof(uint32_t)];
+
+STATIC_ASSERT(sizeof(flog_page_header_t) + (4 * RECORD_SIZE(FLOG_PAYLOAD_MAX)) <= FLOG_PAGE_SIZE);
+STATIC_ASSERT((FLOG_START_ADDR % FLOG_PAGE_SIZE) == 0);
+STATIC_ASSERT((FLOG_END_ADDR % FLOG_PAGE_SIZE) == 0);
+
+/*
+ * Local functions
+ */
+
+static uint32_t page_of(uint32_t sequence);
+static bool page_is_valid(uint32_t sequence);
+static const flog_header_t * record_at(uint32_t address);
+static bool region_is_blank(uint32_t start, uint32_t end);
+static void log_clear(void);
+static ret_code_t step_start(void);
+static void record_failed(void);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Find the pages of the log and build their index
+ */
+void FLOG_Init(flog_event_handler_t event_handler)
+{
+    uint32_t page;
+    uint32_t head = FLOG_PAGE_NUM;
+
+    flog_event_handler = event_handler;
+    APP_ERROR_CHECK(nrf_fstorage_init(&flog_fstorage, &nrf_fstorage_sd, NULL));
+    record_count = 0;
+    dropped = 0;
+    overwritten = 0;
+    busy = false;
+
+    /* Head is the page with the highest sequence number */
+    for (page = 0; page < FLOG_PAGE_NUM; page++) {
+        const flog_page_header_t * header = (const flog_page_header_t *)(uintptr_t)PAGE_ADDRESS(page);
+        page_time[page] = FLOG_NO_TIME;
+        page_records[page] = 0;
+        if ((header->magic == FLOG_PAGE_MAGIC) && (header->sequence < FLOG_SEQUENCE_DIRTY)) {
+            page_sequence[page] = header->sequence;
+            if ((head == FLOG_PAGE_NUM) || (header->sequence > page_sequence[head])) {
+                head = page;
+            }
+        }
+        else if (region_is_blank(PAGE_ADDRESS(page), PAGE_ADDRESS(page) + FLOG_PAGE_SIZE)) {
+            page_sequence[page] = FLOG_SEQUENCE_BLANK;
+        }
+        else {
+            page_sequence[page] = FLOG_SEQUENCE_DIRTY;
+        }
+    }
+
+    if (head == FLOG_PAGE_NUM) {
+        first_page = 0;
+        first_sequence = 0;
+        next_sequence = 0;
+        NRF_LOG_INFO("Empty log");
+        return;
+    }
+
+    /* Log goes back from the head as long as sequence numbers follow */
+    next_sequence = page_sequence[head] + 1;
+    first_sequence = page_sequence[head];
+    first_page = head;
+    for (uint32_t n = 1; n < FLOG_PAGE_NUM; n++) {
+        page = (head + FLOG_PAGE_NUM - n) % FLOG_PAGE_NUM;
+        if ((first_sequence == 0) || (page_sequence[page] != first_sequence - 1)) {
+            break;
+        }
+        first_sequence--;
+        first_page = page;
+    }
+    for (page = 0; page < FLOG_PAGE_NUM; page++) {
+        if ((page_sequence[page] < FLOG_SEQUENCE_DIRTY) && (page_is_valid(page_sequence[page]) == false)) {
+            page_sequence[page] = FLOG_SEQUENCE_DIRTY;
+        }
+    }
+
+    /* Index records of the log pages, the end of the head page must be erased or writes would fail */
+    for (uint32_t sequence = first_sequence; sequence != next_sequence; sequence++) {
+        page = page_of(sequence);
+        uint32_t address = FIRST_RECORD(page);
+        const flog_header_t * header = record_at(address);
+        if (header != NULL) {
+            page_time[page] = header->time;
+        }
+        while (header != NULL) {
+            page_records[page]++;
+            address += RECORD_SIZE(header->length);
+            header = record_at(address);
+        }
+        record_count += page_records[page];
+        write_address = address;
+    }
+    if (region_is_blank(write_address, PAGE_ADDRESS(head) + FLOG_PAGE_SIZE) == false) {
+        NRF_LOG_WARNING("Torn record, head page closed");
+        write_address = PAGE_ADDRESS(head) + FLOG_PAGE_SIZE;
+    }
+    end_address = write_address;
+    NRF_LOG_INFO("%u records in %u pages", record_count, next_sequence - first_sequence);
+}
+
+/**
+ * @brief Start writing a record at the end of the log
+ */
+bool FLOG_Append(uint32_t time, const uint8_t * data, uint16_t length)
+{
+    flog_header_t * header = (flog_header_t *)write_buffer;
+    uint32_t size = RECORD_SIZE(length);
+    uint32_t page;
+
+    if (busy || (length == 0) || (length > FLOG_PAYLOAD_MAX)) {
+        dropped++;
+        return false;
+    }
+    header->length = length;
+    header->length_inv = (uint16_t)~length;
+    header->time = time;
+    memcpy((uint8_t *)write_buffer + sizeof(flog_header_t), data, length);
+    memset((uint8_t *)write_buffer + sizeof(flog_header_t) + length, 0xFF, size - sizeof(flog_header_t) - length);
+
+    if ((next_sequence != first_sequence) && ((write_address - PAGE_START(write_address - 1)) + size <= FLOG_PAGE_SIZE)) {
+        page = PAGE_INDEX(write_address - 1);
+        record_address = write_address;
+        step = FLOG_STEP_RECORD_DATA;
+    }
+    else {
+        /* Records do not span pages, start the next one in the ring */
+        page = (next_sequence == first_sequence) ? first_page : (page_of(next_sequence - 1) + 1) % FLOG_PAGE_NUM;
+        if (next_sequence - first_sequence == FLOG_PAGE_NUM) {
+            /* Log is full, oldest page goes */
+            overwritten += page_records[page];
+            record_count -= page_records[page];
+            first_sequence++;
+            first_page = (first_page + 1) % FLOG_PAGE_NUM;
+        }
+        step = (page_sequence[page] == FLOG_SEQUENCE_BLANK) ? FLOG_STEP_PAGE_HEADER : FLOG_STEP_PAGE_ERASE;
+        page_sequence[page] = next_sequence;
+        page_time[page] = time;
+        page_records[page] = 0;
+        page_header.magic = FLOG_PAGE_MAGIC;
+        page_header.sequence = next_sequence;
+        next_sequence++;
+        record_address = FIRST_RECORD(page);
+        end_address = record_address;
+    }
+    record_size = size;
+    write_address = record_address + size;
+    page_records[page]++;
+    record_count++;
+
+    busy = true;
+    ret_code_t err_code = step_start();
+    if (err_code != NRF_SUCCESS) {
+        NRF_LOG_ERROR("Record write failed: %u", err_code);
+        record_failed();
+        busy = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Start erasing the log
+ */
+bool FLOG_Erase(void)
+{
+    uint32_t first = FLOG_PAGE_NUM;
+    uint32_t last = 0;
+
+    if (busy) {
+        return false;
+    }
+    for (uint32_t page = 0; page < FLOG_PAGE_NUM; page++) {
+        if (page_sequence[page] != FLOG_SEQUENCE_BLANK) {
+            first = (first == FLOG_PAGE_NUM) ? page : first;
+            last = page;
+        }
+    }
+
+    /* Readers stop at once, pages are erased before use even if this erase fails */
+    log_clear();
+    if (first == FLOG_PAGE_NUM) {
+        if (flog_event_handler != NULL) {
+            flog_event_handler(FLOG_EVENT_ERASED);
+        }
+        return true;
+    }
+    for (uint32_t page = first; page <= last; page++) {
+        page_sequence[page] = FLOG_SEQUENCE_DIRTY;
+    }
+    record_address = PAGE_ADDRESS(first);
+    record_size = (last - first + 1) * FLOG_PAGE_SIZE;
+    step = FLOG_STEP_LOG_ERASE;
+
+    busy = true;
+    ret_code_t err_code = step_start();
+    if (err_code != NRF_SUCCESS) {
+        NRF_LOG_ERROR("Log erase failed: %u", err_code);
+        busy = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Return flash log counters
+ */
+void FLOG_GetStatus(flog_status_t * p_status)
+{
+    p_status->record_count = record_count;
+    p_status->used = (next_sequence - first_sequence) * FLOG_PAGE_SIZE;
+    if (p_status->used > 0) {
+        /* Unused end of the head page */
+        p_status->used -= PAGE_ADDRESS(page_of(next_sequence - 1)) + FLOG_PAGE_SIZE - write_address;
+    }
+    p_status->size = FLOG_END_ADDR - FLOG_START_ADDR;
+    p_status->dropped = dropped;
+    p_status->overwritten = overwritten;
+}
+
+/**
+ * @brief Position a reader on the first record recorded at or after since
+ */
+void FLOG_ReadBegin(flog_reader_t * reader, uint32_t since)
+{
+    reader->sequence = first_sequence;
+
+    /* Last page starting before since, the records before since are skipped by FLOG_Read */
+    for (uint32_t sequence = first_sequence; sequence != next_sequence; sequence++) {
+        uint32_t time = page_time[page_of(sequence)];
+        if ((time != FLOG_NO_TIME) && (time <= since)) {
+            reader->sequence = sequence;
+        }
+    }
+    reader->address = FIRST_RECORD(page_of(reader->sequence));
+    reader->next = reader->address;
+    reader->since = since;
+}
+
+/**
+ * @brief Return the record at the reader position, without moving it
+ */
+bool FLOG_Read(flog_reader_t * reader, const uint8_t ** data, uint16_t * length)
+{
+    for (;;) {
+        if (page_is_valid(reader->sequence) == false) {
+            if ((int32_t)(reader->sequence - first_sequence) >= 0) {
+                return false;
+            }
+            /* Page was overwritten while being read, go on from the oldest one */
+            reader->sequence = first_sequence;
+            reader->address = FIRST_RECORD(page_of(first_sequence));
+            continue;
+        }
+        const flog_page_header_t * header_page = (const flog_page_header_t *)(uintptr_t)PAGE_ADDRESS(page_of(reader->sequence));
+        const flog_header_t * header = NULL;
+        bool is_head = (reader->sequence == next_sequence - 1);
+
+        if ((is_head == false) || (reader->address < end_address)) {
+            /* Page whose erase or header write failed is skipped */
+            if ((header_page->magic == FLOG_PAGE_MAGIC) && (header_page->sequence == reader->sequence)) {
+                header = record_at(reader->address);
+            }
+        }
+        if (header == NULL) {
+            /* End of page, or a record whose write failed */
+            if (is_head) {
+                return false;
+            }
+            reader->sequence++;
+            reader->address = FIRST_RECORD(page_of(reader->sequence));
+            continue;
+        }
+        if (header->time < reader->since) {
+            reader->address += RECORD_SIZE(header->length);
+            continue;
+        }
+        *data = (const uint8_t *)header + sizeof(flog_header_t);
+        *length = header->length;
+        reader->next = reader->address + RECORD_SIZE(header->length);
+        return true;
+    }
+}
+
+/**
+ * @brief Move the reader to the record following the one FLOG_Read returned
+ */
+void FLOG_ReadNext(flog_reader_t * reader)
+{
+    reader->address = reader->next;
+}
+
+/*
+ * Local functions
+ */
+
+static uint32_t page_of(uint32_t sequence)
+{
+    return (first_page + (sequence - first_sequence)) % FLOG_PAGE_NUM;
+}
+
+/**
+ * @brief Tell if a page sequence number belongs to the log
+ */
+static bool page_is_valid(uint32_t sequence)
+{
+    return (sequence - first_sequence) < (next_sequence - first_sequence);
+}
+
+/**
+ * @brief Return the header of the record at address, or NULL if there is none
+ */
+static const flog_header_t * record_at(uint32_t address)
+{
+    const flog_header_t * header = (const flog_header_t *)(uintptr_t)address;
+
+    if ((address - PAGE_START(address)) + sizeof(flog_header_t) > FLOG_PAGE_SIZE) {
+        return NULL;
+    }
+    if (((uint16_t)(header->length ^ header->length_inv) != 0xFFFF) ||
+        ((address - PAGE_START(address)) + RECORD_SIZE(header->length) > FLOG_PAGE_SIZE)) {
+        return NULL;
+    }
+    return header;
+}
+
+static bool region_is_blank(uint32_t start, uint32_t end)
+{
+    const uint32_t * word;
+
+    for (word = (const uint32_t *)(uintptr_t)start; word < (const uint32_t *)(uintptr_t)end; word++) {
+        if (*word != FLOG_BLANK_WORD) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Empty the log, the next page started follows the head so that
+ * pages keep being used in turn
+ */
+static void log_clear(void)
+{
+    if (next_sequence != first_sequence) {
+        first_page = (page_of(next_sequence - 1) + 1) % FLOG_PAGE_NUM;
+    }
+    first_sequence = next_sequence;
+    end_address = FLOG_START_ADDR;
+    record_count = 0;
+    dropped = 0;
+    overwritten = 0;
+    memset(page_time, 0xFF, sizeof(page_time));
+    memset(page_records, 0, sizeof(page_records));
+}
+
+static ret_code_t step_start(void)
+{
+    switch (step)
+    {
+        case FLOG_STEP_PAGE_ERASE:
+            return nrf_fstorage_erase(&flog_fstorage, PAGE_START(record_address), 1, NULL);
+
+        case FLOG_STEP_PAGE_HEADER:
+            return nrf_fstorage_write(&flog_fstorage, PAGE_START(record_address), &page_header, sizeof(page_header), NULL);
+
+        case FLOG_STEP_RECORD_DATA:
+            return nrf_fstorage_write(&flog_fstorage, record_address + sizeof(flog_header_t), &write_buffer[sizeof(flog_header_t) / sizeof(uint32_t)],
+                                      record_size - sizeof(flog_header_t), NULL);
+
+        case FLOG_STEP_RECORD_HEADER:
+            return nrf_fstorage_write(&flog_fstorage, record_address, write_buffer, sizeof(flog_header_t), NULL);
+
+        case FLOG_STEP_LOG_ERASE:
+        default:
+            return nrf_fstorage_erase(&flog_fstorage, record_address, record_size / FLOG_PAGE_SIZE, NULL);
+    }
+}
+
+/**
+ * @brief Forget the pending record, the rest of its page is skipped
+ */
+static void record_failed(void)
+{
+    uint32_t page = PAGE_INDEX(record_address);
+
+    if (page_is_valid(page_sequence[page])) {
+        page_records[page]--;
+        record_count--;
+    }
+    dropped++;
+    write_address = PAGE_START(record_address) + FLOG_PAGE_SIZE;
+}
+
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    if ((p_evt->id != NRF_FSTORAGE_EVT_WRITE_RESULT) && (p_evt->id != NRF_FSTORAGE_EVT_ERASE_RESULT)) {
+        return;
+    }
+
+    if (step == FLOG_STEP_LOG_ERASE) {
+        if (p_evt->result != NRF_SUCCESS) {
+            /* Pages stay marked, they are erased before use */
+            NRF_LOG_ERROR("Log erase failed: %u", p_evt->result);
+        }
+        else {
+            memset(page_sequence, 0xFF, sizeof(page_sequence));
+        }
+        busy = false;
+        if (flog_event_handler != NULL) {
+            flog_event_handler(FLOG_EVENT_ERASED);
+        }
+        return;
+    }
+
+    if (p_evt->result != NRF_SUCCESS) {
+        /* Part of the record may be written */
+        NRF_LOG_ERROR("Record write failed: %u", p_evt->result);
+        record_failed();
+        busy = false;
+        return;
+    }
+    if (step == FLOG_STEP_RECORD_HEADER) {
+        end_address = record_address + record_size;
+        busy = false;
+        return;
+    }
+
+    /* Page or record data is ready for the next step */
+    step = (step == FLOG_STEP_PAGE_ERASE) ? FLOG_STEP_PAGE_HEADER :
+           (step == FLOG_STEP_PAGE_HEADER) ? FLOG_STEP_RECORD_DATA : FLOG_STEP_RECORD_HEADER;
+    ret_code_t err_code = step_start();
+    if (err_code != NRF_SUCCESS) {
+        NRF_LOG_ERROR("Record write failed: %u", err_code);
+        record_failed();
+        busy = false;
+    }
+}
+
+/* END OF FILE */
@@ -0,0 +1,148 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: FLASH LOG
+ *
+ *---------------------------------------------------------------
+ * @brief Ring of flash pages holding time stamped records
+ *
+ * Records are written in a flash region reserved after the
+ * application (see linker script), up to the flash data storage
+ * pages FDS places below the bootloader. The bootloader keeps the
+ * whole region as application data (NRF_DFU_APP_DATA_AREA_SIZE),
+ * so a firmware update does not erase the log. Pages are used in turn and,
+ * once all of them hold records, the oldest one is erased to make
+ * room: each page is erased as often as the others.
+ *
+ * Each page starts with a header holding its sequence number, so
+ * that the order of the pages, and the end of the log, are found
+ * again after a reset or a power loss. A record never spans two
+ * pages, and the time of the first record of each page is kept
+ * in RAM to find where reading must start from.
+ *
+ * Dependencies : nrf_fstorage (SoftDevice backend)
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef FLASH_LOG_H_
+#define FLASH_LOG_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Public constants
+ */
+
+#define FLOG_START_ADDR     0x80000                                         /**< First page of the log, the application must end before */
+#define FLOG_BOOTLOADER_ADDR 0xF8000                                        /**< Secure bootloader start, see nrf52-bootloader linker script */
+#define FLOG_FDS_SIZE       (3 * 4096)                                      /**< Flash data storage pages (FDS_VIRTUAL_PAGES), below the bootloader */
+#define FLOG_END_ADDR       (FLOG_BOOTLOADER_ADDR - FLOG_FDS_SIZE)          /**< Same end whether the bootloader is installed or not */
+#define FLOG_PAGE_SIZE      4096
+#define FLOG_PAGE_NUM       ((FLOG_END_ADDR - FLOG_START_ADDR) / FLOG_PAGE_SIZE)
+#define FLOG_PAYLOAD_MAX    1012                                            /**< Largest record, four of them fill a page */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Enumeration of events sent to flog_event_handler
+ */
+typedef enum {
+    FLOG_EVENT_ERASED = 0,
+    FLOG_MAX_EVENT_NUM
+} flog_event_t;
+
+/**
+ * @brief Callback format for flash log events, called from interrupt
+ */
+typedef void (*flog_event_handler_t)(flog_event_t flog_event);
+
+/**
+ * @brief Flash log counters
+ */
+typedef struct {
+    uint32_t record_count;      /**< Records in the log */
+    uint32_t used;              /**< Bytes of flash used, headers and unused page ends included */
+    uint32_t size;              /**< Bytes of flash reserved for the log */
+    uint32_t dropped;           /**< Records not written since last erase: flash busy or error */
+    uint32_t overwritten;       /**< Records erased to make room since last erase */
+} flog_status_t;
+
+/**
+ * @brief Position of a reader in the log
+ */
+typedef struct {
+    uint32_t sequence;          /**< Page being read */
+    uint32_t address;           /**< Record to read */
+    uint32_t next;              /**< Record following the one returned by FLOG_Read */
+    uint32_t since;             /**< Records older than this time are skipped */
+} flog_reader_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Find the pages of the log and build their index. Must be called
+ * once the SoftDevice is enabled.
+ */
+void FLOG_Init(flog_event_handler_t event_handler);
+
+/**
+ * @brief Start writing a record at the end of the log, erasing the oldest
+ * page first if needed
+ * @param[in] time is the POSIX time of the record, used by FLOG_ReadBegin
+ * @param[in] data is copied, 1 to FLOG_PAYLOAD_MAX bytes
+ * @return false if the record is dropped (previous write or erase pending, or bad length)
+ */
+bool FLOG_Append(uint32_t time, const uint8_t * data, uint16_t length);
+
+/**
+ * @brief Start erasing the log, FLOG_EVENT_ERASED is sent once done
+ * @return false if a write or an erase is pending
+ */
+bool FLOG_Erase(void);
+
+/**
+ * @brief Return flash log counters
+ */
+void FLOG_GetStatus(flog_status_t * p_status);
+
+/**
+ * @brief Position a reader on the first record recorded at or after since
+ * (records are assumed to be appended in time order)
+ */
+void FLOG_ReadBegin(flog_reader_t * reader, uint32_t since);
+
+/**
+ * @brief Return the record at the reader position, without moving it
+ * @param[out] data points to the record in flash, valid until the next FLOG_Append
+ * @param[out] length is the record length
+ * @return false at the end of the log
+ */
+bool FLOG_Read(flog_reader_t * reader, const uint8_t ** data, uint16_t * length);
+
+/**
+ * @brief Move the reader to the record following the one FLOG_Read returned
+ */
+void FLOG_ReadNext(flog_reader_t * reader);
+
+#endif /* FLASH_LOG_H_ */
+
+/* END OF FILE */
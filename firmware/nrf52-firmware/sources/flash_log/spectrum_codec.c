@@ -0,0 +1,323 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: SPECTRUM CODEC
+ *
+ *---------------------------------------------------------------
+ * @brief Compact encoding of consecutive impedance spectra
+ *
+ * Record layout, all integers being varints:
+ *   - time of the first spectrum (us since the epoch)
+ *   - zigzag quantization exponent
+ *   - number of values per spectrum (2 per frequency)
+ *   - then for each spectrum:
+ *       - zigzag change of the interval to the previous spectrum
+ *       - value tokens: (zigzag(difference) << 1) for a value,
+ *         ((run - 1) << 1) | 1 for a run of unchanged values.
+ *         The first spectrum is the difference to zero.
+ *
+ * Dependencies : nanopb (Impedance type only)
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <math.h>
+#include <string.h>
+
+/* Project includes */
+#include "spectrum_codec.h"
+
+/*
+ * Local constants
+ */
+
+#define VALUE_LIMIT             (1L << 29)      /**< Quantized values stay below, so that differences fit in 31 bits and tokens in 32 */
+#define TOKEN_RUN               0x01
+
+/*
+ * Local macros
+ */
+
+#define ZIGZAG(v)               (((uint32_t)(v) << 1) ^ (uint32_t)((v) >> 31))
+#define UNZIGZAG(u)             ((int32_t)((u) >> 1) ^ -(int32_t)((u) & 1))
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local variables
+ */
+
+/*
+ * Local functions
+ */
+
+static void varint_write(scodec_encoder_t * encoder, uint64_t value);
+static bool varint_read(scodec_decoder_t * decoder, uint64_t * value);
+static bool quantize(float value, int8_t exponent, int32_t * p_quantized);
+static int8_t exponent_choose(const Impedance * data, uint16_t count);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start an empty record
+ */
+void SCODEC_EncodeBegin(scodec_encoder_t * encoder, uint8_t * buffer, uint16_t size)
+{
+    encoder->buffer = buffer;
+    encoder->size = size;
+    encoder->length = 0;
+    encoder->spectrum_count = 0;
+    encoder->value_num = 0;
+    encoder->exponent = 0;
+    encoder->last_time_us = 0;
+    encoder->last_interval_us = 0;
+    memset(encoder->last_value, 0, sizeof(encoder->last_value));
+}
+
+/**
+ * @brief Add a spectrum to the record
+ */
+bool SCODEC_EncodeSpectrum(scodec_encoder_t * encoder, uint64_t time_us, const Impedance * data, uint16_t count)
+{
+    uint16_t value_num = 2 * count;
+    uint16_t run = 0;
+    int64_t interval = 0;
+    int64_t interval_delta = 0;
+    int8_t exponent = encoder->exponent;
+    int32_t quantized[SCODEC_VALUE_MAX];
+
+    if (value_num > SCODEC_VALUE_MAX) {
+        value_num = SCODEC_VALUE_MAX;
+    }
+
+    if (encoder->length == 0) {
+        exponent = exponent_choose(data, value_num / 2);
+    }
+    else {
+        interval = (int64_t)(time_us - encoder->last_time_us);
+        interval_delta = interval - encoder->last_interval_us;
+        /* Calendar was set, or spectra were missed for half an hour: time cannot follow */
+        if ((value_num != encoder->value_num) ||
+            (interval < INT32_MIN) || (interval > INT32_MAX) ||
+            (interval_delta < INT32_MIN) || (interval_delta > INT32_MAX) ||
+            ((uint32_t)(encoder->size - encoder->length) < SCODEC_SPECTRUM_MAX(value_num / 2))) {
+            return false;
+        }
+    }
+
+    /* A value too large for the step of the record needs a record of its own, the first spectrum always fits */
+    for (uint16_t n = 0; n < value_num; n++) {
+        const float value = (n & 1) ? data[n / 2].imag : data[n / 2].real;
+        if (quantize(value, exponent, &quantized[n]) == false) {
+            return false;
+        }
+    }
+
+    if (encoder->length == 0) {
+        encoder->exponent = exponent;
+        encoder->value_num = value_num;
+        encoder->last_time_us = time_us;
+        varint_write(encoder, time_us);
+        varint_write(encoder, ZIGZAG((int32_t)encoder->exponent));
+        varint_write(encoder, value_num);
+    }
+    else {
+        encoder->last_interval_us = (int32_t)interval;
+        encoder->last_time_us = time_us;
+    }
+    varint_write(encoder, ZIGZAG((int32_t)interval_delta));
+
+    for (uint16_t n = 0; n < value_num; n++) {
+        int32_t difference = quantized[n] - encoder->last_value[n];
+        encoder->last_value[n] = quantized[n];
+        if (difference == 0) {
+            run++;
+            continue;
+        }
+        if (run > 0) {
+            varint_write(encoder, ((uint32_t)(run - 1) << 1) | TOKEN_RUN);
+            run = 0;
+        }
+        varint_write(encoder, ZIGZAG(difference) << 1);
+    }
+    if (run > 0) {
+        varint_write(encoder, ((uint32_t)(run - 1) << 1) | TOKEN_RUN);
+    }
+    encoder->spectrum_count++;
+    return true;
+}
+
+/**
+ * @brief Start decoding a record
+ */
+bool SCODEC_DecodeBegin(scodec_decoder_t * decoder, const uint8_t * data, uint16_t length)
+{
+    uint64_t time_us;
+    uint64_t exponent;
+    uint64_t value_num;
+
+    memset(decoder, 0, sizeof(scodec_decoder_t));
+    decoder->data = data;
+    decoder->length = length;
+
+    if ((varint_read(decoder, &time_us) == false) ||
+        (varint_read(decoder, &exponent) == false) ||
+        (varint_read(decoder, &value_num) == false)) {
+        return false;
+    }
+    if ((exponent > UINT8_MAX) || (value_num == 0) || (value_num > SCODEC_VALUE_MAX) || (value_num & 1)) {
+        return false;
+    }
+    decoder->exponent = (int8_t)UNZIGZAG((uint32_t)exponent);
+    decoder->value_num = (uint16_t)value_num;
+    decoder->last_time_us = time_us;
+    return true;
+}
+
+/**
+ * @brief Decode the next spectrum of the record
+ */
+bool SCODEC_DecodeSpectrum(scodec_decoder_t * decoder, uint64_t * time_us, Impedance * data, uint16_t max_count, uint16_t * count)
+{
+    uint64_t token;
+    uint16_t n = 0;
+
+    if (decoder->offset >= decoder->length) {
+        return false;
+    }
+    if ((varint_read(decoder, &token) == false) || (token > UINT32_MAX)) {
+        return false;
+    }
+    /* Wrapping rather than overflowing on corrupted records */
+    decoder->last_interval_us = (int32_t)((uint32_t)decoder->last_interval_us + (uint32_t)UNZIGZAG((uint32_t)token));
+    decoder->last_time_us += (int64_t)decoder->last_interval_us;
+
+    while (n < decoder->value_num) {
+        if ((varint_read(decoder, &token) == false) || (token > UINT32_MAX)) {
+            return false;
+        }
+        if (token & TOKEN_RUN) {
+            uint32_t run = (uint32_t)(token >> 1) + 1;
+            if (run > (uint32_t)(decoder->value_num - n)) {
+                return false;
+            }
+            n += run;
+        }
+        else {
+            decoder->last_value[n] = (int32_t)((uint32_t)decoder->last_value[n] + (uint32_t)UNZIGZAG((uint32_t)(token >> 1)));
+            n++;
+        }
+    }
+
+    *time_us = decoder->last_time_us;
+    *count = decoder->value_num / 2;
+    if (*count > max_count) {
+        *count = max_count;
+    }
+    for (n = 0; n < *count; n++) {
+        data[n].real = ldexpf((float)decoder->last_value[2 * n], decoder->exponent);
+        data[n].imag = ldexpf((float)decoder->last_value[2 * n + 1], decoder->exponent);
+    }
+    return true;
+}
+
+/*
+ * Local functions
+ */
+
+/* Callers check there is room for the worst case */
+static void varint_write(scodec_encoder_t * encoder, uint64_t value)
+{
+    while (value >= 0x80) {
+        encoder->buffer[encoder->length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    encoder->buffer[encoder->length++] = (uint8_t)value;
+}
+
+static bool varint_read(scodec_decoder_t * decoder, uint64_t * value)
+{
+    uint8_t shift = 0;
+
+    *value = 0;
+    while (decoder->offset < decoder->length) {
+        uint8_t byte = decoder->data[decoder->offset++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+        shift += 7;
+        if (shift >= 64) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Quantize a value with a step of 2^exponent
+ * @return false if it is VALUE_LIMIT steps or more. Non finite values have no
+ * encoding: NaN is stored as 0 and infinities as the largest value.
+ */
+static bool quantize(float value, int8_t exponent, int32_t * p_quantized)
+{
+    float scaled = ldexpf(value, -exponent);
+
+    if (isnan(value)) {
+        *p_quantized = 0;
+    }
+    else if (isinf(value)) {
+        *p_quantized = (value > 0.0f) ? (VALUE_LIMIT - 1) : -(VALUE_LIMIT - 1);
+    }
+    else if (fabsf(scaled) >= (float)VALUE_LIMIT) {
+        return false;
+    }
+    else {
+        *p_quantized = (int32_t)lrintf(scaled);
+    }
+    return true;
+}
+
+/**
+ * @brief Quantization step giving SCODEC_PRECISION_BITS to the largest value
+ */
+static int8_t exponent_choose(const Impedance * data, uint16_t count)
+{
+    float largest = 0.0f;
+    int exponent;
+
+    for (uint16_t n = 0; n < count; n++) {
+        float real = fabsf(data[n].real);
+        float imag = fabsf(data[n].imag);
+        if (isfinite(real) && (real > largest)) {
+            largest = real;
+        }
+        if (isfinite(imag) && (imag > largest)) {
+            largest = imag;
+        }
+    }
+    if (largest == 0.0f) {
+        return 0;
+    }
+    frexpf(largest, &exponent);
+    exponent -= SCODEC_PRECISION_BITS;
+    if (exponent < INT8_MIN) {
+        exponent = INT8_MIN;
+    }
+    return (int8_t)exponent;
+}
+
+/* END OF FILE */
@@ -0,0 +1,128 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: SPECTRUM CODEC
+ *
+ *---------------------------------------------------------------
+ * @brief Compact encoding of consecutive impedance spectra
+ *
+ * Spectra change slowly from one frame to the next: a record holds
+ * the first spectrum and then the difference of each spectrum to
+ * the previous one, quantized with a step chosen from the first
+ * spectrum, zigzag and varint encoded, runs of unchanged values
+ * being replaced by their length. Spectrum times are stored as
+ * the change of the interval between spectra.
+ *
+ * Records are independent from each other, so that a lost one
+ * does not prevent decoding the next.
+ *
+ * Dependencies : nanopb (Impedance type only)
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef SPECTRUM_CODEC_H_
+#define SPECTRUM_CODEC_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Protobuf includes */
+#include "nanopb/pb.h"
+#include "protocol.pb.h"
+
+/*
+ * Public constants
+ */
+
+#define SCODEC_PRECISION_BITS   12                                          /**< Largest value of the first spectrum of a record is 2^12 steps, as precise as a half float */
+#define SCODEC_VALUE_MAX        (2 * pb_arraysize(EdaSpectrum, data))       /**< Real and imaginary parts of each frequency */
+#define SCODEC_HEADER_MAX       (10 + 5 + 5)                                /**< Time, exponent and value count varints */
+
+/*
+ * Public macros
+ */
+
+#define SCODEC_SPECTRUM_MAX(count)  (5 + (5 * 2 * (count)))                 /**< Worst case encoded size of a spectrum of count frequencies */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Record encoder state
+ */
+typedef struct {
+    uint8_t * buffer;                           /**< Record being encoded */
+    uint16_t size;                              /**< Bytes available in buffer */
+    uint16_t length;                            /**< Bytes of buffer used, 0 until the first spectrum */
+    uint16_t spectrum_count;                    /**< Spectra in the record */
+    uint16_t value_num;                         /**< Values per spectrum, from the first spectrum */
+    int8_t exponent;                            /**< Quantization step is 2^exponent */
+    uint64_t last_time_us;
+    int32_t last_interval_us;
+    int32_t last_value[SCODEC_VALUE_MAX];       /**< Quantized values of the previous spectrum */
+} scodec_encoder_t;
+
+/**
+ * @brief Record decoder state
+ */
+typedef struct {
+    const uint8_t * data;                       /**< Record being decoded */
+    uint16_t length;
+    uint16_t offset;                            /**< Next byte to decode */
+    uint16_t value_num;
+    int8_t exponent;
+    uint64_t last_time_us;
+    int32_t last_interval_us;
+    int32_t last_value[SCODEC_VALUE_MAX];
+} scodec_decoder_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start an empty record
+ * @param[in] buffer holds the record, size must be at least SCODEC_HEADER_MAX + SCODEC_SPECTRUM_MAX
+ */
+void SCODEC_EncodeBegin(scodec_encoder_t * encoder, uint8_t * buffer, uint16_t size);
+
+/**
+ * @brief Add a spectrum to the record
+ * @param[in] time_us is the time of the spectrum, in microseconds since the epoch
+ * @param[in] data holds count impedances, count must not change within a record
+ * @return false if the spectrum does not fit in the record (no room left, time
+ * or count change, or a value too large for the quantization step of the
+ * record), which must then be stored and a new one started. The first
+ * spectrum of a record always fits.
+ */
+bool SCODEC_EncodeSpectrum(scodec_encoder_t * encoder, uint64_t time_us, const Impedance * data, uint16_t count);
+
+/**
+ * @brief Start decoding a record
+ * @return false if the record header is not valid
+ */
+bool SCODEC_DecodeBegin(scodec_decoder_t * decoder, const uint8_t * data, uint16_t length);
+
+/**
+ * @brief Decode the next spectrum of the record
+ * @param[out] time_us is the time of the spectrum, in microseconds since the epoch
+ * @param[out] data receives the impedances, max_count at most
+ * @param[out] count is the number of impedances decoded
+ * @return false at the end of the record, or if it is corrupted
+ */
+bool SCODEC_DecodeSpectrum(scodec_decoder_t * decoder, uint64_t * time_us, Impedance * data, uint16_t max_count, uint16_t * count);
+
+#endif /* SPECTRUM_CODEC_H_ */
+
+/* END OF FILE */
@@ -0,0 +1,325 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: FRAME
+ *
+ *---------------------------------------------------------------
+ * @brief Streaming COBS framing of protobuf messages
+ *
+ * The output is the same as nanocobs cobs_encode followed by the
+ * frame delimiter. cobs_encode_inc cannot be used here as it goes
+ * back to write each code byte in the output buffer: blocks are
+ * instead built in a 255 bytes buffer and only sent once their
+ * code byte is known.
+ *
+ * Dependencies : nanopb
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <string.h>
+
+/* Project includes */
+#include "frame.h"
+#include "latency/latency.h"
+
+/*
+ * Local constants
+ */
+
+#define FRAME_DELIMITER     0x00
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local variables
+ */
+
+/*
+ * Local functions
+ */
+
+static bool packet_write(frame_stream_t * stream, const uint8_t * data, uint16_t length);
+static bool packet_flush(frame_stream_t * stream);
+static bool block_flush(frame_stream_t * stream);
+static bool ostream_callback(pb_ostream_t * ostream, const pb_byte_t * buf, size_t count);
+static void rx_frame_reset(frame_rx_t * rx);
+static void rx_byte_add(frame_rx_t * rx, uint8_t byte);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start a new frame
+ */
+void FRAME_Begin(frame_stream_t * stream, frame_sink_t sink, uint8_t * packet, uint16_t packet_size)
+{
+    bool truncated = stream->error;
+
+    stream->sink = sink;
+    stream->packet = packet;
+    stream->packet_size = packet_size;
+    stream->packet_length = 0;
+    stream->block_length = 1;
+    stream->block_full = false;
+    stream->error = false;
+    stream->bytes_sent = 0;
+    stream->cobs_cycles = 0;
+    stream->sink_cycles = 0;
+    stream->sink_ticks = 0;
+
+    if (truncated) {
+        stream->packet[stream->packet_length++] = FRAME_DELIMITER;
+    }
+}
+
+/**
+ * @brief Encode bytes in the current frame
+ */
+bool FRAME_Write(frame_stream_t * stream, const uint8_t * data, size_t length)
+{
+    uint32_t cycles_from = LAT_GetCycles();
+    bool ret = true;
+    size_t n;
+
+    if (stream->error) {
+        return false;
+    }
+
+    for (n = 0; (n < length) && ret; n++) {
+        if (data[n] != 0) {
+            stream->block[stream->block_length++] = data[n];
+            if (stream->block_length == FRAME_BLOCK_SIZE) {
+                ret = block_flush(stream);
+                stream->block_full = true;
+            }
+        }
+        else {
+            ret = block_flush(stream);
+            stream->block_full = false;
+        }
+    }
+    stream->cobs_cycles += LAT_GetCycles() - cycles_from;
+    return ret;
+}
+
+/**
+ * @brief Terminate the current frame and send the last packet
+ */
+bool FRAME_End(frame_stream_t * stream)
+{
+    const uint8_t delimiter = FRAME_DELIMITER;
+    uint32_t cycles_from = LAT_GetCycles();
+    bool ret = true;
+
+    if (stream->error) {
+        return false;
+    }
+    /* A full block at the end of the frame is not followed by an empty one */
+    if ((stream->block_length > 1) || (stream->block_full == false)) {
+        ret = block_flush(stream);
+    }
+    ret = ret && packet_write(stream, &delimiter, 1);
+    ret = ret && packet_flush(stream);
+    stream->cobs_cycles += LAT_GetCycles() - cycles_from;
+    return ret;
+}
+
+/**
+ * @brief Return a nanopb output stream writing to the current frame
+ */
+pb_ostream_t FRAME_GetOstream(frame_stream_t * stream)
+{
+    pb_ostream_t ostream = {
+        .callback = ostream_callback,
+        .state = stream,
+        .max_size = SIZE_MAX,
+        .bytes_written = 0,
+    };
+    return ostream;
+}
+
+/**
+ * @brief Serialize a protobuf message as a complete frame
+ */
+bool FRAME_SendMessage(frame_stream_t * stream, frame_sink_t sink, uint8_t * packet, uint16_t packet_size,
+                       const pb_msgdesc_t * fields, const void * message)
+{
+    uint32_t cycles_from = LAT_GetCycles();
+
+    FRAME_Begin(stream, sink, packet, packet_size);
+    pb_ostream_t ostream = FRAME_GetOstream(stream);
+    if (pb_encode(&ostream, fields, message) == false) {
+        /* Whatever was sent already must be dropped by the receiver */
+        stream->error = true;
+        return false;
+    }
+    if (FRAME_End(stream) == false) {
+        return false;
+    }
+
+    /* Sink may wait for room in the TX queue, timed apart with the RTC */
+    cycles_from = LAT_GetCycles() - cycles_from;
+    LAT_Record(LAT_STAGE_ENCODE, LAT_CyclesToUs(cycles_from - stream->cobs_cycles));
+    LAT_Record(LAT_STAGE_COBS, LAT_CyclesToUs(stream->cobs_cycles - stream->sink_cycles));
+    LAT_Record(LAT_STAGE_SINK, LAT_TicksToUs(stream->sink_ticks));
+    return true;
+}
+
+/**
+ * @brief Start receiving frames
+ */
+void FRAME_RxInit(frame_rx_t * rx, uint8_t * buffer, uint16_t buffer_size)
+{
+    rx->buffer = buffer;
+    rx->buffer_size = buffer_size;
+    rx->dropped = 0;
+    rx_frame_reset(rx);
+}
+
+/**
+ * @brief Decode received bytes up to the end of a frame
+ */
+uint16_t FRAME_RxPush(frame_rx_t * rx, const uint8_t * data, uint16_t length, bool * p_complete)
+{
+    uint16_t n;
+
+    *p_complete = false;
+    for (n = 0; n < length; n++) {
+        uint8_t byte = data[n];
+
+        if (rx->complete) {
+            rx_frame_reset(rx);
+        }
+
+        if (byte == FRAME_DELIMITER) {
+            if (rx->started == false) {
+                /* Empty frame */
+                continue;
+            }
+            if ((rx->error == false) && (rx->block_left == 0)) {
+                rx->complete = true;
+                *p_complete = true;
+                return n + 1;
+            }
+            rx->dropped++;
+            rx_frame_reset(rx);
+            continue;
+        }
+
+        if (rx->error) {
+            continue;
+        }
+        if (rx->block_left > 0) {
+            rx_byte_add(rx, byte);
+            rx->block_left--;
+            continue;
+        }
+
+        /* Code byte: the previous block ended with a zero, unless it was a full one */
+        if (rx->started && (rx->block_full == false)) {
+            rx_byte_add(rx, 0);
+        }
+        rx->started = true;
+        rx->block_left = byte - 1;
+        rx->block_full = (byte == FRAME_BLOCK_SIZE);
+    }
+    return n;
+}
+
+/*
+ * Local functions
+ */
+
+static bool packet_write(frame_stream_t * stream, const uint8_t * data, uint16_t length)
+{
+    while (length > 0) {
+        uint16_t chunk = stream->packet_size - stream->packet_length;
+        if (chunk > length) {
+            chunk = length;
+        }
+        memcpy(&stream->packet[stream->packet_length], data, chunk);
+        stream->packet_length += chunk;
+        data += chunk;
+        length -= chunk;
+        if (stream->packet_length == stream->packet_size) {
+            if (packet_flush(stream) == false) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool packet_flush(frame_stream_t * stream)
+{
+    uint32_t cycles_from;
+    uint32_t ticks_from;
+    bool ret;
+
+    if (stream->packet_length == 0) {
+        return true;
+    }
+    cycles_from = LAT_GetCycles();
+    ticks_from = LAT_GetTicks();
+    ret = stream->sink(stream->packet, stream->packet_length);
+    stream->sink_cycles += LAT_GetCycles() - cycles_from;
+    stream->sink_ticks += LAT_GetTicksSince(ticks_from);
+    if (ret == false) {
+        stream->error = true;
+        return false;
+    }
+    stream->bytes_sent += stream->packet_length;
+    stream->packet_length = 0;
+    return true;
+}
+
+static bool block_flush(frame_stream_t * stream)
+{
+    stream->block[0] = stream->block_length;
+    bool ret = packet_write(stream, stream->block, stream->block_length);
+    stream->block_length = 1;
+    return ret;
+}
+
+static bool ostream_callback(pb_ostream_t * ostream, const pb_byte_t * buf, size_t count)
+{
+    return FRAME_Write((frame_stream_t *)ostream->state, buf, count);
+}
+
+static void rx_frame_reset(frame_rx_t * rx)
+{
+    rx->length = 0;
+    rx->block_left = 0;
+    rx->block_full = false;
+    rx->started = false;
+    rx->complete = false;
+    rx->error = false;
+}
+
+static void rx_byte_add(frame_rx_t * rx, uint8_t byte)
+{
+    if (rx->length >= rx->buffer_size) {
+        rx->error = true;
+        return;
+    }
+    rx->buffer[rx->length++] = byte;
+}
+
+/* END OF FILE */
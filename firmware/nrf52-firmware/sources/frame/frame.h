@@ -0,0 +1,155 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: FRAME
+ *
+ *---------------------------------------------------------------
+ * @brief Streaming COBS framing of protobuf messages
+ *
+ * Encodes a message with COBS while it is being serialized and
+ * hands the encoded bytes to a sink by packets of a given size
+ * (e.g. the BLE MTU), so that neither the serialized nor the
+ * encoded message has to be stored.
+ *
+ * The receiver side decodes COBS as bytes arrive, whatever the
+ * packets they are split in, and stops at each frame delimiter
+ * so that the frame is taken before the next one overwrites it.
+ *
+ * Dependencies : nanopb
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Protobuf includes */
+#include "nanopb/pb.h"
+#include "nanopb/pb_encode.h"
+
+/*
+ * Public constants
+ */
+
+#define FRAME_BLOCK_SIZE    255     /**< Largest COBS block: code byte and 254 non zero bytes */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**@brief Packet sink, returns false if the packet could not be sent */
+typedef bool (*frame_sink_t)(uint8_t * data, uint16_t length);
+
+/**@brief Frame stream state */
+typedef struct {
+    frame_sink_t sink;                      /**< Where packets are sent */
+    uint8_t * packet;                       /**< Packet being filled */
+    uint16_t packet_size;                   /**< Bytes sent to the sink per packet (except the last one) */
+    uint16_t packet_length;                 /**< Bytes already in packet */
+    uint8_t block[FRAME_BLOCK_SIZE];        /**< COBS block being encoded, block[0] is its code byte */
+    uint8_t block_length;                   /**< Bytes already in block, code byte included */
+    bool block_full;                        /**< Last block sent was a full one (code 0xFF) */
+    bool error;                             /**< Sink failed, the frame sent is truncated */
+    uint32_t bytes_sent;                    /**< Encoded bytes sent in the current frame */
+    uint32_t cobs_cycles;                   /**< CPU cycles spent in encoding and sending the current frame */
+    uint32_t sink_cycles;                   /**< Of those, spent in the sink */
+    uint32_t sink_ticks;                    /**< RTC ticks spent in the sink, which may sleep while the cycle counter stops */
+} frame_stream_t;
+
+/**@brief Frame receiver state */
+typedef struct {
+    uint8_t * buffer;                       /**< Decoded bytes of the frame being received */
+    uint16_t buffer_size;
+    uint16_t length;                        /**< Decoded bytes in buffer */
+    uint8_t block_left;                     /**< Bytes left in the current COBS block, 0 when a code byte is expected */
+    bool block_full;                        /**< Current block has code 0xFF, no zero follows it */
+    bool started;                           /**< A code byte of the current frame was received */
+    bool complete;                          /**< buffer holds a complete frame, dropped by the next byte pushed */
+    bool error;                             /**< Current frame is too long or malformed, dropped at its delimiter */
+    uint32_t dropped;                       /**< Frames dropped since FRAME_RxInit */
+} frame_rx_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start a new frame
+ *
+ * If the previous frame on this stream was truncated, a frame delimiter is
+ * sent first so that the receiver drops it instead of the new one.
+ *
+ * @param[in] stream is the frame stream state
+ * @param[in] sink is called with each packet
+ * @param[in] packet is a buffer of packet_size bytes holding the packet being filled
+ * @param[in] packet_size is the number of bytes per packet
+ */
+void FRAME_Begin(frame_stream_t * stream, frame_sink_t sink, uint8_t * packet, uint16_t packet_size);
+
+/**
+ * @brief Encode bytes in the current frame
+ * @return false if the sink failed
+ */
+bool FRAME_Write(frame_stream_t * stream, const uint8_t * data, size_t length);
+
+/**
+ * @brief Terminate the current frame and send the last packet
+ * @return false if the sink failed
+ */
+bool FRAME_End(frame_stream_t * stream);
+
+/**
+ * @brief Return a nanopb output stream writing to the current frame
+ */
+pb_ostream_t FRAME_GetOstream(frame_stream_t * stream);
+
+/**
+ * @brief Serialize a protobuf message as a complete frame
+ * @return false if encoding or the sink failed
+ */
+bool FRAME_SendMessage(frame_stream_t * stream, frame_sink_t sink, uint8_t * packet, uint16_t packet_size,
+                       const pb_msgdesc_t * fields, const void * message);
+
+/**
+ * @brief Start receiving frames
+ * @param[in] rx is the frame receiver state
+ * @param[in] buffer holds the decoded frame, buffer_size bytes at most
+ */
+void FRAME_RxInit(frame_rx_t * rx, uint8_t * buffer, uint16_t buffer_size);
+
+/**
+ * @brief Decode received bytes up to the end of a frame
+ *
+ * A frame too long for the buffer, or with a malformed COBS block, is
+ * counted in dropped and skipped up to its delimiter. Empty frames (two
+ * delimiters in a row, as after a truncated frame) are skipped silently.
+ *
+ * @param[in] rx is the frame receiver state
+ * @param[in] data are the received bytes
+ * @param[in] length is the number of received bytes
+ * @param[out] p_complete is set true if rx->buffer holds a complete frame of
+ * rx->length bytes, which is valid until the next call
+ * @return the number of bytes consumed, up to the delimiter of a complete frame
+ */
+uint16_t FRAME_RxPush(frame_rx_t * rx, const uint8_t * data, uint16_t length, bool * p_complete);
+
+#endif /* FRAME_H_ */
+
+/* END OF FILE */
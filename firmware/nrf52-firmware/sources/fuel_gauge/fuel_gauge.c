@@ -113,6 +113,26 @@ uint8_t FGA_GetStateOfCharge(void)
     return BQ27441_soc(UNFILTERED);
 }
 
+/**
+ * @brief Retrieve average battery current, updated each second by the gauge
+ * @return Current in mA, negative while discharging
+ */
+int16_t FGA_GetAverageCurrent(void)
+{
+    if (!is_init) return 0;
+    return BQ27441_current(AVG);
+}
+
+/**
+ * @brief Retrieve remaining battery capacity
+ * @return Capacity in mAh
+ */
+uint16_t FGA_GetRemainingCapacity(void)
+{
+    if (!is_init) return 0;
+    return BQ27441_capacity(REMAIN);
+}
+
 /*
  * Local functions
  */
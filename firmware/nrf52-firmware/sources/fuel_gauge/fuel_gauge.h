@@ -58,6 +58,18 @@ bool FGA_Init(void);
  */
 uint8_t FGA_GetStateOfCharge(void);
 
+/**
+ * @brief Retrieve average battery current, updated each second by the gauge
+ * @return Current in mA, negative while discharging
+ */
+int16_t FGA_GetAverageCurrent(void);
+
+/**
+ * @brief Retrieve remaining battery capacity
+ * @return Capacity in mAh
+ */
+uint16_t FGA_GetRemainingCapacity(void);
+
 #endif /* FUEL_GAUGE_H */
 
 /* END OF FILE */
\ No newline at end of file
@@ -0,0 +1,207 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: LATENCY
+ *
+ *---------------------------------------------------------------
+ * @brief Duration statistics of the processing stages, from the
+ * SAADC buffer to the notification acknowledged by the central
+ *
+ * Each stage is only updated from one interrupt level, so that no
+ * lock is needed on the hot paths.
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <string.h>
+
+/* SDK includes */
+#include "nrf.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+
+#define NRF_LOG_MODULE_NAME LAT
+#define NRF_LOG_INFO_COLOR  3
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/* Project includes */
+#include "latency.h"
+
+/*
+ * Local constants
+ */
+
+#define CYCLES_PER_US           (SystemCoreClock / 1000000UL)
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local variables
+ */
+
+static lat_stats_t lat_stats[LAT_STAGE_NUM];
+
+static const char * const stage_names[LAT_STAGE_NUM] = {
+    "saadc wait",
+    "scaling",
+    "transform",
+    "impedance",
+    "encode",
+    "cobs",
+    "tx",
+    "dsp slice",
+    "sink",
+};
+
+/*
+ * Local functions
+ */
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start the DWT cycle counter and clear statistics
+ */
+void LAT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    LAT_Reset();
+}
+
+/**
+ * @brief Clear statistics of all stages
+ */
+void LAT_Reset(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(lat_stats, 0, sizeof(lat_stats));
+    for (uint8_t stage = 0; stage < LAT_STAGE_NUM; stage++) {
+        lat_stats[stage].min = UINT32_MAX;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Return the DWT cycle counter, to time a stage that does not sleep
+ */
+uint32_t LAT_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Return the app_timer RTC counter, to time a stage that may sleep
+ */
+uint32_t LAT_GetTicks(void)
+{
+    return app_timer_cnt_get();
+}
+
+/**
+ * @brief Return the app_timer RTC ticks elapsed since LAT_GetTicks() value start
+ */
+uint32_t LAT_GetTicksSince(uint32_t start)
+{
+    return app_timer_cnt_diff_compute(app_timer_cnt_get(), start);
+}
+
+/**
+ * @brief Add the duration of a stage
+ */
+void LAT_Record(lat_stage_t stage, uint32_t us)
+{
+    lat_stats_t * stats = &lat_stats[stage];
+    uint8_t bin = (us == 0) ? 0 : (uint8_t)(31 - __CLZ(us));
+
+    if (bin >= LAT_HISTOGRAM_BINS) {
+        bin = LAT_HISTOGRAM_BINS - 1;
+    }
+    stats->histogram[bin]++;
+    stats->count++;
+    stats->total += us;
+    if (us < stats->min) {
+        stats->min = us;
+    }
+    if (us > stats->max) {
+        stats->max = us;
+    }
+}
+
+/**
+ * @brief Add the duration of a stage started at LAT_GetCycles() value start
+ */
+void LAT_RecordCycles(lat_stage_t stage, uint32_t start)
+{
+    LAT_Record(stage, LAT_CyclesToUs(DWT->CYCCNT - start));
+}
+
+/**
+ * @brief Add the duration of a stage started at LAT_GetTicks() value start
+ */
+void LAT_RecordTicks(lat_stage_t stage, uint32_t start)
+{
+    LAT_Record(stage, LAT_TicksToUs(LAT_GetTicksSince(start)));
+}
+
+/**
+ * @brief Convert DWT cycles to us
+ */
+uint32_t LAT_CyclesToUs(uint32_t cycles)
+{
+    return cycles / CYCLES_PER_US;
+}
+
+/**
+ * @brief Convert app_timer RTC ticks to us
+ */
+uint32_t LAT_TicksToUs(uint32_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * 1000000ULL) / APP_TIMER_CLOCK_FREQ);
+}
+
+/**
+ * @brief Return the statistics of a stage, the main context may be recording it
+ */
+void LAT_GetStats(lat_stage_t stage, lat_stats_t * p_stats)
+{
+    CRITICAL_REGION_ENTER();
+    *p_stats = lat_stats[stage];
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+ * @brief Log count, min, mean and max of each stage
+ */
+void LAT_Log(void)
+{
+    for (uint8_t stage = 0; stage < LAT_STAGE_NUM; stage++) {
+        const lat_stats_t * stats = &lat_stats[stage];
+        if (stats->count == 0) {
+            continue;
+        }
+        NRF_LOG_INFO("%s: %u x, %u / %u / %u us", stage_names[stage], stats->count,
+                     stats->min, (uint32_t)(stats->total / stats->count), stats->max);
+    }
+}
+
+/* END OF FILE */
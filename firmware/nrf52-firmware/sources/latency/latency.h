@@ -0,0 +1,166 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: LATENCY
+ *
+ *---------------------------------------------------------------
+ * @brief Duration statistics of the processing stages, from the
+ * SAADC buffer to the notification acknowledged by the central
+ *
+ * Stages running on the CPU are timed with the DWT cycle counter,
+ * which stops while the CPU sleeps. Stages that wait for an event
+ * (main loop, link layer) are timed with the app_timer RTC.
+ * Each stage keeps count, min, max, mean and a histogram of its
+ * durations in us, since boot or LAT_Reset.
+ *
+ * Dependencies : app_timer, DWT (Cortex-M4)
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdint.h>
+
+/*
+ * Public constants
+ */
+
+#ifndef LAT_ENABLED
+#define LAT_ENABLED             1       /**< 0 turns all functions into empty ones (host builds) */
+#endif
+
+#define LAT_HISTOGRAM_BINS      20      /**< Bin n counts durations from 2^n to 2^(n+1) - 1 us (bin 0 from 0), the last one all longer ones */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Stages timed, in processing order
+ */
+typedef enum {
+    LAT_STAGE_SAADC_WAIT = 0,   /**< SAADC buffer done to its processing in the main loop */
+    LAT_STAGE_SCALING,          /**< Samples pushed into the DSP window and scaled */
+    LAT_STAGE_TRANSFORM,        /**< FFT (or Goertzel) of both channels */
+    LAT_STAGE_IMPEDANCE,        /**< V / I division and delay compensation */
+    LAT_STAGE_ENCODE,           /**< Protobuf encoding of a message, COBS excluded */
+    LAT_STAGE_COBS,             /**< COBS encoding of a message, sink excluded */
+    LAT_STAGE_TX,               /**< NUS packet queued to notification acknowledged */
+    LAT_STAGE_DSP_SLICE,        /**< One scheduler slice of the spectrum computation, bounds the delay of other events */
+    LAT_STAGE_SINK,             /**< Packets of a message handed to the sink, waits for room in the TX queue included */
+    LAT_STAGE_NUM
+} lat_stage_t;
+
+/**
+ * @brief Durations of a stage, in us
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[LAT_HISTOGRAM_BINS];
+} lat_stats_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+#if (LAT_ENABLED == 1)
+
+/**
+ * @brief Start the DWT cycle counter and clear statistics
+ */
+void LAT_Init(void);
+
+/**
+ * @brief Clear statistics of all stages
+ */
+void LAT_Reset(void);
+
+/**
+ * @brief Return the DWT cycle counter, to time a stage that does not sleep
+ */
+uint32_t LAT_GetCycles(void);
+
+/**
+ * @brief Return the app_timer RTC counter, to time a stage that may sleep
+ */
+uint32_t LAT_GetTicks(void);
+
+/**
+ * @brief Return the app_timer RTC ticks elapsed since LAT_GetTicks() value start
+ */
+uint32_t LAT_GetTicksSince(uint32_t start);
+
+/**
+ * @brief Add the duration of a stage
+ */
+void LAT_Record(lat_stage_t stage, uint32_t us);
+
+/**
+ * @brief Add the duration of a stage started at LAT_GetCycles() value start
+ */
+void LAT_RecordCycles(lat_stage_t stage, uint32_t start);
+
+/**
+ * @brief Add the duration of a stage started at LAT_GetTicks() value start
+ */
+void LAT_RecordTicks(lat_stage_t stage, uint32_t start);
+
+/**
+ * @brief Convert DWT cycles to us
+ */
+uint32_t LAT_CyclesToUs(uint32_t cycles);
+
+/**
+ * @brief Convert app_timer RTC ticks to us
+ */
+uint32_t LAT_TicksToUs(uint32_t ticks);
+
+/**
+ * @brief Return the statistics of a stage, copied atomically so that it may be
+ * called from an interrupt. Stages are not copied atomically with each other.
+ */
+void LAT_GetStats(lat_stage_t stage, lat_stats_t * p_stats);
+
+/**
+ * @brief Log count, min, mean and max of each stage
+ */
+void LAT_Log(void);
+
+#else
+
+static inline void LAT_Init(void) {}
+static inline void LAT_Reset(void) {}
+static inline uint32_t LAT_GetCycles(void) { return 0; }
+static inline uint32_t LAT_GetTicks(void) { return 0; }
+static inline uint32_t LAT_GetTicksSince(uint32_t start) { (void)start; return 0; }
+static inline void LAT_Record(lat_stage_t stage, uint32_t us) { (void)stage; (void)us; }
+static inline void LAT_RecordCycles(lat_stage_t stage, uint32_t start) { (void)stage; (void)start; }
+static inline void LAT_RecordTicks(lat_stage_t stage, uint32_t start) { (void)stage; (void)start; }
+static inline uint32_t LAT_CyclesToUs(uint32_t cycles) { return cycles; }
+static inline uint32_t LAT_TicksToUs(uint32_t ticks) { return ticks; }
+static inline void LAT_GetStats(lat_stage_t stage, lat_stats_t * p_stats) { (void)stage; *p_stats = (lat_stats_t){ 0 }; }
+static inline void LAT_Log(void) {}
+
+#endif
+
+#endif /* LATENCY_H_ */
+
+/* END OF FILE */
@@ -18,6 +18,10 @@
 
 /* Standard C library includes */
 
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+
 /* SDK includes */
 
 #define NRF_LOG_MODULE_NAME MAIN
@@ -39,11 +43,19 @@ NRF_LOG_MODULE_REGISTER();
 /* Project includes */
 
 #include "bluetooth/bluetooth.h"
+#include "calib_store/calib_store.h"
 #include "eda_toolbox/eda_cfg.h"
 #include "eda_toolbox/eda_afe.h"
+#include "eda_toolbox/eda_calib.h"
 #include "eda_toolbox/eda_dsp.h"
 #include "fuel_gauge/fuel_gauge.h"
 #include "calendar/calendar.h"
+#include "energy/energy.h"
+#include "frame/frame.h"
+#include "flash_log/flash_log.h"
+#include "flash_log/spectrum_codec.h"
+#include "latency/latency.h"
+#include "time_sync/time_sync.h"
 
 /* Protobuf and COBS includes */
 #include "nanocobs/cobs.h"
@@ -55,13 +67,32 @@ NRF_LOG_MODULE_REGISTER();
  * Local constants
  */
 
-#define SCHEDULER_QUEUE_SIZE      4
+#define SCHEDULER_QUEUE_SIZE      8
 #define SCHEDULER_DATA_SIZE       sizeof(scheduler_event_t)
 
-#define BLE_TX_MAX_BUFFER_SIZE      32768           /**< Maximum payload for BLE messages sent - TO BE REPLACED WITH PROTOBUF MAX MESSAGE SIZE*/
 #define BATT_TIMER_MS               60000           /**< Update interval of battery state of charge */
 #define RGB_LED_TIMER_MS            500
 
+#define EDA_BATCH_SIZE              8               /**< Spectra sent per EdaBatch message (at most EdaBatch.spectra max_count) */
+#define EDA_BATCH_LATENCY_MS        1000            /**< Maximum delay between first spectrum of a batch and its sending */
+#define EDA_SPECTRUM_RATE_HZ        (EDA_SAMPLING_RATE / EDA_ADC_BUFFER_SIZE)   /**< Spectra computed per second */
+#define EDA_ADAPTIVE_INTERVAL_MS    2000            /**< Adaptive rate: longest time between two spectra sent, unless the host sets it */
+
+#define EDA_RAW_SAMPLE_BITS         14              /**< SAADC resolution, raw samples are packed on as many bits */
+#define EDA_RAW_CHUNK_SAMPLES       128             /**< V, I sample pairs per RawSamples message */
+#define EDA_RAW_CHUNK_SIZE          (EDA_RAW_CHUNK_SAMPLES * 2 * EDA_RAW_SAMPLE_BITS / 8)   /**< Packed bytes per RawSamples message */
+#define EDA_RAW_CHUNK_RATE_HZ       (EDA_SAMPLING_RATE / EDA_RAW_CHUNK_SAMPLES)             /**< RawSamples messages per second */
+#define EDA_RAW_FRAME_MAX           (COBS_ENCODE_MAX(RawSamples_size + 3) + 1)  /**< Framed raw_samples DeviceMessage, delimiter of a truncated frame included */
+
+#define EDA_WINDOW_BUFFERS          (EDA_DSP_GetWindowSize() / EDA_ADC_BUFFER_SIZE)    /**< SAADC buffers in the DSP analysis window */
+#define EDA_HALF_SAMPLE_US          (500000 / EDA_SAMPLING_RATE)                       /**< Centre of an even analysis window from the sample pair before it */
+
+#define LOG_DOWNLOAD_RETRY_MS       10              /**< Delay before trying again when the NUS TX queue has no room for a logged batch */
+#define LOG_DOWNLOAD_THROUGHPUT     100000          /**< More than NUS can carry, for the shortest connection interval during downloads */
+
+#define HOST_FRAME_NUM              2               /**< Host messages received and waiting for the scheduler */
+#define HOST_MESSAGE_BUDGET_US      5000            /**< Handling time of a host message: longer work continues in scheduler slices, a warning is logged above it */
+
 /*
  * Local macros
  */
@@ -93,6 +124,14 @@ typedef enum {
     SCHEDULER_EVENT_DISCONNECTED,
     SCHEDULER_EVENT_ADV_STOP,
     SCHEDULER_EVENT_EDA_BUFFER_FULL,
+    SCHEDULER_EVENT_EDA_BATCH_TIMEOUT,
+    SCHEDULER_EVENT_EDA_DSP_STEP,
+    SCHEDULER_EVENT_HOST_MESSAGE,
+    SCHEDULER_EVENT_LOG_DOWNLOAD,
+    SCHEDULER_EVENT_LOG_ERASED,
+    SCHEDULER_EVENT_CALIBRATION_STORE,
+    SCHEDULER_EVENT_EDA_STOPPED,
+    SCHEDULER_EVENT_SETTINGS_APPLY,
     SCHEDULER_EVENT_NUM
 } scheduler_event_type_t;
 
@@ -101,19 +140,112 @@ typedef struct {
     void * data;
 } scheduler_event_t;
 
+/**
+ * @brief Host message reassembled from NUS writes, decoded from the scheduler
+ */
+typedef struct {
+    uint8_t data[HostMessage_size];
+    uint16_t length;
+    uint64_t received_us;       /**< Device clock when the last write of the message was received */
+    volatile bool queued;       /**< Waits for the scheduler, not to be overwritten */
+} host_frame_t;
+
+/**
+ * @brief Handler of a HostMessage payload, called from the scheduler
+ */
+typedef void (*host_message_handler_t)(const HostMessage * message);
+
+typedef struct {
+    pb_size_t tag;              /**< HostMessage payload tag */
+    host_message_handler_t handler;
+} host_message_entry_t;
+
 /*
  * Local variables
  */
 
 static fsm_state_t fsm_state;
-static scheduler_event_t scheduler_event;
-static EdaBuffer edaBuffer = {
-    .has_timestamp = true,
+static DeviceMessage deviceMessage = {
+    .which_payload = DeviceMessage_eda_batch_tag,
+    .payload.eda_batch.has_timestamp = true,
 };
-static uint8_t ble_tx_packet[EdaBuffer_size + 2];       /**< Maximum protobuf message size plus 2 COBS sentinel values */
-
-static uint8_t pb_message[Timestamp_size + 1];
-static Timestamp timestamp;
+static DeviceMessage logMessage = {
+    .which_payload = DeviceMessage_log_batch_tag,
+    .payload.log_batch.has_timestamp = true,
+};
+static DeviceMessage rawMessage = {
+    .which_payload = DeviceMessage_raw_samples_tag,
+    .payload.raw_samples.has_timestamp = true,
+};
+static frame_stream_t ble_tx_stream;                /**< Messages are COBS encoded while serialized, and sent by MTU sized packets */
+static uint8_t ble_tx_packet[BLE_NUS_MAX_DATA_LEN];  /**< Packet being filled by ble_tx_stream */
+
+STATIC_ASSERT(EDA_BATCH_SIZE <= pb_arraysize(EdaBatch, spectra));
+STATIC_ASSERT(EDA_RAW_CHUNK_SIZE <= pb_membersize(RawSamples, data.bytes));
+STATIC_ASSERT((EDA_ADC_BUFFER_SIZE % EDA_RAW_CHUNK_SAMPLES) == 0);
+STATIC_ASSERT((EDA_RAW_CHUNK_SAMPLES % 4) == 0);   /* Whole bytes per chunk */
+STATIC_ASSERT(FLOG_FDS_SIZE == (FDS_VIRTUAL_PAGES * FDS_VIRTUAL_PAGE_SIZE * 4));   /* Log ends where FDS starts */
+
+static LatencyReport latencyReport;
+static uint8_t latency_report_value[BLE_DIAGNOSTICS_MAX_LEN];  /**< Encoded latencyReport, read from the diagnostics characteristic */
+
+STATIC_ASSERT(LAT_STAGE_NUM <= pb_arraysize(LatencyReport, stages));
+STATIC_ASSERT(LAT_HISTOGRAM_BINS == pb_arraysize(StageLatency, histogram));
+STATIC_ASSERT((int)LatencyStage_LATENCY_STAGE_SINK == (int)LAT_STAGE_SINK);
+STATIC_ASSERT(NRG_SUBSYSTEM_NUM <= pb_arraysize(EnergyReport, subsystems));
+STATIC_ASSERT(EDA_FREQUENCY_NUM <= pb_arraysize(CalibrationStatus, points));
+STATIC_ASSERT(EDA_FREQUENCY_NUM <= pb_arraysize(DspStatus, frequencies));
+
+static frame_rx_t host_rx;                              /**< Host messages may span several NUS writes */
+static uint8_t host_rx_buffer[HostMessage_size];
+static host_frame_t host_frames[HOST_FRAME_NUM];
+static uint32_t host_frames_busy;                       /**< Host messages dropped since connection, all frames were queued */
+static HostMessage hostMessage;
+static uint64_t host_message_received_us;               /**< received_us of hostMessage */
+static tsync_t time_sync;                               /**< Fit of the device clock against the connected host */
+
+static ImpedanceEncoding impedance_encoding = ImpedanceEncoding_IMPEDANCE_ENCODING_FLOAT;  /**< Set by the host after connection */
+static OutputMode output_mode = OutputMode_OUTPUT_MODE_SPECTRA;                         /**< Mode applied from the scheduler */
+static float adaptive_threshold;                                                        /**< Set by the host after connection, 0 sends every spectrum */
+static uint32_t adaptive_interval_ms = EDA_ADAPTIVE_INTERVAL_MS;                        /**< Set by the host after connection */
+static volatile bool adaptive_reference_valid;                                          /**< adaptive_magnitude holds the last spectrum sent */
+static float adaptive_magnitude[EDA_FREQUENCY_NUM];                                     /**< |Z| of the last spectrum sent */
+static uint64_t adaptive_time_us;                                                       /**< Time of the last spectrum sent */
+static uint32_t adaptive_skipped;                                                       /**< Spectra not sent since the last one */
+static uint32_t raw_chunks_dropped;                                                     /**< RawSamples messages the NUS TX queue had no room for */
+static uint32_t eda_last_sequence = UINT32_MAX;                                         /**< Sequence of the last SAADC buffer processed, UINT32_MAX before the first one */
+static uint8_t eda_window_refill;                                                       /**< Spectra skipped until the DSP window holds contiguous samples again */
+static bool eda_fft_pending;                                                            /**< Spectrum being computed in scheduler slices */
+static bool eda_fft_step_queued;                                                        /**< Next slice is already in the scheduler queue */
+static bool eda_fft_discard;                                                            /**< Spectrum in progress is computed while the window is refilled */
+static uint64_t eda_fft_time;                                                           /**< Time of the centre of the analysis window of the spectrum computed */
+static uint32_t eda_fft_us;
+static uint32_t eda_fft_frame;                                                          /**< Frame index of the last sample pair pushed into the DSP window */
+static uint32_t eda_fft_rtc_counter;                                                    /**< Calendar RTC counter at that sample pair */
+static Impedance eda_impedance[EDA_FREQUENCY_NUM];                                      /**< Output of the spectrum in progress */
+static uint64_t acquisition_status_time;                                                /**< Time AcquisitionStatus was last sent on lost samples */
+static uint32_t calibration_request_id;                                                  /**< Request of the store or erase in progress, replied to once done */
+static volatile cstore_event_t calibration_store_event;                                 /**< Last calibration store event, handled from the scheduler */
+static bool calibration_stored;                                                         /**< Calibration in use was read from or written to flash */
+static bool calibration_error;                                                          /**< Last store or erase failed */
+static MeasurementState measurement_state = MeasurementState_MEASUREMENT_STATE_RUNNING; /**< Frontend runs from boot, spectra are logged until a host stops it */
+static uint32_t measurement_request_id;                                                  /**< Request of the stop in progress, replied to once stopped */
+static bool settings_apply_pending;                                                     /**< Output mode and DSP profile wait for the spectrum in progress */
+static OutputMode settings_output_mode;
+static uint8_t settings_dsp_profile;
+static uint32_t settings_request_id;                                                    /**< Replied to once they are applied */
+
+static volatile bool nus_started;           /**< Host receives NUS notifications, spectra are logged in flash otherwise */
+static LogRequest log_request;              /**< Last request received */
+static uint32_t log_request_id;             /**< Replied to once the download or erase is done */
+static scodec_encoder_t log_encoder;        /**< Spectra being compressed in log_record */
+static uint8_t log_record[FLOG_PAYLOAD_MAX];
+static flog_reader_t log_reader;
+static scodec_decoder_t log_decoder;        /**< Record being sent, from log_download_record */
+static uint8_t log_download_record[FLOG_PAYLOAD_MAX];
+static bool log_decoding;
+static bool log_batch_ready;                /**< logMessage waits for room in the NUS TX queue */
+static bool log_downloading;
 
 /*
  * Local functions
@@ -123,10 +255,62 @@ static void ble_connection_event_handler(uint16_t ble_event);
 static void ble_advertising_event_handler(ble_adv_evt_t ble_adv_evt);
 static void ble_uart_rx_data_handler(ble_nus_evt_t *p_evt);
 
-static void pb_decode_message(const uint8_t *p_data, uint16_t length);
+static void host_rx_push(const uint8_t * p_data, uint16_t length);
+static void host_frame_queue(void);
+static void host_message_handle(host_frame_t * frame);
+static void timestamp_handle(const HostMessage * message);
+static void settings_handle(const HostMessage * message);
+static void settings_apply_continue(void);
+static void acquisition_request_handle(const HostMessage * message);
+static void energy_request_handle(const HostMessage * message);
+static void time_sync_handle(const HostMessage * message);
+static void request_error_send(RequestErrorCode code, uint32_t request_id);
+static void status_message_send(pb_size_t tag, const pb_msgdesc_t * fields, const void * status, uint32_t request_id);
 
 static void eda_event_handler(eda_event_t eda_event, void * data);
-static void eda_send_fft(eda_buffer_t * buffer);
+static void eda_buffer_process(eda_buffer_t * buffer);
+static void eda_fft_begin(eda_buffer_t * buffer);
+static eda_dsp_status_t eda_fft_slice(void);
+static void eda_fft_step(void);
+static void eda_fft_step_schedule(void);
+static void eda_fft_complete(void);
+static void eda_fft_output(void);
+static void eda_fft_timestamp(void);
+static bool eda_rate_decimate(void);
+static void eda_batch_send(void);
+static void eda_send_raw(eda_buffer_t * buffer);
+static void raw_samples_pack(const int16_t * samples, uint16_t count, uint8_t * out);
+static void output_mode_apply(OutputMode mode);
+static void output_throughput_require(void);
+static void dsp_profile_apply(uint8_t profile);
+static void dsp_status_send(uint32_t request_id);
+static void acquisition_status_send(uint32_t request_id);
+static void energy_report_send(uint32_t request_id);
+static void calibration_request_handle(const HostMessage * message);
+static void calibration_store_handle(void);
+static void calibration_status_send(uint32_t request_id);
+static void measurement_request_handle(const HostMessage * message);
+static void measurement_stop_complete(void);
+static void measurement_status_send(uint32_t request_id);
+static void cstore_event_handler(cstore_event_t cstore_event);
+static uint16_t latency_report_read(uint8_t const ** p_data);
+
+static void flog_event_handler(flog_event_t flog_event);
+static void log_request_handle(const HostMessage * message);
+static void log_download_continue(void);
+static void log_download_stop(void);
+static void log_spectrum_add(uint64_t time, uint32_t us, const Impedance * impedance);
+static void log_record_flush(void);
+static bool log_batch_fill(void);
+static void log_status_send(uint32_t request_id);
+
+APP_TIMER_DEF(log_download_timer_id);
+static void log_download_timer_handler(void *p_context);
+
+APP_TIMER_DEF(eda_batch_timer_id);
+static void eda_batch_timer_handler(void *p_context);
+static void impedance_pack_half(const Impedance * impedance, uint16_t count, EdaSpectrum * spectrum);
+static uint16_t float_to_half(float value);
 
 static void rgb_led_init(void);
 static void rgb_led_set(bool red, bool green, bool blue);
@@ -140,6 +324,20 @@ static void batt_timer_handler(void *p_context);
 
 static void scheduler_event_handler(void * p_event, uint16_t size);
 
+/**
+ * @brief Handlers of host messages, a new message only needs an entry here
+ */
+static const host_message_entry_t host_messages[] = {
+    { HostMessage_timestamp_tag,            timestamp_handle },
+    { HostMessage_settings_tag,             settings_handle },
+    { HostMessage_log_request_tag,          log_request_handle },
+    { HostMessage_acquisition_request_tag,  acquisition_request_handle },
+    { HostMessage_energy_request_tag,       energy_request_handle },
+    { HostMessage_calibration_request_tag,  calibration_request_handle },
+    { HostMessage_measurement_request_tag,  measurement_request_handle },
+    { HostMessage_time_sync_request_tag,    time_sync_handle },
+};
+
 /****************************************************************
  * IMPLEMENTATION
  ****************************************************************/
@@ -170,25 +368,45 @@ int main(void)
     /* Initialize scheduler */
     APP_SCHED_INIT(SCHEDULER_DATA_SIZE, SCHEDULER_QUEUE_SIZE);
 
+    /* Start processing stage timing */
+    LAT_Init();
+
     /* Initialize RGB Led */
     app_timer_create(&rgb_led_timer_id, APP_TIMER_MODE_REPEATED, rgb_led_timer_handler);
     rgb_led_init();
     rgb_led_blink_blue();
 
+    /* Calibration record is read once the peer manager has initialized flash data storage */
+    CSTORE_Init(cstore_event_handler);
+
+    /* Host messages are reassembled across NUS writes */
+    FRAME_RxInit(&host_rx, host_rx_buffer, sizeof(host_rx_buffer));
+
     /* Start BLE stack */
     BLE_Init();
     BLE_SetConnectionCallback(ble_connection_event_handler);
     BLE_SetAdvertisingCallback(ble_advertising_event_handler);
     BLE_SetUartRXCallback(ble_uart_rx_data_handler);
+    BLE_SetDiagnosticsReadCallback(latency_report_read);
+
+    /* Open spectra log, once SoftDevice handles flash operations */
+    FLOG_Init(flog_event_handler);
+    SCODEC_EncodeBegin(&log_encoder, log_record, sizeof(log_record));
+    app_timer_create(&log_download_timer_id, APP_TIMER_MODE_SINGLE_SHOT, log_download_timer_handler);
 
     /* Start in advertising state */
     fsm_state = FSM_STATE_ADVERT;
     BLE_AdvertisingStart(false);
 
-    /* Start calendar */
+    /* Start calendar, its drift is fitted from host requests */
     CAL_Init();
+    TSYNC_Init(&time_sync);
+
+    /* Prepare sending of EDA spectra by batch */
+    app_timer_create(&eda_batch_timer_id, APP_TIMER_MODE_SINGLE_SHOT, eda_batch_timer_handler);
 
-    /* Start frontend */
+    /* Start frontend, impedance corrected with default calibration */
+    EDA_CALIB_Init();
     EDA_DSP_Init();
     EDA_Init(eda_event_handler);
 
@@ -197,6 +415,9 @@ int main(void)
     batt_timer_handler(NULL);
     app_timer_create(&batt_timer_id, APP_TIMER_MODE_REPEATED, batt_timer_handler);
     app_timer_start(batt_timer_id, APP_TIMER_TICKS(BATT_TIMER_MS), NULL);
+
+    /* Start energy accounting, uses SoftDevice radio notifications and fuel gauge */
+    NRG_Init();
     
     /* Enter main loop. */
     for (;;)
@@ -212,6 +433,7 @@ int main(void)
         if (NRF_LOG_PROCESS() == false)
         {
             nrf_pwr_mgmt_run();
+            NRG_CountWakeup();
         }
     }
 }
@@ -222,40 +444,44 @@ int main(void)
 
 static void ble_connection_event_handler(uint16_t ble_event)
 {
-    scheduler_event.type = SCHEDULER_EVENT_DUMMY;
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_DUMMY };
 
     switch (ble_event)
     {
         case BLE_GAP_EVT_CONNECTED:
-            scheduler_event.type = SCHEDULER_EVENT_CONNECTED;
+            /* Partial message of the previous connection is dropped, from the same context as host_rx_push */
+            FRAME_RxInit(&host_rx, host_rx_buffer, sizeof(host_rx_buffer));
+            host_frames_busy = 0;
+            event.type = SCHEDULER_EVENT_CONNECTED;
             break;
 
         case BLE_GAP_EVT_DISCONNECTED:
-            scheduler_event.type = SCHEDULER_EVENT_DISCONNECTED;
+            nus_started = false;
+            event.type = SCHEDULER_EVENT_DISCONNECTED;
             break;
 
         default:
             break;
     }
 
-    app_sched_event_put(&scheduler_event, sizeof(scheduler_event_t), scheduler_event_handler);
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
 }
 
 static void ble_advertising_event_handler(ble_adv_evt_t ble_adv_evt)
 {
-    scheduler_event.type = SCHEDULER_EVENT_DUMMY;
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_DUMMY };
 
     switch(ble_adv_evt)
     {
         case BLE_ADV_EVT_IDLE:
-            scheduler_event.type = SCHEDULER_EVENT_ADV_STOP;
+            event.type = SCHEDULER_EVENT_ADV_STOP;
             break;
 
         default:
             break;
     }
 
-    app_sched_event_put(&scheduler_event, sizeof(scheduler_event_t), scheduler_event_handler);
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
 }
 
 static void ble_uart_rx_data_handler(ble_nus_evt_t *p_evt)
@@ -263,15 +489,17 @@ static void ble_uart_rx_data_handler(ble_nus_evt_t *p_evt)
     switch (p_evt->type) 
     {
         case BLE_NUS_EVT_COMM_STARTED:
+            nus_started = true;
             rgb_led_set(false, true, false);
             break;
          
         case BLE_NUS_EVT_COMM_STOPPED:
+            nus_started = false;
             rgb_led_set(false, false, true);
             break;
 
         case BLE_NUS_EVT_RX_DATA:
-            pb_decode_message(p_evt->params.rx_data.p_data, p_evt->params.rx_data.length);
+            host_rx_push(p_evt->params.rx_data.p_data, p_evt->params.rx_data.length);
             break;
         
         default:
@@ -279,38 +507,213 @@ static void ble_uart_rx_data_handler(ble_nus_evt_t *p_evt)
     }
 }
 
-static void pb_decode_message(const uint8_t *p_data, uint16_t length)
+/**
+ * @brief Reassemble host messages from NUS writes, and queue the complete ones
+ * for the scheduler (called from the BLE event handler)
+ */
+static void host_rx_push(const uint8_t * p_data, uint16_t length)
+{
+    bool complete;
+    uint16_t used;
+
+    while (length > 0) {
+        used = FRAME_RxPush(&host_rx, p_data, length, &complete);
+        p_data += used;
+        length -= used;
+        if (complete) {
+            host_frame_queue();
+        }
+    }
+}
+
+/**
+ * @brief Copy the message just reassembled to a free frame, decoded from the scheduler
+ */
+static void host_frame_queue(void)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_HOST_MESSAGE };
+    host_frame_t * frame = NULL;
+
+    for (uint8_t n = 0; n < HOST_FRAME_NUM; n++) {
+        if (host_frames[n].queued == false) {
+            frame = &host_frames[n];
+            break;
+        }
+    }
+    if (frame == NULL) {
+        /* Host sends faster than the scheduler handles messages */
+        host_frames_busy++;
+        return;
+    }
+    memcpy(frame->data, host_rx.buffer, host_rx.length);
+    frame->length = host_rx.length;
+    frame->received_us = CAL_GetUptime();
+    frame->queued = true;
+    event.data = frame;
+    if (app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler) != NRF_SUCCESS) {
+        frame->queued = false;
+        host_frames_busy++;
+    }
+}
+
+/**
+ * @brief Decode a host message and run its handler. Each message gets a scheduler
+ * event of its own, so that SAADC buffers queued meanwhile are not held behind
+ * several of them.
+ */
+static void host_message_handle(host_frame_t * frame)
 {
-    if (length > sizeof(pb_message))
-    {
-        NRF_LOG_ERROR("Size of message is %u but max is %u", length, Timestamp_size + 1);
+    uint32_t cycles_from = LAT_GetCycles();
+    pb_istream_t istream = pb_istream_from_buffer(frame->data, frame->length);
+    bool status = pb_decode(&istream, HostMessage_fields, &hostMessage);
+    uint8_t n;
+
+    host_message_received_us = frame->received_us;
+    frame->queued = false;
+    if (!status) {
+        NRF_LOG_ERROR("protobuf decoding failed: %s", PB_GET_ERROR(&istream));
+        request_error_send(RequestErrorCode_REQUEST_ERROR_MALFORMED, 0);
         return;
     }
-    memcpy(pb_message, p_data, length);
-    /* COBS decode */
-    cobs_ret_t cobs_ret = cobs_decode_inplace(pb_message, length);
-    if (cobs_ret != COBS_RET_SUCCESS)
-    {
-        NRF_LOG_ERROR("error %d while decoding cobs", cobs_ret);
+
+    for (n = 0; n < ARRAY_SIZE(host_messages); n++) {
+        if (host_messages[n].tag == hostMessage.which_payload) {
+            host_messages[n].handler(&hostMessage);
+            break;
+        }
+    }
+    if (n == ARRAY_SIZE(host_messages)) {
+        NRF_LOG_WARNING("Unknown host message %u", hostMessage.which_payload);
+        request_error_send(RequestErrorCode_REQUEST_ERROR_UNKNOWN, hostMessage.request_id);
         return;
     }
 
-    /* Decode protobuf message (should be a request) */
-    pb_istream_t istream = pb_istream_from_buffer(pb_message + 1, length - 2);
-    bool status = pb_decode(&istream, Timestamp_fields, &timestamp);
-    if (!status) {
-        NRF_LOG_ERROR("protobuf decoding failed: %s\n", PB_GET_ERROR(&istream));
+    uint32_t us = LAT_CyclesToUs(LAT_GetCycles() - cycles_from);
+    if (us > HOST_MESSAGE_BUDGET_US) {
+        NRF_LOG_WARNING("Host message %u handled in %u us", hostMessage.which_payload, us);
+    }
+}
+
+static void timestamp_handle(const HostMessage * message)
+{
+    /* Spectra of a batch are relative to its first timestamp, send them before time changes */
+    eda_batch_send();
+    adaptive_reference_valid = false;
+    CAL_SetTime(message->payload.timestamp.time, message->payload.timestamp.us);
+}
+
+static void settings_handle(const HostMessage * message)
+{
+    const Settings * settings = &message->payload.settings;
+
+    impedance_encoding = settings->impedance_encoding;
+    NRF_LOG_INFO("Impedance encoding %u", impedance_encoding);
+    EDA_SetOverrunPolicy((settings->overrun_policy == OverrunPolicy_OVERRUN_POLICY_BLOCK) ?
+                         EDA_OVERRUN_BLOCK : EDA_OVERRUN_SKIP);
+    adaptive_threshold = settings->adaptive_threshold;
+    adaptive_interval_ms = (settings->adaptive_interval_ms > 0) ?
+                           settings->adaptive_interval_ms : EDA_ADAPTIVE_INTERVAL_MS;
+    adaptive_reference_valid = false;
+
+    /* Previous settings still wait: they are replaced, and keep their queued event */
+    if (settings_apply_pending) {
+        dsp_status_send(settings_request_id);
+    }
+    settings_output_mode = settings->output_mode;
+    settings_dsp_profile = (uint8_t)MIN(settings->dsp_profile, UINT8_MAX);
+    settings_request_id = message->request_id;
+    if (settings_apply_pending == false) {
+        settings_apply_pending = true;
+        settings_apply_continue();
+    }
+}
+
+/**
+ * @brief Apply the output mode and DSP profile of the last settings once the spectrum
+ * in progress is done. It is left to its own slices rather than completed within the
+ * host message budget, and this is tried again after them. Settings received meanwhile
+ * replace the pending ones, whose request only gets the DspStatus still in use.
+ */
+static void settings_apply_continue(void)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_SETTINGS_APPLY };
+
+    if (settings_apply_pending == false) {
+        return;
+    }
+    if (eda_fft_pending) {
+        eda_fft_step_schedule();
+    }
+    if (eda_fft_pending && (app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler) == NRF_SUCCESS)) {
         return;
     }
 
-    CAL_SetTime(timestamp.time, timestamp.us);
+    settings_apply_pending = false;
+    output_mode_apply(settings_output_mode);
+    dsp_profile_apply(settings_dsp_profile);
+    dsp_status_send(settings_request_id);
+}
+
+static void acquisition_request_handle(const HostMessage * message)
+{
+    acquisition_status_send(message->request_id);
+}
+
+static void energy_request_handle(const HostMessage * message)
+{
+    energy_report_send(message->request_id);
+    if (message->payload.energy_request.reset) {
+        NRG_Reset();
+    }
+}
+
+/**
+ * @brief Fit the device clock from the previous request, whose time of reception the
+ * host got in our reply and paired with its own time, then reply with this one's
+ */
+static void time_sync_handle(const HostMessage * message)
+{
+    const TimeSyncRequest * request = &message->payload.time_sync_request;
+    TimeSyncStatus status = TimeSyncStatus_init_zero;
+    tsync_model_t model;
+    uint64_t host_us, device_time;
+    uint32_t device_us;
+
+    if ((request->last_device_us != 0) && request->has_last_host_time) {
+        host_us = (request->last_host_time.time * 1000000ULL) + request->last_host_time.us;
+        /* Error of the model in use, before the fit */
+        CAL_GetUptimeTime(request->last_device_us, &device_time, &device_us);
+        status.error_us = (int32_t)MAX(INT32_MIN, MIN(INT32_MAX,
+                          (int64_t)((device_time * 1000000ULL) + device_us - host_us)));
+        if (TSYNC_AddSample(&time_sync, request->last_device_us, host_us, request->last_rtt_us, &model)) {
+            /* Spectra of a batch are relative to its first timestamp */
+            eda_batch_send();
+            CAL_SetClockModel(model.ref_us, model.offset_us, model.drift_ppm);
+            status.samples = model.samples;
+        }
+    }
+    status.device_us = host_message_received_us;
+    status.drift_ppm = time_sync.drift_ppm;
+    status.has_time = true;
+    CAL_GetUptimeTime(host_message_received_us, &status.time.time, &status.time.us);
+    status_message_send(DeviceMessage_time_sync_status_tag, TimeSyncStatus_fields, &status, message->request_id);
 }
 
 static void eda_event_handler(eda_event_t eda_event, void * data)
 {
-    scheduler_event.type = SCHEDULER_EVENT_EDA_BUFFER_FULL;
-    scheduler_event.data = data;
-    app_sched_event_put(&scheduler_event, sizeof(scheduler_event_t), scheduler_event_handler);
+    /* From the SAADC or edge counter interrupt, which preempt the other event sources: each event is built on the stack */
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_EDA_STOPPED };
+
+    if (eda_event == EDA_EVENT_STOPPED) {
+        app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
+        return;
+    }
+    event.type = SCHEDULER_EVENT_EDA_BUFFER_FULL;
+    event.data = data;
+    if (app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler) != NRF_SUCCESS) {
+        /* Scheduler queue full, the buffer would never be released */
+        EDA_ReleaseBuffer(data);
+    }
 }
 
 static void scheduler_event_handler(void * p_event, uint16_t size)
@@ -322,12 +725,25 @@ static void scheduler_event_handler(void * p_event, uint16_t size)
         case SCHEDULER_EVENT_CONNECTED:
             NRF_LOG_INFO("CONNECTED");
             fsm_state = FSM_STATE_CONNECTED;
+            /* Host time of another host, the drift of the device clock is kept */
+            TSYNC_Reset(&time_sync);
+            output_throughput_require();
             rgb_led_set(false, false, true);
             break;
 
         case SCHEDULER_EVENT_DISCONNECTED:
             NRF_LOG_INFO("DISCONNECTED");
             fsm_state = FSM_STATE_ADVERT;
+            /* NUS is stopped, batch in progress is dropped, settings of the host too */
+            settings_apply_pending = false;
+            eda_batch_send();
+            impedance_encoding = ImpedanceEncoding_IMPEDANCE_ENCODING_FLOAT;
+            EDA_SetOverrunPolicy(EDA_OVERRUN_SKIP);
+            log_download_stop();
+            output_mode_apply(OutputMode_OUTPUT_MODE_SPECTRA);
+            dsp_profile_apply(EDA_DSP_PROFILE_DEFAULT);
+            adaptive_threshold = 0.0f;
+            adaptive_interval_ms = EDA_ADAPTIVE_INTERVAL_MS;
             rgb_led_blink_blue();
             break;
 
@@ -339,38 +755,1092 @@ static void scheduler_event_handler(void * p_event, uint16_t size)
             break;
 
         case SCHEDULER_EVENT_EDA_BUFFER_FULL:
-            eda_send_fft(event->data);
+            eda_buffer_process(event->data);
+            break;
+
+        case SCHEDULER_EVENT_EDA_BATCH_TIMEOUT:
+            eda_batch_send();
+            break;
+
+        case SCHEDULER_EVENT_EDA_DSP_STEP:
+            eda_fft_step();
+            break;
+
+        case SCHEDULER_EVENT_HOST_MESSAGE:
+            host_message_handle(event->data);
+            break;
+
+        case SCHEDULER_EVENT_LOG_DOWNLOAD:
+            log_download_continue();
+            break;
+
+        case SCHEDULER_EVENT_LOG_ERASED:
+            NRF_LOG_INFO("Log erased");
+            log_status_send(log_request_id);
+            break;
+
+        case SCHEDULER_EVENT_CALIBRATION_STORE:
+            calibration_store_handle();
+            break;
+
+        case SCHEDULER_EVENT_EDA_STOPPED:
+            if (measurement_state == MeasurementState_MEASUREMENT_STATE_STOPPING) {
+                measurement_stop_complete();
+            }
+            break;
+
+        case SCHEDULER_EVENT_SETTINGS_APPLY:
+            settings_apply_continue();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Process a SAADC buffer then give it back to the frontend
+ */
+static void eda_buffer_process(eda_buffer_t * buffer)
+{
+    uint64_t time;
+    uint32_t us;
+
+    LAT_RecordTicks(LAT_STAGE_SAADC_WAIT, buffer->ticks);
+
+    /* Queued before the frontend was powered down */
+    if (measurement_state == MeasurementState_MEASUREMENT_STATE_IDLE) {
+        EDA_ReleaseBuffer(buffer);
+        return;
+    }
+
+    /* Slices of the previous spectrum did not all run before this buffer, the window needs them */
+    if (eda_fft_pending) {
+        eda_fft_complete();
+    }
+
+    if (buffer->contiguous == false) {
+        /* Samples were lost while the DSP was late, the window would mix both sides of the gap */
+        EDA_DSP_Init();
+        eda_window_refill = EDA_WINDOW_BUFFERS - 1;
+        /* Raw streaming host sees a gap in chunk sequence, as long as the buffers skipped
+           (a stalled SAADC skips no buffer but loses samples, counted as one buffer) */
+        uint32_t skipped = buffer->sequence - eda_last_sequence - 1;
+        if (skipped == 0) {
+            skipped = 1;
+        }
+        rawMessage.payload.raw_samples.sequence += skipped * (EDA_ADC_BUFFER_SIZE / EDA_RAW_CHUNK_SAMPLES);
+        CAL_GetTime(&time, &us);
+        if (time != acquisition_status_time) {
+            acquisition_status_time = time;
+            acquisition_status_send(0);
+        }
+    }
+
+    eda_last_sequence = buffer->sequence;
+
+    if (output_mode == OutputMode_OUTPUT_MODE_RAW_SAMPLES) {
+        eda_send_raw(buffer);
+    }
+    else {
+        eda_fft_begin(buffer);
+    }
+    EDA_ReleaseBuffer(buffer);
+}
+
+/**
+ * @brief Push the SAADC buffer into the DSP window, which frees the buffer, and
+ * compute its spectrum in later scheduler slices of one FFT at most, so that
+ * BLE and host events queued meanwhile are not held behind the whole spectrum
+ */
+static void eda_fft_begin(eda_buffer_t * buffer)
+{
+    uint32_t cycles_from = LAT_GetCycles();
+
+    EDA_DSP_Begin(buffer->samples, buffer->frame);
+    LAT_RecordCycles(LAT_STAGE_DSP_SLICE, cycles_from);
+
+    /* Spectrum is dated from its samples once computed, not from when the scheduler runs it */
+    eda_fft_frame = buffer->frame;
+    eda_fft_rtc_counter = buffer->rtc_counter;
+    /* Window is being refilled after lost samples */
+    eda_fft_discard = (eda_window_refill > 0);
+    if (eda_window_refill > 0) {
+        eda_window_refill--;
+    }
+    eda_fft_pending = true;
+    eda_fft_step_schedule();
+}
+
+/**
+ * @brief Run one step of the spectrum in progress
+ */
+static eda_dsp_status_t eda_fft_slice(void)
+{
+    eda_dsp_status_t status;
+    uint32_t cycles_from = LAT_GetCycles();
+
+    status = EDA_DSP_Step(eda_impedance);
+    LAT_RecordCycles(LAT_STAGE_DSP_SLICE, cycles_from);
+    if (status != EDA_DSP_PENDING) {
+        eda_fft_pending = false;
+    }
+    return status;
+}
+
+static void eda_fft_step(void)
+{
+    eda_dsp_status_t status;
+
+    eda_fft_step_queued = false;
+    /* Spectrum was completed or dropped since this slice was queued */
+    if (eda_fft_pending == false) {
+        return;
+    }
+
+    status = eda_fft_slice();
+    if (status == EDA_DSP_PENDING) {
+        eda_fft_step_schedule();
+    }
+    else if (status == EDA_DSP_DONE) {
+        eda_fft_output();
+    }
+}
+
+static void eda_fft_step_schedule(void)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_EDA_DSP_STEP };
+
+    if (eda_fft_step_queued) {
+        return;
+    }
+    if (app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler) == NRF_SUCCESS) {
+        eda_fft_step_queued = true;
+    }
+    else {
+        /* Scheduler queue full, do not leave the spectrum behind */
+        eda_fft_complete();
+    }
+}
+
+/**
+ * @brief Run the remaining steps of the spectrum in progress at once
+ */
+static void eda_fft_complete(void)
+{
+    eda_dsp_status_t status;
+
+    do {
+        status = eda_fft_slice();
+    } while (status == EDA_DSP_PENDING);
+
+    if (status == EDA_DSP_DONE) {
+        eda_fft_output();
+    }
+}
+
+/**
+ * @brief Add the computed spectrum to the batch, or to the log if nobody listens
+ */
+static void eda_fft_output(void)
+{
+    EdaBatch * batch = &deviceMessage.payload.eda_batch;
+    EdaSpectrum * spectrum;
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_EDA_BATCH_TIMEOUT };
+
+    if (eda_fft_discard) {
+        return;
+    }
+    eda_fft_timestamp();
+
+    /* Nobody to send it to, keep it for a later download */
+    if (nus_started == false) {
+        log_spectrum_add(eda_fft_time, eda_fft_us, eda_impedance);
+        return;
+    }
+    log_record_flush();
+
+    if (eda_rate_decimate()) {
+        return;
+    }
+
+    /* Full batch still waits for its slice */
+    if (batch->spectra_count >= EDA_BATCH_SIZE) {
+        eda_batch_send();
+    }
+
+    spectrum = &batch->spectra[batch->spectra_count];
+    if (impedance_encoding == ImpedanceEncoding_IMPEDANCE_ENCODING_HALF) {
+        impedance_pack_half(eda_impedance, EDA_DSP_GetFrequencyNum(), spectrum);
+    }
+    else {
+        memcpy(spectrum->data, eda_impedance, EDA_DSP_GetFrequencyNum() * sizeof(Impedance));
+        spectrum->data_count = EDA_DSP_GetFrequencyNum();
+        spectrum->data_half.size = 0;
+        spectrum->half_exponent = 0;
+    }
+
+    /* First spectrum of the batch gives the base timestamp and starts latency deadline */
+    if (batch->spectra_count == 0) {
+        batch->timestamp.time = eda_fft_time;
+        batch->timestamp.us = eda_fft_us;
+        app_timer_start(eda_batch_timer_id, APP_TIMER_TICKS(EDA_BATCH_LATENCY_MS), NULL);
+    }
+    spectrum->delta_us = (uint32_t)((int64_t)(eda_fft_time - batch->timestamp.time) * 1000000
+                                    + (int64_t)eda_fft_us - (int64_t)batch->timestamp.us);
+    spectrum->skipped = adaptive_skipped;
+    adaptive_skipped = 0;
+    batch->spectra_count++;
+
+    /* Encoding and COBS of the batch is a slice of its own */
+    if (batch->spectra_count >= EDA_BATCH_SIZE) {
+        if (app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler) != NRF_SUCCESS) {
+            eda_batch_send();
+        }
+    }
+}
+
+/**
+ * @brief Date the spectrum computed at the centre of its analysis window. The DSP
+ * gives the frame there, the RTC counter was latched with the last frame pushed.
+ */
+static void eda_fft_timestamp(void)
+{
+    uint32_t counter = eda_fft_rtc_counter - (eda_fft_frame - EDA_DSP_GetFrame());
+    uint32_t us;
+
+    CAL_GetCounterTime(counter, &eda_fft_time, &us);
+    us += EDA_HALF_SAMPLE_US;
+    if (us >= 1000000) {
+        us -= 1000000;
+        eda_fft_time++;
+    }
+    eda_fft_us = us;
+}
+
+/**
+ * @brief Adaptive rate: tell whether the computed spectrum can be left out, because
+ * |Z| moved less than adaptive_threshold at every frequency since the last spectrum
+ * sent, and adaptive_interval_ms has not elapsed yet
+ */
+static bool eda_rate_decimate(void)
+{
+    uint64_t time_us = (eda_fft_time * 1000000) + eda_fft_us;
+    uint8_t count = EDA_DSP_GetFrequencyNum();
+    bool changed = (adaptive_reference_valid == false) ||
+                   (time_us < adaptive_time_us) ||
+                   ((time_us - adaptive_time_us) >= ((uint64_t)adaptive_interval_ms * 1000));
+    uint8_t n;
+
+    if (adaptive_threshold <= 0.0f) {
+        adaptive_skipped = 0;
+        return false;
+    }
+
+    for (n = 0; (n < count) && (changed == false); n++) {
+        float magnitude = hypotf(eda_impedance[n].real, eda_impedance[n].imag);
+        changed = (fabsf(magnitude - adaptive_magnitude[n]) > (adaptive_threshold * adaptive_magnitude[n]));
+    }
+    if (changed == false) {
+        adaptive_skipped++;
+        return true;
+    }
+
+    /* Spectrum is sent, next ones are compared to it */
+    for (n = 0; n < count; n++) {
+        adaptive_magnitude[n] = hypotf(eda_impedance[n].real, eda_impedance[n].imag);
+    }
+    adaptive_time_us = time_us;
+    adaptive_reference_valid = true;
+    return false;
+}
+
+static void eda_batch_send(void)
+{
+    EdaBatch * batch = &deviceMessage.payload.eda_batch;
+
+    if (batch->spectra_count == 0) {
+        return;
+    }
+    app_timer_stop(eda_batch_timer_id);
+
+    /* Host went away before the batch was complete */
+    if (nus_started == false) {
+        batch->spectra_count = 0;
+        return;
+    }
+
+    /* First packet is sent while the rest of the message is being encoded */
+    BLE_UartBeginMessage();
+    bool ret = FRAME_SendMessage(&ble_tx_stream, BLE_UartSendPacket, ble_tx_packet, BLE_GetMtu(),
+                                 DeviceMessage_fields, &deviceMessage);
+    batch->spectra_count = 0;
+    if ((ret == false) && (ble_tx_stream.bytes_sent > 0)) {
+        NRF_LOG_WARNING("EdaBatch truncated after %u bytes", ble_tx_stream.bytes_sent);
+    }
+}
+
+static void eda_batch_timer_handler(void *p_context)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_EDA_BATCH_TIMEOUT };
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
+}
+
+/**
+ * @brief Send the SAADC buffer as RawSamples messages. A message the NUS TX
+ * queue has no room for is dropped rather than waited for, so that the next
+ * buffers are not delayed, and its sequence number is skipped.
+ */
+static void eda_send_raw(eda_buffer_t * buffer)
+{
+    RawSamples * raw = &rawMessage.payload.raw_samples;
+    uint16_t mtu = BLE_GetMtu();
+    uint16_t packets = (EDA_RAW_FRAME_MAX + mtu - 1) / mtu;
+    uint32_t first_counter = buffer->rtc_counter - ((buffer->length / 2) - 1);
+    uint64_t time;
+    uint32_t us;
+    uint16_t offset;
+
+    for (offset = 0; (offset + (2 * EDA_RAW_CHUNK_SAMPLES)) <= buffer->length; offset += 2 * EDA_RAW_CHUNK_SAMPLES) {
+        if (BLE_UartGetTxQueueFree() < packets) {
+            raw_chunks_dropped++;
+        }
+        else {
+            /* One RTC tick per sample pair */
+            CAL_GetCounterTime(first_counter + (offset / 2), &time, &us);
+            raw->timestamp.time = time;
+            raw->timestamp.us = us;
+            raw_samples_pack(&buffer->samples[offset], 2 * EDA_RAW_CHUNK_SAMPLES, raw->data.bytes);
+            raw->data.size = EDA_RAW_CHUNK_SIZE;
+            BLE_UartBeginMessage();
+            if (FRAME_SendMessage(&ble_tx_stream, BLE_UartSendPacket, ble_tx_packet, mtu,
+                                  DeviceMessage_fields, &rawMessage) == false) {
+                raw_chunks_dropped++;
+            }
+        }
+        raw->sequence++;
+    }
+}
+
+/**
+ * @brief Pack samples as EDA_RAW_SAMPLE_BITS two's complement values, least
+ * significant bit first (count * EDA_RAW_SAMPLE_BITS must be a multiple of 8)
+ */
+static void raw_samples_pack(const int16_t * samples, uint16_t count, uint8_t * out)
+{
+    uint32_t bits = 0;
+    uint8_t bit_count = 0;
+    uint16_t n;
+
+    for (n = 0; n < count; n++) {
+        bits |= ((uint32_t)(uint16_t)samples[n] & ((1UL << EDA_RAW_SAMPLE_BITS) - 1)) << bit_count;
+        bit_count += EDA_RAW_SAMPLE_BITS;
+        while (bit_count >= 8) {
+            *out++ = (uint8_t)(bits & 0xFF);
+            bits >>= 8;
+            bit_count -= 8;
+        }
+    }
+}
+
+/**
+ * @brief Switch between spectra and raw samples output
+ */
+static void output_mode_apply(OutputMode mode)
+{
+    if (mode == output_mode) {
+        return;
+    }
+    if (mode == OutputMode_OUTPUT_MODE_RAW_SAMPLES) {
+        /* Send spectra already computed, sequence restarts for the host */
+        if (eda_fft_pending) {
+            eda_fft_complete();
+        }
+        eda_batch_send();
+        rawMessage.payload.raw_samples.sequence = 0;
+        raw_chunks_dropped = 0;
+    }
+    else {
+        /* Analysis window still holds samples from before raw streaming */
+        EDA_DSP_Init();
+        eda_window_refill = EDA_WINDOW_BUFFERS - 1;
+        adaptive_reference_valid = false;
+    }
+    output_mode = mode;
+    output_throughput_require();
+    NRF_LOG_INFO("Output mode %u", mode);
+}
+
+/**
+ * @brief Switch the DSP analysis window and frequencies. Spectra computed with the
+ * previous profile are sent or logged first, so that a batch or a log record never
+ * mixes frequency sets.
+ */
+static void dsp_profile_apply(uint8_t profile)
+{
+    if (profile == EDA_DSP_GetProfile()) {
+        return;
+    }
+    if (eda_fft_pending) {
+        eda_fft_complete();
+    }
+    eda_batch_send();
+    log_record_flush();
+
+    if (EDA_DSP_SetProfile(profile) == false) {
+        NRF_LOG_WARNING("Unknown DSP profile %u", profile);
+        return;
+    }
+    /* Window is empty, spectra are output again once it is full */
+    eda_window_refill = EDA_WINDOW_BUFFERS - 1;
+    adaptive_reference_valid = false;
+    NRF_LOG_INFO("DSP profile %u, %u points, %u frequencies", profile,
+                 EDA_DSP_GetWindowSize(), EDA_DSP_GetFrequencyNum());
+}
+
+/**
+ * @brief Send the analysis window and frequencies of the spectra
+ */
+static void dsp_status_send(uint32_t request_id)
+{
+    DspStatus status = DspStatus_init_zero;
+
+    if (nus_started == false) {
+        return;
+    }
+    status.profile = EDA_DSP_GetProfile();
+    status.fft_size = EDA_DSP_GetWindowSize();
+    status.frequencies_count = EDA_DSP_GetFrequencyNum();
+    for (uint8_t n = 0; n < status.frequencies_count; n++) {
+        status.frequencies[n] = EDA_DSP_GetFrequency(n);
+    }
+
+    status_message_send(DeviceMessage_dsp_status_tag, DspStatus_fields, &status, request_id);
+}
+
+/**
+ * @brief Start or stop the frontend. A stop waits for the waveform to be back to
+ * zero current, the status is sent once the frontend is powered down.
+ */
+static void measurement_request_handle(const HostMessage * message)
+{
+    /* EDA_EVENT_STOPPED found the scheduler queue full */
+    if ((measurement_state == MeasurementState_MEASUREMENT_STATE_STOPPING) &&
+        (EDA_GetState() == EDA_STATE_STOPPED)) {
+        measurement_stop_complete();
+    }
+
+    switch (message->payload.measurement_request.action) {
+        case MeasurementAction_MEASUREMENT_ACTION_START:
+            if (measurement_state != MeasurementState_MEASUREMENT_STATE_IDLE) {
+                break;
+            }
+            /* Window is empty, spectra are output again once it is full */
+            EDA_DSP_Init();
+            eda_window_refill = EDA_WINDOW_BUFFERS - 1;
+            adaptive_reference_valid = false;
+            eda_last_sequence = UINT32_MAX;
+            EDA_Init(eda_event_handler);
+            measurement_state = MeasurementState_MEASUREMENT_STATE_RUNNING;
+            NRF_LOG_INFO("Measurement started");
             break;
 
+        case MeasurementAction_MEASUREMENT_ACTION_STOP:
+            if (measurement_state != MeasurementState_MEASUREMENT_STATE_RUNNING) {
+                break;
+            }
+            EDA_Stop();
+            measurement_state = MeasurementState_MEASUREMENT_STATE_STOPPING;
+            measurement_request_id = message->request_id;
+            return;
+
         default:
             break;
     }
+    measurement_status_send(message->request_id);
+}
+
+/**
+ * @brief Frontend clock stopped at zero current: output the spectra computed, then
+ * power the SAADC, PPI, edge counter and FPU interrupt down
+ */
+static void measurement_stop_complete(void)
+{
+    if (eda_fft_pending) {
+        eda_fft_complete();
+    }
+    eda_batch_send();
+    log_record_flush();
+
+    EDA_Deinit();
+    EDA_DSP_Deinit();
+    measurement_state = MeasurementState_MEASUREMENT_STATE_IDLE;
+    NRF_LOG_INFO("Measurement stopped");
+    measurement_status_send(measurement_request_id);
+}
+
+/**
+ * @brief Send the frontend state
+ */
+static void measurement_status_send(uint32_t request_id)
+{
+    MeasurementStatus status = MeasurementStatus_init_zero;
+
+    if (nus_started == false) {
+        return;
+    }
+    status.state = measurement_state;
+
+    status_message_send(DeviceMessage_measurement_status_tag, MeasurementStatus_fields, &status, request_id);
+}
+
+/**
+ * @brief Tell the host why its message was not handled
+ */
+static void request_error_send(RequestErrorCode code, uint32_t request_id)
+{
+    RequestError error = RequestError_init_zero;
+
+    error.code = code;
+    error.dropped = host_rx.dropped + host_frames_busy;
+    status_message_send(DeviceMessage_request_error_tag, RequestError_fields, &error, request_id);
+}
+
+/**
+ * @brief Send a DeviceMessage holding one status submessage, with the request_id
+ * of the host message it replies to (left out if 0)
+ */
+static void status_message_send(pb_size_t tag, const pb_msgdesc_t * fields, const void * status, uint32_t request_id)
+{
+    if (nus_started == false) {
+        return;
+    }
+
+    BLE_UartBeginMessage();
+    FRAME_Begin(&ble_tx_stream, BLE_UartSendPacket, ble_tx_packet, BLE_GetMtu());
+    pb_ostream_t ostream = FRAME_GetOstream(&ble_tx_stream);
+    if (pb_encode_tag(&ostream, PB_WT_STRING, tag) &&
+        pb_encode_submessage(&ostream, fields, status) &&
+        ((request_id == 0) ||
+         (pb_encode_tag(&ostream, PB_WT_VARINT, DeviceMessage_request_id_tag) &&
+          pb_encode_varint(&ostream, request_id)))) {
+        FRAME_End(&ble_tx_stream);
+    }
+    else {
+        ble_tx_stream.error = true;
+    }
+}
+
+/**
+ * @brief Tell the BLE module the throughput needed by the current output
+ */
+static void output_throughput_require(void)
+{
+    if (log_downloading) {
+        BLE_SetRequiredThroughput(LOG_DOWNLOAD_THROUGHPUT);
+    }
+    else if (output_mode == OutputMode_OUTPUT_MODE_RAW_SAMPLES) {
+        BLE_SetRequiredThroughput(EDA_RAW_CHUNK_RATE_HZ * EDA_RAW_FRAME_MAX);
+    }
+    else {
+        /* Worst case spectrum size, measured throughput takes over once batches are sent */
+        BLE_SetRequiredThroughput(EDA_SPECTRUM_RATE_HZ * EdaSpectrum_size);
+    }
 }
 
-static void eda_send_fft(eda_buffer_t * buffer)
+/**
+ * @brief Send SAADC to DSP handoff counters
+ */
+static void acquisition_status_send(uint32_t request_id)
+{
+    AcquisitionStatus status;
+    eda_stats_t eda_stats;
+
+    if (nus_started == false) {
+        return;
+    }
+    EDA_GetStats(&eda_stats);
+    status.buffers = eda_stats.buffers;
+    status.overruns = eda_stats.overruns;
+    status.stalls = eda_stats.stalls;
+    status.held_max = eda_stats.held_max;
+    status.pool_size = EDA_ADC_POOL_SIZE;
+    status.tx_dropped = raw_chunks_dropped;
+
+    status_message_send(DeviceMessage_acquisition_status_tag, AcquisitionStatus_fields, &status, request_id);
+}
+
+/**
+ * @brief Send the charge budget since boot or last reset, with the runtime left at the measured current
+ */
+static void energy_report_send(uint32_t request_id)
 {
-    //NRF_LOG_RAW_INFO("t1");
-    int ret = EDA_DSP_GetImpedance(buffer->samples, edaBuffer.data);
-    if (ret != 0) {
+    EnergyReport report = EnergyReport_init_zero;
+    nrg_report_t nrg_report;
+
+    if (nus_started == false) {
         return;
     }
-    CAL_GetTime(&(edaBuffer.timestamp.time), &(edaBuffer.timestamp.us));
-    //NRF_LOG_INFO("%llu.%06lu", edaBuffer.timestamp.time, edaBuffer.timestamp.us);
-    pb_ostream_t ostream = pb_ostream_from_buffer(ble_tx_packet + 1, EdaBuffer_size);
-    bool pb_ret = pb_encode(&ostream, EdaBuffer_fields, &edaBuffer);
-    if (pb_ret == false) {
-        NRF_LOG_ERROR("Error while encoding protobuf : %s", ostream.errmsg);
+    NRG_GetReport(&nrg_report);
+    report.period_s = nrg_report.period_ms / 1000;
+    report.wakeups = nrg_report.wakeups;
+    report.radio_events = nrg_report.radio_events;
+    report.subsystems_count = NRG_SUBSYSTEM_NUM;
+    for (uint8_t n = 0; n < NRG_SUBSYSTEM_NUM; n++) {
+        report.subsystems[n].subsystem = (EnergySubsystem)n;
+        report.subsystems[n].active_ms = (uint32_t)(nrg_report.active_us[n] / 1000);
+        report.subsystems[n].charge_uah = nrg_report.estimated_uah[n];
+    }
+    report.measured_uah = nrg_report.measured_uah;
+    if (nrg_report.period_ms > 0) {
+        report.average_ua = (int32_t)(((int64_t)nrg_report.measured_uah * 3600000) / nrg_report.period_ms);
+    }
+    report.remaining_mah = nrg_report.remaining_mah;
+    if (report.average_ua > 0) {
+        report.runtime_min = (uint32_t)(((uint64_t)nrg_report.remaining_mah * 1000 * 60) / (uint32_t)report.average_ua);
+    }
+
+    status_message_send(DeviceMessage_energy_report_tag, EnergyReport_fields, &report, request_id);
+}
+
+static void calibration_request_handle(const HostMessage * message)
+{
+    const CalibrationRequest * request = &message->payload.calibration_request;
+    eda_calib_t calib;
+
+    calibration_error = false;
+    calibration_request_id = message->request_id;
+    switch (request->action) {
+        case CalibrationAction_CALIBRATION_ACTION_STATUS:
+            break;
+
+        case CalibrationAction_CALIBRATION_ACTION_SET:
+            EDA_CALIB_Get(&calib);
+            if (request->has_parameters) {
+                calib.delay = request->parameters.delay_s;
+                calib.skew = request->parameters.skew_s;
+                calib.tia_resistance = request->parameters.tia_resistance;
+            }
+            for (pb_size_t n = 0; n < request->points_count; n++) {
+                const CalibrationPoint * point = &request->points[n];
+                if (point->index >= EDA_FREQUENCY_NUM) {
+                    continue;
+                }
+                if (point->has_gain) {
+                    calib.gain[point->index] = point->gain.real + (point->gain.imag * I);
+                }
+                if (point->has_offset) {
+                    calib.offset[point->index] = point->offset.real + (point->offset.imag * I);
+                }
+            }
+            /* Parameters left at the proto3 default (0 Ohm TIA) would cancel every spectrum */
+            if (EDA_CALIB_IsValid(&calib) == false) {
+                NRF_LOG_WARNING("Calibration refused");
+                calibration_error = true;
+                break;
+            }
+            EDA_CALIB_Load(&calib);
+            calibration_stored = false;
+            break;
+
+        case CalibrationAction_CALIBRATION_ACTION_STORE:
+            EDA_CALIB_Get(&calib);
+            if (CSTORE_Write(&calib)) {
+                /* Status is sent once written */
+                return;
+            }
+            calibration_error = true;
+            break;
+
+        case CalibrationAction_CALIBRATION_ACTION_ERASE:
+            if (CSTORE_Erase()) {
+                return;
+            }
+            calibration_error = true;
+            break;
+
+        default:
+            NRF_LOG_WARNING("Unknown calibration action %u", request->action);
+            calibration_error = true;
+            break;
+    }
+    calibration_status_send(message->request_id);
+}
+
+/**
+ * @brief Apply the calibration read from flash at startup, or tell the host
+ * the outcome of its store or erase request
+ */
+static void calibration_store_handle(void)
+{
+    eda_calib_t calib;
+
+    switch (calibration_store_event) {
+        case CSTORE_EVENT_LOADED:
+            if (CSTORE_Get(&calib) == false) {
+                return;
+            }
+            /* Stored before parameters were checked, defaults stay in use */
+            if (EDA_CALIB_IsValid(&calib) == false) {
+                NRF_LOG_WARNING("Stored calibration is not valid");
+                return;
+            }
+            EDA_CALIB_Load(&calib);
+            calibration_stored = true;
+            NRF_LOG_INFO("Calibration loaded");
             return;
+
+        case CSTORE_EVENT_WRITTEN:
+            calibration_stored = true;
+            break;
+
+        case CSTORE_EVENT_ERASED:
+            EDA_CALIB_Init();
+            calibration_stored = false;
+            break;
+
+        default:
+            calibration_error = true;
+            break;
+    }
+    calibration_status_send(calibration_request_id);
+}
+
+static void calibration_status_send(uint32_t request_id)
+{
+    CalibrationStatus status = CalibrationStatus_init_zero;
+    eda_calib_t calib;
+
+    if (nus_started == false) {
+        return;
+    }
+    EDA_CALIB_Get(&calib);
+    status.has_parameters = true;
+    status.parameters.delay_s = calib.delay;
+    status.parameters.skew_s = calib.skew;
+    status.parameters.tia_resistance = calib.tia_resistance;
+    status.points_count = EDA_FREQUENCY_NUM;
+    for (uint8_t n = 0; n < EDA_FREQUENCY_NUM; n++) {
+        status.points[n].index = n;
+        status.points[n].has_gain = true;
+        status.points[n].gain.real = crealf(calib.gain[n]);
+        status.points[n].gain.imag = cimagf(calib.gain[n]);
+        status.points[n].has_offset = true;
+        status.points[n].offset.real = crealf(calib.offset[n]);
+        status.points[n].offset.imag = cimagf(calib.offset[n]);
+    }
+    status.stored = calibration_stored;
+    status.error = calibration_error;
+
+    status_message_send(DeviceMessage_calibration_status_tag, CalibrationStatus_fields, &status, request_id);
+}
+
+static void cstore_event_handler(cstore_event_t cstore_event)
+{
+    calibration_store_event = cstore_event;
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_CALIBRATION_STORE };
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
+}
+
+/**
+ * @brief Encode the processing stage durations, on diagnostics characteristic read
+ * (called from the BLE event handler)
+ */
+static uint16_t latency_report_read(uint8_t const ** p_data)
+{
+    lat_stats_t stats;
+    pb_ostream_t ostream;
+
+    latencyReport.stages_count = 0;
+    for (uint8_t stage = 0; stage < LAT_STAGE_NUM; stage++) {
+        LAT_GetStats((lat_stage_t)stage, &stats);
+        if (stats.count == 0) {
+            continue;
+        }
+        StageLatency * report = &latencyReport.stages[latencyReport.stages_count++];
+        report->stage = (LatencyStage)stage;
+        report->count = stats.count;
+        report->min_us = stats.min;
+        report->max_us = stats.max;
+        report->mean_us = (uint32_t)(stats.total / stats.count);
+        report->histogram_count = LAT_HISTOGRAM_BINS;
+        memcpy(report->histogram, stats.histogram, sizeof(report->histogram));
+    }
+
+    ostream = pb_ostream_from_buffer(latency_report_value, sizeof(latency_report_value));
+    if (pb_encode(&ostream, LatencyReport_fields, &latencyReport) == false) {
+        /* Histogram counts grow with uptime, keep the summary only */
+        for (uint8_t n = 0; n < latencyReport.stages_count; n++) {
+            latencyReport.stages[n].histogram_count = 0;
+        }
+        ostream = pb_ostream_from_buffer(latency_report_value, sizeof(latency_report_value));
+        if (pb_encode(&ostream, LatencyReport_fields, &latencyReport) == false) {
+            ostream.bytes_written = 0;
+        }
+    }
+    *p_data = latency_report_value;
+    return (uint16_t)ostream.bytes_written;
+}
+
+static void flog_event_handler(flog_event_t flog_event)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_LOG_ERASED };
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
+}
+
+static void log_request_handle(const HostMessage * message)
+{
+    /* Host gets the spectra recorded until it started notifications too */
+    log_record_flush();
+
+    /* Download goes on after this request, with its parameters */
+    log_request = message->payload.log_request;
+    log_request_id = message->request_id;
+
+    switch (log_request.action)
+    {
+        case LogAction_LOG_ACTION_STATUS:
+            log_status_send(log_request_id);
+            break;
+
+        case LogAction_LOG_ACTION_DOWNLOAD:
+            NRF_LOG_INFO("Log download since %u", (uint32_t)log_request.since);
+            FLOG_ReadBegin(&log_reader, (log_request.since > UINT32_MAX) ? UINT32_MAX : (uint32_t)log_request.since);
+            log_decoding = false;
+            log_batch_ready = false;
+            log_downloading = true;
+            output_throughput_require();
+            log_download_continue();
+            break;
+
+        case LogAction_LOG_ACTION_ERASE:
+            log_download_stop();
+            if (FLOG_Erase() == false) {
+                /* Flash busy, current status tells the host nothing was erased */
+                log_status_send(log_request_id);
+            }
+            break;
+
+        default:
+            NRF_LOG_WARNING("Unknown log action %u", log_request.action);
+            break;
     }
-    ble_tx_packet[0] = COBS_INPLACE_SENTINEL_VALUE;
-    ble_tx_packet[ostream.bytes_written + 1] = COBS_INPLACE_SENTINEL_VALUE;
-    cobs_ret_t cobs_ret = cobs_encode_inplace(ble_tx_packet, ostream.bytes_written + 2);
-    // check for cobs_ret value
-    if (cobs_ret != COBS_RET_SUCCESS) {
-        NRF_LOG_ERROR("Error while encoding COBS message (err %u)", cobs_ret);
+}
+
+/**
+ * @brief Send logged spectra as long as the NUS TX queue has room for them,
+ * then come back later rather than wait so that live data keeps flowing
+ */
+static void log_download_continue(void)
+{
+    size_t size;
+
+    while (log_downloading) {
+        if (nus_started == false) {
+            log_download_stop();
             return;
+        }
+        if ((log_batch_ready == false) && (log_batch_fill() == false)) {
+            log_download_stop();
+            log_status_send(log_request_id);
+            return;
+        }
+        log_batch_ready = true;
+
+        uint16_t mtu = BLE_GetMtu();
+        pb_get_encoded_size(&size, DeviceMessage_fields, &logMessage);
+        uint16_t packets = (COBS_ENCODE_MAX(size) + 1 + mtu - 1) / mtu;
+        if (packets > BLE_UART_TX_QUEUE_SIZE) {
+            packets = BLE_UART_TX_QUEUE_SIZE;
+        }
+        if (BLE_UartGetTxQueueFree() < packets) {
+            app_timer_start(log_download_timer_id, APP_TIMER_TICKS(LOG_DOWNLOAD_RETRY_MS), NULL);
+            return;
+        }
+        BLE_UartBeginMessage();
+        FRAME_SendMessage(&ble_tx_stream, BLE_UartSendPacket, ble_tx_packet, mtu, DeviceMessage_fields, &logMessage);
+        log_batch_ready = false;
+    }
+}
+
+static void log_download_stop(void)
+{
+    if (log_downloading) {
+        app_timer_stop(log_download_timer_id);
+        log_downloading = false;
+        output_throughput_require();
     }
-    BLE_UartSendArray((uint8_t *)ble_tx_packet, ostream.bytes_written + 2);
+}
+
+static void log_download_timer_handler(void *p_context)
+{
+    scheduler_event_t event = { .type = SCHEDULER_EVENT_LOG_DOWNLOAD };
+    app_sched_event_put(&event, sizeof(scheduler_event_t), scheduler_event_handler);
+}
+
+/**
+ * @brief Compress a spectrum in the current log record, the record is written
+ * to flash once full
+ */
+static void log_spectrum_add(uint64_t time, uint32_t us, const Impedance * impedance)
+{
+    uint64_t time_us = (time * 1000000) + us;
+
+    if (SCODEC_EncodeSpectrum(&log_encoder, time_us, impedance, EDA_DSP_GetFrequencyNum()) == false) {
+        log_record_flush();
+        SCODEC_EncodeSpectrum(&log_encoder, time_us, impedance, EDA_DSP_GetFrequencyNum());
+    }
+}
+
+/**
+ * @brief Write the current log record to flash, if it holds any spectrum
+ */
+static void log_record_flush(void)
+{
+    if (log_encoder.spectrum_count == 0) {
+        return;
+    }
+    /* Record time is the time of its last spectrum, so that a download skips records ending before since */
+    FLOG_Append((uint32_t)(log_encoder.last_time_us / 1000000), log_record, log_encoder.length);
+    SCODEC_EncodeBegin(&log_encoder, log_record, sizeof(log_record));
+}
+
+/**
+ * @brief Decode logged spectra into logMessage, up to EDA_BATCH_SIZE of them
+ * @return false if there is no spectrum left in the log
+ */
+static bool log_batch_fill(void)
+{
+    EdaBatch * batch = &logMessage.payload.log_batch;
+    Impedance impedance[EDA_FREQUENCY_NUM];
+    uint64_t time_us;
+    uint16_t count;
+
+    batch->spectra_count = 0;
+    while (batch->spectra_count < EDA_BATCH_SIZE) {
+        if (log_decoding == false) {
+            const uint8_t * data;
+            uint16_t length;
+            if (FLOG_Read(&log_reader, &data, &length) == false) {
+                break;
+            }
+            /* Flash page may be erased for a new record while it is being sent */
+            memcpy(log_download_record, data, length);
+            FLOG_ReadNext(&log_reader);
+            log_decoding = SCODEC_DecodeBegin(&log_decoder, log_download_record, length);
+            continue;
+        }
+        if (SCODEC_DecodeSpectrum(&log_decoder, &time_us, impedance, EDA_FREQUENCY_NUM, &count) == false) {
+            log_decoding = false;
+            continue;
+        }
+        if ((time_us / 1000000) < log_request.since) {
+            continue;
+        }
+
+        EdaSpectrum * spectrum = &batch->spectra[batch->spectra_count];
+        if (batch->spectra_count == 0) {
+            batch->timestamp.time = time_us / 1000000;
+            batch->timestamp.us = time_us % 1000000;
+        }
+        spectrum->delta_us = (uint32_t)(time_us - ((batch->timestamp.time * 1000000) + batch->timestamp.us));
+        impedance_pack_half(impedance, count, spectrum);
+        batch->spectra_count++;
+    }
+    return (batch->spectra_count > 0);
+}
+
+static void log_status_send(uint32_t request_id)
+{
+    LogStatus status;
+    flog_status_t flog_status;
+
+    if (nus_started == false) {
+        return;
+    }
+    FLOG_GetStatus(&flog_status);
+    status.batch_count = flog_status.record_count;
+    status.used_bytes = flog_status.used;
+    status.size_bytes = flog_status.size;
+    status.dropped = flog_status.dropped;
+    status.overwritten = flog_status.overwritten;
+
+    status_message_send(DeviceMessage_log_status_tag, LogStatus_fields, &status, request_id);
+}
+
+/**
+ * @brief Pack impedance as half floats sharing one exponent, so that the largest
+ * component lies in [2^14, 2^15) and every value keeps 11 significant bits
+ */
+static void impedance_pack_half(const Impedance * impedance, uint16_t count, EdaSpectrum * spectrum)
+{
+    float max = 0.0f;
+    int exponent = 0;
+    uint16_t n;
+
+    for (n = 0; n < count; n++) {
+        max = fmaxf(max, fmaxf(fabsf(impedance[n].real), fabsf(impedance[n].imag)));
+    }
+    if (max > 0.0f) {
+        frexpf(max, &exponent);
+        exponent -= 15;
+    }
+
+    for (n = 0; n < count; n++) {
+        uint16_t real = float_to_half(ldexpf(impedance[n].real, -exponent));
+        uint16_t imag = float_to_half(ldexpf(impedance[n].imag, -exponent));
+        spectrum->data_half.bytes[(4*n)]     = (uint8_t)(real & 0xFF);
+        spectrum->data_half.bytes[(4*n) + 1] = (uint8_t)(real >> 8);
+        spectrum->data_half.bytes[(4*n) + 2] = (uint8_t)(imag & 0xFF);
+        spectrum->data_half.bytes[(4*n) + 3] = (uint8_t)(imag >> 8);
+    }
+    spectrum->data_half.size = 4 * count;
+    spectrum->half_exponent = exponent;
+    spectrum->data_count = 0;
+}
+
+/**
+ * @brief Convert to IEEE 754 half float, rounding to nearest even
+ */
+static uint16_t float_to_half(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+    uint32_t half, remainder, halfway;
+
+    if (((bits >> 23) & 0xFF) == 0xFF) {
+        /* Infinity or NaN */
+        return sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0);
+    }
+    if (exponent >= 31) {
+        /* Overflow */
+        return sign | 0x7C00;
+    }
+    if (exponent <= 0) {
+        /* Subnormal half, or zero */
+        if (exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - exponent);
+        half = mantissa >> shift;
+        remainder = mantissa & ((1UL << shift) - 1);
+        halfway = 1UL << (shift - 1);
+    }
+    else {
+        half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1FFF;
+        halfway = 0x1000;
+    }
+    if ((remainder > halfway) || ((remainder == halfway) && ((half & 1) != 0))) {
+        /* A carry into the exponent is still the right rounding */
+        half++;
+    }
+    return sign | (uint16_t)half;
 }
 
 static void rgb_led_init(void)
@@ -410,6 +1880,21 @@ static void batt_timer_handler(void *p_context)
     uint8_t soc = FGA_GetStateOfCharge();
     BLE_BatteryLevelUpdate(soc);
     NRF_LOG_INFO("Batt state %u %%", soc);
+
+    ble_uart_tx_stats_t tx_stats;
+    BLE_UartGetTxStats(&tx_stats);
+    NRF_LOG_INFO("NUS TX %u bytes, %u dropped, queue max %u, %u B/s",
+                 tx_stats.bytes_sent, tx_stats.packets_dropped, tx_stats.queue_depth_max, BLE_GetThroughput());
+    flog_status_t flog_status;
+    FLOG_GetStatus(&flog_status);
+    NRF_LOG_INFO("Flash log %u batches, %u bytes, %u dropped",
+                 flog_status.record_count, flog_status.used, flog_status.dropped);
+    if (output_mode == OutputMode_OUTPUT_MODE_RAW_SAMPLES) {
+        NRF_LOG_INFO("Raw samples %u chunks, %u dropped",
+                     rawMessage.payload.raw_samples.sequence, raw_chunks_dropped);
+    }
+    LAT_Log();
+    NRG_Log();
     if (soc < 20) {
         rgb_led_set(true, false, false);
     }
@@ -18,4 +18,89 @@ PB_BIND(Impedance, Impedance, AUTO)
 PB_BIND(EdaBuffer, EdaBuffer, AUTO)
 
 
+PB_BIND(EdaSpectrum, EdaSpectrum, AUTO)
+
+
+PB_BIND(EdaBatch, EdaBatch, 2)
+
+
+PB_BIND(RawSamples, RawSamples, 2)
+
+
+PB_BIND(Settings, Settings, AUTO)
+
+
+PB_BIND(DspStatus, DspStatus, AUTO)
+
+
+PB_BIND(AcquisitionRequest, AcquisitionRequest, AUTO)
+
+
+PB_BIND(AcquisitionStatus, AcquisitionStatus, AUTO)
+
+
+PB_BIND(LogRequest, LogRequest, AUTO)
+
+
+PB_BIND(LogStatus, LogStatus, AUTO)
+
+
+PB_BIND(EnergyRequest, EnergyRequest, AUTO)
+
+
+PB_BIND(SubsystemEnergy, SubsystemEnergy, AUTO)
+
+
+PB_BIND(EnergyReport, EnergyReport, AUTO)
+
+
+PB_BIND(CalibrationParameters, CalibrationParameters, AUTO)
+
+
+PB_BIND(CalibrationPoint, CalibrationPoint, AUTO)
+
+
+PB_BIND(CalibrationRequest, CalibrationRequest, AUTO)
+
+
+PB_BIND(CalibrationStatus, CalibrationStatus, 2)
+
+
+PB_BIND(MeasurementRequest, MeasurementRequest, AUTO)
+
+
+PB_BIND(MeasurementStatus, MeasurementStatus, AUTO)
+
+
+PB_BIND(RequestError, RequestError, AUTO)
+
+
+PB_BIND(TimeSyncRequest, TimeSyncRequest, AUTO)
+
+
+PB_BIND(TimeSyncStatus, TimeSyncStatus, AUTO)
+
+
+PB_BIND(StageLatency, StageLatency, AUTO)
+
+
+PB_BIND(LatencyReport, LatencyReport, 2)
+
+
+PB_BIND(HostMessage, HostMessage, AUTO)
+
+
+PB_BIND(DeviceMessage, DeviceMessage, 2)
+
+
+
+
+
+
+
+
+
+
+
+
 
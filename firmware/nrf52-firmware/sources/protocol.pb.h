@@ -9,6 +9,76 @@
 #error Regenerate this file with the current version of nanopb generator.
 #endif
 
+/* Enum definitions */
+/* ** Device settings, sent by the host after connection ** */
+typedef enum _ImpedanceEncoding {
+    ImpedanceEncoding_IMPEDANCE_ENCODING_FLOAT = 0, /* Impedance messages, 2 floats per frequency (default) */
+    ImpedanceEncoding_IMPEDANCE_ENCODING_HALF = 1 /* Packed half floats with a shared exponent, 4 bytes per frequency */
+} ImpedanceEncoding;
+
+typedef enum _OutputMode {
+    OutputMode_OUTPUT_MODE_SPECTRA = 0, /* EdaBatch messages (default) */
+    OutputMode_OUTPUT_MODE_RAW_SAMPLES = 1 /* RawSamples messages only, no impedance is computed */
+} OutputMode;
+
+typedef enum _OverrunPolicy {
+    OverrunPolicy_OVERRUN_POLICY_SKIP = 0, /* SAADC buffer filled while the DSP holds all others is dropped (default) */
+    OverrunPolicy_OVERRUN_POLICY_BLOCK = 1 /* SAADC pauses once all buffers are full, until the DSP releases one */
+} OverrunPolicy;
+
+/* ** Log of spectra recorded in flash while no host receives them ** */
+typedef enum _LogAction {
+    LogAction_LOG_ACTION_STATUS = 0, /* Reply with LogStatus */
+    LogAction_LOG_ACTION_DOWNLOAD = 1, /* Send recorded batches as log_batch messages, then LogStatus */
+    LogAction_LOG_ACTION_ERASE = 2 /* Erase the log, then reply with LogStatus */
+} LogAction;
+
+typedef enum _EnergySubsystem {
+    EnergySubsystem_ENERGY_SUBSYSTEM_CPU = 0, /* CPU awake, interrupts included */
+    EnergySubsystem_ENERGY_SUBSYSTEM_RADIO = 1, /* Radio events, HFXO startup included */
+    EnergySubsystem_ENERGY_SUBSYSTEM_SAADC = 2 /* SAADC conversions */
+} EnergySubsystem;
+
+/* ** Per-device calibration, applied to the impedance and kept in flash ** */
+typedef enum _CalibrationAction {
+    CalibrationAction_CALIBRATION_ACTION_STATUS = 0, /* Reply with CalibrationStatus */
+    CalibrationAction_CALIBRATION_ACTION_SET = 1, /* Apply parameters and points given, then reply. Not stored until CALIBRATION_ACTION_STORE */
+    CalibrationAction_CALIBRATION_ACTION_STORE = 2, /* Write calibration in use to flash, reply once written */
+    CalibrationAction_CALIBRATION_ACTION_ERASE = 3 /* Erase calibration from flash and go back to defaults, reply once erased */
+} CalibrationAction;
+
+/* ** Measurement control, the frontend and DSP are powered down while idle ** */
+typedef enum _MeasurementAction {
+    MeasurementAction_MEASUREMENT_ACTION_STATUS = 0, /* Reply with MeasurementStatus */
+    MeasurementAction_MEASUREMENT_ACTION_START = 1, /* Restart the frontend, then reply. Spectra follow once the first window is full. Ignored while stopping */
+    MeasurementAction_MEASUREMENT_ACTION_STOP = 2 /* Stop the frontend once the waveform is back to zero current (1 s at most), reply once stopped */
+} MeasurementAction;
+
+typedef enum _MeasurementState {
+    MeasurementState_MEASUREMENT_STATE_IDLE = 0, /* Frontend clock, SAADC and DSP stopped, nothing is logged */
+    MeasurementState_MEASUREMENT_STATE_RUNNING = 1, /* Default at boot, spectra are sent or logged */
+    MeasurementState_MEASUREMENT_STATE_STOPPING = 2 /* Waiting for the waveform to reach zero current */
+} MeasurementState;
+
+/* ** Reply to a HostMessage the device could not handle ** */
+typedef enum _RequestErrorCode {
+    RequestErrorCode_REQUEST_ERROR_MALFORMED = 0, /* Protobuf decoding failed, request_id is unknown then */
+    RequestErrorCode_REQUEST_ERROR_UNKNOWN = 1 /* Payload not handled by this firmware version */
+} RequestErrorCode;
+
+/* ** Processing stage durations, read from the diagnostics characteristic ** */
+typedef enum _LatencyStage {
+    LatencyStage_LATENCY_STAGE_SAADC_WAIT = 0, /* SAADC buffer done to its processing in the main loop */
+    LatencyStage_LATENCY_STAGE_SCALING = 1, /* Samples pushed into the DSP window and scaled */
+    LatencyStage_LATENCY_STAGE_TRANSFORM = 2, /* FFT (or Goertzel) of both channels */
+    LatencyStage_LATENCY_STAGE_IMPEDANCE = 3, /* V / I division and delay compensation */
+    LatencyStage_LATENCY_STAGE_ENCODE = 4, /* Protobuf encoding of a message, COBS excluded */
+    LatencyStage_LATENCY_STAGE_COBS = 5, /* COBS encoding of a message, sink excluded */
+    LatencyStage_LATENCY_STAGE_TX = 6, /* NUS packet queued to notification acknowledged */
+    LatencyStage_LATENCY_STAGE_DSP_SLICE = 7, /* One scheduler slice of the spectrum computation */
+    LatencyStage_LATENCY_STAGE_SINK = 8 /* Packets of a message handed to the sink, waits for room in the TX queue included */
+} LatencyStage;
+
 /* Struct definitions */
 /* ** Date/Time message to set RTC clock and get timestamps */
 typedef struct _Timestamp {
@@ -36,20 +106,356 @@ typedef struct _EdaBuffer {
     Timestamp timestamp;
 } EdaBuffer;
 
+typedef PB_BYTES_ARRAY_T(64) EdaSpectrum_data_half_t;
+/* ** Several EDA spectra per message, to reduce notification overhead ** */
+typedef struct _EdaSpectrum {
+    pb_size_t data_count;
+    Impedance data[16]; /* IMPEDANCE_ENCODING_FLOAT */
+    uint32_t delta_us; /* Microseconds elapsed since EdaBatch timestamp */
+    EdaSpectrum_data_half_t data_half; /* IMPEDANCE_ENCODING_HALF: real, imag pairs as little endian IEEE 754 half floats */
+    int32_t half_exponent; /* IMPEDANCE_ENCODING_HALF: impedance is data_half value times 2^half_exponent */
+    uint32_t skipped; /* Adaptive rate: spectra computed since the previous one but not sent, |Z| stayed within the threshold */
+} EdaSpectrum;
+
+typedef struct _EdaBatch {
+    bool has_timestamp;
+    Timestamp timestamp; /* Timestamp of the first spectrum, at the centre of its analysis window */
+    pb_size_t spectra_count;
+    EdaSpectrum spectra[8];
+} EdaBatch;
+
+typedef PB_BYTES_ARRAY_T(448) RawSamples_data_t;
+/* ** Raw SAADC samples, for offline analysis (OUTPUT_MODE_RAW_SAMPLES) ** */
+typedef struct _RawSamples {
+    uint32_t sequence; /* Chunk counter since raw streaming started, a gap means chunks were dropped */
+    bool has_timestamp;
+    Timestamp timestamp; /* Sampling time of the first sample pair of the chunk */
+    RawSamples_data_t data; /* Interleaved V, I samples as 14 bits two's complement, packed LSB first */
+} RawSamples;
+
+typedef struct _Settings {
+    ImpedanceEncoding impedance_encoding;
+    OutputMode output_mode;
+    OverrunPolicy overrun_policy;
+    uint32_t dsp_profile; /* Analysis window and frequencies, see DspStatus. 0 is the default */
+    float adaptive_threshold; /* Adaptive rate: relative change of |Z| at any frequency that sends a spectrum. 0 sends all of them (default) */
+    uint32_t adaptive_interval_ms; /* Adaptive rate: longest time between two spectra sent, 0 for 2 s */
+} Settings;
+
+/* ** Analysis window and frequencies of the spectra, sent when Settings change the DSP profile ** */
+typedef struct _DspStatus {
+    uint32_t profile; /* Profile in use, an unknown profile in Settings is refused and profile 0 kept */
+    uint32_t fft_size; /* Analysis window, in samples at 4096 Hz */
+    pb_size_t frequencies_count;
+    uint32_t frequencies[16]; /* Frequency of each impedance of a spectrum, in Hz */
+} DspStatus;
+
+/* ** SAADC to DSP handoff counters, since the frontend started ** */
+typedef struct _AcquisitionRequest {
+    char dummy_field;
+} AcquisitionRequest;
+
+typedef struct _AcquisitionStatus {
+    uint32_t buffers; /* SAADC buffers filled, dropped ones included */
+    uint32_t overruns; /* Buffers dropped by OVERRUN_POLICY_SKIP */
+    uint32_t stalls; /* SAADC pauses by OVERRUN_POLICY_BLOCK, samples are lost for each */
+    uint32_t held_max; /* Most buffers waiting for or under DSP processing at once */
+    uint32_t pool_size; /* SAADC buffers, two of them being filled by the SAADC */
+    uint32_t tx_dropped; /* RawSamples messages dropped, NUS TX queue full */
+} AcquisitionStatus;
+
+typedef struct _LogRequest {
+    LogAction action;
+    uint64_t since; /* LOG_ACTION_DOWNLOAD: skip batches recorded before this POSIX time */
+} LogRequest;
+
+typedef struct _LogStatus {
+    uint32_t batch_count; /* Records in the log, each holding a few seconds of compressed spectra */
+    uint32_t used_bytes; /* Flash used by the log */
+    uint32_t size_bytes; /* Flash reserved for the log */
+    uint32_t dropped; /* Records lost since last erase (flash busy or error) */
+    uint32_t overwritten; /* Oldest records erased since last erase to make room for new ones */
+} LogStatus;
+
+/* ** Charge budget of the main subsystems, since boot or last reset ** */
+typedef struct _EnergyRequest {
+    bool reset; /* Restart accounting once the report is sent */
+} EnergyRequest;
+
+typedef struct _SubsystemEnergy {
+    EnergySubsystem subsystem;
+    uint32_t active_ms;
+    uint32_t charge_uah; /* Active time at the typical current of the subsystem */
+} SubsystemEnergy;
+
+typedef struct _EnergyReport {
+    uint32_t period_s;
+    uint32_t wakeups; /* Main loop wakeups */
+    uint32_t radio_events;
+    pb_size_t subsystems_count;
+    SubsystemEnergy subsystems[3]; /* Estimated, the rest of measured_uah is the analog frontend and sleep floor */
+    int32_t measured_uah; /* Fuel gauge average current integrated over the period, negative while charging */
+    int32_t average_ua; /* measured_uah over the period */
+    uint32_t remaining_mah; /* Fuel gauge remaining capacity */
+    uint32_t runtime_min; /* Remaining capacity at average_ua, 0 if not discharging */
+} EnergyReport;
+
+typedef struct _CalibrationParameters {
+    float delay_s; /* Delay compensated on the current path */
+    float skew_s; /* Sampling time of the current input after the voltage input */
+    float tia_resistance; /* Actual TIA resistance, in Ohm */
+} CalibrationParameters;
+
+typedef struct _CalibrationPoint {
+    uint32_t index; /* Frequency index in the waveform frequency list */
+    bool has_gain;
+    Impedance gain; /* Impedance is gain . Z + offset, Z being compensated with CalibrationParameters. Left out to keep it */
+    bool has_offset;
+    Impedance offset; /* In Ohm. Left out to keep it */
+} CalibrationPoint;
+
+typedef struct _CalibrationRequest {
+    CalibrationAction action;
+    bool has_parameters;
+    CalibrationParameters parameters; /* CALIBRATION_ACTION_SET, left out to keep them */
+    pb_size_t points_count;
+    CalibrationPoint points[4]; /* CALIBRATION_ACTION_SET, a few per request so that it fits in one write */
+} CalibrationRequest;
+
+typedef struct _CalibrationStatus {
+    bool has_parameters;
+    CalibrationParameters parameters;
+    pb_size_t points_count;
+    CalibrationPoint points[16]; /* All frequencies */
+    bool stored; /* Calibration in use was read from or written to flash */
+    bool error; /* Last request failed: parameters not valid, unknown action, store or erase */
+} CalibrationStatus;
+
+typedef struct _MeasurementRequest {
+    MeasurementAction action;
+} MeasurementRequest;
+
+typedef struct _MeasurementStatus {
+    MeasurementState state;
+} MeasurementStatus;
+
+typedef struct _RequestError {
+    RequestErrorCode code;
+    uint32_t dropped; /* Frames dropped since connection: too long, malformed COBS, or received while the device was busy */
+} RequestError;
+
+/* ** Clock synchronization: the device fits its clock against the host midpoints of these requests ** */
+typedef struct _TimeSyncRequest {
+    uint64_t last_device_us; /* device_us of the reply to the previous request, 0 for the first one */
+    bool has_last_host_time;
+    Timestamp last_host_time; /* Host time halfway between sending the previous request and receiving its reply */
+    uint32_t last_rtt_us; /* Round trip of the previous request, long ones are left out of the fit */
+} TimeSyncRequest;
+
+typedef struct _TimeSyncStatus {
+    uint64_t device_us; /* Device clock when the request was received, for the next request */
+    int32_t error_us; /* Device time minus host time at the previous request, before it was added to the fit */
+    float drift_ppm; /* Rate correction of the device clock, positive if it runs slow */
+    uint32_t samples; /* Requests the offset was fitted from */
+    bool has_time;
+    Timestamp time; /* Device time at device_us, once the fit is applied. Pairs with the host midpoint to model the device clock on the host */
+} TimeSyncStatus;
+
+typedef struct _StageLatency {
+    LatencyStage stage;
+    uint32_t count; /* Durations recorded since boot */
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t mean_us;
+    pb_size_t histogram_count;
+    uint32_t histogram[20]; /* Bin n counts durations from 2^n to 2^(n+1) - 1 us (bin 0 from 0), the last one all longer ones. Left out if the report would not fit */
+} StageLatency;
+
+typedef struct _LatencyReport {
+    pb_size_t stages_count;
+    StageLatency stages[9]; /* Stages with at least one duration recorded */
+} LatencyReport;
+
+/* ** Messages sent by the host ** */
+typedef struct _HostMessage {
+    pb_size_t which_payload;
+    union {
+        Timestamp timestamp;
+        Settings settings;
+        LogRequest log_request;
+        AcquisitionRequest acquisition_request; /* Reply with AcquisitionStatus */
+        EnergyRequest energy_request; /* Reply with EnergyReport */
+        CalibrationRequest calibration_request; /* Reply with CalibrationStatus */
+        MeasurementRequest measurement_request; /* Reply with MeasurementStatus */
+        TimeSyncRequest time_sync_request; /* Reply with TimeSyncStatus, every 30 s or so while spectra are sent */
+    } payload;
+    uint32_t request_id; /* Echoed by the replies, 0 if the host does not need to match them. A message may span several writes */
+} HostMessage;
+
+/* ** Messages sent by the device ** */
+typedef struct _DeviceMessage {
+    pb_size_t which_payload;
+    union {
+        EdaBatch eda_batch;
+        RawSamples raw_samples;
+        EdaBatch log_batch; /* Spectra recorded while disconnected, sent on LOG_ACTION_DOWNLOAD */
+        LogStatus log_status;
+        AcquisitionStatus acquisition_status; /* On AcquisitionRequest, and when samples were lost (once per second at most) */
+        EnergyReport energy_report; /* On EnergyRequest */
+        CalibrationStatus calibration_status; /* On CalibrationRequest */
+        DspStatus dsp_status; /* On Settings, spectra that follow use its frequencies. Settings replaced before being applied get the profile in use */
+        MeasurementStatus measurement_status; /* On MeasurementRequest, and once the frontend has stopped */
+        RequestError request_error; /* On a HostMessage that could not be handled */
+        TimeSyncStatus time_sync_status; /* On TimeSyncRequest */
+    } payload;
+    uint32_t request_id; /* request_id of the HostMessage this message replies to, 0 for spectra and other unsolicited messages */
+} DeviceMessage;
+
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Helper constants for enums */
+#define _ImpedanceEncoding_MIN ImpedanceEncoding_IMPEDANCE_ENCODING_FLOAT
+#define _ImpedanceEncoding_MAX ImpedanceEncoding_IMPEDANCE_ENCODING_HALF
+#define _ImpedanceEncoding_ARRAYSIZE ((ImpedanceEncoding)(ImpedanceEncoding_IMPEDANCE_ENCODING_HALF+1))
+
+#define _OutputMode_MIN OutputMode_OUTPUT_MODE_SPECTRA
+#define _OutputMode_MAX OutputMode_OUTPUT_MODE_RAW_SAMPLES
+#define _OutputMode_ARRAYSIZE ((OutputMode)(OutputMode_OUTPUT_MODE_RAW_SAMPLES+1))
+
+#define _OverrunPolicy_MIN OverrunPolicy_OVERRUN_POLICY_SKIP
+#define _OverrunPolicy_MAX OverrunPolicy_OVERRUN_POLICY_BLOCK
+#define _OverrunPolicy_ARRAYSIZE ((OverrunPolicy)(OverrunPolicy_OVERRUN_POLICY_BLOCK+1))
+
+#define _LogAction_MIN LogAction_LOG_ACTION_STATUS
+#define _LogAction_MAX LogAction_LOG_ACTION_ERASE
+#define _LogAction_ARRAYSIZE ((LogAction)(LogAction_LOG_ACTION_ERASE+1))
+
+#define _EnergySubsystem_MIN EnergySubsystem_ENERGY_SUBSYSTEM_CPU
+#define _EnergySubsystem_MAX EnergySubsystem_ENERGY_SUBSYSTEM_SAADC
+#define _EnergySubsystem_ARRAYSIZE ((EnergySubsystem)(EnergySubsystem_ENERGY_SUBSYSTEM_SAADC+1))
+
+#define _CalibrationAction_MIN CalibrationAction_CALIBRATION_ACTION_STATUS
+#define _CalibrationAction_MAX CalibrationAction_CALIBRATION_ACTION_ERASE
+#define _CalibrationAction_ARRAYSIZE ((CalibrationAction)(CalibrationAction_CALIBRATION_ACTION_ERASE+1))
+
+#define _MeasurementAction_MIN MeasurementAction_MEASUREMENT_ACTION_STATUS
+#define _MeasurementAction_MAX MeasurementAction_MEASUREMENT_ACTION_STOP
+#define _MeasurementAction_ARRAYSIZE ((MeasurementAction)(MeasurementAction_MEASUREMENT_ACTION_STOP+1))
+
+#define _MeasurementState_MIN MeasurementState_MEASUREMENT_STATE_IDLE
+#define _MeasurementState_MAX MeasurementState_MEASUREMENT_STATE_STOPPING
+#define _MeasurementState_ARRAYSIZE ((MeasurementState)(MeasurementState_MEASUREMENT_STATE_STOPPING+1))
+
+#define _RequestErrorCode_MIN RequestErrorCode_REQUEST_ERROR_MALFORMED
+#define _RequestErrorCode_MAX RequestErrorCode_REQUEST_ERROR_UNKNOWN
+#define _RequestErrorCode_ARRAYSIZE ((RequestErrorCode)(RequestErrorCode_REQUEST_ERROR_UNKNOWN+1))
+
+#define _LatencyStage_MIN LatencyStage_LATENCY_STAGE_SAADC_WAIT
+#define _LatencyStage_MAX LatencyStage_LATENCY_STAGE_SINK
+#define _LatencyStage_ARRAYSIZE ((LatencyStage)(LatencyStage_LATENCY_STAGE_SINK+1))
+
+
+
+
+
+
+
+
+#define Settings_impedance_encoding_ENUMTYPE ImpedanceEncoding
+#define Settings_output_mode_ENUMTYPE OutputMode
+#define Settings_overrun_policy_ENUMTYPE OverrunPolicy
+
+
+
+
+#define LogRequest_action_ENUMTYPE LogAction
+
+
+
+#define SubsystemEnergy_subsystem_ENUMTYPE EnergySubsystem
+
+
+
+
+#define CalibrationRequest_action_ENUMTYPE CalibrationAction
+
+
+#define MeasurementRequest_action_ENUMTYPE MeasurementAction
+
+#define MeasurementStatus_state_ENUMTYPE MeasurementState
+
+#define RequestError_code_ENUMTYPE RequestErrorCode
+
+
+
+#define StageLatency_stage_ENUMTYPE LatencyStage
+
+
+
+
+
 /* Initializer values for message structs */
 #define Timestamp_init_default                   {0, 0}
 #define EcgBuffer_init_default                   {{0}, 0, false, Timestamp_init_default}
 #define Impedance_init_default                   {0, 0}
 #define EdaBuffer_init_default                   {{Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default}, false, Timestamp_init_default}
+#define EdaSpectrum_init_default                 {0, {Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default, Impedance_init_default}, 0, {0, {0}}, 0, 0}
+#define EdaBatch_init_default                    {false, Timestamp_init_default, 0, {EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default, EdaSpectrum_init_default}}
+#define RawSamples_init_default                  {0, false, Timestamp_init_default, {0, {0}}}
+#define Settings_init_default                    {_ImpedanceEncoding_MIN, _OutputMode_MIN, _OverrunPolicy_MIN, 0, 0, 0}
+#define DspStatus_init_default                   {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define AcquisitionRequest_init_default          {0}
+#define AcquisitionStatus_init_default           {0, 0, 0, 0, 0, 0}
+#define LogRequest_init_default                  {_LogAction_MIN, 0}
+#define LogStatus_init_default                   {0, 0, 0, 0, 0}
+#define EnergyRequest_init_default               {0}
+#define SubsystemEnergy_init_default             {_EnergySubsystem_MIN, 0, 0}
+#define EnergyReport_init_default                {0, 0, 0, 0, {SubsystemEnergy_init_default, SubsystemEnergy_init_default, SubsystemEnergy_init_default}, 0, 0, 0, 0}
+#define CalibrationParameters_init_default       {0, 0, 0}
+#define CalibrationPoint_init_default            {0, false, Impedance_init_default, false, Impedance_init_default}
+#define CalibrationRequest_init_default          {_CalibrationAction_MIN, false, CalibrationParameters_init_default, 0, {CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default}}
+#define CalibrationStatus_init_default           {false, CalibrationParameters_init_default, 0, {CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default, CalibrationPoint_init_default}, 0, 0}
+#define MeasurementRequest_init_default          {_MeasurementAction_MIN}
+#define MeasurementStatus_init_default           {_MeasurementState_MIN}
+#define RequestError_init_default                {_RequestErrorCode_MIN, 0}
+#define TimeSyncRequest_init_default             {0, false, Timestamp_init_default, 0}
+#define TimeSyncStatus_init_default              {0, 0, 0, 0, false, Timestamp_init_default}
+#define StageLatency_init_default                {_LatencyStage_MIN, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define LatencyReport_init_default               {0, {StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default, StageLatency_init_default}}
+#define HostMessage_init_default                 {0, {Timestamp_init_default}, 0}
+#define DeviceMessage_init_default               {0, {EdaBatch_init_default}, 0}
 #define Timestamp_init_zero                      {0, 0}
 #define EcgBuffer_init_zero                      {{0}, 0, false, Timestamp_init_zero}
 #define Impedance_init_zero                      {0, 0}
 #define EdaBuffer_init_zero                      {{Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero}, false, Timestamp_init_zero}
+#define EdaSpectrum_init_zero                    {0, {Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero, Impedance_init_zero}, 0, {0, {0}}, 0, 0}
+#define EdaBatch_init_zero                       {false, Timestamp_init_zero, 0, {EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero, EdaSpectrum_init_zero}}
+#define RawSamples_init_zero                     {0, false, Timestamp_init_zero, {0, {0}}}
+#define Settings_init_zero                       {_ImpedanceEncoding_MIN, _OutputMode_MIN, _OverrunPolicy_MIN, 0, 0, 0}
+#define DspStatus_init_zero                      {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define AcquisitionRequest_init_zero             {0}
+#define AcquisitionStatus_init_zero              {0, 0, 0, 0, 0, 0}
+#define LogRequest_init_zero                     {_LogAction_MIN, 0}
+#define LogStatus_init_zero                      {0, 0, 0, 0, 0}
+#define EnergyRequest_init_zero                  {0}
+#define SubsystemEnergy_init_zero                {_EnergySubsystem_MIN, 0, 0}
+#define EnergyReport_init_zero                   {0, 0, 0, 0, {SubsystemEnergy_init_zero, SubsystemEnergy_init_zero, SubsystemEnergy_init_zero}, 0, 0, 0, 0}
+#define CalibrationParameters_init_zero          {0, 0, 0}
+#define CalibrationPoint_init_zero               {0, false, Impedance_init_zero, false, Impedance_init_zero}
+#define CalibrationRequest_init_zero             {_CalibrationAction_MIN, false, CalibrationParameters_init_zero, 0, {CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero}}
+#define CalibrationStatus_init_zero              {false, CalibrationParameters_init_zero, 0, {CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero, CalibrationPoint_init_zero}, 0, 0}
+#define MeasurementRequest_init_zero             {_MeasurementAction_MIN}
+#define MeasurementStatus_init_zero              {_MeasurementState_MIN}
+#define RequestError_init_zero                   {_RequestErrorCode_MIN, 0}
+#define TimeSyncRequest_init_zero                {0, false, Timestamp_init_zero, 0}
+#define TimeSyncStatus_init_zero                 {0, 0, 0, 0, false, Timestamp_init_zero}
+#define StageLatency_init_zero                   {_LatencyStage_MIN, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define LatencyReport_init_zero                  {0, {StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero, StageLatency_init_zero}}
+#define HostMessage_init_zero                    {0, {Timestamp_init_zero}, 0}
+#define DeviceMessage_init_zero                  {0, {EdaBatch_init_zero}, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define Timestamp_time_tag                       1
@@ -61,6 +467,103 @@ extern "C" {
 #define Impedance_imag_tag                       2
 #define EdaBuffer_data_tag                       1
 #define EdaBuffer_timestamp_tag                  2
+#define EdaSpectrum_data_tag                     1
+#define EdaSpectrum_delta_us_tag                 2
+#define EdaSpectrum_data_half_tag                3
+#define EdaSpectrum_half_exponent_tag            4
+#define EdaSpectrum_skipped_tag                  5
+#define EdaBatch_timestamp_tag                   1
+#define EdaBatch_spectra_tag                     2
+#define RawSamples_sequence_tag                  1
+#define RawSamples_timestamp_tag                 2
+#define RawSamples_data_tag                      3
+#define Settings_impedance_encoding_tag          1
+#define Settings_output_mode_tag                 2
+#define Settings_overrun_policy_tag              3
+#define Settings_dsp_profile_tag                 4
+#define Settings_adaptive_threshold_tag          5
+#define Settings_adaptive_interval_ms_tag        6
+#define DspStatus_profile_tag                    1
+#define DspStatus_fft_size_tag                   2
+#define DspStatus_frequencies_tag                3
+#define AcquisitionStatus_buffers_tag            1
+#define AcquisitionStatus_overruns_tag           2
+#define AcquisitionStatus_stalls_tag             3
+#define AcquisitionStatus_held_max_tag           4
+#define AcquisitionStatus_pool_size_tag          5
+#define AcquisitionStatus_tx_dropped_tag         6
+#define LogRequest_action_tag                    1
+#define LogRequest_since_tag                     2
+#define LogStatus_batch_count_tag                1
+#define LogStatus_used_bytes_tag                 2
+#define LogStatus_size_bytes_tag                 3
+#define LogStatus_dropped_tag                    4
+#define LogStatus_overwritten_tag                5
+#define EnergyRequest_reset_tag                  1
+#define SubsystemEnergy_subsystem_tag            1
+#define SubsystemEnergy_active_ms_tag            2
+#define SubsystemEnergy_charge_uah_tag           3
+#define EnergyReport_period_s_tag                1
+#define EnergyReport_wakeups_tag                 2
+#define EnergyReport_radio_events_tag            3
+#define EnergyReport_subsystems_tag              4
+#define EnergyReport_measured_uah_tag            5
+#define EnergyReport_average_ua_tag              6
+#define EnergyReport_remaining_mah_tag           7
+#define EnergyReport_runtime_min_tag             8
+#define CalibrationParameters_delay_s_tag        1
+#define CalibrationParameters_skew_s_tag         2
+#define CalibrationParameters_tia_resistance_tag 3
+#define CalibrationPoint_index_tag               1
+#define CalibrationPoint_gain_tag                2
+#define CalibrationPoint_offset_tag              3
+#define CalibrationRequest_action_tag            1
+#define CalibrationRequest_parameters_tag        2
+#define CalibrationRequest_points_tag            3
+#define CalibrationStatus_parameters_tag         1
+#define CalibrationStatus_points_tag             2
+#define CalibrationStatus_stored_tag             3
+#define CalibrationStatus_error_tag              4
+#define MeasurementRequest_action_tag            1
+#define MeasurementStatus_state_tag              1
+#define RequestError_code_tag                    1
+#define RequestError_dropped_tag                 2
+#define TimeSyncRequest_last_device_us_tag       1
+#define TimeSyncRequest_last_host_time_tag       2
+#define TimeSyncRequest_last_rtt_us_tag          3
+#define TimeSyncStatus_device_us_tag             1
+#define TimeSyncStatus_error_us_tag              2
+#define TimeSyncStatus_drift_ppm_tag             3
+#define TimeSyncStatus_samples_tag               4
+#define TimeSyncStatus_time_tag                  5
+#define StageLatency_stage_tag                   1
+#define StageLatency_count_tag                   2
+#define StageLatency_min_us_tag                  3
+#define StageLatency_max_us_tag                  4
+#define StageLatency_mean_us_tag                 5
+#define StageLatency_histogram_tag               6
+#define LatencyReport_stages_tag                 1
+#define HostMessage_timestamp_tag                1
+#define HostMessage_settings_tag                 2
+#define HostMessage_log_request_tag              3
+#define HostMessage_acquisition_request_tag      4
+#define HostMessage_energy_request_tag           5
+#define HostMessage_calibration_request_tag      6
+#define HostMessage_measurement_request_tag      7
+#define HostMessage_time_sync_request_tag        8
+#define HostMessage_request_id_tag               16
+#define DeviceMessage_eda_batch_tag              1
+#define DeviceMessage_raw_samples_tag            2
+#define DeviceMessage_log_batch_tag              3
+#define DeviceMessage_log_status_tag             4
+#define DeviceMessage_acquisition_status_tag     5
+#define DeviceMessage_energy_report_tag          6
+#define DeviceMessage_calibration_status_tag     7
+#define DeviceMessage_dsp_status_tag             8
+#define DeviceMessage_measurement_status_tag     9
+#define DeviceMessage_request_error_tag          10
+#define DeviceMessage_time_sync_status_tag       11
+#define DeviceMessage_request_id_tag             16
 
 /* Struct field encoding specification for nanopb */
 #define Timestamp_FIELDLIST(X, a) \
@@ -91,21 +594,327 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  timestamp,         2)
 #define EdaBuffer_data_MSGTYPE Impedance
 #define EdaBuffer_timestamp_MSGTYPE Timestamp
 
+#define EdaSpectrum_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  data,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   delta_us,          2) \
+X(a, STATIC,   SINGULAR, BYTES,    data_half,         3) \
+X(a, STATIC,   SINGULAR, SINT32,   half_exponent,     4) \
+X(a, STATIC,   SINGULAR, UINT32,   skipped,           5)
+#define EdaSpectrum_CALLBACK NULL
+#define EdaSpectrum_DEFAULT NULL
+#define EdaSpectrum_data_MSGTYPE Impedance
+
+#define EdaBatch_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  timestamp,         1) \
+X(a, STATIC,   REPEATED, MESSAGE,  spectra,           2)
+#define EdaBatch_CALLBACK NULL
+#define EdaBatch_DEFAULT NULL
+#define EdaBatch_timestamp_MSGTYPE Timestamp
+#define EdaBatch_spectra_MSGTYPE EdaSpectrum
+
+#define RawSamples_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   sequence,          1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  timestamp,         2) \
+X(a, STATIC,   SINGULAR, BYTES,    data,              3)
+#define RawSamples_CALLBACK NULL
+#define RawSamples_DEFAULT NULL
+#define RawSamples_timestamp_MSGTYPE Timestamp
+
+#define Settings_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    impedance_encoding,   1) \
+X(a, STATIC,   SINGULAR, UENUM,    output_mode,       2) \
+X(a, STATIC,   SINGULAR, UENUM,    overrun_policy,    3) \
+X(a, STATIC,   SINGULAR, UINT32,   dsp_profile,       4) \
+X(a, STATIC,   SINGULAR, FLOAT,    adaptive_threshold,   5) \
+X(a, STATIC,   SINGULAR, UINT32,   adaptive_interval_ms,   6)
+#define Settings_CALLBACK NULL
+#define Settings_DEFAULT NULL
+
+#define DspStatus_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   profile,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   fft_size,          2) \
+X(a, STATIC,   REPEATED, UINT32,   frequencies,       3)
+#define DspStatus_CALLBACK NULL
+#define DspStatus_DEFAULT NULL
+
+#define AcquisitionRequest_FIELDLIST(X, a) \
+
+#define AcquisitionRequest_CALLBACK NULL
+#define AcquisitionRequest_DEFAULT NULL
+
+#define AcquisitionStatus_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   buffers,           1) \
+X(a, STATIC,   SINGULAR, UINT32,   overruns,          2) \
+X(a, STATIC,   SINGULAR, UINT32,   stalls,            3) \
+X(a, STATIC,   SINGULAR, UINT32,   held_max,          4) \
+X(a, STATIC,   SINGULAR, UINT32,   pool_size,         5) \
+X(a, STATIC,   SINGULAR, UINT32,   tx_dropped,        6)
+#define AcquisitionStatus_CALLBACK NULL
+#define AcquisitionStatus_DEFAULT NULL
+
+#define LogRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    action,            1) \
+X(a, STATIC,   SINGULAR, UINT64,   since,             2)
+#define LogRequest_CALLBACK NULL
+#define LogRequest_DEFAULT NULL
+
+#define LogStatus_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   batch_count,       1) \
+X(a, STATIC,   SINGULAR, UINT32,   used_bytes,        2) \
+X(a, STATIC,   SINGULAR, UINT32,   size_bytes,        3) \
+X(a, STATIC,   SINGULAR, UINT32,   dropped,           4) \
+X(a, STATIC,   SINGULAR, UINT32,   overwritten,       5)
+#define LogStatus_CALLBACK NULL
+#define LogStatus_DEFAULT NULL
+
+#define EnergyRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, BOOL,     reset,             1)
+#define EnergyRequest_CALLBACK NULL
+#define EnergyRequest_DEFAULT NULL
+
+#define SubsystemEnergy_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    subsystem,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   active_ms,         2) \
+X(a, STATIC,   SINGULAR, UINT32,   charge_uah,        3)
+#define SubsystemEnergy_CALLBACK NULL
+#define SubsystemEnergy_DEFAULT NULL
+
+#define EnergyReport_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   period_s,          1) \
+X(a, STATIC,   SINGULAR, UINT32,   wakeups,           2) \
+X(a, STATIC,   SINGULAR, UINT32,   radio_events,      3) \
+X(a, STATIC,   REPEATED, MESSAGE,  subsystems,        4) \
+X(a, STATIC,   SINGULAR, SINT32,   measured_uah,      5) \
+X(a, STATIC,   SINGULAR, SINT32,   average_ua,        6) \
+X(a, STATIC,   SINGULAR, UINT32,   remaining_mah,     7) \
+X(a, STATIC,   SINGULAR, UINT32,   runtime_min,       8)
+#define EnergyReport_CALLBACK NULL
+#define EnergyReport_DEFAULT NULL
+#define EnergyReport_subsystems_MSGTYPE SubsystemEnergy
+
+#define CalibrationParameters_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, FLOAT,    delay_s,           1) \
+X(a, STATIC,   SINGULAR, FLOAT,    skew_s,            2) \
+X(a, STATIC,   SINGULAR, FLOAT,    tia_resistance,    3)
+#define CalibrationParameters_CALLBACK NULL
+#define CalibrationParameters_DEFAULT NULL
+
+#define CalibrationPoint_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   index,             1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  gain,              2) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  offset,            3)
+#define CalibrationPoint_CALLBACK NULL
+#define CalibrationPoint_DEFAULT NULL
+#define CalibrationPoint_gain_MSGTYPE Impedance
+#define CalibrationPoint_offset_MSGTYPE Impedance
+
+#define CalibrationRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    action,            1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  parameters,        2) \
+X(a, STATIC,   REPEATED, MESSAGE,  points,            3)
+#define CalibrationRequest_CALLBACK NULL
+#define CalibrationRequest_DEFAULT NULL
+#define CalibrationRequest_parameters_MSGTYPE CalibrationParameters
+#define CalibrationRequest_points_MSGTYPE CalibrationPoint
+
+#define CalibrationStatus_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  parameters,        1) \
+X(a, STATIC,   REPEATED, MESSAGE,  points,            2) \
+X(a, STATIC,   SINGULAR, BOOL,     stored,            3) \
+X(a, STATIC,   SINGULAR, BOOL,     error,             4)
+#define CalibrationStatus_CALLBACK NULL
+#define CalibrationStatus_DEFAULT NULL
+#define CalibrationStatus_parameters_MSGTYPE CalibrationParameters
+#define CalibrationStatus_points_MSGTYPE CalibrationPoint
+
+#define MeasurementRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    action,            1)
+#define MeasurementRequest_CALLBACK NULL
+#define MeasurementRequest_DEFAULT NULL
+
+#define MeasurementStatus_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    state,             1)
+#define MeasurementStatus_CALLBACK NULL
+#define MeasurementStatus_DEFAULT NULL
+
+#define RequestError_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    code,              1) \
+X(a, STATIC,   SINGULAR, UINT32,   dropped,           2)
+#define RequestError_CALLBACK NULL
+#define RequestError_DEFAULT NULL
+
+#define TimeSyncRequest_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT64,   last_device_us,    1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  last_host_time,    2) \
+X(a, STATIC,   SINGULAR, UINT32,   last_rtt_us,       3)
+#define TimeSyncRequest_CALLBACK NULL
+#define TimeSyncRequest_DEFAULT NULL
+#define TimeSyncRequest_last_host_time_MSGTYPE Timestamp
+
+#define TimeSyncStatus_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT64,   device_us,         1) \
+X(a, STATIC,   SINGULAR, SINT32,   error_us,          2) \
+X(a, STATIC,   SINGULAR, FLOAT,    drift_ppm,         3) \
+X(a, STATIC,   SINGULAR, UINT32,   samples,           4) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  time,              5)
+#define TimeSyncStatus_CALLBACK NULL
+#define TimeSyncStatus_DEFAULT NULL
+#define TimeSyncStatus_time_MSGTYPE Timestamp
+
+#define StageLatency_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UENUM,    stage,             1) \
+X(a, STATIC,   SINGULAR, UINT32,   count,             2) \
+X(a, STATIC,   SINGULAR, UINT32,   min_us,            3) \
+X(a, STATIC,   SINGULAR, UINT32,   max_us,            4) \
+X(a, STATIC,   SINGULAR, UINT32,   mean_us,           5) \
+X(a, STATIC,   REPEATED, UINT32,   histogram,         6)
+#define StageLatency_CALLBACK NULL
+#define StageLatency_DEFAULT NULL
+
+#define LatencyReport_FIELDLIST(X, a) \
+X(a, STATIC,   REPEATED, MESSAGE,  stages,            1)
+#define LatencyReport_CALLBACK NULL
+#define LatencyReport_DEFAULT NULL
+#define LatencyReport_stages_MSGTYPE StageLatency
+
+#define HostMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,timestamp,payload.timestamp),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,settings,payload.settings),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,log_request,payload.log_request),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,acquisition_request,payload.acquisition_request),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,energy_request,payload.energy_request),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,calibration_request,payload.calibration_request),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,measurement_request,payload.measurement_request),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,time_sync_request,payload.time_sync_request),   8) \
+X(a, STATIC,   SINGULAR, UINT32,   request_id,       16)
+#define HostMessage_CALLBACK NULL
+#define HostMessage_DEFAULT NULL
+#define HostMessage_payload_timestamp_MSGTYPE Timestamp
+#define HostMessage_payload_settings_MSGTYPE Settings
+#define HostMessage_payload_log_request_MSGTYPE LogRequest
+#define HostMessage_payload_acquisition_request_MSGTYPE AcquisitionRequest
+#define HostMessage_payload_energy_request_MSGTYPE EnergyRequest
+#define HostMessage_payload_calibration_request_MSGTYPE CalibrationRequest
+#define HostMessage_payload_measurement_request_MSGTYPE MeasurementRequest
+#define HostMessage_payload_time_sync_request_MSGTYPE TimeSyncRequest
+
+#define DeviceMessage_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,eda_batch,payload.eda_batch),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,raw_samples,payload.raw_samples),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,log_batch,payload.log_batch),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,log_status,payload.log_status),   4) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,acquisition_status,payload.acquisition_status),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,energy_report,payload.energy_report),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,calibration_status,payload.calibration_status),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,dsp_status,payload.dsp_status),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,measurement_status,payload.measurement_status),   9) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,request_error,payload.request_error),  10) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,time_sync_status,payload.time_sync_status),  11) \
+X(a, STATIC,   SINGULAR, UINT32,   request_id,       16)
+#define DeviceMessage_CALLBACK NULL
+#define DeviceMessage_DEFAULT NULL
+#define DeviceMessage_payload_eda_batch_MSGTYPE EdaBatch
+#define DeviceMessage_payload_raw_samples_MSGTYPE RawSamples
+#define DeviceMessage_payload_log_batch_MSGTYPE EdaBatch
+#define DeviceMessage_payload_log_status_MSGTYPE LogStatus
+#define DeviceMessage_payload_acquisition_status_MSGTYPE AcquisitionStatus
+#define DeviceMessage_payload_energy_report_MSGTYPE EnergyReport
+#define DeviceMessage_payload_calibration_status_MSGTYPE CalibrationStatus
+#define DeviceMessage_payload_dsp_status_MSGTYPE DspStatus
+#define DeviceMessage_payload_measurement_status_MSGTYPE MeasurementStatus
+#define DeviceMessage_payload_request_error_MSGTYPE RequestError
+#define DeviceMessage_payload_time_sync_status_MSGTYPE TimeSyncStatus
+
 extern const pb_msgdesc_t Timestamp_msg;
 extern const pb_msgdesc_t EcgBuffer_msg;
 extern const pb_msgdesc_t Impedance_msg;
 extern const pb_msgdesc_t EdaBuffer_msg;
+extern const pb_msgdesc_t EdaSpectrum_msg;
+extern const pb_msgdesc_t EdaBatch_msg;
+extern const pb_msgdesc_t RawSamples_msg;
+extern const pb_msgdesc_t Settings_msg;
+extern const pb_msgdesc_t DspStatus_msg;
+extern const pb_msgdesc_t AcquisitionRequest_msg;
+extern const pb_msgdesc_t AcquisitionStatus_msg;
+extern const pb_msgdesc_t LogRequest_msg;
+extern const pb_msgdesc_t LogStatus_msg;
+extern const pb_msgdesc_t EnergyRequest_msg;
+extern const pb_msgdesc_t SubsystemEnergy_msg;
+extern const pb_msgdesc_t EnergyReport_msg;
+extern const pb_msgdesc_t CalibrationParameters_msg;
+extern const pb_msgdesc_t CalibrationPoint_msg;
+extern const pb_msgdesc_t CalibrationRequest_msg;
+extern const pb_msgdesc_t CalibrationStatus_msg;
+extern const pb_msgdesc_t MeasurementRequest_msg;
+extern const pb_msgdesc_t MeasurementStatus_msg;
+extern const pb_msgdesc_t RequestError_msg;
+extern const pb_msgdesc_t TimeSyncRequest_msg;
+extern const pb_msgdesc_t TimeSyncStatus_msg;
+extern const pb_msgdesc_t StageLatency_msg;
+extern const pb_msgdesc_t LatencyReport_msg;
+extern const pb_msgdesc_t HostMessage_msg;
+extern const pb_msgdesc_t DeviceMessage_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define Timestamp_fields &Timestamp_msg
 #define EcgBuffer_fields &EcgBuffer_msg
 #define Impedance_fields &Impedance_msg
 #define EdaBuffer_fields &EdaBuffer_msg
+#define EdaSpectrum_fields &EdaSpectrum_msg
+#define EdaBatch_fields &EdaBatch_msg
+#define RawSamples_fields &RawSamples_msg
+#define Settings_fields &Settings_msg
+#define DspStatus_fields &DspStatus_msg
+#define AcquisitionRequest_fields &AcquisitionRequest_msg
+#define AcquisitionStatus_fields &AcquisitionStatus_msg
+#define LogRequest_fields &LogRequest_msg
+#define LogStatus_fields &LogStatus_msg
+#define EnergyRequest_fields &EnergyRequest_msg
+#define SubsystemEnergy_fields &SubsystemEnergy_msg
+#define EnergyReport_fields &EnergyReport_msg
+#define CalibrationParameters_fields &CalibrationParameters_msg
+#define CalibrationPoint_fields &CalibrationPoint_msg
+#define CalibrationRequest_fields &CalibrationRequest_msg
+#define CalibrationStatus_fields &CalibrationStatus_msg
+#define MeasurementRequest_fields &MeasurementRequest_msg
+#define MeasurementStatus_fields &MeasurementStatus_msg
+#define RequestError_fields &RequestError_msg
+#define TimeSyncRequest_fields &TimeSyncRequest_msg
+#define TimeSyncStatus_fields &TimeSyncStatus_msg
+#define StageLatency_fields &StageLatency_msg
+#define LatencyReport_fields &LatencyReport_msg
+#define HostMessage_fields &HostMessage_msg
+#define DeviceMessage_fields &DeviceMessage_msg
 
 /* Maximum encoded size of messages (where known) */
+#define AcquisitionRequest_size                  0
+#define AcquisitionStatus_size                   36
+#define CalibrationParameters_size               15
+#define CalibrationPoint_size                    30
+#define CalibrationRequest_size                  147
+#define CalibrationStatus_size                   533
+#define DeviceMessage_size                       2261
+#define DspStatus_size                           108
 #define EcgBuffer_size                           233
+#define EdaBatch_size                            2251
 #define EdaBuffer_size                           211
+#define EdaSpectrum_size                         276
+#define EnergyReport_size                        90
+#define EnergyRequest_size                       2
+#define HostMessage_size                         157
 #define Impedance_size                           10
+#define LatencyReport_size                       1341
+#define LogRequest_size                          13
+#define LogStatus_size                           30
+#define MeasurementRequest_size                  2
+#define MeasurementStatus_size                   2
+#define RawSamples_size                          476
+#define RequestError_size                        8
+#define Settings_size                            23
+#define StageLatency_size                        146
+#define SubsystemEnergy_size                     14
+#define TimeSyncRequest_size                     36
+#define TimeSyncStatus_size                      47
 #define Timestamp_size                           17
 
 #ifdef __cplusplus
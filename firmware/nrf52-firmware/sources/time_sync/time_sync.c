@@ -0,0 +1,164 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: TIME SYNC
+ *
+ *---------------------------------------------------------------
+ * @brief Fit of the device clock against the host clock
+ *
+ * Sums are done in double relative to the last sample: the fit
+ * only runs on host requests, seconds apart.
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <math.h>
+#include <string.h>
+
+/* Project includes */
+#include "time_sync.h"
+
+/*
+ * Local constants
+ */
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local types
+ */
+
+/*
+ * Local variables
+ */
+
+/*
+ * Local functions
+ */
+
+static uint32_t rtt_limit_get(const tsync_t * sync);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start with no sample and no drift
+ */
+void TSYNC_Init(tsync_t * sync)
+{
+    memset(sync, 0, sizeof(tsync_t));
+}
+
+/**
+ * @brief Drop the samples, for another host
+ */
+void TSYNC_Reset(tsync_t * sync)
+{
+    sync->sample_index = 0;
+    sync->sample_count = 0;
+}
+
+/**
+ * @brief Add a sample and fit the model again
+ */
+bool TSYNC_AddSample(tsync_t * sync, uint64_t device_us, uint64_t host_us, uint32_t rtt_us, tsync_model_t * p_model)
+{
+    uint8_t last = (sync->sample_index + TSYNC_SAMPLE_NUM - 1) % TSYNC_SAMPLE_NUM;
+    tsync_sample_t * sample = &sync->samples[sync->sample_index];
+    uint32_t rtt_limit;
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    double x_min = 0.0, x_max = 0.0;
+    double slope, intercept;
+    uint8_t count = 0;
+
+    if ((sync->sample_count > 0) && (device_us <= sync->samples[last].device_us)) {
+        return false;
+    }
+
+    sample->device_us = device_us;
+    sample->error_us = (int64_t)(host_us - device_us);
+    sample->rtt_us = rtt_us;
+    sync->sample_index = (sync->sample_index + 1) % TSYNC_SAMPLE_NUM;
+    if (sync->sample_count < TSYNC_SAMPLE_NUM) {
+        sync->sample_count++;
+    }
+
+    /* Device clock relative to the new sample, the sample of the shortest round trip is always used */
+    rtt_limit = rtt_limit_get(sync);
+    for (uint8_t n = 0; n < sync->sample_count; n++) {
+        const tsync_sample_t * s = &sync->samples[n];
+        double x, y;
+
+        if (s->rtt_us > rtt_limit) {
+            continue;
+        }
+        x = -(double)(device_us - s->device_us);
+        y = (double)s->error_us;
+        if ((count == 0) || (x < x_min)) {
+            x_min = x;
+        }
+        if ((count == 0) || (x > x_max)) {
+            x_max = x;
+        }
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+        count++;
+    }
+
+    p_model->ref_us = device_us;
+    p_model->samples = count;
+    p_model->drift_fitted = false;
+
+    if ((count >= 2) && ((x_max - x_min) >= (double)TSYNC_DRIFT_SPAN_US)) {
+        slope = ((count * sum_xy) - (sum_x * sum_y)) / ((count * sum_xx) - (sum_x * sum_x));
+        sync->drift_ppm = fmaxf(-TSYNC_DRIFT_MAX_PPM, fminf(TSYNC_DRIFT_MAX_PPM, (float)(slope * 1.0e6)));
+        p_model->drift_fitted = true;
+    }
+
+    /* Offset of the line of that slope through the samples, also for a clamped or kept drift */
+    slope = (double)sync->drift_ppm * 1.0e-6;
+    intercept = (sum_y - (slope * sum_x)) / count;
+
+    p_model->offset_us = (int64_t)llround(intercept);
+    p_model->drift_ppm = sync->drift_ppm;
+    return true;
+}
+
+/*
+ * Local functions
+ */
+
+/**
+ * @brief Return the longest round trip of a sample used by the fit
+ */
+static uint32_t rtt_limit_get(const tsync_t * sync)
+{
+    uint32_t rtt_min = UINT32_MAX;
+
+    for (uint8_t n = 0; n < sync->sample_count; n++) {
+        if (sync->samples[n].rtt_us < rtt_min) {
+            rtt_min = sync->samples[n].rtt_us;
+        }
+    }
+    return (rtt_min > (UINT32_MAX - TSYNC_RTT_SLACK_US)) ? UINT32_MAX : (rtt_min + TSYNC_RTT_SLACK_US);
+}
+
+/* END OF FILE */
@@ -0,0 +1,115 @@
+/****************************************************************
+ * Project: RENFORCE EDA FIRMWARE
+ * Module: TIME SYNC
+ *
+ *---------------------------------------------------------------
+ * @brief Fit of the device clock against the host clock
+ *
+ * Each sample pairs the device clock when a host request was
+ * received with the host time at that point, which the host takes
+ * halfway between sending the request and receiving the reply.
+ * Samples whose round trip is well above the shortest one of the
+ * window are left out, their midpoint is the least reliable.
+ *
+ * The error of the device clock, host time minus device time, is
+ * fitted as a line over the last TSYNC_SAMPLE_NUM samples: its
+ * value at the last sample gives the offset, its slope the drift.
+ * The drift is only fitted once the samples span
+ * TSYNC_DRIFT_SPAN_US, the last one is kept until then.
+ *
+ * Dependencies : none
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef TIME_SYNC_H_
+#define TIME_SYNC_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Public constants
+ */
+
+#define TSYNC_SAMPLE_NUM        32                  /**< Samples of the fit, 16 min with a request every 30 s */
+#define TSYNC_RTT_SLACK_US      20000               /**< Round trip above the shortest one of the window that leaves a sample out, a few connection intervals */
+#define TSYNC_DRIFT_SPAN_US     120000000ULL        /**< Samples span needed to fit the drift, BLE latency jitter is a few ms */
+#define TSYNC_DRIFT_MAX_PPM     1000.0f             /**< Drift fitted is clamped to this, above what the LFCLK sources can do */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief One device time, host time pair
+ */
+typedef struct {
+    uint64_t device_us;                         /**< Device clock when the request was received */
+    int64_t error_us;                           /**< Host time minus device_us */
+    uint32_t rtt_us;                            /**< Round trip measured by the host */
+} tsync_sample_t;
+
+/**
+ * @brief Fit state
+ */
+typedef struct {
+    tsync_sample_t samples[TSYNC_SAMPLE_NUM];   /**< Used as a ring */
+    uint8_t sample_index;                       /**< Next sample written */
+    uint8_t sample_count;
+    float drift_ppm;                            /**< Last drift fitted, kept by TSYNC_Reset */
+} tsync_t;
+
+/**
+ * @brief Clock model: host time = device_us + offset_us + (device_us - ref_us) * drift_ppm / 1e6
+ */
+typedef struct {
+    uint64_t ref_us;                            /**< Device clock of the last sample */
+    int64_t offset_us;                          /**< Error fitted at ref_us */
+    float drift_ppm;                            /**< Positive if the device clock runs slow */
+    uint8_t samples;                            /**< Samples the offset was fitted from */
+    bool drift_fitted;                          /**< false if drift_ppm is the one kept from before */
+} tsync_model_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start with no sample and no drift
+ */
+void TSYNC_Init(tsync_t * sync);
+
+/**
+ * @brief Drop the samples, for another host. The drift is kept: it belongs to the
+ * device clock.
+ */
+void TSYNC_Reset(tsync_t * sync);
+
+/**
+ * @brief Add a sample and fit the model again
+ * @param[in] device_us device clock when the request was received
+ * @param[in] host_us host time at that point
+ * @param[in] rtt_us round trip the host measured for the request
+ * @param[out] p_model model fitted
+ * @return false if the sample was refused (device clock not after the last sample)
+ */
+bool TSYNC_AddSample(tsync_t * sync, uint64_t device_us, uint64_t host_us, uint32_t rtt_us, tsync_model_t * p_model);
+
+#endif /* TIME_SYNC_H_ */
+
+/* END OF FILE */
@@ -0,0 +1,588 @@
+/****************************************************************
+ * Project: RENFORCE EDA RECEIVER
+ * Module: RECEIVER TEST
+ *
+ *---------------------------------------------------------------
+ * @brief Check that receiver.c merges the spectra of simulated
+ * devices in host time order and maps them to the host time they
+ * were computed at, whatever the epoch and drift of each device
+ * clock, while each device corrects its calendar
+ *
+ * Devices run the firmware time_sync fit on their clock and apply
+ * its model to the calendar that dates their spectra at each
+ * TimeSyncRequest, sending the batch in progress first, as the
+ * firmware does.
+ *
+ * Devices run in threads at the other end of socket pairs, and
+ * write in BLE sized packets. Host time is a clock of the test,
+ * stepped by TEST_STEP_US every TEST_STEP_REAL_US of real time so
+ * that the clock models see minutes of drift in a few seconds. The
+ * receiver reads its socket through a transport of the test that
+ * counts bytes in flight, and the clock only steps once both ways
+ * are handled: a request is replied to within a step and has an
+ * exact midpoint, whatever the load of the machine.
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Project includes */
+
+#include "receiver.h"
+#include "transport_fd.h"
+#include "frame/frame.h"
+#include "time_sync/time_sync.h"
+#include "nanocobs/cobs.h"
+#include "nanopb/pb_encode.h"
+#include "nanopb/pb_decode.h"
+#include "protocol.pb.h"
+
+/*
+ * Local constants
+ */
+
+#define TEST_STEP_US            100000              /**< Host time step */
+#define TEST_STEP_REAL_US       1000                /**< Time of an exchange to be replied to within a step */
+#define TEST_HOST_START_US      1700000000000000ULL
+#define TEST_DURATION_US        400000000ULL        /**< Host time the devices send spectra */
+#define TEST_WARMUP_US          200000000ULL        /**< Spectra before are not checked against their host time, the drift is fitted once sync samples span TSYNC_DRIFT_SPAN_US */
+#define TEST_SPECTRUM_US        125000ULL           /**< 8 spectra per second */
+#define TEST_BATCH_SIZE         8
+#define TEST_FREQUENCY_NUM      16
+#define TEST_PACKET_SIZE        20                  /**< Default BLE MTU, both ways */
+#define TEST_SYNC_INTERVAL_MS   10000
+#define TEST_DEVICE_NUM         3
+#define TEST_SPECTRUM_MAX       (TEST_DEVICE_NUM * (TEST_DURATION_US / TEST_SPECTRUM_US) + 64)
+#define TEST_ALIGN_TOLERANCE_US 1000
+#define TEST_DRIFT_TOLERANCE    1.0
+#define TEST_LATE_MAX           0.01                /**< Share of spectra out of host time order */
+#define TEST_MODEL_MIN          10                  /**< Calendar corrections of each device, one per TimeSyncRequest after the first */
+
+/*
+ * Local types
+ */
+
+typedef struct {
+    uint8_t index;
+    int fd;                     /**< Device end of the socket pair */
+    double drift_ppm;           /**< Positive if the device clock runs slow */
+    uint64_t boot_us;           /**< Device clock at TEST_HOST_START_US */
+    uint64_t epoch_us;          /**< Calendar at TEST_HOST_START_US */
+    uint64_t first_us;          /**< Host time of the first spectrum */
+    bool half;                  /**< IMPEDANCE_ENCODING_HALF */
+    pthread_t thread;
+    tsync_t sync;               /**< Device fit of its clock */
+    uint64_t cal_ref_us;        /**< Calendar model: calendar = clock + offset + (clock - ref) * drift */
+    int64_t cal_offset_us;
+    float cal_drift_ppm;
+    uint32_t models;            /**< Models applied to the calendar */
+    uint32_t batch_k;           /**< First spectrum of the batch in progress */
+    uint32_t batch_count;       /**< Spectra of the batch in progress */
+    uint32_t generated;
+    uint32_t sync_requests;
+    uint32_t sync_returned;     /**< Requests carrying the host time of the previous one */
+    int64_t sync_excess_max;    /**< Error of that host time beyond half its round trip */
+    uint64_t last_device_us;    /**< Device clock the previous request was received */
+    uint64_t last_host_us;      /**< Host time the previous request was received */
+    uint64_t to_device;         /**< Bytes written by the receiver */
+    uint64_t to_device_done;    /**< Of those, handled by the device */
+    uint64_t to_host;           /**< Bytes written by the device */
+    uint64_t to_host_done;      /**< Of those, handled by the receiver reader */
+} sim_device_t;
+
+/**
+ * @brief Receiver transport of a device, a file descriptor one counting bytes
+ */
+typedef struct {
+    sim_device_t * device;
+    tfd_t tfd;
+    rcv_transport_t fd_transport;
+    int read_last;              /**< Bytes of the last read, handled once the reader reads again */
+} sim_link_t;
+
+typedef struct {
+    uint8_t device;
+    uint64_t host_us;
+    float real;
+    float imag;
+} record_t;
+
+/*
+ * Local variables
+ */
+
+static int failures;
+static volatile uint64_t host_now = TEST_HOST_START_US;
+static sim_device_t devices[TEST_DEVICE_NUM] = {
+    /* Drifts of an LFRC, uncorrected they are above TEST_ALIGN_TOLERANCE_US within seconds */
+    { .drift_ppm = 250.0,  .boot_us = 3600000000ULL, .epoch_us = 3600000000ULL },                         /* Calendar never set */
+    { .drift_ppm = -150.0, .boot_us = 60000000ULL,   .epoch_us = TEST_HOST_START_US - 7200000000ULL },    /* Set by another host */
+    { .drift_ppm = 20.0,   .boot_us = 5000000ULL,    .epoch_us = TEST_HOST_START_US + 5000000ULL, .half = true },
+};
+static record_t records[TEST_SPECTRUM_MAX];
+static uint32_t record_count;
+
+/*
+ * Local functions
+ */
+
+static uint64_t test_clock(void)
+{
+    return __atomic_load_n(&host_now, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Free running device clock (CAL_GetUptime) at a host time
+ */
+static uint64_t device_clock(const sim_device_t * device, uint64_t host_us)
+{
+    double elapsed = (double)(int64_t)(host_us - TEST_HOST_START_US);
+
+    return device->boot_us + (uint64_t)llround(elapsed / (1.0 + (device->drift_ppm * 1.0e-6)));
+}
+
+/**
+ * @brief Calendar at a device clock value, as CAL_GetUptimeTime
+ */
+static uint64_t device_calendar(const sim_device_t * device, uint64_t clock_us)
+{
+    double correction = (double)(int64_t)(clock_us - device->cal_ref_us) * (double)device->cal_drift_ppm * 1.0e-6;
+
+    return (uint64_t)(device->cal_offset_us + (int64_t)clock_us + (int64_t)llround(correction));
+}
+
+static uint64_t device_time(const sim_device_t * device, uint64_t host_us)
+{
+    return device_calendar(device, device_clock(device, host_us));
+}
+
+static uint64_t spectrum_time(const sim_device_t * device, int64_t k)
+{
+    return device->first_us + (uint64_t)(k * (int64_t)TEST_SPECTRUM_US);
+}
+
+/**
+ * @brief Half float of a small integer, exact below 2048
+ */
+static uint16_t half_from_int(int value)
+{
+    uint16_t sign = (value < 0) ? 0x8000 : 0;
+    int exponent = 0;
+
+    value = abs(value);
+    if (value == 0) {
+        return sign;
+    }
+    while ((value >> exponent) > 1) {
+        exponent++;
+    }
+    return sign | (uint16_t)((exponent + 15) << 10) | (uint16_t)(((value << 10) >> exponent) & 0x3FF);
+}
+
+static void sim_send(sim_device_t * device, const DeviceMessage * message)
+{
+    uint8_t buffer[DeviceMessage_size];
+    uint8_t frame[DeviceMessage_size + (DeviceMessage_size / 254) + 2];
+    pb_ostream_t ostream = pb_ostream_from_buffer(buffer, sizeof(buffer));
+    unsigned length;
+
+    if (!pb_encode(&ostream, DeviceMessage_fields, message) ||
+        (cobs_encode(buffer, (unsigned)ostream.bytes_written, frame, sizeof(frame), &length) != COBS_RET_SUCCESS)) {
+        printf("device %u: encoding failed\n", device->index);
+        failures++;
+        return;
+    }
+    for (unsigned offset = 0; offset < length; offset += TEST_PACKET_SIZE) {
+        unsigned size = ((length - offset) < TEST_PACKET_SIZE) ? (length - offset) : TEST_PACKET_SIZE;
+        __atomic_add_fetch(&device->to_host, size, __ATOMIC_SEQ_CST);
+        if (write(device->fd, &frame[offset], size) != (ssize_t)size) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Spectra of the batch in progress, dated by the calendar. The real part of
+ * spectrum k is k modulo 1024 so that the check finds the host time it was computed at.
+ */
+static void sim_batch_send(sim_device_t * device)
+{
+    DeviceMessage message = DeviceMessage_init_zero;
+    EdaBatch * batch = &message.payload.eda_batch;
+    uint32_t k = device->batch_k;
+    uint64_t first_us = device_time(device, spectrum_time(device, k));
+
+    if (device->batch_count == 0) {
+        return;
+    }
+    message.which_payload = DeviceMessage_eda_batch_tag;
+    batch->has_timestamp = true;
+    batch->timestamp.time = first_us / 1000000ULL;
+    batch->timestamp.us = (uint32_t)(first_us % 1000000ULL);
+    batch->spectra_count = device->batch_count;
+    for (uint8_t n = 0; n < device->batch_count; n++) {
+        EdaSpectrum * spectrum = &batch->spectra[n];
+        int real = (int)((k + n) % 1024);
+
+        spectrum->delta_us = (uint32_t)(device_time(device, spectrum_time(device, k + n)) - first_us);
+        for (uint8_t f = 0; f < TEST_FREQUENCY_NUM; f++) {
+            int imag = -(int)((device->index * TEST_FREQUENCY_NUM) + f);
+            if (device->half) {
+                uint16_t half_real = half_from_int(real);
+                uint16_t half_imag = half_from_int(imag);
+                spectrum->data_half.bytes[(4 * f) + 0] = (uint8_t)half_real;
+                spectrum->data_half.bytes[(4 * f) + 1] = (uint8_t)(half_real >> 8);
+                spectrum->data_half.bytes[(4 * f) + 2] = (uint8_t)half_imag;
+                spectrum->data_half.bytes[(4 * f) + 3] = (uint8_t)(half_imag >> 8);
+            }
+            else {
+                spectrum->data[f].real = (float)real;
+                spectrum->data[f].imag = (float)imag;
+            }
+        }
+        if (device->half) {
+            spectrum->data_half.size = 4 * TEST_FREQUENCY_NUM;
+        }
+        else {
+            spectrum->data_count = TEST_FREQUENCY_NUM;
+        }
+    }
+    sim_send(device, &message);
+    device->batch_k += device->batch_count;
+    device->batch_count = 0;
+}
+
+/**
+ * @brief Handle a host message as the firmware does: a Timestamp sets the calendar,
+ * a TimeSyncRequest fits the device clock from the previous one, applies the model
+ * to the calendar, and is replied to
+ */
+static void sim_message_handle(sim_device_t * device, const HostMessage * request)
+{
+    DeviceMessage message = DeviceMessage_init_zero;
+    TimeSyncStatus * status = &message.payload.time_sync_status;
+    const TimeSyncRequest * sync = &request->payload.time_sync_request;
+    uint64_t host_us = test_clock();
+    uint64_t clock_us = device_clock(device, host_us);
+    uint64_t device_us;
+    tsync_model_t model;
+
+    if (request->which_payload == HostMessage_timestamp_tag) {
+        /* CAL_SetTime, the drift correction goes on from the time set */
+        sim_batch_send(device);
+        device->cal_offset_us += (int64_t)((request->payload.timestamp.time * 1000000ULL) + request->payload.timestamp.us) -
+                                 (int64_t)device_calendar(device, clock_us);
+        return;
+    }
+    if (request->which_payload != HostMessage_time_sync_request_tag) {
+        return;
+    }
+    device->sync_requests++;
+    if (sync->has_last_host_time && (sync->last_device_us == device->last_device_us)) {
+        /* Midpoint is within half the round trip of the time the request was received */
+        int64_t error = (int64_t)((sync->last_host_time.time * 1000000ULL) + sync->last_host_time.us - device->last_host_us);
+        int64_t excess = llabs(error) - (sync->last_rtt_us / 2);
+        device->sync_returned++;
+        if (excess > device->sync_excess_max) {
+            device->sync_excess_max = excess;
+        }
+    }
+    if ((sync->last_device_us != 0) && sync->has_last_host_time &&
+        TSYNC_AddSample(&device->sync, sync->last_device_us,
+                        (sync->last_host_time.time * 1000000ULL) + sync->last_host_time.us, sync->last_rtt_us, &model)) {
+        /* Spectra of a batch are relative to its first timestamp */
+        sim_batch_send(device);
+        device->cal_ref_us = model.ref_us;
+        device->cal_offset_us = model.offset_us;
+        device->cal_drift_ppm = model.drift_ppm;
+        device->models++;
+    }
+    device->last_device_us = clock_us;
+    device->last_host_us = host_us;
+
+    device_us = device_calendar(device, clock_us);
+    message.which_payload = DeviceMessage_time_sync_status_tag;
+    message.request_id = request->request_id;
+    status->device_us = clock_us;
+    status->drift_ppm = device->sync.drift_ppm;
+    status->has_time = true;
+    status->time.time = device_us / 1000000ULL;
+    status->time.us = (uint32_t)(device_us % 1000000ULL);
+    sim_send(device, &message);
+}
+
+static void * sim_thread(void * arg)
+{
+    sim_device_t * device = arg;
+    uint8_t rx_buffer[HostMessage_size];
+    frame_rx_t rx;
+
+    TSYNC_Init(&device->sync);
+    device->cal_offset_us = (int64_t)device->epoch_us - (int64_t)device->boot_us;
+    FRAME_RxInit(&rx, rx_buffer, sizeof(rx_buffer));
+    for (;;) {
+        uint64_t now = test_clock();
+        struct pollfd pfd = { .fd = device->fd, .events = POLLIN };
+        uint8_t data[64];
+        ssize_t length;
+
+        if (now >= (TEST_HOST_START_US + TEST_DURATION_US)) {
+            break;
+        }
+        /* Batch is sent once its last spectrum is computed */
+        while (now >= spectrum_time(device, device->batch_k + device->batch_count)) {
+            device->batch_count++;
+            if (device->batch_count == TEST_BATCH_SIZE) {
+                sim_batch_send(device);
+            }
+        }
+        if ((poll(&pfd, 1, 1) <= 0) || ((length = read(device->fd, data, sizeof(data))) <= 0)) {
+            continue;
+        }
+        __atomic_add_fetch(&device->to_device_done, length, __ATOMIC_SEQ_CST);
+        for (const uint8_t * p_data = data; length > 0; ) {
+            bool complete;
+            uint16_t used = FRAME_RxPush(&rx, p_data, (uint16_t)length, &complete);
+            p_data += used;
+            length -= used;
+            if (complete) {
+                HostMessage request = HostMessage_init_zero;
+                pb_istream_t istream = pb_istream_from_buffer(rx.buffer, rx.length);
+                if (pb_decode(&istream, HostMessage_fields, &request)) {
+                    sim_message_handle(device, &request);
+                }
+            }
+        }
+    }
+    device->generated = device->batch_k;
+    shutdown(device->fd, SHUT_WR);
+    return NULL;
+}
+
+static int link_read(void * context, uint8_t * data, size_t size)
+{
+    sim_link_t * link = context;
+
+    __atomic_add_fetch(&link->device->to_host_done, link->read_last, __ATOMIC_SEQ_CST);
+    link->read_last = link->fd_transport.ops->read(link->fd_transport.context, data, size);
+    return link->read_last;
+}
+
+static int link_write(void * context, const uint8_t * data, size_t size)
+{
+    sim_link_t * link = context;
+    int length = link->fd_transport.ops->write(link->fd_transport.context, data, size);
+
+    if (length > 0) {
+        __atomic_add_fetch(&link->device->to_device, length, __ATOMIC_SEQ_CST);
+    }
+    return length;
+}
+
+static void link_close(void * context)
+{
+    sim_link_t * link = context;
+
+    link->fd_transport.ops->close(link->fd_transport.context);
+}
+
+static const rcv_transport_ops_t link_ops = {
+    .read = link_read,
+    .write = link_write,
+    .close = link_close,
+};
+
+/**
+ * @brief Return true if all bytes written both ways were handled
+ */
+static bool links_idle(void)
+{
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        if ((__atomic_load_n(&devices[d].to_device, __ATOMIC_SEQ_CST) !=
+             __atomic_load_n(&devices[d].to_device_done, __ATOMIC_SEQ_CST)) ||
+            (__atomic_load_n(&devices[d].to_host, __ATOMIC_SEQ_CST) !=
+             __atomic_load_n(&devices[d].to_host_done, __ATOMIC_SEQ_CST))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Merged stream handler, from the receiver service thread
+ */
+static void spectrum_handle(const rcv_spectrum_t * spectrum, void * context)
+{
+    if (record_count < TEST_SPECTRUM_MAX) {
+        records[record_count].device = spectrum->device;
+        records[record_count].host_us = spectrum->host_us;
+        records[record_count].real = spectrum->real[0];
+        records[record_count].imag = spectrum->imag[TEST_FREQUENCY_NUM - 1];
+        record_count++;
+    }
+}
+
+/**
+ * @brief Host time a spectrum was computed at, from its real part and host time
+ */
+static uint64_t record_truth(const record_t * record)
+{
+    const sim_device_t * device = &devices[record->device];
+    int64_t k = (int64_t)record->real;
+    double wraps = (double)(int64_t)(record->host_us - spectrum_time(device, k)) / (1024.0 * TEST_SPECTRUM_US);
+
+    return spectrum_time(device, k + (1024 * llround(wraps)));
+}
+
+static void test_merge(void)
+{
+    rcv_config_t config = {
+        .workers = 3,
+        .sync_interval_ms = TEST_SYNC_INTERVAL_MS,
+        .clock = test_clock,
+        .handler = spectrum_handle,
+    };
+    sim_link_t links[TEST_DEVICE_NUM];
+    int fds[TEST_DEVICE_NUM][2];
+    uint32_t received[TEST_DEVICE_NUM] = { 0 };
+    uint32_t out_of_order = 0;
+    int64_t error_max = 0;
+    rcv_t * receiver;
+
+    receiver = RCV_Create(&config);
+    if (receiver == NULL) {
+        printf("merge: receiver not created\n");
+        failures++;
+        return;
+    }
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        rcv_transport_t transport = { .ops = &link_ops, .context = &links[d], .packet_size = TEST_PACKET_SIZE };
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds[d]) != 0) {
+            printf("merge: no socket pair\n");
+            failures++;
+            return;
+        }
+        devices[d].index = d;
+        devices[d].fd = fds[d][1];
+        /* Devices do not compute their spectra at the same time */
+        devices[d].first_us = TEST_HOST_START_US + (d * 40000ULL);
+        pthread_create(&devices[d].thread, NULL, sim_thread, &devices[d]);
+        links[d].device = &devices[d];
+        links[d].read_last = 0;
+        TFD_Init(&links[d].tfd, fds[d][0], TEST_PACKET_SIZE, &links[d].fd_transport);
+        if (RCV_AddDevice(receiver, &transport) != d) {
+            printf("merge: device %u not added\n", d);
+            failures++;
+        }
+    }
+
+    while (test_clock() < (TEST_HOST_START_US + TEST_DURATION_US)) {
+        usleep(TEST_STEP_REAL_US);
+        while (links_idle() == false) {
+            usleep(TEST_STEP_REAL_US / 10);
+        }
+        __atomic_add_fetch(&host_now, TEST_STEP_US, __ATOMIC_SEQ_CST);
+    }
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        pthread_join(devices[d].thread, NULL);
+    }
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        rcv_device_stats_t stats;
+        int64_t calendar_error = (int64_t)(device_time(&devices[d], test_clock()) - test_clock());
+
+        RCV_GetDeviceStats(receiver, d, &stats);
+        printf("device %u: drift %.1f ppm for %.1f, %u sync samples, %u/%u requests returned their host time\n",
+               d, stats.drift_ppm, devices[d].drift_ppm, stats.sync_samples,
+               devices[d].sync_returned, devices[d].sync_requests);
+        printf("device %u: calendar corrected %u times, %lld us from host time at the end\n",
+               d, devices[d].models, (long long)calendar_error);
+        if ((devices[d].models < TEST_MODEL_MIN) || (llabs(calendar_error) > TEST_ALIGN_TOLERANCE_US)) {
+            printf("device %u: calendar not corrected by the device\n", d);
+            failures++;
+        }
+        if ((stats.modelled == false) || (fabs(stats.drift_ppm - devices[d].drift_ppm) > TEST_DRIFT_TOLERANCE)) {
+            printf("device %u: clock model off\n", d);
+            failures++;
+        }
+        if ((devices[d].sync_returned == 0) || (devices[d].sync_excess_max > 0)) {
+            printf("device %u: host times of the requests off\n", d);
+            failures++;
+        }
+        if ((stats.frames_dropped != 0) || (stats.decode_errors != 0)) {
+            printf("device %u: %u frames dropped, %u not decoded\n", d, stats.frames_dropped, stats.decode_errors);
+            failures++;
+        }
+    }
+    RCV_Destroy(receiver);
+
+    for (uint32_t n = 0; n < record_count; n++) {
+        const record_t * record = &records[n];
+        uint64_t truth = record_truth(record);
+        int64_t error = (int64_t)(record->host_us - truth);
+
+        received[record->device]++;
+        if ((n > 0) && (record->host_us < records[n - 1].host_us)) {
+            out_of_order++;
+        }
+        if (record->imag != -(float)((record->device * TEST_FREQUENCY_NUM) + TEST_FREQUENCY_NUM - 1)) {
+            printf("merge: device %u spectrum impedance mixed up\n", record->device);
+            failures++;
+            break;
+        }
+        if ((truth >= (TEST_HOST_START_US + TEST_WARMUP_US)) && (llabs(error) > error_max)) {
+            error_max = llabs(error);
+        }
+    }
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        if (received[d] != devices[d].generated) {
+            printf("merge: device %u %u spectra merged out of %u\n", d, received[d], devices[d].generated);
+            failures++;
+        }
+    }
+
+    printf("merge: %u spectra, %u out of host time order, max error %lld us\n",
+           record_count, out_of_order, (long long)error_max);
+    if (out_of_order > (uint32_t)(record_count * TEST_LATE_MAX)) {
+        printf("merge: stream out of order\n");
+        failures++;
+    }
+    if (error_max > TEST_ALIGN_TOLERANCE_US) {
+        printf("merge: host times off\n");
+        failures++;
+    }
+    for (uint8_t d = 0; d < TEST_DEVICE_NUM; d++) {
+        close(fds[d][0]);
+        close(fds[d][1]);
+    }
+}
+
+int main(void)
+{
+    test_merge();
+
+    if (failures != 0) {
+        printf("FAILED (%d)\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("receiver: OK\n");
+    return EXIT_SUCCESS;
+}
+
+/* END OF FILE */
@@ -0,0 +1,820 @@
+/****************************************************************
+ * Project: RENFORCE EDA RECEIVER
+ * Module: RECEIVER
+ *
+ *---------------------------------------------------------------
+ * @brief Host receiver of several EDA devices, merged in host time
+ *
+ * A single lock guards the receiver and its devices, it is not
+ * held while frames are decoded, written to a transport, or handed
+ * to the handler. Frames of a device go through a ring of jobs in
+ * arrival order: the reader fills a free job, a worker decodes it,
+ * and the service thread releases decoded jobs from the head only,
+ * so that the spectra of a device keep their order whatever the
+ * worker that decoded them.
+ *
+ * Spectra are dated by the device calendar, which the device
+ * corrects itself at each TimeSyncRequest. Each TimeSyncStatus
+ * gives the calendar model the device uses from then on: spectra
+ * released after it, in arrival order, are brought back with it
+ * to the free running device clock. The receiver fits its own
+ * model of that clock, which no one else changes, and maps device
+ * clock to host time when a spectrum is merged, with the last
+ * model fitted: a host time span of a device is never computed
+ * with two models.
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project includes */
+#include "receiver.h"
+#include "frame/frame.h"
+#include "time_sync/time_sync.h"
+
+/* Protobuf includes */
+#include "nanocobs/cobs.h"
+#include "nanopb/pb_encode.h"
+#include "nanopb/pb_decode.h"
+#include "protocol.pb.h"
+
+/*
+ * Local constants
+ */
+
+#define RCV_JOB_NUM             16          /**< Frames of a device waiting for or under decoding */
+#define RCV_QUEUE_NUM           256         /**< Spectra of a device waiting for the merge, 32 s at 8 spectra per second */
+#define RCV_BATCH_SIZE          pb_arraysize(EdaBatch, spectra)
+#define RCV_READ_SIZE           256
+#define RCV_POLL_MS             10          /**< Service thread period, bounds the delay of time requests and of merge_delay_ms */
+#define RCV_TX_FRAME_SIZE       (HostMessage_size + (HostMessage_size / 254) + 2)   /**< COBS overhead and delimiter */
+
+/*
+ * Local macros
+ */
+
+#define RCV_MIN(a, b)           (((a) < (b)) ? (a) : (b))
+#define RCV_ARRAY_SIZE(array)   (sizeof(array) / sizeof((array)[0]))
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local types
+ */
+
+typedef enum {
+    RCV_JOB_FREE = 0,
+    RCV_JOB_QUEUED,                         /**< Waits for or is under decoding */
+    RCV_JOB_DONE,                           /**< Waits for the jobs before it to be released */
+} rcv_job_state_t;
+
+typedef struct rcv_device_s rcv_device_t;
+
+typedef struct {
+    rcv_device_t * device;
+    rcv_job_state_t state;
+    uint8_t data[DeviceMessage_size];       /**< Decoded COBS frame */
+    uint16_t length;
+    uint64_t received_us;                   /**< Host time the frame was complete */
+    uint8_t spectrum_count;
+    rcv_spectrum_t spectra[RCV_BATCH_SIZE]; /**< Of an EdaBatch, host_us not set yet and device_us in calendar time */
+    bool sync_status;                       /**< Job is a TimeSyncStatus, handled once released */
+    uint32_t request_id;
+    TimeSyncStatus status;
+} rcv_job_t;
+
+struct rcv_device_s {
+    rcv_t * receiver;
+    uint8_t index;
+    rcv_transport_t transport;
+    pthread_t reader;
+    frame_rx_t rx;                          /**< Reader thread only */
+    uint8_t rx_buffer[DeviceMessage_size];
+    rcv_job_t jobs[RCV_JOB_NUM];            /**< Ring in arrival order */
+    uint8_t job_head;
+    uint8_t job_count;
+    rcv_spectrum_t queue[RCV_QUEUE_NUM];    /**< Ring of spectra released, in arrival order */
+    uint16_t queue_head;
+    uint16_t queue_count;
+    tsync_t sync;
+    tsync_model_t model;                    /**< Host time of the device clock */
+    bool calendar_valid;                    /**< Calendar model of the device known, queued spectra are in device clock */
+    uint64_t calendar_device_us;            /**< Device clock of the last TimeSyncStatus */
+    uint64_t calendar_us;                   /**< Calendar time at calendar_device_us */
+    float calendar_drift_ppm;               /**< Calendar runs faster than the device clock by this */
+    uint32_t request_id;                    /**< Of the last HostMessage sent */
+    uint32_t sync_request_id;               /**< TimeSyncRequest waiting for its reply, 0 if none */
+    uint64_t sync_sent_us;
+    uint64_t sync_next_us;                  /**< Host time of the next TimeSyncRequest */
+    bool sync_last_valid;                   /**< Previous request was replied to, sent back with the next one */
+    uint64_t sync_last_device_us;
+    uint64_t sync_last_host_us;
+    uint32_t sync_last_rtt_us;
+    rcv_device_stats_t stats;
+};
+
+struct rcv_s {
+    rcv_config_t config;
+    pthread_mutex_t lock;                   /**< Everything below, and all devices */
+    pthread_cond_t work_cond;               /**< Job queued, or stopping */
+    pthread_cond_t done_cond;               /**< Job decoded or released, device ended, or flushing */
+    pthread_t workers[RCV_WORKER_MAX];
+    uint8_t worker_count;
+    pthread_t service;
+    bool service_started;
+    rcv_device_t * devices[RCV_DEVICE_MAX];
+    uint8_t device_count;
+    rcv_job_t * work[RCV_DEVICE_MAX * RCV_JOB_NUM];     /**< Ring of jobs waiting for a worker */
+    uint16_t work_head;
+    uint16_t work_count;
+    bool stopping;                          /**< Workers exit once work is empty */
+    bool flushing;                          /**< Service thread hands all spectra and exits */
+    bool emitted;
+    uint64_t emitted_us;                    /**< host_us of the last spectrum handled */
+};
+
+/*
+ * Local variables
+ */
+
+/*
+ * Local functions
+ */
+
+static void * reader_thread(void * arg);
+static void job_queue(rcv_device_t * device);
+static void * worker_thread(void * arg);
+static bool job_decode(rcv_job_t * job, DeviceMessage * message);
+static void batch_unpack(rcv_job_t * job, const EdaBatch * batch);
+static float half_to_float(uint16_t half);
+static void time_sync_status_handle(rcv_device_t * device, const rcv_job_t * job);
+static uint64_t calendar_to_device(const rcv_device_t * device, uint64_t calendar_us);
+static void * service_thread(void * arg);
+static void jobs_release(rcv_device_t * device);
+static void merge_emit(rcv_t * receiver, uint64_t now_us, bool flush);
+static uint64_t device_to_host(const rcv_device_t * device, uint64_t device_us);
+static bool sync_request_encode(rcv_device_t * device, uint64_t now_us, uint8_t * frame, unsigned * p_length);
+static bool message_encode(const HostMessage * message, uint8_t * frame, unsigned * p_length);
+static bool transport_send(rcv_device_t * device, const uint8_t * frame, unsigned length);
+static uint64_t host_clock(const rcv_t * receiver);
+static uint64_t timestamp_to_us(const Timestamp * timestamp);
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start the worker and service threads
+ */
+rcv_t * RCV_Create(const rcv_config_t * config)
+{
+    rcv_t * receiver = calloc(1, sizeof(rcv_t));
+    pthread_condattr_t attr;
+
+    if (receiver == NULL) {
+        return NULL;
+    }
+    receiver->config = *config;
+    if (receiver->config.workers == 0) {
+        receiver->config.workers = RCV_WORKER_DEFAULT;
+    }
+    receiver->config.workers = RCV_MIN(receiver->config.workers, RCV_WORKER_MAX);
+    if (receiver->config.sync_interval_ms == 0) {
+        receiver->config.sync_interval_ms = RCV_SYNC_INTERVAL_MS;
+    }
+    if (receiver->config.merge_delay_ms == 0) {
+        receiver->config.merge_delay_ms = RCV_MERGE_DELAY_MS;
+    }
+
+    pthread_mutex_init(&receiver->lock, NULL);
+    pthread_cond_init(&receiver->work_cond, NULL);
+    /* Service thread period must not follow host clock steps */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&receiver->done_cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    for (uint8_t n = 0; n < receiver->config.workers; n++) {
+        if (pthread_create(&receiver->workers[n], NULL, worker_thread, receiver) != 0) {
+            RCV_Destroy(receiver);
+            return NULL;
+        }
+        receiver->worker_count++;
+    }
+    if (pthread_create(&receiver->service, NULL, service_thread, receiver) != 0) {
+        RCV_Destroy(receiver);
+        return NULL;
+    }
+    receiver->service_started = true;
+    return receiver;
+}
+
+/**
+ * @brief Start receiving from a device, and sending it time requests
+ */
+int RCV_AddDevice(rcv_t * receiver, const rcv_transport_t * transport)
+{
+    rcv_device_t * device;
+    int index;
+
+    pthread_mutex_lock(&receiver->lock);
+    index = (receiver->device_count < RCV_DEVICE_MAX) ? receiver->device_count : -1;
+    pthread_mutex_unlock(&receiver->lock);
+    if ((index < 0) || ((device = calloc(1, sizeof(rcv_device_t))) == NULL)) {
+        return -1;
+    }
+    device->receiver = receiver;
+    device->index = (uint8_t)index;
+    device->transport = *transport;
+    FRAME_RxInit(&device->rx, device->rx_buffer, sizeof(device->rx_buffer));
+    for (uint8_t n = 0; n < RCV_JOB_NUM; n++) {
+        device->jobs[n].device = device;
+    }
+    TSYNC_Init(&device->sync);
+    device->stats.connected = true;
+
+    /* No Timestamp: the device sets its calendar from the TimeSyncRequests, and spectra
+     * dated before would be mapped with a calendar model they were not dated with */
+    device->sync_next_us = host_clock(receiver);
+
+    if (pthread_create(&device->reader, NULL, reader_thread, device) != 0) {
+        free(device);
+        return -1;
+    }
+    pthread_mutex_lock(&receiver->lock);
+    receiver->devices[index] = device;
+    receiver->device_count++;
+    pthread_mutex_unlock(&receiver->lock);
+    return index;
+}
+
+/**
+ * @brief Copy the counters and clock model of a device
+ */
+void RCV_GetDeviceStats(rcv_t * receiver, uint8_t device, rcv_device_stats_t * p_stats)
+{
+    pthread_mutex_lock(&receiver->lock);
+    if (device < receiver->device_count) {
+        *p_stats = receiver->devices[device]->stats;
+    }
+    else {
+        memset(p_stats, 0, sizeof(rcv_device_stats_t));
+    }
+    pthread_mutex_unlock(&receiver->lock);
+}
+
+/**
+ * @brief Close all transports, hand all spectra decoded to the handler, and stop
+ */
+void RCV_Destroy(rcv_t * receiver)
+{
+    /* No more frames */
+    for (uint8_t n = 0; n < receiver->device_count; n++) {
+        rcv_device_t * device = receiver->devices[n];
+        device->transport.ops->close(device->transport.context);
+        pthread_join(device->reader, NULL);
+    }
+
+    /* Frames received are decoded */
+    pthread_mutex_lock(&receiver->lock);
+    receiver->stopping = true;
+    pthread_cond_broadcast(&receiver->work_cond);
+    pthread_mutex_unlock(&receiver->lock);
+    for (uint8_t n = 0; n < receiver->worker_count; n++) {
+        pthread_join(receiver->workers[n], NULL);
+    }
+
+    /* And merged */
+    if (receiver->service_started) {
+        pthread_mutex_lock(&receiver->lock);
+        receiver->flushing = true;
+        pthread_cond_broadcast(&receiver->done_cond);
+        pthread_mutex_unlock(&receiver->lock);
+        pthread_join(receiver->service, NULL);
+    }
+
+    for (uint8_t n = 0; n < receiver->device_count; n++) {
+        free(receiver->devices[n]);
+    }
+    pthread_cond_destroy(&receiver->done_cond);
+    pthread_cond_destroy(&receiver->work_cond);
+    pthread_mutex_destroy(&receiver->lock);
+    free(receiver);
+}
+
+/*
+ * Local functions
+ */
+
+/**
+ * @brief Reassemble frames from the transport of a device, until its end
+ */
+static void * reader_thread(void * arg)
+{
+    rcv_device_t * device = arg;
+    rcv_t * receiver = device->receiver;
+    uint8_t data[RCV_READ_SIZE];
+    int length;
+
+    while ((length = device->transport.ops->read(device->transport.context, data, sizeof(data))) > 0) {
+        const uint8_t * p_data = data;
+
+        while (length > 0) {
+            bool complete;
+            uint16_t used = FRAME_RxPush(&device->rx, p_data, (uint16_t)length, &complete);
+
+            p_data += used;
+            length -= used;
+            if (complete) {
+                job_queue(device);
+            }
+        }
+    }
+
+    pthread_mutex_lock(&receiver->lock);
+    device->stats.connected = false;
+    device->stats.frames_dropped = device->rx.dropped;
+    pthread_cond_broadcast(&receiver->done_cond);
+    pthread_mutex_unlock(&receiver->lock);
+    return NULL;
+}
+
+/**
+ * @brief Copy the frame just reassembled to a free job. Waits for one, so that
+ * slow decoding backs up into the transport instead of dropping frames.
+ */
+static void job_queue(rcv_device_t * device)
+{
+    rcv_t * receiver = device->receiver;
+    uint64_t received_us = host_clock(receiver);
+    rcv_job_t * job;
+
+    pthread_mutex_lock(&receiver->lock);
+    while (device->job_count == RCV_JOB_NUM) {
+        pthread_cond_wait(&receiver->done_cond, &receiver->lock);
+    }
+    job = &device->jobs[(device->job_head + device->job_count) % RCV_JOB_NUM];
+    device->job_count++;
+    memcpy(job->data, device->rx.buffer, device->rx.length);
+    job->length = device->rx.length;
+    job->received_us = received_us;
+    job->spectrum_count = 0;
+    job->sync_status = false;
+    job->state = RCV_JOB_QUEUED;
+    device->stats.frames++;
+    device->stats.frames_dropped = device->rx.dropped;
+
+    receiver->work[(receiver->work_head + receiver->work_count) % RCV_ARRAY_SIZE(receiver->work)] = job;
+    receiver->work_count++;
+    pthread_cond_signal(&receiver->work_cond);
+    pthread_mutex_unlock(&receiver->lock);
+}
+
+/**
+ * @brief Decode jobs of any device, until stopping and no job is left
+ */
+static void * worker_thread(void * arg)
+{
+    rcv_t * receiver = arg;
+    DeviceMessage message;
+
+    pthread_mutex_lock(&receiver->lock);
+    for (;;) {
+        rcv_job_t * job;
+        bool decoded;
+
+        while ((receiver->work_count == 0) && (receiver->stopping == false)) {
+            pthread_cond_wait(&receiver->work_cond, &receiver->lock);
+        }
+        if (receiver->work_count == 0) {
+            break;
+        }
+        job = receiver->work[receiver->work_head];
+        receiver->work_head = (receiver->work_head + 1) % RCV_ARRAY_SIZE(receiver->work);
+        receiver->work_count--;
+        pthread_mutex_unlock(&receiver->lock);
+
+        decoded = job_decode(job, &message);
+
+        pthread_mutex_lock(&receiver->lock);
+        if (decoded == false) {
+            job->device->stats.decode_errors++;
+        }
+        job->state = RCV_JOB_DONE;
+        pthread_cond_broadcast(&receiver->done_cond);
+    }
+    pthread_mutex_unlock(&receiver->lock);
+    return NULL;
+}
+
+/**
+ * @brief Decode a job, and unpack its spectra if it is an EdaBatch, or keep it if it
+ * is a TimeSyncStatus. Spectra recorded while disconnected (log_batch) are not part of
+ * the live stream.
+ */
+static bool job_decode(rcv_job_t * job, DeviceMessage * message)
+{
+    pb_istream_t istream = pb_istream_from_buffer(job->data, job->length);
+
+    if (!pb_decode(&istream, DeviceMessage_fields, message)) {
+        return false;
+    }
+    if ((message->which_payload == DeviceMessage_eda_batch_tag) && message->payload.eda_batch.has_timestamp) {
+        batch_unpack(job, &message->payload.eda_batch);
+    }
+    else if (message->which_payload == DeviceMessage_time_sync_status_tag) {
+        job->sync_status = true;
+        job->request_id = message->request_id;
+        job->status = message->payload.time_sync_status;
+    }
+    return true;
+}
+
+/**
+ * @brief Copy the spectra of a batch, whatever the impedance encoding
+ */
+static void batch_unpack(rcv_job_t * job, const EdaBatch * batch)
+{
+    uint64_t batch_us = timestamp_to_us(&batch->timestamp);
+
+    job->spectrum_count = (uint8_t)RCV_MIN(batch->spectra_count, RCV_BATCH_SIZE);
+    for (uint8_t n = 0; n < job->spectrum_count; n++) {
+        const EdaSpectrum * source = &batch->spectra[n];
+        rcv_spectrum_t * spectrum = &job->spectra[n];
+
+        spectrum->device = job->device->index;
+        spectrum->device_us = batch_us + source->delta_us;
+        spectrum->skipped = source->skipped;
+        if (source->data_half.size > 0) {
+            /* IMPEDANCE_ENCODING_HALF: little endian real, imag half float pairs sharing one exponent */
+            float scale = ldexpf(1.0f, source->half_exponent);
+            const uint8_t * data = source->data_half.bytes;
+
+            spectrum->count = (uint8_t)RCV_MIN(source->data_half.size / 4, RCV_FREQUENCY_MAX);
+            for (uint8_t k = 0; k < spectrum->count; k++, data += 4) {
+                spectrum->real[k] = half_to_float((uint16_t)(data[0] | (data[1] << 8))) * scale;
+                spectrum->imag[k] = half_to_float((uint16_t)(data[2] | (data[3] << 8))) * scale;
+            }
+        }
+        else {
+            spectrum->count = (uint8_t)RCV_MIN(source->data_count, RCV_FREQUENCY_MAX);
+            for (uint8_t k = 0; k < spectrum->count; k++) {
+                spectrum->real[k] = source->data[k].real;
+                spectrum->imag[k] = source->data[k].imag;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Return the value of an IEEE 754 half float
+ */
+static float half_to_float(uint16_t half)
+{
+    float sign = (half & 0x8000) ? -1.0f : 1.0f;
+    int exponent = (half >> 10) & 0x1F;
+    int mantissa = half & 0x3FF;
+
+    if (exponent == 0) {
+        return sign * ldexpf((float)mantissa, -24);
+    }
+    if (exponent == 31) {
+        return mantissa ? NAN : sign * INFINITY;
+    }
+    return sign * ldexpf((float)(mantissa + 1024), exponent - 25);
+}
+
+/**
+ * @brief Keep the calendar model of a TimeSyncStatus, pair its device clock with the
+ * host midpoint of its request, and fit the device clock model again. Called with the
+ * lock held, in arrival order.
+ */
+static void time_sync_status_handle(rcv_device_t * device, const rcv_job_t * job)
+{
+    const TimeSyncStatus * status = &job->status;
+    uint64_t host_us;
+    uint32_t rtt_us;
+    tsync_model_t model;
+
+    if (status->has_time) {
+        /* Device applies its model before replying, spectra that follow are dated with it */
+        bool first = (device->calendar_valid == false);
+
+        device->calendar_valid = true;
+        device->calendar_device_us = status->device_us;
+        device->calendar_us = timestamp_to_us(&status->time);
+        device->calendar_drift_ppm = status->drift_ppm;
+        if (first) {
+            /* Spectra released before the first status, the first request did not change the calendar */
+            for (uint16_t n = 0; n < device->queue_count; n++) {
+                rcv_spectrum_t * spectrum = &device->queue[(device->queue_head + n) % RCV_QUEUE_NUM];
+                spectrum->device_us = calendar_to_device(device, spectrum->device_us);
+            }
+        }
+    }
+
+    if ((device->sync_request_id == 0) || (job->request_id != device->sync_request_id)) {
+        /* Reply to a request given up */
+        return;
+    }
+    device->sync_request_id = 0;
+    rtt_us = (uint32_t)(job->received_us - device->sync_sent_us);
+    host_us = device->sync_sent_us + (rtt_us / 2);
+
+    /* For the device own fit, with the next request */
+    device->sync_last_valid = true;
+    device->sync_last_device_us = status->device_us;
+    device->sync_last_host_us = host_us;
+    device->sync_last_rtt_us = rtt_us;
+
+    if (device->calendar_valid == false) {
+        /* Spectra could not be brought to the device clock */
+        return;
+    }
+    if (TSYNC_AddSample(&device->sync, status->device_us, host_us, rtt_us, &model) == false) {
+        /* Device clock went back, the device restarted: fit again from this sample */
+        TSYNC_Reset(&device->sync);
+        TSYNC_AddSample(&device->sync, status->device_us, host_us, rtt_us, &model);
+    }
+    device->model = model;
+    device->stats.modelled = true;
+    device->stats.sync_samples = model.samples;
+    device->stats.offset_us = model.offset_us;
+    device->stats.drift_ppm = model.drift_ppm;
+}
+
+/**
+ * @brief Release decoded jobs, send time requests and merge spectra, until flushing
+ */
+static void * service_thread(void * arg)
+{
+    rcv_t * receiver = arg;
+
+    pthread_mutex_lock(&receiver->lock);
+    for (;;) {
+        uint64_t now_us = host_clock(receiver);
+        bool flush = receiver->flushing;
+        struct timespec until;
+
+        for (uint8_t n = 0; n < receiver->device_count; n++) {
+            rcv_device_t * device = receiver->devices[n];
+            uint8_t frame[RCV_TX_FRAME_SIZE];
+            unsigned length;
+
+            jobs_release(device);
+            if (flush || (device->stats.connected == false) || (now_us < device->sync_next_us)) {
+                continue;
+            }
+            if (sync_request_encode(device, now_us, frame, &length)) {
+                device->sync_sent_us = host_clock(receiver);
+                pthread_mutex_unlock(&receiver->lock);
+                transport_send(device, frame, length);
+                pthread_mutex_lock(&receiver->lock);
+            }
+        }
+
+        merge_emit(receiver, now_us, flush);
+        if (flush) {
+            break;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &until);
+        until.tv_nsec += RCV_POLL_MS * 1000000L;
+        if (until.tv_nsec >= 1000000000L) {
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000L;
+        }
+        if (receiver->flushing == false) {
+            pthread_cond_timedwait(&receiver->done_cond, &receiver->lock, &until);
+        }
+    }
+    pthread_mutex_unlock(&receiver->lock);
+    return NULL;
+}
+
+/**
+ * @brief Move the spectra of decoded jobs to the device queue, in arrival order, in
+ * device clock once its calendar model is known. Called with the lock held.
+ */
+static void jobs_release(rcv_device_t * device)
+{
+    bool released = false;
+
+    while ((device->job_count > 0) && (device->jobs[device->job_head].state == RCV_JOB_DONE)) {
+        rcv_job_t * job = &device->jobs[device->job_head];
+
+        if (job->sync_status) {
+            time_sync_status_handle(device, job);
+        }
+        for (uint8_t n = 0; n < job->spectrum_count; n++) {
+            if (device->queue_count == RCV_QUEUE_NUM) {
+                /* No clock model for that long, oldest spectrum goes */
+                device->queue_head = (device->queue_head + 1) % RCV_QUEUE_NUM;
+                device->queue_count--;
+                device->stats.spectra_dropped++;
+            }
+            device->queue[(device->queue_head + device->queue_count) % RCV_QUEUE_NUM] = job->spectra[n];
+            if (device->calendar_valid) {
+                rcv_spectrum_t * spectrum = &device->queue[(device->queue_head + device->queue_count) % RCV_QUEUE_NUM];
+                spectrum->device_us = calendar_to_device(device, spectrum->device_us);
+            }
+            device->queue_count++;
+        }
+        job->state = RCV_JOB_FREE;
+        device->job_head = (device->job_head + 1) % RCV_JOB_NUM;
+        device->job_count--;
+        released = true;
+    }
+    if (released) {
+        pthread_cond_broadcast(&device->receiver->done_cond);
+    }
+}
+
+/**
+ * @brief Hand queued spectra to the handler in host time order. The earliest one
+ * waits while another connected device has none queued, for merge_delay_ms at most.
+ * Called with the lock held, released around the handler.
+ */
+static void merge_emit(rcv_t * receiver, uint64_t now_us, bool flush)
+{
+    uint64_t delay_us = receiver->config.merge_delay_ms * 1000ULL;
+
+    for (;;) {
+        rcv_device_t * next = NULL;
+        uint64_t next_us = 0;
+        rcv_spectrum_t spectrum;
+
+        for (uint8_t n = 0; n < receiver->device_count; n++) {
+            rcv_device_t * device = receiver->devices[n];
+            uint64_t host_us;
+
+            if ((device->queue_count == 0) || (device->stats.modelled == false)) {
+                continue;
+            }
+            host_us = device_to_host(device, device->queue[device->queue_head].device_us);
+            if ((next == NULL) || (host_us < next_us)) {
+                next = device;
+                next_us = host_us;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+
+        if ((flush == false) && (now_us < (next_us + delay_us))) {
+            bool wait = false;
+
+            for (uint8_t n = 0; n < receiver->device_count; n++) {
+                rcv_device_t * device = receiver->devices[n];
+
+                if ((device != next) && device->stats.connected &&
+                    ((device->queue_count == 0) || (device->stats.modelled == false))) {
+                    wait = true;
+                }
+            }
+            if (wait) {
+                break;
+            }
+        }
+
+        spectrum = next->queue[next->queue_head];
+        next->queue_head = (next->queue_head + 1) % RCV_QUEUE_NUM;
+        next->queue_count--;
+        spectrum.host_us = next_us;
+        next->stats.spectra++;
+        if (receiver->emitted && (next_us < receiver->emitted_us)) {
+            /* Device lagging past merge_delay_ms, or a model step back */
+            next->stats.spectra_late++;
+        }
+        else {
+            receiver->emitted = true;
+            receiver->emitted_us = next_us;
+        }
+
+        pthread_mutex_unlock(&receiver->lock);
+        receiver->config.handler(&spectrum, receiver->config.context);
+        pthread_mutex_lock(&receiver->lock);
+    }
+
+    if (flush) {
+        /* Devices never modelled */
+        for (uint8_t n = 0; n < receiver->device_count; n++) {
+            receiver->devices[n]->stats.spectra_dropped += receiver->devices[n]->queue_count;
+            receiver->devices[n]->queue_count = 0;
+        }
+    }
+}
+
+/**
+ * @brief Return host time at a device clock value, with the model fitted by the receiver
+ */
+static uint64_t device_to_host(const rcv_device_t * device, uint64_t device_us)
+{
+    const tsync_model_t * model = &device->model;
+    double correction = (double)(int64_t)(device_us - model->ref_us) * (double)model->drift_ppm * 1.0e-6;
+
+    return (uint64_t)((int64_t)device_us + model->offset_us + (int64_t)llround(correction));
+}
+
+/**
+ * @brief Return the device clock at a calendar time, with the calendar model of the
+ * last TimeSyncStatus released: calendar = device clock + offset + drift
+ */
+static uint64_t calendar_to_device(const rcv_device_t * device, uint64_t calendar_us)
+{
+    double elapsed = (double)(int64_t)(calendar_us - device->calendar_us) / (1.0 + ((double)device->calendar_drift_ppm * 1.0e-6));
+
+    return (uint64_t)((int64_t)device->calendar_device_us + (int64_t)llround(elapsed));
+}
+
+/**
+ * @brief Encode the next TimeSyncRequest of a device, carrying the reply to the
+ * previous one. A request not replied to is given up. Called with the lock held.
+ */
+static bool sync_request_encode(rcv_device_t * device, uint64_t now_us, uint8_t * frame, unsigned * p_length)
+{
+    HostMessage message = HostMessage_init_zero;
+    TimeSyncRequest * request = &message.payload.time_sync_request;
+
+    message.which_payload = HostMessage_time_sync_request_tag;
+    if (device->sync_last_valid) {
+        request->last_device_us = device->sync_last_device_us;
+        request->has_last_host_time = true;
+        request->last_host_time.time = device->sync_last_host_us / 1000000ULL;
+        request->last_host_time.us = (uint32_t)(device->sync_last_host_us % 1000000ULL);
+        request->last_rtt_us = device->sync_last_rtt_us;
+        device->sync_last_valid = false;
+    }
+    message.request_id = ++device->request_id;
+    device->sync_request_id = message.request_id;
+    device->sync_next_us = now_us + (device->receiver->config.sync_interval_ms * 1000ULL);
+    return message_encode(&message, frame, p_length);
+}
+
+/**
+ * @brief Serialize a host message as a COBS frame, delimiter included
+ */
+static bool message_encode(const HostMessage * message, uint8_t * frame, unsigned * p_length)
+{
+    uint8_t buffer[HostMessage_size];
+    pb_ostream_t ostream = pb_ostream_from_buffer(buffer, sizeof(buffer));
+
+    if (!pb_encode(&ostream, HostMessage_fields, message)) {
+        return false;
+    }
+    return cobs_encode(buffer, (unsigned)ostream.bytes_written, frame, RCV_TX_FRAME_SIZE, p_length) == COBS_RET_SUCCESS;
+}
+
+/**
+ * @brief Write a frame to a device, by packet_size writes
+ */
+static bool transport_send(rcv_device_t * device, const uint8_t * frame, unsigned length)
+{
+    const rcv_transport_t * transport = &device->transport;
+    unsigned packet_size = (transport->packet_size > 0) ? transport->packet_size : length;
+
+    for (unsigned offset = 0; offset < length; ) {
+        int written = transport->ops->write(transport->context, &frame[offset], RCV_MIN(packet_size, length - offset));
+
+        if (written <= 0) {
+            return false;
+        }
+        offset += (unsigned)written;
+    }
+    return true;
+}
+
+static uint64_t host_clock(const rcv_t * receiver)
+{
+    struct timespec now;
+
+    if (receiver->config.clock != NULL) {
+        return receiver->config.clock();
+    }
+    clock_gettime(CLOCK_REALTIME, &now);
+    return ((uint64_t)now.tv_sec * 1000000ULL) + ((uint64_t)now.tv_nsec / 1000ULL);
+}
+
+static uint64_t timestamp_to_us(const Timestamp * timestamp)
+{
+    return (timestamp->time * 1000000ULL) + timestamp->us;
+}
+
+/* END OF FILE */
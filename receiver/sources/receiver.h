@@ -0,0 +1,155 @@
+/****************************************************************
+ * Project: RENFORCE EDA RECEIVER
+ * Module: RECEIVER
+ *
+ *---------------------------------------------------------------
+ * @brief Host receiver of several EDA devices, merged in host time
+ *
+ * Each device is read from a transport of its own (a BLE NUS
+ * bridge, a socket, a pty) by a reader thread that reassembles
+ * COBS frames. Frames are decoded by a pool of worker threads,
+ * and a service thread releases them in arrival order for each
+ * device.
+ *
+ * The service thread sends every device a TimeSyncRequest every
+ * sync_interval_ms as the web app does, so that the device fits
+ * its calendar to host time. The device dates its spectra with
+ * that calendar, and replies with the model it uses, which brings
+ * them back to its free running clock. That clock value is paired
+ * with the host midpoint of the request and fitted (time_sync)
+ * into a model of the receiver, which maps the spectra to host
+ * time whatever the corrections the device makes to its calendar.
+ *
+ * Spectra of all devices are handed to a single handler in host
+ * time order. A spectrum waits until every other connected device
+ * has a later one, or merge_delay_ms at most.
+ *
+ * Dependencies : frame, nanocobs, nanopb, time_sync, pthreads
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef RECEIVER_H_
+#define RECEIVER_H_
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Public constants
+ */
+
+#define RCV_DEVICE_MAX              8           /**< Devices of a receiver */
+#define RCV_WORKER_MAX              8           /**< Decoding threads */
+#define RCV_FREQUENCY_MAX           16          /**< Impedances of a spectrum, EdaSpectrum.data max_count */
+#define RCV_WORKER_DEFAULT          2
+#define RCV_SYNC_INTERVAL_MS        30000       /**< Between two TimeSyncRequest, as the web app */
+#define RCV_MERGE_DELAY_MS          3000        /**< Batches are sent every second, spectra are half a window older */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+/**
+ * @brief Byte stream to and from one device
+ */
+typedef struct {
+    int (*read)(void * context, uint8_t * data, size_t size);           /**< Blocks until bytes arrive, returns the byte count, 0 at end of stream, -1 on error */
+    int (*write)(void * context, const uint8_t * data, size_t size);    /**< Returns the byte count, -1 on error */
+    void (*close)(void * context);                                      /**< Ends the stream, a blocked read returns */
+} rcv_transport_ops_t;
+
+typedef struct {
+    const rcv_transport_ops_t * ops;
+    void * context;
+    uint16_t packet_size;       /**< Bytes per write, 20 for the default BLE MTU, 0 for a whole frame */
+} rcv_transport_t;
+
+/**
+ * @brief One spectrum of the merged stream
+ */
+typedef struct {
+    uint8_t device;                         /**< Index returned by RCV_AddDevice */
+    uint64_t host_us;                       /**< Centre of the analysis window, host clock */
+    uint64_t device_us;                     /**< Same, device clock (free running, not the calendar) */
+    uint32_t skipped;                       /**< Spectra decimated by the device adaptive rate before this one */
+    uint8_t count;                          /**< Impedances */
+    float real[RCV_FREQUENCY_MAX];          /**< In Ohm, whatever the impedance encoding */
+    float imag[RCV_FREQUENCY_MAX];
+} rcv_spectrum_t;
+
+/**
+ * @brief Handler of the merged stream, called from the service thread
+ */
+typedef void (*rcv_spectrum_handler_t)(const rcv_spectrum_t * spectrum, void * context);
+
+typedef struct {
+    uint8_t workers;                        /**< Decoding threads, RCV_WORKER_DEFAULT if 0 */
+    uint32_t sync_interval_ms;              /**< RCV_SYNC_INTERVAL_MS if 0 */
+    uint32_t merge_delay_ms;                /**< RCV_MERGE_DELAY_MS if 0 */
+    uint64_t (*clock)(void);                /**< Host clock in us, CLOCK_REALTIME if NULL */
+    rcv_spectrum_handler_t handler;
+    void * context;                         /**< Given to handler */
+} rcv_config_t;
+
+typedef struct {
+    bool connected;                         /**< Transport not at its end yet */
+    bool modelled;                          /**< Device clock model fitted, spectra wait for it */
+    uint32_t frames;
+    uint32_t frames_dropped;                /**< Malformed or too long frames */
+    uint32_t decode_errors;                 /**< Frames that are not a DeviceMessage */
+    uint32_t spectra;                       /**< Spectra handed to the handler */
+    uint32_t spectra_late;                  /**< Of those, earlier than a spectrum handled before */
+    uint32_t spectra_dropped;               /**< Waited too long for a clock model */
+    uint32_t sync_samples;                  /**< Samples of the clock model fit */
+    int64_t offset_us;                      /**< Host time minus device clock, at the last sync sample */
+    float drift_ppm;                        /**< Positive if the device clock runs slow */
+} rcv_device_stats_t;
+
+typedef struct rcv_s rcv_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Start the worker and service threads
+ * @return NULL if memory or threads could not be allocated
+ */
+rcv_t * RCV_Create(const rcv_config_t * config);
+
+/**
+ * @brief Start receiving from a device, and sending it time sync requests (from one thread only)
+ * @param[in] transport is copied, its context must stay valid until RCV_Destroy
+ * @return device index, -1 if RCV_DEVICE_MAX devices were added or threads could not start
+ */
+int RCV_AddDevice(rcv_t * receiver, const rcv_transport_t * transport);
+
+/**
+ * @brief Copy the counters and clock model of a device
+ */
+void RCV_GetDeviceStats(rcv_t * receiver, uint8_t device, rcv_device_stats_t * p_stats);
+
+/**
+ * @brief Close all transports, hand all spectra decoded to the handler, and stop
+ */
+void RCV_Destroy(rcv_t * receiver);
+
+#endif /* RECEIVER_H_ */
+
+/* END OF FILE */
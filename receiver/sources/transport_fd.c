@@ -0,0 +1,116 @@
+/****************************************************************
+ * Project: RENFORCE EDA RECEIVER
+ * Module: FILE DESCRIPTOR TRANSPORT
+ *
+ *---------------------------------------------------------------
+ * @brief Receiver transport over a file descriptor
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+/*
+ * Included files
+ */
+
+/* Standard C library includes */
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "transport_fd.h"
+
+/*
+ * Local constants
+ */
+
+/*
+ * Local macros
+ */
+
+/*
+ * Public variables
+ */
+
+/*
+ * Local types
+ */
+
+/*
+ * Local variables
+ */
+
+/*
+ * Local functions
+ */
+
+static int tfd_read(void * context, uint8_t * data, size_t size);
+static int tfd_write(void * context, const uint8_t * data, size_t size);
+static void tfd_close(void * context);
+
+static const rcv_transport_ops_t tfd_ops = {
+    .read = tfd_read,
+    .write = tfd_write,
+    .close = tfd_close,
+};
+
+/****************************************************************
+ * IMPLEMENTATION
+ ****************************************************************/
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Fill a receiver transport reading and writing fd
+ */
+void TFD_Init(tfd_t * tfd, int fd, uint16_t packet_size, rcv_transport_t * p_transport)
+{
+    tfd->fd = fd;
+    p_transport->ops = &tfd_ops;
+    p_transport->context = tfd;
+    p_transport->packet_size = packet_size;
+}
+
+/*
+ * Local functions
+ */
+
+static int tfd_read(void * context, uint8_t * data, size_t size)
+{
+    tfd_t * tfd = context;
+    ssize_t length;
+
+    do {
+        length = read(tfd->fd, data, size);
+    } while ((length < 0) && (errno == EINTR));
+    return (int)length;
+}
+
+static int tfd_write(void * context, const uint8_t * data, size_t size)
+{
+    tfd_t * tfd = context;
+    ssize_t length;
+
+    do {
+        length = write(tfd->fd, data, size);
+    } while ((length < 0) && (errno == EINTR));
+    return (int)length;
+}
+
+/**
+ * @brief Make a blocked read return. A socket is only shut down, so that its
+ * descriptor is not reused while the reader may still use it.
+ */
+static void tfd_close(void * context)
+{
+    tfd_t * tfd = context;
+
+    if (shutdown(tfd->fd, SHUT_RDWR) != 0) {
+        close(tfd->fd);
+    }
+}
+
+/* END OF FILE */
@@ -0,0 +1,62 @@
+/****************************************************************
+ * Project: RENFORCE EDA RECEIVER
+ * Module: FILE DESCRIPTOR TRANSPORT
+ *
+ *---------------------------------------------------------------
+ * @brief Receiver transport over a file descriptor
+ *
+ * Any byte stream to a device: a socket of a BLE NUS bridge, a
+ * pty, or one end of a socket pair in tests. Closing it shuts a
+ * socket down, which the caller closes after RCV_Destroy, and
+ * closes any other descriptor.
+ *
+ * Dependencies : receiver
+ *
+ *---------------------------------------------------------------
+ * Copyright (c) 2023 INL - INSA LYON
+ ****************************************************************/
+
+#ifndef TRANSPORT_FD_H_
+#define TRANSPORT_FD_H_
+
+/*
+ * Included files
+ */
+
+/* Project includes */
+#include "receiver.h"
+
+/*
+ * Public constants
+ */
+
+/*
+ * Public macros
+ */
+
+/*
+ * Public types
+ */
+
+typedef struct {
+    int fd;
+} tfd_t;
+
+/*
+ * Public variables
+ */
+
+/*
+ * Public functions
+ */
+
+/**
+ * @brief Fill a receiver transport reading and writing fd
+ * @param[in] tfd holds fd, must stay valid until RCV_Destroy
+ * @param[in] packet_size is the largest write, 0 for a whole frame
+ */
+void TFD_Init(tfd_t * tfd, int fd, uint16_t packet_size, rcv_transport_t * p_transport);
+
+#endif /* TRANSPORT_FD_H_ */
+
+/* END OF FILE */
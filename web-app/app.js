@@ -26,6 +26,8 @@ const UUIDS = {
     NRF_UART_SERVICE_UUID: '6e400001-b5a3-f393-e0a9-e50e24dcca9e',
     NRF_UART_TX_CHAR_UUID: '6e400002-b5a3-f393-e0a9-e50e24dcca9e',
     NRF_UART_RX_CHAR_UUID: '6e400003-b5a3-f393-e0a9-e50e24dcca9e',
+    DIAGNOSTICS_SERVICE_UUID: '6e400010-b5a3-f393-e0a9-e50e24dcca9e',
+    LATENCY_CHAR_UUID: '6e400011-b5a3-f393-e0a9-e50e24dcca9e',
 };
 const bleDeviceNamePrefix = "EDA"
 let bleDevice;
@@ -53,7 +55,7 @@ async function onConnectBLEButtonClick() {
                 filters: [
                     { namePrefix: bleDeviceNamePrefix },
                 ],
-                optionalServices: [UUIDS.NRF_UART_SERVICE_UUID, 'device_information', 'battery_service'],
+                optionalServices: [UUIDS.NRF_UART_SERVICE_UUID, UUIDS.DIAGNOSTICS_SERVICE_UUID, 'device_information', 'battery_service'],
             });
             bleDevice.addEventListener('gattserverdisconnected', bleOnDisconnected);
             const gatt = await bleDevice.gatt.connect();
@@ -75,6 +77,15 @@ async function onConnectBLEButtonClick() {
             window.txChar = txChar;
             window.batChar = batChar;
             window.batChar.startNotifications();
+            // Diagnostics service is missing on older firmwares
+            window.latencyChar = null;
+            try {
+                const diagService = await gatt.getPrimaryService(UUIDS.DIAGNOSTICS_SERVICE_UUID);
+                window.latencyChar = await diagService.getCharacteristic(UUIDS.LATENCY_CHAR_UUID);
+            }
+            catch (err) {
+                console.log("No diagnostics service");
+            }
             console.log("Connected");
             bleConnected = true;
             clearInterval(searchTimer);
@@ -111,6 +122,19 @@ function bleOnDisconnected(event) {
     connectBLEButton.removeAttribute('disabled');
     connectBLEStatusIcon.setAttribute('disabled', '');
     deviceLabel.innerHTML = 'Device';
+    /* Device is back to spectra after disconnection */
+    rawSamplesMode = false;
+    rawModeButtonLabel.innerHTML = 'Raw Samples';
+    dspProfile = 0;
+    adaptiveThreshold = 0;
+    adaptiveIntervalMs = 0;
+    /* Device restarts its clock fit with the next host */
+    stopTimeSync();
+    /* Whatever was received is kept, the rest stays in the device log */
+    if (logDownloading) {
+        logDownloading = false;
+        saveLogData();
+    }
 }
 
 function bleSetupRxListener(rxchar) {
@@ -125,10 +149,14 @@ function bleSetupRxListener(rxchar) {
             let rx_data = new Uint8Array(char.value.buffer);
             rx_buf = new Uint8Array([...rx_buf,...rx_data]);
             let zeroIndex = rx_buf.indexOf(0);
-            if(zeroIndex != -1) {
+            while(zeroIndex != -1) {
                 const cobs_data = rx_buf.slice(0, zeroIndex + 1);
-                decodeMessage(cobs_data);
+                /* A lone delimiter only closes a frame the device could not finish */
+                if (cobs_data.length > 1) {
+                    decodeMessage(cobs_data);
+                }
                 rx_buf = rx_buf.slice(zeroIndex + 1);
+                zeroIndex = rx_buf.indexOf(0);
             }
 
         }
@@ -159,33 +187,345 @@ function bleSetupBatListener(batchar) {
 function decodeMessage(message) {
     try {
         const decoded = decode(message).subarray(0,-1);
-        const edaBuffer = proto.EdaBuffer.deserializeBinary(decoded);
-        const measures = edaBuffer.getDataList();
-        const timestamp = edaBuffer.getTimestamp();
-        const time = (timestamp.getTime() + (timestamp.getUs() * 10**-6)) - timeDataStart;
-        nyquistChartAddResults(measures, time);
+        const deviceMessage = proto.DeviceMessage.deserializeBinary(decoded);
+        switch (deviceMessage.getPayloadCase()) {
+            case proto.DeviceMessage.PayloadCase.EDA_BATCH:
+                decodeEdaBatch(deviceMessage.getEdaBatch());
+                break;
+            case proto.DeviceMessage.PayloadCase.RAW_SAMPLES:
+                decodeRawSamples(deviceMessage.getRawSamples());
+                break;
+            case proto.DeviceMessage.PayloadCase.LOG_BATCH:
+                decodeLogBatch(deviceMessage.getLogBatch());
+                break;
+            case proto.DeviceMessage.PayloadCase.LOG_STATUS:
+                decodeLogStatus(deviceMessage.getLogStatus());
+                break;
+            case proto.DeviceMessage.PayloadCase.ACQUISITION_STATUS:
+                decodeAcquisitionStatus(deviceMessage.getAcquisitionStatus());
+                break;
+            case proto.DeviceMessage.PayloadCase.ENERGY_REPORT:
+                decodeEnergyReport(deviceMessage.getEnergyReport());
+                break;
+            case proto.DeviceMessage.PayloadCase.CALIBRATION_STATUS:
+                decodeCalibrationStatus(deviceMessage.getCalibrationStatus());
+                break;
+            case proto.DeviceMessage.PayloadCase.DSP_STATUS:
+                decodeDspStatus(deviceMessage.getDspStatus());
+                break;
+            case proto.DeviceMessage.PayloadCase.MEASUREMENT_STATUS:
+                decodeMeasurementStatus(deviceMessage.getMeasurementStatus());
+                break;
+            case proto.DeviceMessage.PayloadCase.TIME_SYNC_STATUS:
+                decodeTimeSyncStatus(deviceMessage.getTimeSyncStatus(), deviceMessage.getRequestId());
+                break;
+            case proto.DeviceMessage.PayloadCase.REQUEST_ERROR:
+                decodeRequestError(deviceMessage.getRequestError(), deviceMessage.getRequestId());
+                break;
+            default:
+                console.error("Unknown message type " + deviceMessage.getPayloadCase());
+                break;
+        }
     } catch (error) {
         console.error("Error while decoding message: " + error);
     }
 }
 
+/**
+ * @param {proto.EdaBatch} edaBatch
+ */
+function decodeEdaBatch(edaBatch) {
+    const timestamp = edaBatch.getTimestamp();
+    const baseTime = timestamp.getTime() + (timestamp.getUs() * 10**-6);
+    for (const spectrum of edaBatch.getSpectraList()) {
+        const time = (baseTime + (spectrum.getDeltaUs() * 10**-6)) - timeDataStart;
+        if (spectrum.getSkipped() > 0) {
+            /* Adaptive rate: impedance stayed close to the previous spectrum meanwhile */
+            console.debug(spectrum.getSkipped() + " spectra decimated before t=" + time.toFixed(3) + " s");
+        }
+        nyquistChartAddResults(decodeEdaSpectrumData(spectrum), time);
+    }
+}
+
+/**
+ * @param {proto.EdaSpectrum} spectrum
+ * @returns {proto.Impedance[]} impedance at each frequency, whatever the encoding
+ */
+function decodeEdaSpectrumData(spectrum) {
+    const dataHalf = spectrum.getDataHalf_asU8();
+    if (dataHalf.length == 0) {
+        return spectrum.getDataList();
+    }
+    /* IMPEDANCE_ENCODING_HALF: little endian real, imag half float pairs sharing one exponent */
+    const view = new DataView(dataHalf.buffer, dataHalf.byteOffset, dataHalf.byteLength);
+    const scale = 2 ** spectrum.getHalfExponent();
+    let data = [];
+    for (let offset = 0; offset + 4 <= dataHalf.length; offset += 4) {
+        data.push(new proto.Impedance()
+            .setReal(halfToFloat(view.getUint16(offset, true)) * scale)
+            .setImag(halfToFloat(view.getUint16(offset + 2, true)) * scale));
+    }
+    return data;
+}
+
+/**
+ * @param {proto.EdaBatch} edaBatch recorded by the device while no host listened
+ */
+function decodeLogBatch(edaBatch) {
+    const timestamp = edaBatch.getTimestamp();
+    const baseTime = timestamp.getTime() + (timestamp.getUs() * 10**-6);
+    for (const spectrum of edaBatch.getSpectraList()) {
+        let row = [baseTime + (spectrum.getDeltaUs() * 10**-6)];
+        decodeEdaSpectrumData(spectrum).forEach(impedance => {
+            row.push(impedance.getReal());
+            row.push(impedance.getImag());
+        });
+        window.logData.push(row);
+    }
+}
+
+/**
+ * @param {proto.LogStatus} logStatus
+ */
+async function decodeLogStatus(logStatus) {
+    console.log("Device log: " + logStatus.getBatchCount() + " records, "
+        + logStatus.getUsedBytes() + "/" + logStatus.getSizeBytes() + " bytes, "
+        + logStatus.getDropped() + " dropped, " + logStatus.getOverwritten() + " overwritten");
+    /* Status is sent at the end of a download */
+    if (logDownloading) {
+        logDownloading = false;
+        downloadLogButton.removeAttribute('disabled');
+        saveLogData();
+        if ((window.logData.length > 0) && confirm(window.logData.length + " spectra downloaded, erase device log?")) {
+            await encodeMessage(new proto.HostMessage().setLogRequest(
+                new proto.LogRequest().setAction(proto.LogAction.LOG_ACTION_ERASE)));
+        }
+    }
+}
+
+/**
+ * @param {proto.AcquisitionStatus} acquisitionStatus sent when the device DSP fell behind the SAADC
+ */
+function decodeAcquisitionStatus(acquisitionStatus) {
+    console.warn("Device acquisition: " + acquisitionStatus.getBuffers() + " buffers, "
+        + acquisitionStatus.getOverruns() + " overruns, " + acquisitionStatus.getStalls() + " stalls, "
+        + acquisitionStatus.getHeldMax() + "/" + acquisitionStatus.getPoolSize() + " buffers held at most, "
+        + acquisitionStatus.getTxDropped() + " raw chunks dropped");
+}
+
+/**
+ * @param {proto.EnergyReport} energyReport charge budget of the device since last reset
+ */
+function decodeEnergyReport(energyReport) {
+    const subsystemNames = Object.keys(proto.EnergySubsystem);
+    console.log("Device energy over " + energyReport.getPeriodS() + " s: "
+        + energyReport.getMeasuredUah() + " uAh measured (" + energyReport.getAverageUa() + " uA), "
+        + energyReport.getWakeups() + " wakeups, " + energyReport.getRadioEvents() + " radio events, "
+        + energyReport.getRemainingMah() + " mAh left (" + energyReport.getRuntimeMin() + " min)");
+    console.table(energyReport.getSubsystemsList().map(subsystem => ({
+        subsystem: subsystemNames[subsystem.getSubsystem()],
+        active_ms: subsystem.getActiveMs(),
+        charge_uah: subsystem.getChargeUah(),
+    })));
+}
+
+/**
+ * @param {proto.CalibrationStatus} calibrationStatus calibration applied by the device to the impedance
+ */
+function decodeCalibrationStatus(calibrationStatus) {
+    const parameters = calibrationStatus.getParameters();
+    console.log("Device calibration: delay " + parameters.getDelayS() + " s, skew " + parameters.getSkewS()
+        + " s, TIA " + parameters.getTiaResistance() + " Ohm"
+        + (calibrationStatus.getStored() ? ", stored" : ", not stored")
+        + (calibrationStatus.getError() ? ", last store or erase failed" : ""));
+    console.table(calibrationStatus.getPointsList().map(point => ({
+        index: point.getIndex(),
+        gain: point.getGain().getReal() + " " + point.getGain().getImag() + "j",
+        offset: point.getOffset().getReal() + " " + point.getOffset().getImag() + "j",
+    })));
+}
+
+/**
+ * @param {proto.DspStatus} dspStatus analysis window and frequencies of the spectra that follow
+ */
+function decodeDspStatus(dspStatus) {
+    const frequencies = dspStatus.getFrequenciesList();
+    console.log("Device DSP profile " + dspStatus.getProfile() + ": " + dspStatus.getFftSize() + " points, "
+        + frequencies.length + " frequencies");
+    dspProfile = dspStatus.getProfile();
+    if (frequencies.join() != spectrumFrequencies.join()) {
+        /* Charts hold one dataset per frequency */
+        spectrumFrequencies = frequencies;
+        nyquistChart.data.datasets = [];
+        magnitudeChart.data.datasets = [];
+    }
+}
+
+/**
+ * @param {proto.MeasurementStatus} measurementStatus frontend state, sent on request and once stopped
+ */
+function decodeMeasurementStatus(measurementStatus) {
+    const stateNames = Object.keys(proto.MeasurementState);
+    console.log("Device measurement: " + stateNames[measurementStatus.getState()]);
+}
+
+/**
+ * @param {proto.TimeSyncStatus} timeSyncStatus device clock when the request was received, fit of the previous one
+ * @param {number} replyRequestId
+ */
+function decodeTimeSyncStatus(timeSyncStatus, replyRequestId) {
+    if ((timeSyncPending == null) || (replyRequestId != timeSyncPending.requestId)) return;
+    const receivedUs = Date.now() * 1000;
+    const rttUs = receivedUs - timeSyncPending.sentUs;
+    /* Device got the request halfway, sent back with the next request */
+    timeSyncLast = {
+        deviceUs: timeSyncStatus.getDeviceUs(),
+        hostUs: timeSyncPending.sentUs + (rttUs / 2),
+        rttUs: rttUs,
+    };
+    timeSyncPending = null;
+    if (timeSyncStatus.getSamples() > 0) {
+        console.log("Device clock: error " + timeSyncStatus.getErrorUs() + " us, drift "
+            + timeSyncStatus.getDriftPpm().toFixed(2) + " ppm from " + timeSyncStatus.getSamples() + " samples");
+    }
+}
+
+function decodeRequestError(requestError, failedRequestId) {
+    const codeNames = Object.keys(proto.RequestErrorCode);
+    console.error("Device refused request " + failedRequestId + ": " + codeNames[requestError.getCode()]
+                  + ", " + requestError.getDropped() + " messages dropped");
+}
+
+/**
+ * Send a time sync request, carrying the reply to the previous one
+ */
+async function sendTimeSync() {
+    const request = new proto.TimeSyncRequest();
+    if (timeSyncLast != null) {
+        const seconds = Math.floor(timeSyncLast.hostUs * 1e-6);
+        request.setLastDeviceUs(timeSyncLast.deviceUs)
+            .setLastHostTime(new proto.Timestamp()
+                .setTime(seconds)
+                .setUs(Math.round(timeSyncLast.hostUs - (seconds * 1e6))))
+            .setLastRttUs(Math.round(timeSyncLast.rttUs));
+        timeSyncLast = null;
+    }
+    const hostMessage = new proto.HostMessage().setTimeSyncRequest(request);
+    const sentUs = Date.now() * 1000;
+    await encodeMessage(hostMessage);
+    timeSyncPending = { requestId: hostMessage.getRequestId(), sentUs: sentUs };
+}
+
+function startTimeSync() {
+    stopTimeSync();
+    sendTimeSync();
+    timeSyncTimer = setInterval(sendTimeSync, TIME_SYNC_INTERVAL_MS);
+}
+
+function stopTimeSync() {
+    if (timeSyncTimer != null) {
+        clearInterval(timeSyncTimer);
+        timeSyncTimer = null;
+    }
+    timeSyncPending = null;
+    timeSyncLast = null;
+}
+
+/**
+ * @param {number} profile DSP profile, analysis window and frequencies of the spectra
+ */
+async function setDspProfile(profile) {
+    dspProfile = profile;
+    await setDeviceSettings();
+}
+
+/**
+ * @param {number} threshold relative change of |Z| at any frequency that sends a spectrum, 0 sends all of them
+ * @param {number} intervalMs longest time between two spectra sent, 0 for the device default
+ */
+async function setAdaptiveRate(threshold, intervalMs) {
+    adaptiveThreshold = threshold;
+    adaptiveIntervalMs = intervalMs;
+    await setDeviceSettings();
+}
+
+/**
+ * @param {proto.RawSamples} rawSamples
+ */
+function decodeRawSamples(rawSamples) {
+    const sequence = rawSamples.getSequence();
+    if ((rawSequenceNext != null) && (sequence != rawSequenceNext)) {
+        console.warn("Raw samples: " + (sequence - rawSequenceNext) + " chunks lost");
+    }
+    rawSequenceNext = sequence + 1;
+    window.rawData.push({
+        sequence: sequence,
+        samples: unpackRawSamples(rawSamples.getData_asU8()),
+    });
+}
+
+/**
+ * @param {Uint8Array} data 14 bits two's complement samples, packed LSB first
+ * @returns {Int16Array} interleaved V, I samples
+ */
+function unpackRawSamples(data) {
+    const samples = new Int16Array(Math.floor(data.length * 8 / RAW_SAMPLE_BITS));
+    const mask = (1 << RAW_SAMPLE_BITS) - 1;
+    const sign = 1 << (RAW_SAMPLE_BITS - 1);
+    let bits = 0;
+    let bitCount = 0;
+    let n = 0;
+    for (const byte of data) {
+        bits |= byte << bitCount;
+        bitCount += 8;
+        if (bitCount >= RAW_SAMPLE_BITS) {
+            const value = bits & mask;
+            samples[n++] = (value & sign) ? value - (mask + 1) : value;
+            bits >>= RAW_SAMPLE_BITS;
+            bitCount -= RAW_SAMPLE_BITS;
+        }
+    }
+    return samples;
+}
+
+/**
+ * @param {number} half IEEE 754 half float bits
+ * @returns {number}
+ */
+function halfToFloat(half) {
+    const sign = (half & 0x8000) ? -1 : 1;
+    const exponent = (half >> 10) & 0x1F;
+    const mantissa = half & 0x3FF;
+    if (exponent == 0) {
+        return sign * mantissa * 2 ** -24;
+    }
+    if (exponent == 31) {
+        return mantissa ? NaN : sign * Infinity;
+    }
+    return sign * (1 + mantissa / 1024) * 2 ** (exponent - 15);
+}
+
 /*******************************************************************************
  * TX Message encoder
  ******************************************************************************/
 
 /**
- * @param {proto.Timestamp} timestamp
+ * @param {proto.HostMessage} hostMessage
  */
-async function encodeMessage(timestamp) {
+async function encodeMessage(hostMessage) {
+    /* Replies of the device carry this id back */
+    hostMessage.setRequestId(++requestId);
     /* Serialize JS object */
-    let protoBuffer = timestamp.serializeBinary();
+    let protoBuffer = hostMessage.serializeBinary();
     /* Encode with COBS */
     let cobsBuffer = encode(protoBuffer);
-    /* Add final zero for subsequent decoding by nanocobs */
+    /* Add final zero, the device reassembles the message up to it */
     cobsBuffer = new Uint8Array([...cobsBuffer, 0]);
-    /* Dispatch to interface */
+    /* Dispatch to interface, in writes that fit the default MTU */
     if (bleConnected == true) {
-        await txChar.writeValueWithoutResponse(cobsBuffer);
+        for (let offset = 0; offset < cobsBuffer.length; offset += TX_CHUNK_SIZE) {
+            await txChar.writeValueWithoutResponse(cobsBuffer.slice(offset, offset + TX_CHUNK_SIZE));
+        }
     }
     else {
         console.error("No device connected to send request");
@@ -201,18 +541,27 @@ const startMeasureButton = document.querySelector('.app-start-measure-button');
 const startMeasureButtonRipple = new mdc.ripple.MDCRipple(startMeasureButton);
 const stopMeasureButton = document.querySelector('.app-stop-measure-button');
 const stopMeasureButtonRipple = new mdc.ripple.MDCRipple(stopMeasureButton);
+const rawModeButton = document.querySelector('.app-raw-mode-button');
+const rawModeButtonRipple = new mdc.ripple.MDCRipple(rawModeButton);
+const rawModeButtonLabel = document.querySelector('.app-raw-mode-button-label');
+const downloadLogButton = document.querySelector('.app-download-log-button');
+const downloadLogButtonRipple = new mdc.ripple.MDCRipple(downloadLogButton);
 const batteryStatusIcon = document.querySelector('.app-bat-status-icon');
 const deviceLabel = document.getElementById('device-title-id');
 
 function disableControlButtons() {
     startMeasureButton.setAttribute('disabled', '');
     stopMeasureButton.setAttribute('disabled', '');
+    rawModeButton.setAttribute('disabled', '');
+    downloadLogButton.setAttribute('disabled', '');
     batteryStatusIcon.setAttribute('disabled', '');
 }
 
 function enableControlButtons() {
     startMeasureButton.removeAttribute('disabled');
     stopMeasureButton.removeAttribute('disabled');
+    rawModeButton.removeAttribute('disabled');
+    downloadLogButton.removeAttribute('disabled');
     batteryStatusIcon.removeAttribute('disabled');
 }
 
@@ -261,18 +610,100 @@ async function onStartMeasureButtonClick() {
     timeDataStart = millis * 0.001;
     // Placeholder to save data in file later
     window.data = [];
+    window.rawData = [];
+    rawSequenceNext = null;
     // Enable notifications
-    window.rxChar.startNotifications();
+    await window.rxChar.startNotifications();
+    // Frontend may have been stopped by a previous measurement
+    await encodeMessage(new proto.HostMessage().setMeasurementRequest(
+        new proto.MeasurementRequest().setAction(proto.MeasurementAction.MEASUREMENT_ACTION_START)));
+    // Energy budget of the measurement starts now
+    await encodeMessage(new proto.HostMessage().setEnergyRequest(new proto.EnergyRequest().setReset(true)));
+    // Device clock drift is fitted from these while spectra are received
+    startTimeSync();
     // Reset graphes
     onClearGraphClick();
 }
 
 async function onStopMeasureButtonClick() {
     if (bleConnected == false) return;
+    // Power the frontend down until next measurement, nothing is logged meanwhile
+    await encodeMessage(new proto.HostMessage().setMeasurementRequest(
+        new proto.MeasurementRequest().setAction(proto.MeasurementAction.MEASUREMENT_ACTION_STOP)));
+    // Energy budget of the measurement, device only replies while notifications are enabled
+    await encodeMessage(new proto.HostMessage().setEnergyRequest(new proto.EnergyRequest()));
+    stopTimeSync();
+    await new Promise(resolve => setTimeout(resolve, 500));
     // Disable notifications
     window.rxChar.stopNotifications();
     // Save data
     saveWindowData();
+    await readLatencyReport();
+}
+
+/**
+ * Log the device processing stage durations, from SAADC buffer to notification sent
+ */
+async function readLatencyReport() {
+    if (window.latencyChar == null) return;
+    const value = await window.latencyChar.readValue();
+    const report = proto.LatencyReport.deserializeBinary(new Uint8Array(value.buffer));
+    const stageNames = Object.keys(proto.LatencyStage);
+    console.table(report.getStagesList().map(stage => ({
+        stage: stageNames[stage.getStage()],
+        count: stage.getCount(),
+        min_us: stage.getMinUs(),
+        mean_us: stage.getMeanUs(),
+        max_us: stage.getMaxUs(),
+        histogram: stage.getHistogramList().join(' '),
+    })));
+}
+
+async function onRawModeButtonClick() {
+    if (bleConnected == false) return;
+    // Device restarts raw samples sequence when switching mode
+    rawSamplesMode = !rawSamplesMode;
+    rawSequenceNext = null;
+    rawModeButtonLabel.innerHTML = rawSamplesMode ? 'Spectra' : 'Raw Samples';
+    await setDeviceSettings();
+}
+
+async function onDownloadLogButtonClick() {
+    if (bleConnected == false) return;
+    window.logData = [];
+    logDownloading = true;
+    downloadLogButton.setAttribute('disabled', '');
+    // Device only sends while notifications are enabled, and logs otherwise
+    await window.rxChar.startNotifications();
+    await encodeMessage(new proto.HostMessage().setLogRequest(
+        new proto.LogRequest().setAction(proto.LogAction.LOG_ACTION_DOWNLOAD)));
+}
+
+/**
+ * Send a calibration measured on a reference load, then store it in device flash (from the console)
+ * @param {{delay_s: number, skew_s: number, tia_resistance: number}} parameters
+ * @param {{gain: number[], offset: number[]}[]} points real, imag pairs, one point per frequency
+ */
+async function sendCalibration(parameters, points) {
+    const CALIBRATION_POINTS_PER_REQUEST = 4; // CalibrationRequest.points max_count
+    for (let first = 0; first < points.length; first += CALIBRATION_POINTS_PER_REQUEST) {
+        const request = new proto.CalibrationRequest().setAction(proto.CalibrationAction.CALIBRATION_ACTION_SET);
+        if (first == 0) {
+            request.setParameters(new proto.CalibrationParameters()
+                .setDelayS(parameters.delay_s)
+                .setSkewS(parameters.skew_s)
+                .setTiaResistance(parameters.tia_resistance));
+        }
+        points.slice(first, first + CALIBRATION_POINTS_PER_REQUEST).forEach((point, n) => {
+            request.addPoints(new proto.CalibrationPoint()
+                .setIndex(first + n)
+                .setGain(new proto.Impedance().setReal(point.gain[0]).setImag(point.gain[1]))
+                .setOffset(new proto.Impedance().setReal(point.offset[0]).setImag(point.offset[1])));
+        });
+        await encodeMessage(new proto.HostMessage().setCalibrationRequest(request));
+    }
+    await encodeMessage(new proto.HostMessage().setCalibrationRequest(
+        new proto.CalibrationRequest().setAction(proto.CalibrationAction.CALIBRATION_ACTION_STORE)));
 }
 
 async function saveCurrentData() {
@@ -287,7 +718,17 @@ async function setDeviceTimestamp() {
     const timestamp = new proto.Timestamp()
         .setTime(seconds)
         .setUs(micros);
-    await encodeMessage(timestamp);
+    await encodeMessage(new proto.HostMessage().setTimestamp(timestamp));
+}
+
+async function setDeviceSettings() {
+    const settings = new proto.Settings()
+        .setImpedanceEncoding(proto.ImpedanceEncoding.IMPEDANCE_ENCODING_HALF)
+        .setOutputMode(rawSamplesMode ? proto.OutputMode.OUTPUT_MODE_RAW_SAMPLES : proto.OutputMode.OUTPUT_MODE_SPECTRA)
+        .setDspProfile(dspProfile)
+        .setAdaptiveThreshold(adaptiveThreshold)
+        .setAdaptiveIntervalMs(adaptiveIntervalMs);
+    await encodeMessage(new proto.HostMessage().setSettings(settings));
 }
 
 async function getDeviceBattery() {
@@ -300,6 +741,7 @@ async function getDeviceBattery() {
 
 function getDeviceInformation() {
     setTimeout(setDeviceTimestamp, 200);
+    setTimeout(setDeviceSettings, 300);
     setTimeout(getDeviceBattery, 400);
 }
 
@@ -330,7 +772,23 @@ const chartTimeMax = 60.0; // seconds
 let timeDataStart = 0.0;
 const colorset = [ '#ef5350FF', '#5c6bc0FF', '#26a69aFF', '#ffee58FF', '#5d4037ff', '#e91e63ff', '#2196f3ff', '#4caf50ff', '#ffc107ff', '#ef5350FF', '#5c6bc0FF', '#26a69aFF', '#ffee58FF', '#5d4037ff', '#e91e63ff', '#2196f3ff', '#4caf50ff', '#ffc107ff'];
 const EDA_FREQUENCY_LIST = [12, 28, 32, 36, 44, 68, 84, 108, 136, 196, 256, 324, 400, 484, 576, 724];
+const RAW_SAMPLE_BITS = 14;
 window.data = [];
+window.rawData = [];
+window.logData = [];
+let spectrumFrequencies = EDA_FREQUENCY_LIST; // Frequency of each impedance of a spectrum, from DspStatus
+let rawSamplesMode = false;
+let dspProfile = 0;
+let adaptiveThreshold = 0; // Relative |Z| change that sends a spectrum, 0 sends all of them
+let adaptiveIntervalMs = 0;
+let logDownloading = false;
+let rawSequenceNext = null;
+const TX_CHUNK_SIZE = 20; // ATT payload of the default MTU
+let requestId = 0; // Id of the last HostMessage sent
+const TIME_SYNC_INTERVAL_MS = 30000;
+let timeSyncTimer = null;
+let timeSyncPending = null; // Request waiting for its TimeSyncStatus
+let timeSyncLast = null; // Device clock and host time of the last request replied to, sent with the next one
 
 /* Graphical components binding */
 
@@ -521,7 +979,7 @@ function nyquistChartAddResults(data, time) {
         var val = {};
         val.real = element.getReal();
         val.imag = element.getImag();
-        val.freq = EDA_FREQUENCY_LIST[index];
+        val.freq = spectrumFrequencies[index];
         return val;
     });
 
@@ -584,13 +1042,13 @@ function nyquistChartAddResults(data, time) {
     nyquistChart.update();
 
     /* Update conductance chart */
-    for (let i = 0; i < EDA_FREQUENCY_LIST.length; i++) {
-        if (magnitudeChart.data.datasets.length < EDA_FREQUENCY_LIST.length) {
+    for (let i = 0; i < spectrumFrequencies.length; i++) {
+        if (magnitudeChart.data.datasets.length < spectrumFrequencies.length) {
             if (i == 0) {
-                magnitudeChart.data.datasets.push({ label: EDA_FREQUENCY_LIST[i] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[i], borderColor: colorset[i], showLine: true });
+                magnitudeChart.data.datasets.push({ label: spectrumFrequencies[i] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[i], borderColor: colorset[i], showLine: true });
             }
             else {
-                magnitudeChart.data.datasets.push({ label: EDA_FREQUENCY_LIST[i] + " Hz", labels: [], data: [], hidden: true, tension: 0.4, backgroundColor: colorset[i], borderColor: colorset[i], showLine: true });
+                magnitudeChart.data.datasets.push({ label: spectrumFrequencies[i] + " Hz", labels: [], data: [], hidden: true, tension: 0.4, backgroundColor: colorset[i], borderColor: colorset[i], showLine: true });
             }
         }
         magnitudeChart.data.datasets[i].data.push({x: time, y:(1000000.0/Math.sqrt((impedanceData[i].x ** 2) + (impedanceData[i].y ** 2)))});
@@ -598,7 +1056,7 @@ function nyquistChartAddResults(data, time) {
 
     while (magnitudeChart.data.datasets[0].data[magnitudeChart.data.datasets[0].data.length - 1].x - magnitudeChart.data.datasets[0].data[0].x > chartTimeMax) {
         //magnitudeChart.data.labels.shift();
-        for (let i = 0; i < EDA_FREQUENCY_LIST.length; i++) {
+        for (let i = 0; i < spectrumFrequencies.length; i++) {
             magnitudeChart.data.datasets[i].data.shift();
         }
     }
@@ -630,7 +1088,7 @@ setInterval(refreshHistoryChart, 60000)
 function refreshHistoryChart() {
     historyChart.data.labels = [];
     historyChart.data.datasets = [];
-    historyChart.data.datasets.push({ label: EDA_FREQUENCY_LIST[0] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[0], borderColor: colorset[0], showLine: true });
+    historyChart.data.datasets.push({ label: spectrumFrequencies[0] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[0], borderColor: colorset[0], showLine: true });
     window.data.forEach(dataArray => {
         real = dataArray[1];
         imag = dataArray[2];
@@ -640,10 +1098,12 @@ function refreshHistoryChart() {
     
     historyChart2.data.labels = [];
     historyChart2.data.datasets = [];
-    historyChart2.data.datasets.push({ label: EDA_FREQUENCY_LIST[15] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[1], borderColor: colorset[1], showLine: true });
+    /* Highest frequency of the DSP profile */
+    const last = spectrumFrequencies.length - 1;
+    historyChart2.data.datasets.push({ label: spectrumFrequencies[last] + " Hz", labels: [], data: [], tension: 0.4, backgroundColor: colorset[1], borderColor: colorset[1], showLine: true });
     window.data.forEach(dataArray => {
-        real = dataArray[31];
-        imag = dataArray[32];
+        real = dataArray[(2 * last) + 1];
+        imag = dataArray[(2 * last) + 2];
         historyChart2.data.datasets[0].data.push({x:dataArray[0], y:1000000.0/Math.sqrt((real ** 2) + (imag ** 2))});
     });
     historyChart2.update();
@@ -678,6 +1138,51 @@ function saveWindowData() {
         element.click();
         document.body.removeChild(element);
     }
+
+    if (window.rawData.length > 0) {
+        // One row per V, I pair, sample index jumps over lost chunks
+        let lines = ['Sample, V, I'];
+        window.rawData.forEach(chunk => {
+            const first = chunk.sequence * chunk.samples.length / 2;
+            for (let n = 0; n + 1 < chunk.samples.length; n += 2) {
+                lines.push((first + n / 2) + ', ' + chunk.samples[n] + ', ' + chunk.samples[n + 1]);
+            }
+        });
+        // Too large for a data URL
+        const blob = new Blob([lines.join('\r\n')], { type: 'text/csv' });
+        let element = document.createElement('a');
+        element.setAttribute('href', URL.createObjectURL(blob));
+        element.setAttribute('download', filename.replace('.csv', '_raw.csv'));
+        element.style.display = 'none';
+
+        document.body.appendChild(element);
+        element.click();
+        document.body.removeChild(element);
+        setTimeout(() => URL.revokeObjectURL(element.href), 1000);
+    }
+}
+
+function saveLogData() {
+    if (window.logData.length == 0) return;
+    const filename = bleDeviceName + "_" + getFormattedTime(Date.now() * 0.001).replace(/:/g, "-").replace(/ /g, "_") + '_log.csv';
+    // Absolute POSIX time, as recorded by the device
+    let header = 'Time(s)';
+    EDA_FREQUENCY_LIST.forEach(e => {
+        header = header + ', ' + e.toString() + 'Hz(Re), ' + e.toString() + 'Hz(Im)';
+    });
+    const csvContent = header + '\r\n' + window.logData.map(e =>
+        e.map(e => e.toFixed(4).toString()).join(', ')
+    ).join('\r\n');
+    const blob = new Blob([csvContent], { type: 'text/csv' });
+    let element = document.createElement('a');
+    element.setAttribute('href', URL.createObjectURL(blob));
+    element.setAttribute('download', filename);
+    element.style.display = 'none';
+
+    document.body.appendChild(element);
+    element.click();
+    document.body.removeChild(element);
+    setTimeout(() => URL.revokeObjectURL(element.href), 1000);
 }
 
 /*******************************************************************************
@@ -12,9 +12,46 @@
 // @ts-nocheck
 
 
+goog.provide('proto.AcquisitionRequest');
+goog.provide('proto.AcquisitionStatus');
+goog.provide('proto.CalibrationAction');
+goog.provide('proto.CalibrationParameters');
+goog.provide('proto.CalibrationPoint');
+goog.provide('proto.CalibrationRequest');
+goog.provide('proto.CalibrationStatus');
+goog.provide('proto.DeviceMessage');
+goog.provide('proto.DeviceMessage.PayloadCase');
+goog.provide('proto.DspStatus');
 goog.provide('proto.EcgBuffer');
+goog.provide('proto.EdaBatch');
 goog.provide('proto.EdaBuffer');
+goog.provide('proto.EdaSpectrum');
+goog.provide('proto.EnergyReport');
+goog.provide('proto.EnergyRequest');
+goog.provide('proto.EnergySubsystem');
+goog.provide('proto.HostMessage');
+goog.provide('proto.HostMessage.PayloadCase');
 goog.provide('proto.Impedance');
+goog.provide('proto.ImpedanceEncoding');
+goog.provide('proto.LatencyReport');
+goog.provide('proto.LatencyStage');
+goog.provide('proto.LogAction');
+goog.provide('proto.LogRequest');
+goog.provide('proto.LogStatus');
+goog.provide('proto.MeasurementAction');
+goog.provide('proto.MeasurementRequest');
+goog.provide('proto.MeasurementState');
+goog.provide('proto.MeasurementStatus');
+goog.provide('proto.OutputMode');
+goog.provide('proto.OverrunPolicy');
+goog.provide('proto.RawSamples');
+goog.provide('proto.RequestError');
+goog.provide('proto.RequestErrorCode');
+goog.provide('proto.Settings');
+goog.provide('proto.StageLatency');
+goog.provide('proto.SubsystemEnergy');
+goog.provide('proto.TimeSyncRequest');
+goog.provide('proto.TimeSyncStatus');
 goog.provide('proto.Timestamp');
 
 goog.require('jspb.BinaryReader');
@@ -105,6 +142,6177 @@ if (goog.DEBUG && !COMPILED) {
    */
   proto.EdaBuffer.displayName = 'proto.EdaBuffer';
 }
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.EdaSpectrum = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.EdaSpectrum.repeatedFields_, null);
+};
+goog.inherits(proto.EdaSpectrum, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.EdaSpectrum.displayName = 'proto.EdaSpectrum';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.EdaBatch = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.EdaBatch.repeatedFields_, null);
+};
+goog.inherits(proto.EdaBatch, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.EdaBatch.displayName = 'proto.EdaBatch';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.RawSamples = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.RawSamples, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.RawSamples.displayName = 'proto.RawSamples';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.Settings = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.Settings, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.Settings.displayName = 'proto.Settings';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.DspStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.DspStatus.repeatedFields_, null);
+};
+goog.inherits(proto.DspStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.DspStatus.displayName = 'proto.DspStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.AcquisitionRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.AcquisitionRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.AcquisitionRequest.displayName = 'proto.AcquisitionRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.AcquisitionStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.AcquisitionStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.AcquisitionStatus.displayName = 'proto.AcquisitionStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.LogRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.LogRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.LogRequest.displayName = 'proto.LogRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.LogStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.LogStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.LogStatus.displayName = 'proto.LogStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.EnergyRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.EnergyRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.EnergyRequest.displayName = 'proto.EnergyRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.SubsystemEnergy = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.SubsystemEnergy, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.SubsystemEnergy.displayName = 'proto.SubsystemEnergy';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.EnergyReport = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.EnergyReport.repeatedFields_, null);
+};
+goog.inherits(proto.EnergyReport, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.EnergyReport.displayName = 'proto.EnergyReport';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.CalibrationParameters = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.CalibrationParameters, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.CalibrationParameters.displayName = 'proto.CalibrationParameters';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.CalibrationPoint = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.CalibrationPoint, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.CalibrationPoint.displayName = 'proto.CalibrationPoint';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.CalibrationRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.CalibrationRequest.repeatedFields_, null);
+};
+goog.inherits(proto.CalibrationRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.CalibrationRequest.displayName = 'proto.CalibrationRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.CalibrationStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.CalibrationStatus.repeatedFields_, null);
+};
+goog.inherits(proto.CalibrationStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.CalibrationStatus.displayName = 'proto.CalibrationStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.MeasurementRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.MeasurementRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.MeasurementRequest.displayName = 'proto.MeasurementRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.MeasurementStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.MeasurementStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.MeasurementStatus.displayName = 'proto.MeasurementStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.RequestError = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.RequestError, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.RequestError.displayName = 'proto.RequestError';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.TimeSyncRequest = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.TimeSyncRequest, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.TimeSyncRequest.displayName = 'proto.TimeSyncRequest';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.TimeSyncStatus = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, null);
+};
+goog.inherits(proto.TimeSyncStatus, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.TimeSyncStatus.displayName = 'proto.TimeSyncStatus';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.StageLatency = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.StageLatency.repeatedFields_, null);
+};
+goog.inherits(proto.StageLatency, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.StageLatency.displayName = 'proto.StageLatency';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.LatencyReport = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, proto.LatencyReport.repeatedFields_, null);
+};
+goog.inherits(proto.LatencyReport, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.LatencyReport.displayName = 'proto.LatencyReport';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.HostMessage = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, proto.HostMessage.oneofGroups_);
+};
+goog.inherits(proto.HostMessage, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.HostMessage.displayName = 'proto.HostMessage';
+}
+/**
+ * Generated by JsPbCodeGenerator.
+ * @param {Array=} opt_data Optional initial data array, typically from a
+ * server response, or constructed directly in Javascript. The array is used
+ * in place and becomes part of the constructed object. It is not cloned.
+ * If no data is provided, the constructed object will be empty, but still
+ * valid.
+ * @extends {jspb.Message}
+ * @constructor
+ */
+proto.DeviceMessage = function(opt_data) {
+  jspb.Message.initialize(this, opt_data, 0, -1, null, proto.DeviceMessage.oneofGroups_);
+};
+goog.inherits(proto.DeviceMessage, jspb.Message);
+if (goog.DEBUG && !COMPILED) {
+  /**
+   * @public
+   * @override
+   */
+  proto.DeviceMessage.displayName = 'proto.DeviceMessage';
+}
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.Timestamp.prototype.toObject = function(opt_includeInstance) {
+  return proto.Timestamp.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.Timestamp} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Timestamp.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    time: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    us: jspb.Message.getFieldWithDefault(msg, 2, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.Timestamp}
+ */
+proto.Timestamp.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.Timestamp;
+  return proto.Timestamp.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.Timestamp} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.Timestamp}
+ */
+proto.Timestamp.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint64());
+      msg.setTime(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setUs(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.Timestamp.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.Timestamp.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.Timestamp} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Timestamp.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getTime();
+  if (f !== 0) {
+    writer.writeUint64(
+      1,
+      f
+    );
+  }
+  f = message.getUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint64 time = 1;
+ * @return {number}
+ */
+proto.Timestamp.prototype.getTime = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Timestamp} returns this
+ */
+proto.Timestamp.prototype.setTime = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 us = 2;
+ * @return {number}
+ */
+proto.Timestamp.prototype.getUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Timestamp} returns this
+ */
+proto.Timestamp.prototype.setUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EcgBuffer.prototype.toObject = function(opt_includeInstance) {
+  return proto.EcgBuffer.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EcgBuffer} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EcgBuffer.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    data: msg.getData_asB64(),
+    lodpn: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EcgBuffer}
+ */
+proto.EcgBuffer.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EcgBuffer;
+  return proto.EcgBuffer.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EcgBuffer} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EcgBuffer}
+ */
+proto.EcgBuffer.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!Uint8Array} */ (reader.readBytes());
+      msg.setData(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readInt32());
+      msg.setLodpn(value);
+      break;
+    case 3:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTimestamp(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EcgBuffer.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EcgBuffer.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EcgBuffer} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EcgBuffer.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getData_asU8();
+  if (f.length > 0) {
+    writer.writeBytes(
+      1,
+      f
+    );
+  }
+  f = message.getLodpn();
+  if (f !== 0) {
+    writer.writeInt32(
+      2,
+      f
+    );
+  }
+  f = message.getTimestamp();
+  if (f != null) {
+    writer.writeMessage(
+      3,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * optional bytes data = 1;
+ * @return {!(string|Uint8Array)}
+ */
+proto.EcgBuffer.prototype.getData = function() {
+  return /** @type {!(string|Uint8Array)} */ (jspb.Message.getFieldWithDefault(this, 1, ""));
+};
+
+
+/**
+ * optional bytes data = 1;
+ * This is a type-conversion wrapper around `getData()`
+ * @return {string}
+ */
+proto.EcgBuffer.prototype.getData_asB64 = function() {
+  return /** @type {string} */ (jspb.Message.bytesAsB64(
+      this.getData()));
+};
+
+
+/**
+ * optional bytes data = 1;
+ * Note that Uint8Array is not supported on all browsers.
+ * @see http://caniuse.com/Uint8Array
+ * This is a type-conversion wrapper around `getData()`
+ * @return {!Uint8Array}
+ */
+proto.EcgBuffer.prototype.getData_asU8 = function() {
+  return /** @type {!Uint8Array} */ (jspb.Message.bytesAsU8(
+      this.getData()));
+};
+
+
+/**
+ * @param {!(string|Uint8Array)} value
+ * @return {!proto.EcgBuffer} returns this
+ */
+proto.EcgBuffer.prototype.setData = function(value) {
+  return jspb.Message.setProto3BytesField(this, 1, value);
+};
+
+
+/**
+ * optional int32 lodpn = 2;
+ * @return {number}
+ */
+proto.EcgBuffer.prototype.getLodpn = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EcgBuffer} returns this
+ */
+proto.EcgBuffer.prototype.setLodpn = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional Timestamp timestamp = 3;
+ * @return {?proto.Timestamp}
+ */
+proto.EcgBuffer.prototype.getTimestamp = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 3));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.EcgBuffer} returns this
+*/
+proto.EcgBuffer.prototype.setTimestamp = function(value) {
+  return jspb.Message.setWrapperField(this, 3, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.EcgBuffer} returns this
+ */
+proto.EcgBuffer.prototype.clearTimestamp = function() {
+  return this.setTimestamp(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.EcgBuffer.prototype.hasTimestamp = function() {
+  return jspb.Message.getField(this, 3) != null;
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.Impedance.prototype.toObject = function(opt_includeInstance) {
+  return proto.Impedance.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.Impedance} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Impedance.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    real: jspb.Message.getFloatingPointFieldWithDefault(msg, 1, 0.0),
+    imag: jspb.Message.getFloatingPointFieldWithDefault(msg, 2, 0.0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.Impedance}
+ */
+proto.Impedance.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.Impedance;
+  return proto.Impedance.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.Impedance} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.Impedance}
+ */
+proto.Impedance.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setReal(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setImag(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.Impedance.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.Impedance.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.Impedance} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Impedance.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getReal();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      1,
+      f
+    );
+  }
+  f = message.getImag();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      2,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional float real = 1;
+ * @return {number}
+ */
+proto.Impedance.prototype.getReal = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 1, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Impedance} returns this
+ */
+proto.Impedance.prototype.setReal = function(value) {
+  return jspb.Message.setProto3FloatField(this, 1, value);
+};
+
+
+/**
+ * optional float imag = 2;
+ * @return {number}
+ */
+proto.Impedance.prototype.getImag = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 2, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Impedance} returns this
+ */
+proto.Impedance.prototype.setImag = function(value) {
+  return jspb.Message.setProto3FloatField(this, 2, value);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.EdaBuffer.repeatedFields_ = [1];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EdaBuffer.prototype.toObject = function(opt_includeInstance) {
+  return proto.EdaBuffer.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EdaBuffer} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaBuffer.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    dataList: jspb.Message.toObjectList(msg.getDataList(),
+    proto.Impedance.toObject, includeInstance),
+    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EdaBuffer}
+ */
+proto.EdaBuffer.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EdaBuffer;
+  return proto.EdaBuffer.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EdaBuffer} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EdaBuffer}
+ */
+proto.EdaBuffer.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = new proto.Impedance;
+      reader.readMessage(value,proto.Impedance.deserializeBinaryFromReader);
+      msg.addData(value);
+      break;
+    case 2:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTimestamp(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EdaBuffer.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EdaBuffer.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EdaBuffer} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaBuffer.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getDataList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      1,
+      f,
+      proto.Impedance.serializeBinaryToWriter
+    );
+  }
+  f = message.getTimestamp();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * repeated Impedance data = 1;
+ * @return {!Array<!proto.Impedance>}
+ */
+proto.EdaBuffer.prototype.getDataList = function() {
+  return /** @type{!Array<!proto.Impedance>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.Impedance, 1));
+};
+
+
+/**
+ * @param {!Array<!proto.Impedance>} value
+ * @return {!proto.EdaBuffer} returns this
+*/
+proto.EdaBuffer.prototype.setDataList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 1, value);
+};
+
+
+/**
+ * @param {!proto.Impedance=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.Impedance}
+ */
+proto.EdaBuffer.prototype.addData = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 1, opt_value, proto.Impedance, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.EdaBuffer} returns this
+ */
+proto.EdaBuffer.prototype.clearDataList = function() {
+  return this.setDataList([]);
+};
+
+
+/**
+ * optional Timestamp timestamp = 2;
+ * @return {?proto.Timestamp}
+ */
+proto.EdaBuffer.prototype.getTimestamp = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 2));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.EdaBuffer} returns this
+*/
+proto.EdaBuffer.prototype.setTimestamp = function(value) {
+  return jspb.Message.setWrapperField(this, 2, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.EdaBuffer} returns this
+ */
+proto.EdaBuffer.prototype.clearTimestamp = function() {
+  return this.setTimestamp(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.EdaBuffer.prototype.hasTimestamp = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.EdaSpectrum.repeatedFields_ = [1];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EdaSpectrum.prototype.toObject = function(opt_includeInstance) {
+  return proto.EdaSpectrum.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EdaSpectrum} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaSpectrum.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    dataList: jspb.Message.toObjectList(msg.getDataList(),
+    proto.Impedance.toObject, includeInstance),
+    deltaUs: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    dataHalf: msg.getDataHalf_asB64(),
+    halfExponent: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    skipped: jspb.Message.getFieldWithDefault(msg, 5, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EdaSpectrum}
+ */
+proto.EdaSpectrum.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EdaSpectrum;
+  return proto.EdaSpectrum.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EdaSpectrum} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EdaSpectrum}
+ */
+proto.EdaSpectrum.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = new proto.Impedance;
+      reader.readMessage(value,proto.Impedance.deserializeBinaryFromReader);
+      msg.addData(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setDeltaUs(value);
+      break;
+    case 3:
+      var value = /** @type {!Uint8Array} */ (reader.readBytes());
+      msg.setDataHalf(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readSint32());
+      msg.setHalfExponent(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setSkipped(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EdaSpectrum.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EdaSpectrum.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EdaSpectrum} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaSpectrum.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getDataList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      1,
+      f,
+      proto.Impedance.serializeBinaryToWriter
+    );
+  }
+  f = message.getDeltaUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getDataHalf_asU8();
+  if (f.length > 0) {
+    writer.writeBytes(
+      3,
+      f
+    );
+  }
+  f = message.getHalfExponent();
+  if (f !== 0) {
+    writer.writeSint32(
+      4,
+      f
+    );
+  }
+  f = message.getSkipped();
+  if (f !== 0) {
+    writer.writeUint32(
+      5,
+      f
+    );
+  }
+};
+
+
+/**
+ * repeated Impedance data = 1;
+ * @return {!Array<!proto.Impedance>}
+ */
+proto.EdaSpectrum.prototype.getDataList = function() {
+  return /** @type{!Array<!proto.Impedance>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.Impedance, 1));
+};
+
+
+/**
+ * @param {!Array<!proto.Impedance>} value
+ * @return {!proto.EdaSpectrum} returns this
+*/
+proto.EdaSpectrum.prototype.setDataList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 1, value);
+};
+
+
+/**
+ * @param {!proto.Impedance=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.Impedance}
+ */
+proto.EdaSpectrum.prototype.addData = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 1, opt_value, proto.Impedance, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.EdaSpectrum} returns this
+ */
+proto.EdaSpectrum.prototype.clearDataList = function() {
+  return this.setDataList([]);
+};
+
+
+/**
+ * optional uint32 delta_us = 2;
+ * @return {number}
+ */
+proto.EdaSpectrum.prototype.getDeltaUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EdaSpectrum} returns this
+ */
+proto.EdaSpectrum.prototype.setDeltaUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional bytes data_half = 3;
+ * @return {!(string|Uint8Array)}
+ */
+proto.EdaSpectrum.prototype.getDataHalf = function() {
+  return /** @type {!(string|Uint8Array)} */ (jspb.Message.getFieldWithDefault(this, 3, ""));
+};
+
+
+/**
+ * optional bytes data_half = 3;
+ * This is a type-conversion wrapper around `getDataHalf()`
+ * @return {string}
+ */
+proto.EdaSpectrum.prototype.getDataHalf_asB64 = function() {
+  return /** @type {string} */ (jspb.Message.bytesAsB64(
+      this.getDataHalf()));
+};
+
+
+/**
+ * optional bytes data_half = 3;
+ * Note that Uint8Array is not supported on all browsers.
+ * @see http://caniuse.com/Uint8Array
+ * This is a type-conversion wrapper around `getDataHalf()`
+ * @return {!Uint8Array}
+ */
+proto.EdaSpectrum.prototype.getDataHalf_asU8 = function() {
+  return /** @type {!Uint8Array} */ (jspb.Message.bytesAsU8(
+      this.getDataHalf()));
+};
+
+
+/**
+ * @param {!(string|Uint8Array)} value
+ * @return {!proto.EdaSpectrum} returns this
+ */
+proto.EdaSpectrum.prototype.setDataHalf = function(value) {
+  return jspb.Message.setProto3BytesField(this, 3, value);
+};
+
+
+/**
+ * optional sint32 half_exponent = 4;
+ * @return {number}
+ */
+proto.EdaSpectrum.prototype.getHalfExponent = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EdaSpectrum} returns this
+ */
+proto.EdaSpectrum.prototype.setHalfExponent = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional uint32 skipped = 5;
+ * @return {number}
+ */
+proto.EdaSpectrum.prototype.getSkipped = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 5, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EdaSpectrum} returns this
+ */
+proto.EdaSpectrum.prototype.setSkipped = function(value) {
+  return jspb.Message.setProto3IntField(this, 5, value);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.EdaBatch.repeatedFields_ = [2];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EdaBatch.prototype.toObject = function(opt_includeInstance) {
+  return proto.EdaBatch.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EdaBatch} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaBatch.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f),
+    spectraList: jspb.Message.toObjectList(msg.getSpectraList(),
+    proto.EdaSpectrum.toObject, includeInstance)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EdaBatch}
+ */
+proto.EdaBatch.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EdaBatch;
+  return proto.EdaBatch.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EdaBatch} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EdaBatch}
+ */
+proto.EdaBatch.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTimestamp(value);
+      break;
+    case 2:
+      var value = new proto.EdaSpectrum;
+      reader.readMessage(value,proto.EdaSpectrum.deserializeBinaryFromReader);
+      msg.addSpectra(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EdaBatch.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EdaBatch.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EdaBatch} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EdaBatch.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getTimestamp();
+  if (f != null) {
+    writer.writeMessage(
+      1,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+  f = message.getSpectraList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      2,
+      f,
+      proto.EdaSpectrum.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * optional Timestamp timestamp = 1;
+ * @return {?proto.Timestamp}
+ */
+proto.EdaBatch.prototype.getTimestamp = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 1));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.EdaBatch} returns this
+*/
+proto.EdaBatch.prototype.setTimestamp = function(value) {
+  return jspb.Message.setWrapperField(this, 1, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.EdaBatch} returns this
+ */
+proto.EdaBatch.prototype.clearTimestamp = function() {
+  return this.setTimestamp(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.EdaBatch.prototype.hasTimestamp = function() {
+  return jspb.Message.getField(this, 1) != null;
+};
+
+
+/**
+ * repeated EdaSpectrum spectra = 2;
+ * @return {!Array<!proto.EdaSpectrum>}
+ */
+proto.EdaBatch.prototype.getSpectraList = function() {
+  return /** @type{!Array<!proto.EdaSpectrum>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.EdaSpectrum, 2));
+};
+
+
+/**
+ * @param {!Array<!proto.EdaSpectrum>} value
+ * @return {!proto.EdaBatch} returns this
+*/
+proto.EdaBatch.prototype.setSpectraList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 2, value);
+};
+
+
+/**
+ * @param {!proto.EdaSpectrum=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.EdaSpectrum}
+ */
+proto.EdaBatch.prototype.addSpectra = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 2, opt_value, proto.EdaSpectrum, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.EdaBatch} returns this
+ */
+proto.EdaBatch.prototype.clearSpectraList = function() {
+  return this.setSpectraList([]);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.RawSamples.prototype.toObject = function(opt_includeInstance) {
+  return proto.RawSamples.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.RawSamples} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.RawSamples.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    sequence: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f),
+    data: msg.getData_asB64()
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.RawSamples}
+ */
+proto.RawSamples.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.RawSamples;
+  return proto.RawSamples.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.RawSamples} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.RawSamples}
+ */
+proto.RawSamples.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setSequence(value);
+      break;
+    case 2:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTimestamp(value);
+      break;
+    case 3:
+      var value = /** @type {!Uint8Array} */ (reader.readBytes());
+      msg.setData(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.RawSamples.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.RawSamples.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.RawSamples} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.RawSamples.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getSequence();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getTimestamp();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+  f = message.getData_asU8();
+  if (f.length > 0) {
+    writer.writeBytes(
+      3,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint32 sequence = 1;
+ * @return {number}
+ */
+proto.RawSamples.prototype.getSequence = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.RawSamples} returns this
+ */
+proto.RawSamples.prototype.setSequence = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional Timestamp timestamp = 2;
+ * @return {?proto.Timestamp}
+ */
+proto.RawSamples.prototype.getTimestamp = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 2));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.RawSamples} returns this
+*/
+proto.RawSamples.prototype.setTimestamp = function(value) {
+  return jspb.Message.setWrapperField(this, 2, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.RawSamples} returns this
+ */
+proto.RawSamples.prototype.clearTimestamp = function() {
+  return this.setTimestamp(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.RawSamples.prototype.hasTimestamp = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+/**
+ * optional bytes data = 3;
+ * @return {!(string|Uint8Array)}
+ */
+proto.RawSamples.prototype.getData = function() {
+  return /** @type {!(string|Uint8Array)} */ (jspb.Message.getFieldWithDefault(this, 3, ""));
+};
+
+
+/**
+ * optional bytes data = 3;
+ * This is a type-conversion wrapper around `getData()`
+ * @return {string}
+ */
+proto.RawSamples.prototype.getData_asB64 = function() {
+  return /** @type {string} */ (jspb.Message.bytesAsB64(
+      this.getData()));
+};
+
+
+/**
+ * optional bytes data = 3;
+ * Note that Uint8Array is not supported on all browsers.
+ * @see http://caniuse.com/Uint8Array
+ * This is a type-conversion wrapper around `getData()`
+ * @return {!Uint8Array}
+ */
+proto.RawSamples.prototype.getData_asU8 = function() {
+  return /** @type {!Uint8Array} */ (jspb.Message.bytesAsU8(
+      this.getData()));
+};
+
+
+/**
+ * @param {!(string|Uint8Array)} value
+ * @return {!proto.RawSamples} returns this
+ */
+proto.RawSamples.prototype.setData = function(value) {
+  return jspb.Message.setProto3BytesField(this, 3, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.Settings.prototype.toObject = function(opt_includeInstance) {
+  return proto.Settings.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.Settings} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Settings.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    impedanceEncoding: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    outputMode: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    overrunPolicy: jspb.Message.getFieldWithDefault(msg, 3, 0),
+    dspProfile: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    adaptiveThreshold: jspb.Message.getFloatingPointFieldWithDefault(msg, 5, 0.0),
+    adaptiveIntervalMs: jspb.Message.getFieldWithDefault(msg, 6, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.Settings}
+ */
+proto.Settings.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.Settings;
+  return proto.Settings.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.Settings} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.Settings}
+ */
+proto.Settings.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.ImpedanceEncoding} */ (reader.readEnum());
+      msg.setImpedanceEncoding(value);
+      break;
+    case 2:
+      var value = /** @type {!proto.OutputMode} */ (reader.readEnum());
+      msg.setOutputMode(value);
+      break;
+    case 3:
+      var value = /** @type {!proto.OverrunPolicy} */ (reader.readEnum());
+      msg.setOverrunPolicy(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setDspProfile(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setAdaptiveThreshold(value);
+      break;
+    case 6:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setAdaptiveIntervalMs(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.Settings.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.Settings.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.Settings} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.Settings.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getImpedanceEncoding();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getOutputMode();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      2,
+      f
+    );
+  }
+  f = message.getOverrunPolicy();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      3,
+      f
+    );
+  }
+  f = message.getDspProfile();
+  if (f !== 0) {
+    writer.writeUint32(
+      4,
+      f
+    );
+  }
+  f = message.getAdaptiveThreshold();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      5,
+      f
+    );
+  }
+  f = message.getAdaptiveIntervalMs();
+  if (f !== 0) {
+    writer.writeUint32(
+      6,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional ImpedanceEncoding impedance_encoding = 1;
+ * @return {!proto.ImpedanceEncoding}
+ */
+proto.Settings.prototype.getImpedanceEncoding = function() {
+  return /** @type {!proto.ImpedanceEncoding} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.ImpedanceEncoding} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setImpedanceEncoding = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional OutputMode output_mode = 2;
+ * @return {!proto.OutputMode}
+ */
+proto.Settings.prototype.getOutputMode = function() {
+  return /** @type {!proto.OutputMode} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {!proto.OutputMode} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setOutputMode = function(value) {
+  return jspb.Message.setProto3EnumField(this, 2, value);
+};
+
+
+/**
+ * optional OverrunPolicy overrun_policy = 3;
+ * @return {!proto.OverrunPolicy}
+ */
+proto.Settings.prototype.getOverrunPolicy = function() {
+  return /** @type {!proto.OverrunPolicy} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {!proto.OverrunPolicy} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setOverrunPolicy = function(value) {
+  return jspb.Message.setProto3EnumField(this, 3, value);
+};
+
+
+/**
+ * optional uint32 dsp_profile = 4;
+ * @return {number}
+ */
+proto.Settings.prototype.getDspProfile = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setDspProfile = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional float adaptive_threshold = 5;
+ * @return {number}
+ */
+proto.Settings.prototype.getAdaptiveThreshold = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 5, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setAdaptiveThreshold = function(value) {
+  return jspb.Message.setProto3FloatField(this, 5, value);
+};
+
+
+/**
+ * optional uint32 adaptive_interval_ms = 6;
+ * @return {number}
+ */
+proto.Settings.prototype.getAdaptiveIntervalMs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 6, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.Settings} returns this
+ */
+proto.Settings.prototype.setAdaptiveIntervalMs = function(value) {
+  return jspb.Message.setProto3IntField(this, 6, value);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.DspStatus.repeatedFields_ = [3];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.DspStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.DspStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.DspStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.DspStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    profile: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    fftSize: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    frequenciesList: (f = jspb.Message.getRepeatedField(msg, 3)) == null ? undefined : f
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.DspStatus}
+ */
+proto.DspStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.DspStatus;
+  return proto.DspStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.DspStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.DspStatus}
+ */
+proto.DspStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setProfile(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setFftSize(value);
+      break;
+    case 3:
+      var values = /** @type {!Array<number>} */ (reader.isDelimited() ? reader.readPackedUint32() : [reader.readUint32()]);
+      for (var i = 0; i < values.length; i++) {
+        msg.addFrequencies(values[i]);
+      }
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.DspStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.DspStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.DspStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.DspStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getProfile();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getFftSize();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getFrequenciesList();
+  if (f.length > 0) {
+    writer.writePackedUint32(
+      3,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint32 profile = 1;
+ * @return {number}
+ */
+proto.DspStatus.prototype.getProfile = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.DspStatus} returns this
+ */
+proto.DspStatus.prototype.setProfile = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 fft_size = 2;
+ * @return {number}
+ */
+proto.DspStatus.prototype.getFftSize = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.DspStatus} returns this
+ */
+proto.DspStatus.prototype.setFftSize = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * repeated uint32 frequencies = 3;
+ * @return {!Array<number>}
+ */
+proto.DspStatus.prototype.getFrequenciesList = function() {
+  return /** @type {!Array<number>} */ (jspb.Message.getRepeatedField(this, 3));
+};
+
+
+/**
+ * @param {!Array<number>} value
+ * @return {!proto.DspStatus} returns this
+ */
+proto.DspStatus.prototype.setFrequenciesList = function(value) {
+  return jspb.Message.setField(this, 3, value || []);
+};
+
+
+/**
+ * @param {number} value
+ * @param {number=} opt_index
+ * @return {!proto.DspStatus} returns this
+ */
+proto.DspStatus.prototype.addFrequencies = function(value, opt_index) {
+  return jspb.Message.addToRepeatedField(this, 3, value, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.DspStatus} returns this
+ */
+proto.DspStatus.prototype.clearFrequenciesList = function() {
+  return this.setFrequenciesList([]);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.AcquisitionRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.AcquisitionRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.AcquisitionRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.AcquisitionRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.AcquisitionRequest}
+ */
+proto.AcquisitionRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.AcquisitionRequest;
+  return proto.AcquisitionRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.AcquisitionRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.AcquisitionRequest}
+ */
+proto.AcquisitionRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.AcquisitionRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.AcquisitionRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.AcquisitionRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.AcquisitionRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.AcquisitionStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.AcquisitionStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.AcquisitionStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.AcquisitionStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    buffers: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    overruns: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    stalls: jspb.Message.getFieldWithDefault(msg, 3, 0),
+    heldMax: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    poolSize: jspb.Message.getFieldWithDefault(msg, 5, 0),
+    txDropped: jspb.Message.getFieldWithDefault(msg, 6, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.AcquisitionStatus}
+ */
+proto.AcquisitionStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.AcquisitionStatus;
+  return proto.AcquisitionStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.AcquisitionStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.AcquisitionStatus}
+ */
+proto.AcquisitionStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setBuffers(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setOverruns(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setStalls(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setHeldMax(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setPoolSize(value);
+      break;
+    case 6:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setTxDropped(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.AcquisitionStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.AcquisitionStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.AcquisitionStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.AcquisitionStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getBuffers();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getOverruns();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getStalls();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+  f = message.getHeldMax();
+  if (f !== 0) {
+    writer.writeUint32(
+      4,
+      f
+    );
+  }
+  f = message.getPoolSize();
+  if (f !== 0) {
+    writer.writeUint32(
+      5,
+      f
+    );
+  }
+  f = message.getTxDropped();
+  if (f !== 0) {
+    writer.writeUint32(
+      6,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint32 buffers = 1;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getBuffers = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setBuffers = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 overruns = 2;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getOverruns = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setOverruns = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional uint32 stalls = 3;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getStalls = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setStalls = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+/**
+ * optional uint32 held_max = 4;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getHeldMax = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setHeldMax = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional uint32 pool_size = 5;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getPoolSize = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 5, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setPoolSize = function(value) {
+  return jspb.Message.setProto3IntField(this, 5, value);
+};
+
+
+/**
+ * optional uint32 tx_dropped = 6;
+ * @return {number}
+ */
+proto.AcquisitionStatus.prototype.getTxDropped = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 6, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.AcquisitionStatus} returns this
+ */
+proto.AcquisitionStatus.prototype.setTxDropped = function(value) {
+  return jspb.Message.setProto3IntField(this, 6, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.LogRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.LogRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.LogRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.LogRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    action: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    since: jspb.Message.getFieldWithDefault(msg, 2, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.LogRequest}
+ */
+proto.LogRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.LogRequest;
+  return proto.LogRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.LogRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.LogRequest}
+ */
+proto.LogRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.LogAction} */ (reader.readEnum());
+      msg.setAction(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint64());
+      msg.setSince(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.LogRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.LogRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.LogRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.LogRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getAction();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getSince();
+  if (f !== 0) {
+    writer.writeUint64(
+      2,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional LogAction action = 1;
+ * @return {!proto.LogAction}
+ */
+proto.LogRequest.prototype.getAction = function() {
+  return /** @type {!proto.LogAction} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.LogAction} value
+ * @return {!proto.LogRequest} returns this
+ */
+proto.LogRequest.prototype.setAction = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional uint64 since = 2;
+ * @return {number}
+ */
+proto.LogRequest.prototype.getSince = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogRequest} returns this
+ */
+proto.LogRequest.prototype.setSince = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.LogStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.LogStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.LogStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.LogStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    batchCount: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    usedBytes: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    sizeBytes: jspb.Message.getFieldWithDefault(msg, 3, 0),
+    dropped: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    overwritten: jspb.Message.getFieldWithDefault(msg, 5, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.LogStatus}
+ */
+proto.LogStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.LogStatus;
+  return proto.LogStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.LogStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.LogStatus}
+ */
+proto.LogStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setBatchCount(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setUsedBytes(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setSizeBytes(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setDropped(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setOverwritten(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.LogStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.LogStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.LogStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.LogStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getBatchCount();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getUsedBytes();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getSizeBytes();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+  f = message.getDropped();
+  if (f !== 0) {
+    writer.writeUint32(
+      4,
+      f
+    );
+  }
+  f = message.getOverwritten();
+  if (f !== 0) {
+    writer.writeUint32(
+      5,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint32 batch_count = 1;
+ * @return {number}
+ */
+proto.LogStatus.prototype.getBatchCount = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogStatus} returns this
+ */
+proto.LogStatus.prototype.setBatchCount = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 used_bytes = 2;
+ * @return {number}
+ */
+proto.LogStatus.prototype.getUsedBytes = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogStatus} returns this
+ */
+proto.LogStatus.prototype.setUsedBytes = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional uint32 size_bytes = 3;
+ * @return {number}
+ */
+proto.LogStatus.prototype.getSizeBytes = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogStatus} returns this
+ */
+proto.LogStatus.prototype.setSizeBytes = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+/**
+ * optional uint32 dropped = 4;
+ * @return {number}
+ */
+proto.LogStatus.prototype.getDropped = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogStatus} returns this
+ */
+proto.LogStatus.prototype.setDropped = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional uint32 overwritten = 5;
+ * @return {number}
+ */
+proto.LogStatus.prototype.getOverwritten = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 5, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.LogStatus} returns this
+ */
+proto.LogStatus.prototype.setOverwritten = function(value) {
+  return jspb.Message.setProto3IntField(this, 5, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EnergyRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.EnergyRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EnergyRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EnergyRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    reset: jspb.Message.getBooleanFieldWithDefault(msg, 1, false)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EnergyRequest}
+ */
+proto.EnergyRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EnergyRequest;
+  return proto.EnergyRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EnergyRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EnergyRequest}
+ */
+proto.EnergyRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {boolean} */ (reader.readBool());
+      msg.setReset(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EnergyRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EnergyRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EnergyRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EnergyRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getReset();
+  if (f) {
+    writer.writeBool(
+      1,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional bool reset = 1;
+ * @return {boolean}
+ */
+proto.EnergyRequest.prototype.getReset = function() {
+  return /** @type {boolean} */ (jspb.Message.getBooleanFieldWithDefault(this, 1, false));
+};
+
+
+/**
+ * @param {boolean} value
+ * @return {!proto.EnergyRequest} returns this
+ */
+proto.EnergyRequest.prototype.setReset = function(value) {
+  return jspb.Message.setProto3BooleanField(this, 1, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.SubsystemEnergy.prototype.toObject = function(opt_includeInstance) {
+  return proto.SubsystemEnergy.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.SubsystemEnergy} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.SubsystemEnergy.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    subsystem: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    activeMs: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    chargeUah: jspb.Message.getFieldWithDefault(msg, 3, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.SubsystemEnergy}
+ */
+proto.SubsystemEnergy.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.SubsystemEnergy;
+  return proto.SubsystemEnergy.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.SubsystemEnergy} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.SubsystemEnergy}
+ */
+proto.SubsystemEnergy.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.EnergySubsystem} */ (reader.readEnum());
+      msg.setSubsystem(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setActiveMs(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setChargeUah(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.SubsystemEnergy.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.SubsystemEnergy.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.SubsystemEnergy} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.SubsystemEnergy.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getSubsystem();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getActiveMs();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getChargeUah();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional EnergySubsystem subsystem = 1;
+ * @return {!proto.EnergySubsystem}
+ */
+proto.SubsystemEnergy.prototype.getSubsystem = function() {
+  return /** @type {!proto.EnergySubsystem} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.EnergySubsystem} value
+ * @return {!proto.SubsystemEnergy} returns this
+ */
+proto.SubsystemEnergy.prototype.setSubsystem = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 active_ms = 2;
+ * @return {number}
+ */
+proto.SubsystemEnergy.prototype.getActiveMs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.SubsystemEnergy} returns this
+ */
+proto.SubsystemEnergy.prototype.setActiveMs = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional uint32 charge_uah = 3;
+ * @return {number}
+ */
+proto.SubsystemEnergy.prototype.getChargeUah = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.SubsystemEnergy} returns this
+ */
+proto.SubsystemEnergy.prototype.setChargeUah = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.EnergyReport.repeatedFields_ = [4];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.EnergyReport.prototype.toObject = function(opt_includeInstance) {
+  return proto.EnergyReport.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.EnergyReport} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EnergyReport.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    periodS: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    wakeups: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    radioEvents: jspb.Message.getFieldWithDefault(msg, 3, 0),
+    subsystemsList: jspb.Message.toObjectList(msg.getSubsystemsList(),
+    proto.SubsystemEnergy.toObject, includeInstance),
+    measuredUah: jspb.Message.getFieldWithDefault(msg, 5, 0),
+    averageUa: jspb.Message.getFieldWithDefault(msg, 6, 0),
+    remainingMah: jspb.Message.getFieldWithDefault(msg, 7, 0),
+    runtimeMin: jspb.Message.getFieldWithDefault(msg, 8, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.EnergyReport}
+ */
+proto.EnergyReport.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.EnergyReport;
+  return proto.EnergyReport.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.EnergyReport} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.EnergyReport}
+ */
+proto.EnergyReport.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setPeriodS(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setWakeups(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setRadioEvents(value);
+      break;
+    case 4:
+      var value = new proto.SubsystemEnergy;
+      reader.readMessage(value,proto.SubsystemEnergy.deserializeBinaryFromReader);
+      msg.addSubsystems(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readSint32());
+      msg.setMeasuredUah(value);
+      break;
+    case 6:
+      var value = /** @type {number} */ (reader.readSint32());
+      msg.setAverageUa(value);
+      break;
+    case 7:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setRemainingMah(value);
+      break;
+    case 8:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setRuntimeMin(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.EnergyReport.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.EnergyReport.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.EnergyReport} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.EnergyReport.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getPeriodS();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getWakeups();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getRadioEvents();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+  f = message.getSubsystemsList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      4,
+      f,
+      proto.SubsystemEnergy.serializeBinaryToWriter
+    );
+  }
+  f = message.getMeasuredUah();
+  if (f !== 0) {
+    writer.writeSint32(
+      5,
+      f
+    );
+  }
+  f = message.getAverageUa();
+  if (f !== 0) {
+    writer.writeSint32(
+      6,
+      f
+    );
+  }
+  f = message.getRemainingMah();
+  if (f !== 0) {
+    writer.writeUint32(
+      7,
+      f
+    );
+  }
+  f = message.getRuntimeMin();
+  if (f !== 0) {
+    writer.writeUint32(
+      8,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint32 period_s = 1;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getPeriodS = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setPeriodS = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 wakeups = 2;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getWakeups = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setWakeups = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional uint32 radio_events = 3;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getRadioEvents = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setRadioEvents = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+/**
+ * repeated SubsystemEnergy subsystems = 4;
+ * @return {!Array<!proto.SubsystemEnergy>}
+ */
+proto.EnergyReport.prototype.getSubsystemsList = function() {
+  return /** @type{!Array<!proto.SubsystemEnergy>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.SubsystemEnergy, 4));
+};
+
+
+/**
+ * @param {!Array<!proto.SubsystemEnergy>} value
+ * @return {!proto.EnergyReport} returns this
+*/
+proto.EnergyReport.prototype.setSubsystemsList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 4, value);
+};
+
+
+/**
+ * @param {!proto.SubsystemEnergy=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.SubsystemEnergy}
+ */
+proto.EnergyReport.prototype.addSubsystems = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 4, opt_value, proto.SubsystemEnergy, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.clearSubsystemsList = function() {
+  return this.setSubsystemsList([]);
+};
+
+
+/**
+ * optional sint32 measured_uah = 5;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getMeasuredUah = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 5, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setMeasuredUah = function(value) {
+  return jspb.Message.setProto3IntField(this, 5, value);
+};
+
+
+/**
+ * optional sint32 average_ua = 6;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getAverageUa = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 6, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setAverageUa = function(value) {
+  return jspb.Message.setProto3IntField(this, 6, value);
+};
+
+
+/**
+ * optional uint32 remaining_mah = 7;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getRemainingMah = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 7, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setRemainingMah = function(value) {
+  return jspb.Message.setProto3IntField(this, 7, value);
+};
+
+
+/**
+ * optional uint32 runtime_min = 8;
+ * @return {number}
+ */
+proto.EnergyReport.prototype.getRuntimeMin = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 8, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.EnergyReport} returns this
+ */
+proto.EnergyReport.prototype.setRuntimeMin = function(value) {
+  return jspb.Message.setProto3IntField(this, 8, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.CalibrationParameters.prototype.toObject = function(opt_includeInstance) {
+  return proto.CalibrationParameters.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.CalibrationParameters} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationParameters.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    delayS: jspb.Message.getFloatingPointFieldWithDefault(msg, 1, 0.0),
+    skewS: jspb.Message.getFloatingPointFieldWithDefault(msg, 2, 0.0),
+    tiaResistance: jspb.Message.getFloatingPointFieldWithDefault(msg, 3, 0.0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.CalibrationParameters}
+ */
+proto.CalibrationParameters.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.CalibrationParameters;
+  return proto.CalibrationParameters.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.CalibrationParameters} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.CalibrationParameters}
+ */
+proto.CalibrationParameters.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setDelayS(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setSkewS(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setTiaResistance(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.CalibrationParameters.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.CalibrationParameters.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.CalibrationParameters} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationParameters.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getDelayS();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      1,
+      f
+    );
+  }
+  f = message.getSkewS();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      2,
+      f
+    );
+  }
+  f = message.getTiaResistance();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      3,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional float delay_s = 1;
+ * @return {number}
+ */
+proto.CalibrationParameters.prototype.getDelayS = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 1, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.CalibrationParameters} returns this
+ */
+proto.CalibrationParameters.prototype.setDelayS = function(value) {
+  return jspb.Message.setProto3FloatField(this, 1, value);
+};
+
+
+/**
+ * optional float skew_s = 2;
+ * @return {number}
+ */
+proto.CalibrationParameters.prototype.getSkewS = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 2, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.CalibrationParameters} returns this
+ */
+proto.CalibrationParameters.prototype.setSkewS = function(value) {
+  return jspb.Message.setProto3FloatField(this, 2, value);
+};
+
+
+/**
+ * optional float tia_resistance = 3;
+ * @return {number}
+ */
+proto.CalibrationParameters.prototype.getTiaResistance = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 3, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.CalibrationParameters} returns this
+ */
+proto.CalibrationParameters.prototype.setTiaResistance = function(value) {
+  return jspb.Message.setProto3FloatField(this, 3, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.CalibrationPoint.prototype.toObject = function(opt_includeInstance) {
+  return proto.CalibrationPoint.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.CalibrationPoint} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationPoint.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    index: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    gain: (f = msg.getGain()) && proto.Impedance.toObject(includeInstance, f),
+    offset: (f = msg.getOffset()) && proto.Impedance.toObject(includeInstance, f)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.CalibrationPoint}
+ */
+proto.CalibrationPoint.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.CalibrationPoint;
+  return proto.CalibrationPoint.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.CalibrationPoint} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.CalibrationPoint}
+ */
+proto.CalibrationPoint.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setIndex(value);
+      break;
+    case 2:
+      var value = new proto.Impedance;
+      reader.readMessage(value,proto.Impedance.deserializeBinaryFromReader);
+      msg.setGain(value);
+      break;
+    case 3:
+      var value = new proto.Impedance;
+      reader.readMessage(value,proto.Impedance.deserializeBinaryFromReader);
+      msg.setOffset(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.CalibrationPoint.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.CalibrationPoint.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.CalibrationPoint} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationPoint.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getIndex();
+  if (f !== 0) {
+    writer.writeUint32(
+      1,
+      f
+    );
+  }
+  f = message.getGain();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.Impedance.serializeBinaryToWriter
+    );
+  }
+  f = message.getOffset();
+  if (f != null) {
+    writer.writeMessage(
+      3,
+      f,
+      proto.Impedance.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * optional uint32 index = 1;
+ * @return {number}
+ */
+proto.CalibrationPoint.prototype.getIndex = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.CalibrationPoint} returns this
+ */
+proto.CalibrationPoint.prototype.setIndex = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional Impedance gain = 2;
+ * @return {?proto.Impedance}
+ */
+proto.CalibrationPoint.prototype.getGain = function() {
+  return /** @type{?proto.Impedance} */ (
+    jspb.Message.getWrapperField(this, proto.Impedance, 2));
+};
+
+
+/**
+ * @param {?proto.Impedance|undefined} value
+ * @return {!proto.CalibrationPoint} returns this
+*/
+proto.CalibrationPoint.prototype.setGain = function(value) {
+  return jspb.Message.setWrapperField(this, 2, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.CalibrationPoint} returns this
+ */
+proto.CalibrationPoint.prototype.clearGain = function() {
+  return this.setGain(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.CalibrationPoint.prototype.hasGain = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+/**
+ * optional Impedance offset = 3;
+ * @return {?proto.Impedance}
+ */
+proto.CalibrationPoint.prototype.getOffset = function() {
+  return /** @type{?proto.Impedance} */ (
+    jspb.Message.getWrapperField(this, proto.Impedance, 3));
+};
+
+
+/**
+ * @param {?proto.Impedance|undefined} value
+ * @return {!proto.CalibrationPoint} returns this
+*/
+proto.CalibrationPoint.prototype.setOffset = function(value) {
+  return jspb.Message.setWrapperField(this, 3, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.CalibrationPoint} returns this
+ */
+proto.CalibrationPoint.prototype.clearOffset = function() {
+  return this.setOffset(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.CalibrationPoint.prototype.hasOffset = function() {
+  return jspb.Message.getField(this, 3) != null;
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.CalibrationRequest.repeatedFields_ = [3];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.CalibrationRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.CalibrationRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.CalibrationRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    action: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    parameters: (f = msg.getParameters()) && proto.CalibrationParameters.toObject(includeInstance, f),
+    pointsList: jspb.Message.toObjectList(msg.getPointsList(),
+    proto.CalibrationPoint.toObject, includeInstance)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.CalibrationRequest}
+ */
+proto.CalibrationRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.CalibrationRequest;
+  return proto.CalibrationRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.CalibrationRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.CalibrationRequest}
+ */
+proto.CalibrationRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.CalibrationAction} */ (reader.readEnum());
+      msg.setAction(value);
+      break;
+    case 2:
+      var value = new proto.CalibrationParameters;
+      reader.readMessage(value,proto.CalibrationParameters.deserializeBinaryFromReader);
+      msg.setParameters(value);
+      break;
+    case 3:
+      var value = new proto.CalibrationPoint;
+      reader.readMessage(value,proto.CalibrationPoint.deserializeBinaryFromReader);
+      msg.addPoints(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.CalibrationRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.CalibrationRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.CalibrationRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getAction();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getParameters();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.CalibrationParameters.serializeBinaryToWriter
+    );
+  }
+  f = message.getPointsList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      3,
+      f,
+      proto.CalibrationPoint.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * optional CalibrationAction action = 1;
+ * @return {!proto.CalibrationAction}
+ */
+proto.CalibrationRequest.prototype.getAction = function() {
+  return /** @type {!proto.CalibrationAction} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.CalibrationAction} value
+ * @return {!proto.CalibrationRequest} returns this
+ */
+proto.CalibrationRequest.prototype.setAction = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional CalibrationParameters parameters = 2;
+ * @return {?proto.CalibrationParameters}
+ */
+proto.CalibrationRequest.prototype.getParameters = function() {
+  return /** @type{?proto.CalibrationParameters} */ (
+    jspb.Message.getWrapperField(this, proto.CalibrationParameters, 2));
+};
+
+
+/**
+ * @param {?proto.CalibrationParameters|undefined} value
+ * @return {!proto.CalibrationRequest} returns this
+*/
+proto.CalibrationRequest.prototype.setParameters = function(value) {
+  return jspb.Message.setWrapperField(this, 2, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.CalibrationRequest} returns this
+ */
+proto.CalibrationRequest.prototype.clearParameters = function() {
+  return this.setParameters(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.CalibrationRequest.prototype.hasParameters = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+/**
+ * repeated CalibrationPoint points = 3;
+ * @return {!Array<!proto.CalibrationPoint>}
+ */
+proto.CalibrationRequest.prototype.getPointsList = function() {
+  return /** @type{!Array<!proto.CalibrationPoint>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.CalibrationPoint, 3));
+};
+
+
+/**
+ * @param {!Array<!proto.CalibrationPoint>} value
+ * @return {!proto.CalibrationRequest} returns this
+*/
+proto.CalibrationRequest.prototype.setPointsList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 3, value);
+};
+
+
+/**
+ * @param {!proto.CalibrationPoint=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.CalibrationPoint}
+ */
+proto.CalibrationRequest.prototype.addPoints = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 3, opt_value, proto.CalibrationPoint, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.CalibrationRequest} returns this
+ */
+proto.CalibrationRequest.prototype.clearPointsList = function() {
+  return this.setPointsList([]);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.CalibrationStatus.repeatedFields_ = [2];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.CalibrationStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.CalibrationStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.CalibrationStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    parameters: (f = msg.getParameters()) && proto.CalibrationParameters.toObject(includeInstance, f),
+    pointsList: jspb.Message.toObjectList(msg.getPointsList(),
+    proto.CalibrationPoint.toObject, includeInstance),
+    stored: jspb.Message.getBooleanFieldWithDefault(msg, 3, false),
+    error: jspb.Message.getBooleanFieldWithDefault(msg, 4, false)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.CalibrationStatus}
+ */
+proto.CalibrationStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.CalibrationStatus;
+  return proto.CalibrationStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.CalibrationStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.CalibrationStatus}
+ */
+proto.CalibrationStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = new proto.CalibrationParameters;
+      reader.readMessage(value,proto.CalibrationParameters.deserializeBinaryFromReader);
+      msg.setParameters(value);
+      break;
+    case 2:
+      var value = new proto.CalibrationPoint;
+      reader.readMessage(value,proto.CalibrationPoint.deserializeBinaryFromReader);
+      msg.addPoints(value);
+      break;
+    case 3:
+      var value = /** @type {boolean} */ (reader.readBool());
+      msg.setStored(value);
+      break;
+    case 4:
+      var value = /** @type {boolean} */ (reader.readBool());
+      msg.setError(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.CalibrationStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.CalibrationStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.CalibrationStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.CalibrationStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getParameters();
+  if (f != null) {
+    writer.writeMessage(
+      1,
+      f,
+      proto.CalibrationParameters.serializeBinaryToWriter
+    );
+  }
+  f = message.getPointsList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      2,
+      f,
+      proto.CalibrationPoint.serializeBinaryToWriter
+    );
+  }
+  f = message.getStored();
+  if (f) {
+    writer.writeBool(
+      3,
+      f
+    );
+  }
+  f = message.getError();
+  if (f) {
+    writer.writeBool(
+      4,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional CalibrationParameters parameters = 1;
+ * @return {?proto.CalibrationParameters}
+ */
+proto.CalibrationStatus.prototype.getParameters = function() {
+  return /** @type{?proto.CalibrationParameters} */ (
+    jspb.Message.getWrapperField(this, proto.CalibrationParameters, 1));
+};
+
+
+/**
+ * @param {?proto.CalibrationParameters|undefined} value
+ * @return {!proto.CalibrationStatus} returns this
+*/
+proto.CalibrationStatus.prototype.setParameters = function(value) {
+  return jspb.Message.setWrapperField(this, 1, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.CalibrationStatus} returns this
+ */
+proto.CalibrationStatus.prototype.clearParameters = function() {
+  return this.setParameters(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.CalibrationStatus.prototype.hasParameters = function() {
+  return jspb.Message.getField(this, 1) != null;
+};
+
+
+/**
+ * repeated CalibrationPoint points = 2;
+ * @return {!Array<!proto.CalibrationPoint>}
+ */
+proto.CalibrationStatus.prototype.getPointsList = function() {
+  return /** @type{!Array<!proto.CalibrationPoint>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.CalibrationPoint, 2));
+};
+
+
+/**
+ * @param {!Array<!proto.CalibrationPoint>} value
+ * @return {!proto.CalibrationStatus} returns this
+*/
+proto.CalibrationStatus.prototype.setPointsList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 2, value);
+};
+
+
+/**
+ * @param {!proto.CalibrationPoint=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.CalibrationPoint}
+ */
+proto.CalibrationStatus.prototype.addPoints = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 2, opt_value, proto.CalibrationPoint, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.CalibrationStatus} returns this
+ */
+proto.CalibrationStatus.prototype.clearPointsList = function() {
+  return this.setPointsList([]);
+};
+
+
+/**
+ * optional bool stored = 3;
+ * @return {boolean}
+ */
+proto.CalibrationStatus.prototype.getStored = function() {
+  return /** @type {boolean} */ (jspb.Message.getBooleanFieldWithDefault(this, 3, false));
+};
+
+
+/**
+ * @param {boolean} value
+ * @return {!proto.CalibrationStatus} returns this
+ */
+proto.CalibrationStatus.prototype.setStored = function(value) {
+  return jspb.Message.setProto3BooleanField(this, 3, value);
+};
+
+
+/**
+ * optional bool error = 4;
+ * @return {boolean}
+ */
+proto.CalibrationStatus.prototype.getError = function() {
+  return /** @type {boolean} */ (jspb.Message.getBooleanFieldWithDefault(this, 4, false));
+};
+
+
+/**
+ * @param {boolean} value
+ * @return {!proto.CalibrationStatus} returns this
+ */
+proto.CalibrationStatus.prototype.setError = function(value) {
+  return jspb.Message.setProto3BooleanField(this, 4, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.MeasurementRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.MeasurementRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.MeasurementRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.MeasurementRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    action: jspb.Message.getFieldWithDefault(msg, 1, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.MeasurementRequest}
+ */
+proto.MeasurementRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.MeasurementRequest;
+  return proto.MeasurementRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.MeasurementRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.MeasurementRequest}
+ */
+proto.MeasurementRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.MeasurementAction} */ (reader.readEnum());
+      msg.setAction(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.MeasurementRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.MeasurementRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.MeasurementRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.MeasurementRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getAction();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional MeasurementAction action = 1;
+ * @return {!proto.MeasurementAction}
+ */
+proto.MeasurementRequest.prototype.getAction = function() {
+  return /** @type {!proto.MeasurementAction} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.MeasurementAction} value
+ * @return {!proto.MeasurementRequest} returns this
+ */
+proto.MeasurementRequest.prototype.setAction = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.MeasurementStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.MeasurementStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.MeasurementStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.MeasurementStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    state: jspb.Message.getFieldWithDefault(msg, 1, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.MeasurementStatus}
+ */
+proto.MeasurementStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.MeasurementStatus;
+  return proto.MeasurementStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.MeasurementStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.MeasurementStatus}
+ */
+proto.MeasurementStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.MeasurementState} */ (reader.readEnum());
+      msg.setState(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.MeasurementStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.MeasurementStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.MeasurementStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.MeasurementStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getState();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional MeasurementState state = 1;
+ * @return {!proto.MeasurementState}
+ */
+proto.MeasurementStatus.prototype.getState = function() {
+  return /** @type {!proto.MeasurementState} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.MeasurementState} value
+ * @return {!proto.MeasurementStatus} returns this
+ */
+proto.MeasurementStatus.prototype.setState = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.RequestError.prototype.toObject = function(opt_includeInstance) {
+  return proto.RequestError.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.RequestError} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.RequestError.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    code: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    dropped: jspb.Message.getFieldWithDefault(msg, 2, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.RequestError}
+ */
+proto.RequestError.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.RequestError;
+  return proto.RequestError.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.RequestError} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.RequestError}
+ */
+proto.RequestError.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.RequestErrorCode} */ (reader.readEnum());
+      msg.setCode(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setDropped(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.RequestError.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.RequestError.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.RequestError} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.RequestError.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getCode();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getDropped();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional RequestErrorCode code = 1;
+ * @return {!proto.RequestErrorCode}
+ */
+proto.RequestError.prototype.getCode = function() {
+  return /** @type {!proto.RequestErrorCode} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.RequestErrorCode} value
+ * @return {!proto.RequestError} returns this
+ */
+proto.RequestError.prototype.setCode = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 dropped = 2;
+ * @return {number}
+ */
+proto.RequestError.prototype.getDropped = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.RequestError} returns this
+ */
+proto.RequestError.prototype.setDropped = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.TimeSyncRequest.prototype.toObject = function(opt_includeInstance) {
+  return proto.TimeSyncRequest.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.TimeSyncRequest} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.TimeSyncRequest.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    lastDeviceUs: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    lastHostTime: (f = msg.getLastHostTime()) && proto.Timestamp.toObject(includeInstance, f),
+    lastRttUs: jspb.Message.getFieldWithDefault(msg, 3, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.TimeSyncRequest}
+ */
+proto.TimeSyncRequest.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.TimeSyncRequest;
+  return proto.TimeSyncRequest.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.TimeSyncRequest} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.TimeSyncRequest}
+ */
+proto.TimeSyncRequest.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint64());
+      msg.setLastDeviceUs(value);
+      break;
+    case 2:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setLastHostTime(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setLastRttUs(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.TimeSyncRequest.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.TimeSyncRequest.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.TimeSyncRequest} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.TimeSyncRequest.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getLastDeviceUs();
+  if (f !== 0) {
+    writer.writeUint64(
+      1,
+      f
+    );
+  }
+  f = message.getLastHostTime();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+  f = message.getLastRttUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional uint64 last_device_us = 1;
+ * @return {number}
+ */
+proto.TimeSyncRequest.prototype.getLastDeviceUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncRequest} returns this
+ */
+proto.TimeSyncRequest.prototype.setLastDeviceUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional Timestamp last_host_time = 2;
+ * @return {?proto.Timestamp}
+ */
+proto.TimeSyncRequest.prototype.getLastHostTime = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 2));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.TimeSyncRequest} returns this
+*/
+proto.TimeSyncRequest.prototype.setLastHostTime = function(value) {
+  return jspb.Message.setWrapperField(this, 2, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.TimeSyncRequest} returns this
+ */
+proto.TimeSyncRequest.prototype.clearLastHostTime = function() {
+  return this.setLastHostTime(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.TimeSyncRequest.prototype.hasLastHostTime = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+/**
+ * optional uint32 last_rtt_us = 3;
+ * @return {number}
+ */
+proto.TimeSyncRequest.prototype.getLastRttUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncRequest} returns this
+ */
+proto.TimeSyncRequest.prototype.setLastRttUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.TimeSyncStatus.prototype.toObject = function(opt_includeInstance) {
+  return proto.TimeSyncStatus.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.TimeSyncStatus} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.TimeSyncStatus.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    deviceUs: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    errorUs: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    driftPpm: jspb.Message.getFloatingPointFieldWithDefault(msg, 3, 0.0),
+    samples: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    time: (f = msg.getTime()) && proto.Timestamp.toObject(includeInstance, f)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.TimeSyncStatus}
+ */
+proto.TimeSyncStatus.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.TimeSyncStatus;
+  return proto.TimeSyncStatus.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.TimeSyncStatus} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.TimeSyncStatus}
+ */
+proto.TimeSyncStatus.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {number} */ (reader.readUint64());
+      msg.setDeviceUs(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readSint32());
+      msg.setErrorUs(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readFloat());
+      msg.setDriftPpm(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setSamples(value);
+      break;
+    case 5:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTime(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.TimeSyncStatus.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.TimeSyncStatus.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.TimeSyncStatus} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.TimeSyncStatus.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getDeviceUs();
+  if (f !== 0) {
+    writer.writeUint64(
+      1,
+      f
+    );
+  }
+  f = message.getErrorUs();
+  if (f !== 0) {
+    writer.writeSint32(
+      2,
+      f
+    );
+  }
+  f = message.getDriftPpm();
+  if (f !== 0.0) {
+    writer.writeFloat(
+      3,
+      f
+    );
+  }
+  f = message.getSamples();
+  if (f !== 0) {
+    writer.writeUint32(
+      4,
+      f
+    );
+  }
+  f = message.getTime();
+  if (f != null) {
+    writer.writeMessage(
+      5,
+      f,
+      proto.Timestamp.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * optional uint64 device_us = 1;
+ * @return {number}
+ */
+proto.TimeSyncStatus.prototype.getDeviceUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncStatus} returns this
+ */
+proto.TimeSyncStatus.prototype.setDeviceUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 1, value);
+};
+
+
+/**
+ * optional sint32 error_us = 2;
+ * @return {number}
+ */
+proto.TimeSyncStatus.prototype.getErrorUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncStatus} returns this
+ */
+proto.TimeSyncStatus.prototype.setErrorUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional float drift_ppm = 3;
+ * @return {number}
+ */
+proto.TimeSyncStatus.prototype.getDriftPpm = function() {
+  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 3, 0.0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncStatus} returns this
+ */
+proto.TimeSyncStatus.prototype.setDriftPpm = function(value) {
+  return jspb.Message.setProto3FloatField(this, 3, value);
+};
+
+
+/**
+ * optional uint32 samples = 4;
+ * @return {number}
+ */
+proto.TimeSyncStatus.prototype.getSamples = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.TimeSyncStatus} returns this
+ */
+proto.TimeSyncStatus.prototype.setSamples = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional Timestamp time = 5;
+ * @return {?proto.Timestamp}
+ */
+proto.TimeSyncStatus.prototype.getTime = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 5));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.TimeSyncStatus} returns this
+*/
+proto.TimeSyncStatus.prototype.setTime = function(value) {
+  return jspb.Message.setWrapperField(this, 5, value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.TimeSyncStatus} returns this
+ */
+proto.TimeSyncStatus.prototype.clearTime = function() {
+  return this.setTime(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.TimeSyncStatus.prototype.hasTime = function() {
+  return jspb.Message.getField(this, 5) != null;
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.StageLatency.repeatedFields_ = [6];
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.StageLatency.prototype.toObject = function(opt_includeInstance) {
+  return proto.StageLatency.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.StageLatency} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.StageLatency.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    stage: jspb.Message.getFieldWithDefault(msg, 1, 0),
+    count: jspb.Message.getFieldWithDefault(msg, 2, 0),
+    minUs: jspb.Message.getFieldWithDefault(msg, 3, 0),
+    maxUs: jspb.Message.getFieldWithDefault(msg, 4, 0),
+    meanUs: jspb.Message.getFieldWithDefault(msg, 5, 0),
+    histogramList: (f = jspb.Message.getRepeatedField(msg, 6)) == null ? undefined : f
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.StageLatency}
+ */
+proto.StageLatency.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.StageLatency;
+  return proto.StageLatency.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.StageLatency} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.StageLatency}
+ */
+proto.StageLatency.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = /** @type {!proto.LatencyStage} */ (reader.readEnum());
+      msg.setStage(value);
+      break;
+    case 2:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setCount(value);
+      break;
+    case 3:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setMinUs(value);
+      break;
+    case 4:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setMaxUs(value);
+      break;
+    case 5:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setMeanUs(value);
+      break;
+    case 6:
+      var values = /** @type {!Array<number>} */ (reader.isDelimited() ? reader.readPackedUint32() : [reader.readUint32()]);
+      for (var i = 0; i < values.length; i++) {
+        msg.addHistogram(values[i]);
+      }
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.StageLatency.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.StageLatency.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.StageLatency} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.StageLatency.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getStage();
+  if (f !== 0.0) {
+    writer.writeEnum(
+      1,
+      f
+    );
+  }
+  f = message.getCount();
+  if (f !== 0) {
+    writer.writeUint32(
+      2,
+      f
+    );
+  }
+  f = message.getMinUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      3,
+      f
+    );
+  }
+  f = message.getMaxUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      4,
+      f
+    );
+  }
+  f = message.getMeanUs();
+  if (f !== 0) {
+    writer.writeUint32(
+      5,
+      f
+    );
+  }
+  f = message.getHistogramList();
+  if (f.length > 0) {
+    writer.writePackedUint32(
+      6,
+      f
+    );
+  }
+};
+
+
+/**
+ * optional LatencyStage stage = 1;
+ * @return {!proto.LatencyStage}
+ */
+proto.StageLatency.prototype.getStage = function() {
+  return /** @type {!proto.LatencyStage} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+};
+
+
+/**
+ * @param {!proto.LatencyStage} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setStage = function(value) {
+  return jspb.Message.setProto3EnumField(this, 1, value);
+};
+
+
+/**
+ * optional uint32 count = 2;
+ * @return {number}
+ */
+proto.StageLatency.prototype.getCount = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setCount = function(value) {
+  return jspb.Message.setProto3IntField(this, 2, value);
+};
+
+
+/**
+ * optional uint32 min_us = 3;
+ * @return {number}
+ */
+proto.StageLatency.prototype.getMinUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 3, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setMinUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 3, value);
+};
+
+
+/**
+ * optional uint32 max_us = 4;
+ * @return {number}
+ */
+proto.StageLatency.prototype.getMaxUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 4, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setMaxUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 4, value);
+};
+
+
+/**
+ * optional uint32 mean_us = 5;
+ * @return {number}
+ */
+proto.StageLatency.prototype.getMeanUs = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 5, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setMeanUs = function(value) {
+  return jspb.Message.setProto3IntField(this, 5, value);
+};
+
+
+/**
+ * repeated uint32 histogram = 6;
+ * @return {!Array<number>}
+ */
+proto.StageLatency.prototype.getHistogramList = function() {
+  return /** @type {!Array<number>} */ (jspb.Message.getRepeatedField(this, 6));
+};
+
+
+/**
+ * @param {!Array<number>} value
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.setHistogramList = function(value) {
+  return jspb.Message.setField(this, 6, value || []);
+};
+
+
+/**
+ * @param {number} value
+ * @param {number=} opt_index
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.addHistogram = function(value, opt_index) {
+  return jspb.Message.addToRepeatedField(this, 6, value, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.StageLatency} returns this
+ */
+proto.StageLatency.prototype.clearHistogramList = function() {
+  return this.setHistogramList([]);
+};
+
+
+
+/**
+ * List of repeated fields within this message type.
+ * @private {!Array<number>}
+ * @const
+ */
+proto.LatencyReport.repeatedFields_ = [1];
 
 
 
@@ -121,8 +6329,8 @@ if (jspb.Message.GENERATE_TO_OBJECT) {
  *     http://goto/soy-param-migration
  * @return {!Object}
  */
-proto.Timestamp.prototype.toObject = function(opt_includeInstance) {
-  return proto.Timestamp.toObject(opt_includeInstance, this);
+proto.LatencyReport.prototype.toObject = function(opt_includeInstance) {
+  return proto.LatencyReport.toObject(opt_includeInstance, this);
 };
 
 
@@ -131,14 +6339,14 @@ proto.Timestamp.prototype.toObject = function(opt_includeInstance) {
  * @param {boolean|undefined} includeInstance Deprecated. Whether to include
  *     the JSPB instance for transitional soy proto support:
  *     http://goto/soy-param-migration
- * @param {!proto.Timestamp} msg The msg instance to transform.
+ * @param {!proto.LatencyReport} msg The msg instance to transform.
  * @return {!Object}
  * @suppress {unusedLocalVariables} f is only used for nested messages
  */
-proto.Timestamp.toObject = function(includeInstance, msg) {
+proto.LatencyReport.toObject = function(includeInstance, msg) {
   var f, obj = {
-    time: jspb.Message.getFieldWithDefault(msg, 1, 0),
-    us: jspb.Message.getFieldWithDefault(msg, 2, 0)
+    stagesList: jspb.Message.toObjectList(msg.getStagesList(),
+    proto.StageLatency.toObject, includeInstance)
   };
 
   if (includeInstance) {
@@ -152,23 +6360,23 @@ proto.Timestamp.toObject = function(includeInstance, msg) {
 /**
  * Deserializes binary data (in protobuf wire format).
  * @param {jspb.ByteSource} bytes The bytes to deserialize.
- * @return {!proto.Timestamp}
+ * @return {!proto.LatencyReport}
  */
-proto.Timestamp.deserializeBinary = function(bytes) {
+proto.LatencyReport.deserializeBinary = function(bytes) {
   var reader = new jspb.BinaryReader(bytes);
-  var msg = new proto.Timestamp;
-  return proto.Timestamp.deserializeBinaryFromReader(msg, reader);
+  var msg = new proto.LatencyReport;
+  return proto.LatencyReport.deserializeBinaryFromReader(msg, reader);
 };
 
 
 /**
  * Deserializes binary data (in protobuf wire format) from the
  * given reader into the given message object.
- * @param {!proto.Timestamp} msg The message object to deserialize into.
+ * @param {!proto.LatencyReport} msg The message object to deserialize into.
  * @param {!jspb.BinaryReader} reader The BinaryReader to use.
- * @return {!proto.Timestamp}
+ * @return {!proto.LatencyReport}
  */
-proto.Timestamp.deserializeBinaryFromReader = function(msg, reader) {
+proto.LatencyReport.deserializeBinaryFromReader = function(msg, reader) {
   while (reader.nextField()) {
     if (reader.isEndGroup()) {
       break;
@@ -176,12 +6384,240 @@ proto.Timestamp.deserializeBinaryFromReader = function(msg, reader) {
     var field = reader.getFieldNumber();
     switch (field) {
     case 1:
-      var value = /** @type {number} */ (reader.readUint64());
-      msg.setTime(value);
+      var value = new proto.StageLatency;
+      reader.readMessage(value,proto.StageLatency.deserializeBinaryFromReader);
+      msg.addStages(value);
+      break;
+    default:
+      reader.skipField();
+      break;
+    }
+  }
+  return msg;
+};
+
+
+/**
+ * Serializes the message to binary data (in protobuf wire format).
+ * @return {!Uint8Array}
+ */
+proto.LatencyReport.prototype.serializeBinary = function() {
+  var writer = new jspb.BinaryWriter();
+  proto.LatencyReport.serializeBinaryToWriter(this, writer);
+  return writer.getResultBuffer();
+};
+
+
+/**
+ * Serializes the given message to binary data (in protobuf wire
+ * format), writing to the given BinaryWriter.
+ * @param {!proto.LatencyReport} message
+ * @param {!jspb.BinaryWriter} writer
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.LatencyReport.serializeBinaryToWriter = function(message, writer) {
+  var f = undefined;
+  f = message.getStagesList();
+  if (f.length > 0) {
+    writer.writeRepeatedMessage(
+      1,
+      f,
+      proto.StageLatency.serializeBinaryToWriter
+    );
+  }
+};
+
+
+/**
+ * repeated StageLatency stages = 1;
+ * @return {!Array<!proto.StageLatency>}
+ */
+proto.LatencyReport.prototype.getStagesList = function() {
+  return /** @type{!Array<!proto.StageLatency>} */ (
+    jspb.Message.getRepeatedWrapperField(this, proto.StageLatency, 1));
+};
+
+
+/**
+ * @param {!Array<!proto.StageLatency>} value
+ * @return {!proto.LatencyReport} returns this
+*/
+proto.LatencyReport.prototype.setStagesList = function(value) {
+  return jspb.Message.setRepeatedWrapperField(this, 1, value);
+};
+
+
+/**
+ * @param {!proto.StageLatency=} opt_value
+ * @param {number=} opt_index
+ * @return {!proto.StageLatency}
+ */
+proto.LatencyReport.prototype.addStages = function(opt_value, opt_index) {
+  return jspb.Message.addToRepeatedWrapperField(this, 1, opt_value, proto.StageLatency, opt_index);
+};
+
+
+/**
+ * Clears the list making it empty but non-null.
+ * @return {!proto.LatencyReport} returns this
+ */
+proto.LatencyReport.prototype.clearStagesList = function() {
+  return this.setStagesList([]);
+};
+
+
+
+/**
+ * Oneof group definitions for this message. Each group defines the field
+ * numbers belonging to that group. When of these fields' value is set, all
+ * other fields in the group are cleared. During deserialization, if multiple
+ * fields are encountered for a group, only the last value seen will be kept.
+ * @private {!Array<!Array<number>>}
+ * @const
+ */
+proto.HostMessage.oneofGroups_ = [[1,2,3,4,5,6,7,8]];
+
+/**
+ * @enum {number}
+ */
+proto.HostMessage.PayloadCase = {
+  PAYLOAD_NOT_SET: 0,
+  TIMESTAMP: 1,
+  SETTINGS: 2,
+  LOG_REQUEST: 3,
+  ACQUISITION_REQUEST: 4,
+  ENERGY_REQUEST: 5,
+  CALIBRATION_REQUEST: 6,
+  MEASUREMENT_REQUEST: 7,
+  TIME_SYNC_REQUEST: 8
+};
+
+/**
+ * @return {proto.HostMessage.PayloadCase}
+ */
+proto.HostMessage.prototype.getPayloadCase = function() {
+  return /** @type {proto.HostMessage.PayloadCase} */(jspb.Message.computeOneofCase(this, proto.HostMessage.oneofGroups_[0]));
+};
+
+
+
+if (jspb.Message.GENERATE_TO_OBJECT) {
+/**
+ * Creates an object representation of this proto.
+ * Field names that are reserved in JavaScript and will be renamed to pb_name.
+ * Optional fields that are not set will be set to undefined.
+ * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
+ * For the list of reserved names please see:
+ *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
+ * @param {boolean=} opt_includeInstance Deprecated. whether to include the
+ *     JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @return {!Object}
+ */
+proto.HostMessage.prototype.toObject = function(opt_includeInstance) {
+  return proto.HostMessage.toObject(opt_includeInstance, this);
+};
+
+
+/**
+ * Static version of the {@see toObject} method.
+ * @param {boolean|undefined} includeInstance Deprecated. Whether to include
+ *     the JSPB instance for transitional soy proto support:
+ *     http://goto/soy-param-migration
+ * @param {!proto.HostMessage} msg The msg instance to transform.
+ * @return {!Object}
+ * @suppress {unusedLocalVariables} f is only used for nested messages
+ */
+proto.HostMessage.toObject = function(includeInstance, msg) {
+  var f, obj = {
+    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f),
+    settings: (f = msg.getSettings()) && proto.Settings.toObject(includeInstance, f),
+    logRequest: (f = msg.getLogRequest()) && proto.LogRequest.toObject(includeInstance, f),
+    acquisitionRequest: (f = msg.getAcquisitionRequest()) && proto.AcquisitionRequest.toObject(includeInstance, f),
+    energyRequest: (f = msg.getEnergyRequest()) && proto.EnergyRequest.toObject(includeInstance, f),
+    calibrationRequest: (f = msg.getCalibrationRequest()) && proto.CalibrationRequest.toObject(includeInstance, f),
+    measurementRequest: (f = msg.getMeasurementRequest()) && proto.MeasurementRequest.toObject(includeInstance, f),
+    timeSyncRequest: (f = msg.getTimeSyncRequest()) && proto.TimeSyncRequest.toObject(includeInstance, f),
+    requestId: jspb.Message.getFieldWithDefault(msg, 16, 0)
+  };
+
+  if (includeInstance) {
+    obj.$jspbMessageInstance = msg;
+  }
+  return obj;
+};
+}
+
+
+/**
+ * Deserializes binary data (in protobuf wire format).
+ * @param {jspb.ByteSource} bytes The bytes to deserialize.
+ * @return {!proto.HostMessage}
+ */
+proto.HostMessage.deserializeBinary = function(bytes) {
+  var reader = new jspb.BinaryReader(bytes);
+  var msg = new proto.HostMessage;
+  return proto.HostMessage.deserializeBinaryFromReader(msg, reader);
+};
+
+
+/**
+ * Deserializes binary data (in protobuf wire format) from the
+ * given reader into the given message object.
+ * @param {!proto.HostMessage} msg The message object to deserialize into.
+ * @param {!jspb.BinaryReader} reader The BinaryReader to use.
+ * @return {!proto.HostMessage}
+ */
+proto.HostMessage.deserializeBinaryFromReader = function(msg, reader) {
+  while (reader.nextField()) {
+    if (reader.isEndGroup()) {
+      break;
+    }
+    var field = reader.getFieldNumber();
+    switch (field) {
+    case 1:
+      var value = new proto.Timestamp;
+      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
+      msg.setTimestamp(value);
       break;
     case 2:
+      var value = new proto.Settings;
+      reader.readMessage(value,proto.Settings.deserializeBinaryFromReader);
+      msg.setSettings(value);
+      break;
+    case 3:
+      var value = new proto.LogRequest;
+      reader.readMessage(value,proto.LogRequest.deserializeBinaryFromReader);
+      msg.setLogRequest(value);
+      break;
+    case 4:
+      var value = new proto.AcquisitionRequest;
+      reader.readMessage(value,proto.AcquisitionRequest.deserializeBinaryFromReader);
+      msg.setAcquisitionRequest(value);
+      break;
+    case 5:
+      var value = new proto.EnergyRequest;
+      reader.readMessage(value,proto.EnergyRequest.deserializeBinaryFromReader);
+      msg.setEnergyRequest(value);
+      break;
+    case 6:
+      var value = new proto.CalibrationRequest;
+      reader.readMessage(value,proto.CalibrationRequest.deserializeBinaryFromReader);
+      msg.setCalibrationRequest(value);
+      break;
+    case 7:
+      var value = new proto.MeasurementRequest;
+      reader.readMessage(value,proto.MeasurementRequest.deserializeBinaryFromReader);
+      msg.setMeasurementRequest(value);
+      break;
+    case 8:
+      var value = new proto.TimeSyncRequest;
+      reader.readMessage(value,proto.TimeSyncRequest.deserializeBinaryFromReader);
+      msg.setTimeSyncRequest(value);
+      break;
+    case 16:
       var value = /** @type {number} */ (reader.readUint32());
-      msg.setUs(value);
+      msg.setRequestId(value);
       break;
     default:
       reader.skipField();
@@ -196,9 +6632,9 @@ proto.Timestamp.deserializeBinaryFromReader = function(msg, reader) {
  * Serializes the message to binary data (in protobuf wire format).
  * @return {!Uint8Array}
  */
-proto.Timestamp.prototype.serializeBinary = function() {
+proto.HostMessage.prototype.serializeBinary = function() {
   var writer = new jspb.BinaryWriter();
-  proto.Timestamp.serializeBinaryToWriter(this, writer);
+  proto.HostMessage.serializeBinaryToWriter(this, writer);
   return writer.getResultBuffer();
 };
 
@@ -206,23 +6642,80 @@ proto.Timestamp.prototype.serializeBinary = function() {
 /**
  * Serializes the given message to binary data (in protobuf wire
  * format), writing to the given BinaryWriter.
- * @param {!proto.Timestamp} message
+ * @param {!proto.HostMessage} message
  * @param {!jspb.BinaryWriter} writer
  * @suppress {unusedLocalVariables} f is only used for nested messages
  */
-proto.Timestamp.serializeBinaryToWriter = function(message, writer) {
+proto.HostMessage.serializeBinaryToWriter = function(message, writer) {
   var f = undefined;
-  f = message.getTime();
-  if (f !== 0) {
-    writer.writeUint64(
+  f = message.getTimestamp();
+  if (f != null) {
+    writer.writeMessage(
       1,
-      f
+      f,
+      proto.Timestamp.serializeBinaryToWriter
     );
   }
-  f = message.getUs();
+  f = message.getSettings();
+  if (f != null) {
+    writer.writeMessage(
+      2,
+      f,
+      proto.Settings.serializeBinaryToWriter
+    );
+  }
+  f = message.getLogRequest();
+  if (f != null) {
+    writer.writeMessage(
+      3,
+      f,
+      proto.LogRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getAcquisitionRequest();
+  if (f != null) {
+    writer.writeMessage(
+      4,
+      f,
+      proto.AcquisitionRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getEnergyRequest();
+  if (f != null) {
+    writer.writeMessage(
+      5,
+      f,
+      proto.EnergyRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getCalibrationRequest();
+  if (f != null) {
+    writer.writeMessage(
+      6,
+      f,
+      proto.CalibrationRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getMeasurementRequest();
+  if (f != null) {
+    writer.writeMessage(
+      7,
+      f,
+      proto.MeasurementRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getTimeSyncRequest();
+  if (f != null) {
+    writer.writeMessage(
+      8,
+      f,
+      proto.TimeSyncRequest.serializeBinaryToWriter
+    );
+  }
+  f = message.getRequestId();
   if (f !== 0) {
     writer.writeUint32(
-      2,
+      16,
       f
     );
   }
@@ -230,44 +6723,357 @@ proto.Timestamp.serializeBinaryToWriter = function(message, writer) {
 
 
 /**
- * optional uint64 time = 1;
+ * optional Timestamp timestamp = 1;
+ * @return {?proto.Timestamp}
+ */
+proto.HostMessage.prototype.getTimestamp = function() {
+  return /** @type{?proto.Timestamp} */ (
+    jspb.Message.getWrapperField(this, proto.Timestamp, 1));
+};
+
+
+/**
+ * @param {?proto.Timestamp|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setTimestamp = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 1, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearTimestamp = function() {
+  return this.setTimestamp(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasTimestamp = function() {
+  return jspb.Message.getField(this, 1) != null;
+};
+
+
+/**
+ * optional Settings settings = 2;
+ * @return {?proto.Settings}
+ */
+proto.HostMessage.prototype.getSettings = function() {
+  return /** @type{?proto.Settings} */ (
+    jspb.Message.getWrapperField(this, proto.Settings, 2));
+};
+
+
+/**
+ * @param {?proto.Settings|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setSettings = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 2, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearSettings = function() {
+  return this.setSettings(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasSettings = function() {
+  return jspb.Message.getField(this, 2) != null;
+};
+
+
+/**
+ * optional LogRequest log_request = 3;
+ * @return {?proto.LogRequest}
+ */
+proto.HostMessage.prototype.getLogRequest = function() {
+  return /** @type{?proto.LogRequest} */ (
+    jspb.Message.getWrapperField(this, proto.LogRequest, 3));
+};
+
+
+/**
+ * @param {?proto.LogRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setLogRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 3, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearLogRequest = function() {
+  return this.setLogRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasLogRequest = function() {
+  return jspb.Message.getField(this, 3) != null;
+};
+
+
+/**
+ * optional AcquisitionRequest acquisition_request = 4;
+ * @return {?proto.AcquisitionRequest}
+ */
+proto.HostMessage.prototype.getAcquisitionRequest = function() {
+  return /** @type{?proto.AcquisitionRequest} */ (
+    jspb.Message.getWrapperField(this, proto.AcquisitionRequest, 4));
+};
+
+
+/**
+ * @param {?proto.AcquisitionRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setAcquisitionRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 4, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearAcquisitionRequest = function() {
+  return this.setAcquisitionRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasAcquisitionRequest = function() {
+  return jspb.Message.getField(this, 4) != null;
+};
+
+
+/**
+ * optional EnergyRequest energy_request = 5;
+ * @return {?proto.EnergyRequest}
+ */
+proto.HostMessage.prototype.getEnergyRequest = function() {
+  return /** @type{?proto.EnergyRequest} */ (
+    jspb.Message.getWrapperField(this, proto.EnergyRequest, 5));
+};
+
+
+/**
+ * @param {?proto.EnergyRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setEnergyRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 5, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearEnergyRequest = function() {
+  return this.setEnergyRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasEnergyRequest = function() {
+  return jspb.Message.getField(this, 5) != null;
+};
+
+
+/**
+ * optional CalibrationRequest calibration_request = 6;
+ * @return {?proto.CalibrationRequest}
+ */
+proto.HostMessage.prototype.getCalibrationRequest = function() {
+  return /** @type{?proto.CalibrationRequest} */ (
+    jspb.Message.getWrapperField(this, proto.CalibrationRequest, 6));
+};
+
+
+/**
+ * @param {?proto.CalibrationRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setCalibrationRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 6, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearCalibrationRequest = function() {
+  return this.setCalibrationRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasCalibrationRequest = function() {
+  return jspb.Message.getField(this, 6) != null;
+};
+
+
+/**
+ * optional MeasurementRequest measurement_request = 7;
+ * @return {?proto.MeasurementRequest}
+ */
+proto.HostMessage.prototype.getMeasurementRequest = function() {
+  return /** @type{?proto.MeasurementRequest} */ (
+    jspb.Message.getWrapperField(this, proto.MeasurementRequest, 7));
+};
+
+
+/**
+ * @param {?proto.MeasurementRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setMeasurementRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 7, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearMeasurementRequest = function() {
+  return this.setMeasurementRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasMeasurementRequest = function() {
+  return jspb.Message.getField(this, 7) != null;
+};
+
+
+/**
+ * optional TimeSyncRequest time_sync_request = 8;
+ * @return {?proto.TimeSyncRequest}
+ */
+proto.HostMessage.prototype.getTimeSyncRequest = function() {
+  return /** @type{?proto.TimeSyncRequest} */ (
+    jspb.Message.getWrapperField(this, proto.TimeSyncRequest, 8));
+};
+
+
+/**
+ * @param {?proto.TimeSyncRequest|undefined} value
+ * @return {!proto.HostMessage} returns this
+*/
+proto.HostMessage.prototype.setTimeSyncRequest = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 8, proto.HostMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.HostMessage} returns this
+ */
+proto.HostMessage.prototype.clearTimeSyncRequest = function() {
+  return this.setTimeSyncRequest(undefined);
+};
+
+
+/**
+ * Returns whether this field is set.
+ * @return {boolean}
+ */
+proto.HostMessage.prototype.hasTimeSyncRequest = function() {
+  return jspb.Message.getField(this, 8) != null;
+};
+
+
+/**
+ * optional uint32 request_id = 16;
  * @return {number}
  */
-proto.Timestamp.prototype.getTime = function() {
-  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 1, 0));
+proto.HostMessage.prototype.getRequestId = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 16, 0));
 };
 
 
 /**
  * @param {number} value
- * @return {!proto.Timestamp} returns this
+ * @return {!proto.HostMessage} returns this
  */
-proto.Timestamp.prototype.setTime = function(value) {
-  return jspb.Message.setProto3IntField(this, 1, value);
+proto.HostMessage.prototype.setRequestId = function(value) {
+  return jspb.Message.setProto3IntField(this, 16, value);
 };
 
 
+
 /**
- * optional uint32 us = 2;
- * @return {number}
+ * Oneof group definitions for this message. Each group defines the field
+ * numbers belonging to that group. When of these fields' value is set, all
+ * other fields in the group are cleared. During deserialization, if multiple
+ * fields are encountered for a group, only the last value seen will be kept.
+ * @private {!Array<!Array<number>>}
+ * @const
+ */
+proto.DeviceMessage.oneofGroups_ = [[1,2,3,4,5,6,7,8,9,10,11]];
+
+/**
+ * @enum {number}
  */
-proto.Timestamp.prototype.getUs = function() {
-  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+proto.DeviceMessage.PayloadCase = {
+  PAYLOAD_NOT_SET: 0,
+  EDA_BATCH: 1,
+  RAW_SAMPLES: 2,
+  LOG_BATCH: 3,
+  LOG_STATUS: 4,
+  ACQUISITION_STATUS: 5,
+  ENERGY_REPORT: 6,
+  CALIBRATION_STATUS: 7,
+  DSP_STATUS: 8,
+  MEASUREMENT_STATUS: 9,
+  REQUEST_ERROR: 10,
+  TIME_SYNC_STATUS: 11
 };
 
-
 /**
- * @param {number} value
- * @return {!proto.Timestamp} returns this
+ * @return {proto.DeviceMessage.PayloadCase}
  */
-proto.Timestamp.prototype.setUs = function(value) {
-  return jspb.Message.setProto3IntField(this, 2, value);
+proto.DeviceMessage.prototype.getPayloadCase = function() {
+  return /** @type {proto.DeviceMessage.PayloadCase} */(jspb.Message.computeOneofCase(this, proto.DeviceMessage.oneofGroups_[0]));
 };
 
 
 
-
-
 if (jspb.Message.GENERATE_TO_OBJECT) {
 /**
  * Creates an object representation of this proto.
@@ -281,8 +7087,8 @@ if (jspb.Message.GENERATE_TO_OBJECT) {
  *     http://goto/soy-param-migration
  * @return {!Object}
  */
-proto.EcgBuffer.prototype.toObject = function(opt_includeInstance) {
-  return proto.EcgBuffer.toObject(opt_includeInstance, this);
+proto.DeviceMessage.prototype.toObject = function(opt_includeInstance) {
+  return proto.DeviceMessage.toObject(opt_includeInstance, this);
 };
 
 
@@ -291,15 +7097,24 @@ proto.EcgBuffer.prototype.toObject = function(opt_includeInstance) {
  * @param {boolean|undefined} includeInstance Deprecated. Whether to include
  *     the JSPB instance for transitional soy proto support:
  *     http://goto/soy-param-migration
- * @param {!proto.EcgBuffer} msg The msg instance to transform.
+ * @param {!proto.DeviceMessage} msg The msg instance to transform.
  * @return {!Object}
  * @suppress {unusedLocalVariables} f is only used for nested messages
  */
-proto.EcgBuffer.toObject = function(includeInstance, msg) {
+proto.DeviceMessage.toObject = function(includeInstance, msg) {
   var f, obj = {
-    data: msg.getData_asB64(),
-    lodpn: jspb.Message.getFieldWithDefault(msg, 2, 0),
-    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f)
+    edaBatch: (f = msg.getEdaBatch()) && proto.EdaBatch.toObject(includeInstance, f),
+    rawSamples: (f = msg.getRawSamples()) && proto.RawSamples.toObject(includeInstance, f),
+    logBatch: (f = msg.getLogBatch()) && proto.EdaBatch.toObject(includeInstance, f),
+    logStatus: (f = msg.getLogStatus()) && proto.LogStatus.toObject(includeInstance, f),
+    acquisitionStatus: (f = msg.getAcquisitionStatus()) && proto.AcquisitionStatus.toObject(includeInstance, f),
+    energyReport: (f = msg.getEnergyReport()) && proto.EnergyReport.toObject(includeInstance, f),
+    calibrationStatus: (f = msg.getCalibrationStatus()) && proto.CalibrationStatus.toObject(includeInstance, f),
+    dspStatus: (f = msg.getDspStatus()) && proto.DspStatus.toObject(includeInstance, f),
+    measurementStatus: (f = msg.getMeasurementStatus()) && proto.MeasurementStatus.toObject(includeInstance, f),
+    requestError: (f = msg.getRequestError()) && proto.RequestError.toObject(includeInstance, f),
+    timeSyncStatus: (f = msg.getTimeSyncStatus()) && proto.TimeSyncStatus.toObject(includeInstance, f),
+    requestId: jspb.Message.getFieldWithDefault(msg, 16, 0)
   };
 
   if (includeInstance) {
@@ -313,23 +7128,23 @@ proto.EcgBuffer.toObject = function(includeInstance, msg) {
 /**
  * Deserializes binary data (in protobuf wire format).
  * @param {jspb.ByteSource} bytes The bytes to deserialize.
- * @return {!proto.EcgBuffer}
+ * @return {!proto.DeviceMessage}
  */
-proto.EcgBuffer.deserializeBinary = function(bytes) {
+proto.DeviceMessage.deserializeBinary = function(bytes) {
   var reader = new jspb.BinaryReader(bytes);
-  var msg = new proto.EcgBuffer;
-  return proto.EcgBuffer.deserializeBinaryFromReader(msg, reader);
+  var msg = new proto.DeviceMessage;
+  return proto.DeviceMessage.deserializeBinaryFromReader(msg, reader);
 };
 
 
 /**
  * Deserializes binary data (in protobuf wire format) from the
  * given reader into the given message object.
- * @param {!proto.EcgBuffer} msg The message object to deserialize into.
+ * @param {!proto.DeviceMessage} msg The message object to deserialize into.
  * @param {!jspb.BinaryReader} reader The BinaryReader to use.
- * @return {!proto.EcgBuffer}
+ * @return {!proto.DeviceMessage}
  */
-proto.EcgBuffer.deserializeBinaryFromReader = function(msg, reader) {
+proto.DeviceMessage.deserializeBinaryFromReader = function(msg, reader) {
   while (reader.nextField()) {
     if (reader.isEndGroup()) {
       break;
@@ -337,17 +7152,63 @@ proto.EcgBuffer.deserializeBinaryFromReader = function(msg, reader) {
     var field = reader.getFieldNumber();
     switch (field) {
     case 1:
-      var value = /** @type {!Uint8Array} */ (reader.readBytes());
-      msg.setData(value);
+      var value = new proto.EdaBatch;
+      reader.readMessage(value,proto.EdaBatch.deserializeBinaryFromReader);
+      msg.setEdaBatch(value);
       break;
     case 2:
-      var value = /** @type {number} */ (reader.readInt32());
-      msg.setLodpn(value);
+      var value = new proto.RawSamples;
+      reader.readMessage(value,proto.RawSamples.deserializeBinaryFromReader);
+      msg.setRawSamples(value);
       break;
     case 3:
-      var value = new proto.Timestamp;
-      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
-      msg.setTimestamp(value);
+      var value = new proto.EdaBatch;
+      reader.readMessage(value,proto.EdaBatch.deserializeBinaryFromReader);
+      msg.setLogBatch(value);
+      break;
+    case 4:
+      var value = new proto.LogStatus;
+      reader.readMessage(value,proto.LogStatus.deserializeBinaryFromReader);
+      msg.setLogStatus(value);
+      break;
+    case 5:
+      var value = new proto.AcquisitionStatus;
+      reader.readMessage(value,proto.AcquisitionStatus.deserializeBinaryFromReader);
+      msg.setAcquisitionStatus(value);
+      break;
+    case 6:
+      var value = new proto.EnergyReport;
+      reader.readMessage(value,proto.EnergyReport.deserializeBinaryFromReader);
+      msg.setEnergyReport(value);
+      break;
+    case 7:
+      var value = new proto.CalibrationStatus;
+      reader.readMessage(value,proto.CalibrationStatus.deserializeBinaryFromReader);
+      msg.setCalibrationStatus(value);
+      break;
+    case 8:
+      var value = new proto.DspStatus;
+      reader.readMessage(value,proto.DspStatus.deserializeBinaryFromReader);
+      msg.setDspStatus(value);
+      break;
+    case 9:
+      var value = new proto.MeasurementStatus;
+      reader.readMessage(value,proto.MeasurementStatus.deserializeBinaryFromReader);
+      msg.setMeasurementStatus(value);
+      break;
+    case 10:
+      var value = new proto.RequestError;
+      reader.readMessage(value,proto.RequestError.deserializeBinaryFromReader);
+      msg.setRequestError(value);
+      break;
+    case 11:
+      var value = new proto.TimeSyncStatus;
+      reader.readMessage(value,proto.TimeSyncStatus.deserializeBinaryFromReader);
+      msg.setTimeSyncStatus(value);
+      break;
+    case 16:
+      var value = /** @type {number} */ (reader.readUint32());
+      msg.setRequestId(value);
       break;
     default:
       reader.skipField();
@@ -362,9 +7223,9 @@ proto.EcgBuffer.deserializeBinaryFromReader = function(msg, reader) {
  * Serializes the message to binary data (in protobuf wire format).
  * @return {!Uint8Array}
  */
-proto.EcgBuffer.prototype.serializeBinary = function() {
+proto.DeviceMessage.prototype.serializeBinary = function() {
   var writer = new jspb.BinaryWriter();
-  proto.EcgBuffer.serializeBinaryToWriter(this, writer);
+  proto.DeviceMessage.serializeBinaryToWriter(this, writer);
   return writer.getResultBuffer();
 };
 
@@ -372,122 +7233,209 @@ proto.EcgBuffer.prototype.serializeBinary = function() {
 /**
  * Serializes the given message to binary data (in protobuf wire
  * format), writing to the given BinaryWriter.
- * @param {!proto.EcgBuffer} message
+ * @param {!proto.DeviceMessage} message
  * @param {!jspb.BinaryWriter} writer
  * @suppress {unusedLocalVariables} f is only used for nested messages
  */
-proto.EcgBuffer.serializeBinaryToWriter = function(message, writer) {
+proto.DeviceMessage.serializeBinaryToWriter = function(message, writer) {
   var f = undefined;
-  f = message.getData_asU8();
-  if (f.length > 0) {
-    writer.writeBytes(
+  f = message.getEdaBatch();
+  if (f != null) {
+    writer.writeMessage(
       1,
-      f
+      f,
+      proto.EdaBatch.serializeBinaryToWriter
     );
   }
-  f = message.getLodpn();
-  if (f !== 0) {
-    writer.writeInt32(
+  f = message.getRawSamples();
+  if (f != null) {
+    writer.writeMessage(
       2,
-      f
+      f,
+      proto.RawSamples.serializeBinaryToWriter
     );
   }
-  f = message.getTimestamp();
+  f = message.getLogBatch();
   if (f != null) {
     writer.writeMessage(
       3,
       f,
-      proto.Timestamp.serializeBinaryToWriter
+      proto.EdaBatch.serializeBinaryToWriter
+    );
+  }
+  f = message.getLogStatus();
+  if (f != null) {
+    writer.writeMessage(
+      4,
+      f,
+      proto.LogStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getAcquisitionStatus();
+  if (f != null) {
+    writer.writeMessage(
+      5,
+      f,
+      proto.AcquisitionStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getEnergyReport();
+  if (f != null) {
+    writer.writeMessage(
+      6,
+      f,
+      proto.EnergyReport.serializeBinaryToWriter
+    );
+  }
+  f = message.getCalibrationStatus();
+  if (f != null) {
+    writer.writeMessage(
+      7,
+      f,
+      proto.CalibrationStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getDspStatus();
+  if (f != null) {
+    writer.writeMessage(
+      8,
+      f,
+      proto.DspStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getMeasurementStatus();
+  if (f != null) {
+    writer.writeMessage(
+      9,
+      f,
+      proto.MeasurementStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getRequestError();
+  if (f != null) {
+    writer.writeMessage(
+      10,
+      f,
+      proto.RequestError.serializeBinaryToWriter
+    );
+  }
+  f = message.getTimeSyncStatus();
+  if (f != null) {
+    writer.writeMessage(
+      11,
+      f,
+      proto.TimeSyncStatus.serializeBinaryToWriter
+    );
+  }
+  f = message.getRequestId();
+  if (f !== 0) {
+    writer.writeUint32(
+      16,
+      f
     );
   }
 };
 
 
 /**
- * optional bytes data = 1;
- * @return {!(string|Uint8Array)}
+ * optional EdaBatch eda_batch = 1;
+ * @return {?proto.EdaBatch}
  */
-proto.EcgBuffer.prototype.getData = function() {
-  return /** @type {!(string|Uint8Array)} */ (jspb.Message.getFieldWithDefault(this, 1, ""));
+proto.DeviceMessage.prototype.getEdaBatch = function() {
+  return /** @type{?proto.EdaBatch} */ (
+    jspb.Message.getWrapperField(this, proto.EdaBatch, 1));
 };
 
 
 /**
- * optional bytes data = 1;
- * This is a type-conversion wrapper around `getData()`
- * @return {string}
+ * @param {?proto.EdaBatch|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setEdaBatch = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 1, proto.DeviceMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EcgBuffer.prototype.getData_asB64 = function() {
-  return /** @type {string} */ (jspb.Message.bytesAsB64(
-      this.getData()));
+proto.DeviceMessage.prototype.clearEdaBatch = function() {
+  return this.setEdaBatch(undefined);
 };
 
 
 /**
- * optional bytes data = 1;
- * Note that Uint8Array is not supported on all browsers.
- * @see http://caniuse.com/Uint8Array
- * This is a type-conversion wrapper around `getData()`
- * @return {!Uint8Array}
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.EcgBuffer.prototype.getData_asU8 = function() {
-  return /** @type {!Uint8Array} */ (jspb.Message.bytesAsU8(
-      this.getData()));
+proto.DeviceMessage.prototype.hasEdaBatch = function() {
+  return jspb.Message.getField(this, 1) != null;
 };
 
 
 /**
- * @param {!(string|Uint8Array)} value
- * @return {!proto.EcgBuffer} returns this
+ * optional RawSamples raw_samples = 2;
+ * @return {?proto.RawSamples}
  */
-proto.EcgBuffer.prototype.setData = function(value) {
-  return jspb.Message.setProto3BytesField(this, 1, value);
+proto.DeviceMessage.prototype.getRawSamples = function() {
+  return /** @type{?proto.RawSamples} */ (
+    jspb.Message.getWrapperField(this, proto.RawSamples, 2));
 };
 
 
 /**
- * optional int32 lodpn = 2;
- * @return {number}
+ * @param {?proto.RawSamples|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setRawSamples = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 2, proto.DeviceMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EcgBuffer.prototype.getLodpn = function() {
-  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 2, 0));
+proto.DeviceMessage.prototype.clearRawSamples = function() {
+  return this.setRawSamples(undefined);
 };
 
 
 /**
- * @param {number} value
- * @return {!proto.EcgBuffer} returns this
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.EcgBuffer.prototype.setLodpn = function(value) {
-  return jspb.Message.setProto3IntField(this, 2, value);
+proto.DeviceMessage.prototype.hasRawSamples = function() {
+  return jspb.Message.getField(this, 2) != null;
 };
 
 
 /**
- * optional Timestamp timestamp = 3;
- * @return {?proto.Timestamp}
+ * optional EdaBatch log_batch = 3;
+ * @return {?proto.EdaBatch}
  */
-proto.EcgBuffer.prototype.getTimestamp = function() {
-  return /** @type{?proto.Timestamp} */ (
-    jspb.Message.getWrapperField(this, proto.Timestamp, 3));
+proto.DeviceMessage.prototype.getLogBatch = function() {
+  return /** @type{?proto.EdaBatch} */ (
+    jspb.Message.getWrapperField(this, proto.EdaBatch, 3));
 };
 
 
 /**
- * @param {?proto.Timestamp|undefined} value
- * @return {!proto.EcgBuffer} returns this
+ * @param {?proto.EdaBatch|undefined} value
+ * @return {!proto.DeviceMessage} returns this
 */
-proto.EcgBuffer.prototype.setTimestamp = function(value) {
-  return jspb.Message.setWrapperField(this, 3, value);
+proto.DeviceMessage.prototype.setLogBatch = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 3, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
  * Clears the message field making it undefined.
- * @return {!proto.EcgBuffer} returns this
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EcgBuffer.prototype.clearTimestamp = function() {
-  return this.setTimestamp(undefined);
+proto.DeviceMessage.prototype.clearLogBatch = function() {
+  return this.setLogBatch(undefined);
 };
 
 
@@ -495,370 +7443,295 @@ proto.EcgBuffer.prototype.clearTimestamp = function() {
  * Returns whether this field is set.
  * @return {boolean}
  */
-proto.EcgBuffer.prototype.hasTimestamp = function() {
+proto.DeviceMessage.prototype.hasLogBatch = function() {
   return jspb.Message.getField(this, 3) != null;
 };
 
 
+/**
+ * optional LogStatus log_status = 4;
+ * @return {?proto.LogStatus}
+ */
+proto.DeviceMessage.prototype.getLogStatus = function() {
+  return /** @type{?proto.LogStatus} */ (
+    jspb.Message.getWrapperField(this, proto.LogStatus, 4));
+};
+
 
+/**
+ * @param {?proto.LogStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setLogStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 4, proto.DeviceMessage.oneofGroups_[0], value);
+};
 
 
-if (jspb.Message.GENERATE_TO_OBJECT) {
 /**
- * Creates an object representation of this proto.
- * Field names that are reserved in JavaScript and will be renamed to pb_name.
- * Optional fields that are not set will be set to undefined.
- * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
- * For the list of reserved names please see:
- *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
- * @param {boolean=} opt_includeInstance Deprecated. whether to include the
- *     JSPB instance for transitional soy proto support:
- *     http://goto/soy-param-migration
- * @return {!Object}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.Impedance.prototype.toObject = function(opt_includeInstance) {
-  return proto.Impedance.toObject(opt_includeInstance, this);
+proto.DeviceMessage.prototype.clearLogStatus = function() {
+  return this.setLogStatus(undefined);
 };
 
 
 /**
- * Static version of the {@see toObject} method.
- * @param {boolean|undefined} includeInstance Deprecated. Whether to include
- *     the JSPB instance for transitional soy proto support:
- *     http://goto/soy-param-migration
- * @param {!proto.Impedance} msg The msg instance to transform.
- * @return {!Object}
- * @suppress {unusedLocalVariables} f is only used for nested messages
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.Impedance.toObject = function(includeInstance, msg) {
-  var f, obj = {
-    real: jspb.Message.getFloatingPointFieldWithDefault(msg, 1, 0.0),
-    imag: jspb.Message.getFloatingPointFieldWithDefault(msg, 2, 0.0)
-  };
+proto.DeviceMessage.prototype.hasLogStatus = function() {
+  return jspb.Message.getField(this, 4) != null;
+};
 
-  if (includeInstance) {
-    obj.$jspbMessageInstance = msg;
-  }
-  return obj;
+
+/**
+ * optional AcquisitionStatus acquisition_status = 5;
+ * @return {?proto.AcquisitionStatus}
+ */
+proto.DeviceMessage.prototype.getAcquisitionStatus = function() {
+  return /** @type{?proto.AcquisitionStatus} */ (
+    jspb.Message.getWrapperField(this, proto.AcquisitionStatus, 5));
 };
-}
 
 
 /**
- * Deserializes binary data (in protobuf wire format).
- * @param {jspb.ByteSource} bytes The bytes to deserialize.
- * @return {!proto.Impedance}
+ * @param {?proto.AcquisitionStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setAcquisitionStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 5, proto.DeviceMessage.oneofGroups_[0], value);
+};
+
+
+/**
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.Impedance.deserializeBinary = function(bytes) {
-  var reader = new jspb.BinaryReader(bytes);
-  var msg = new proto.Impedance;
-  return proto.Impedance.deserializeBinaryFromReader(msg, reader);
+proto.DeviceMessage.prototype.clearAcquisitionStatus = function() {
+  return this.setAcquisitionStatus(undefined);
 };
 
 
 /**
- * Deserializes binary data (in protobuf wire format) from the
- * given reader into the given message object.
- * @param {!proto.Impedance} msg The message object to deserialize into.
- * @param {!jspb.BinaryReader} reader The BinaryReader to use.
- * @return {!proto.Impedance}
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.Impedance.deserializeBinaryFromReader = function(msg, reader) {
-  while (reader.nextField()) {
-    if (reader.isEndGroup()) {
-      break;
-    }
-    var field = reader.getFieldNumber();
-    switch (field) {
-    case 1:
-      var value = /** @type {number} */ (reader.readFloat());
-      msg.setReal(value);
-      break;
-    case 2:
-      var value = /** @type {number} */ (reader.readFloat());
-      msg.setImag(value);
-      break;
-    default:
-      reader.skipField();
-      break;
-    }
-  }
-  return msg;
+proto.DeviceMessage.prototype.hasAcquisitionStatus = function() {
+  return jspb.Message.getField(this, 5) != null;
+};
+
+
+/**
+ * optional EnergyReport energy_report = 6;
+ * @return {?proto.EnergyReport}
+ */
+proto.DeviceMessage.prototype.getEnergyReport = function() {
+  return /** @type{?proto.EnergyReport} */ (
+    jspb.Message.getWrapperField(this, proto.EnergyReport, 6));
+};
+
+
+/**
+ * @param {?proto.EnergyReport|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setEnergyReport = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 6, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
- * Serializes the message to binary data (in protobuf wire format).
- * @return {!Uint8Array}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.Impedance.prototype.serializeBinary = function() {
-  var writer = new jspb.BinaryWriter();
-  proto.Impedance.serializeBinaryToWriter(this, writer);
-  return writer.getResultBuffer();
+proto.DeviceMessage.prototype.clearEnergyReport = function() {
+  return this.setEnergyReport(undefined);
 };
 
 
 /**
- * Serializes the given message to binary data (in protobuf wire
- * format), writing to the given BinaryWriter.
- * @param {!proto.Impedance} message
- * @param {!jspb.BinaryWriter} writer
- * @suppress {unusedLocalVariables} f is only used for nested messages
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.Impedance.serializeBinaryToWriter = function(message, writer) {
-  var f = undefined;
-  f = message.getReal();
-  if (f !== 0.0) {
-    writer.writeFloat(
-      1,
-      f
-    );
-  }
-  f = message.getImag();
-  if (f !== 0.0) {
-    writer.writeFloat(
-      2,
-      f
-    );
-  }
+proto.DeviceMessage.prototype.hasEnergyReport = function() {
+  return jspb.Message.getField(this, 6) != null;
 };
 
 
 /**
- * optional float real = 1;
- * @return {number}
+ * optional CalibrationStatus calibration_status = 7;
+ * @return {?proto.CalibrationStatus}
  */
-proto.Impedance.prototype.getReal = function() {
-  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 1, 0.0));
+proto.DeviceMessage.prototype.getCalibrationStatus = function() {
+  return /** @type{?proto.CalibrationStatus} */ (
+    jspb.Message.getWrapperField(this, proto.CalibrationStatus, 7));
 };
 
 
 /**
- * @param {number} value
- * @return {!proto.Impedance} returns this
- */
-proto.Impedance.prototype.setReal = function(value) {
-  return jspb.Message.setProto3FloatField(this, 1, value);
+ * @param {?proto.CalibrationStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setCalibrationStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 7, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
- * optional float imag = 2;
- * @return {number}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.Impedance.prototype.getImag = function() {
-  return /** @type {number} */ (jspb.Message.getFloatingPointFieldWithDefault(this, 2, 0.0));
+proto.DeviceMessage.prototype.clearCalibrationStatus = function() {
+  return this.setCalibrationStatus(undefined);
 };
 
 
 /**
- * @param {number} value
- * @return {!proto.Impedance} returns this
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.Impedance.prototype.setImag = function(value) {
-  return jspb.Message.setProto3FloatField(this, 2, value);
+proto.DeviceMessage.prototype.hasCalibrationStatus = function() {
+  return jspb.Message.getField(this, 7) != null;
 };
 
 
-
 /**
- * List of repeated fields within this message type.
- * @private {!Array<number>}
- * @const
+ * optional DspStatus dsp_status = 8;
+ * @return {?proto.DspStatus}
  */
-proto.EdaBuffer.repeatedFields_ = [1];
+proto.DeviceMessage.prototype.getDspStatus = function() {
+  return /** @type{?proto.DspStatus} */ (
+    jspb.Message.getWrapperField(this, proto.DspStatus, 8));
+};
+
 
+/**
+ * @param {?proto.DspStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setDspStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 8, proto.DeviceMessage.oneofGroups_[0], value);
+};
 
 
-if (jspb.Message.GENERATE_TO_OBJECT) {
 /**
- * Creates an object representation of this proto.
- * Field names that are reserved in JavaScript and will be renamed to pb_name.
- * Optional fields that are not set will be set to undefined.
- * To access a reserved field use, foo.pb_<name>, eg, foo.pb_default.
- * For the list of reserved names please see:
- *     net/proto2/compiler/js/internal/generator.cc#kKeyword.
- * @param {boolean=} opt_includeInstance Deprecated. whether to include the
- *     JSPB instance for transitional soy proto support:
- *     http://goto/soy-param-migration
- * @return {!Object}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EdaBuffer.prototype.toObject = function(opt_includeInstance) {
-  return proto.EdaBuffer.toObject(opt_includeInstance, this);
+proto.DeviceMessage.prototype.clearDspStatus = function() {
+  return this.setDspStatus(undefined);
 };
 
 
 /**
- * Static version of the {@see toObject} method.
- * @param {boolean|undefined} includeInstance Deprecated. Whether to include
- *     the JSPB instance for transitional soy proto support:
- *     http://goto/soy-param-migration
- * @param {!proto.EdaBuffer} msg The msg instance to transform.
- * @return {!Object}
- * @suppress {unusedLocalVariables} f is only used for nested messages
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.EdaBuffer.toObject = function(includeInstance, msg) {
-  var f, obj = {
-    dataList: jspb.Message.toObjectList(msg.getDataList(),
-    proto.Impedance.toObject, includeInstance),
-    timestamp: (f = msg.getTimestamp()) && proto.Timestamp.toObject(includeInstance, f)
-  };
-
-  if (includeInstance) {
-    obj.$jspbMessageInstance = msg;
-  }
-  return obj;
+proto.DeviceMessage.prototype.hasDspStatus = function() {
+  return jspb.Message.getField(this, 8) != null;
 };
-}
 
 
 /**
- * Deserializes binary data (in protobuf wire format).
- * @param {jspb.ByteSource} bytes The bytes to deserialize.
- * @return {!proto.EdaBuffer}
+ * optional MeasurementStatus measurement_status = 9;
+ * @return {?proto.MeasurementStatus}
  */
-proto.EdaBuffer.deserializeBinary = function(bytes) {
-  var reader = new jspb.BinaryReader(bytes);
-  var msg = new proto.EdaBuffer;
-  return proto.EdaBuffer.deserializeBinaryFromReader(msg, reader);
+proto.DeviceMessage.prototype.getMeasurementStatus = function() {
+  return /** @type{?proto.MeasurementStatus} */ (
+    jspb.Message.getWrapperField(this, proto.MeasurementStatus, 9));
 };
 
 
 /**
- * Deserializes binary data (in protobuf wire format) from the
- * given reader into the given message object.
- * @param {!proto.EdaBuffer} msg The message object to deserialize into.
- * @param {!jspb.BinaryReader} reader The BinaryReader to use.
- * @return {!proto.EdaBuffer}
- */
-proto.EdaBuffer.deserializeBinaryFromReader = function(msg, reader) {
-  while (reader.nextField()) {
-    if (reader.isEndGroup()) {
-      break;
-    }
-    var field = reader.getFieldNumber();
-    switch (field) {
-    case 1:
-      var value = new proto.Impedance;
-      reader.readMessage(value,proto.Impedance.deserializeBinaryFromReader);
-      msg.addData(value);
-      break;
-    case 2:
-      var value = new proto.Timestamp;
-      reader.readMessage(value,proto.Timestamp.deserializeBinaryFromReader);
-      msg.setTimestamp(value);
-      break;
-    default:
-      reader.skipField();
-      break;
-    }
-  }
-  return msg;
+ * @param {?proto.MeasurementStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
+*/
+proto.DeviceMessage.prototype.setMeasurementStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 9, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
- * Serializes the message to binary data (in protobuf wire format).
- * @return {!Uint8Array}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EdaBuffer.prototype.serializeBinary = function() {
-  var writer = new jspb.BinaryWriter();
-  proto.EdaBuffer.serializeBinaryToWriter(this, writer);
-  return writer.getResultBuffer();
+proto.DeviceMessage.prototype.clearMeasurementStatus = function() {
+  return this.setMeasurementStatus(undefined);
 };
 
 
 /**
- * Serializes the given message to binary data (in protobuf wire
- * format), writing to the given BinaryWriter.
- * @param {!proto.EdaBuffer} message
- * @param {!jspb.BinaryWriter} writer
- * @suppress {unusedLocalVariables} f is only used for nested messages
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.EdaBuffer.serializeBinaryToWriter = function(message, writer) {
-  var f = undefined;
-  f = message.getDataList();
-  if (f.length > 0) {
-    writer.writeRepeatedMessage(
-      1,
-      f,
-      proto.Impedance.serializeBinaryToWriter
-    );
-  }
-  f = message.getTimestamp();
-  if (f != null) {
-    writer.writeMessage(
-      2,
-      f,
-      proto.Timestamp.serializeBinaryToWriter
-    );
-  }
+proto.DeviceMessage.prototype.hasMeasurementStatus = function() {
+  return jspb.Message.getField(this, 9) != null;
 };
 
 
 /**
- * repeated Impedance data = 1;
- * @return {!Array<!proto.Impedance>}
+ * optional RequestError request_error = 10;
+ * @return {?proto.RequestError}
  */
-proto.EdaBuffer.prototype.getDataList = function() {
-  return /** @type{!Array<!proto.Impedance>} */ (
-    jspb.Message.getRepeatedWrapperField(this, proto.Impedance, 1));
+proto.DeviceMessage.prototype.getRequestError = function() {
+  return /** @type{?proto.RequestError} */ (
+    jspb.Message.getWrapperField(this, proto.RequestError, 10));
 };
 
 
 /**
- * @param {!Array<!proto.Impedance>} value
- * @return {!proto.EdaBuffer} returns this
+ * @param {?proto.RequestError|undefined} value
+ * @return {!proto.DeviceMessage} returns this
 */
-proto.EdaBuffer.prototype.setDataList = function(value) {
-  return jspb.Message.setRepeatedWrapperField(this, 1, value);
+proto.DeviceMessage.prototype.setRequestError = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 10, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
- * @param {!proto.Impedance=} opt_value
- * @param {number=} opt_index
- * @return {!proto.Impedance}
+ * Clears the message field making it undefined.
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EdaBuffer.prototype.addData = function(opt_value, opt_index) {
-  return jspb.Message.addToRepeatedWrapperField(this, 1, opt_value, proto.Impedance, opt_index);
+proto.DeviceMessage.prototype.clearRequestError = function() {
+  return this.setRequestError(undefined);
 };
 
 
 /**
- * Clears the list making it empty but non-null.
- * @return {!proto.EdaBuffer} returns this
+ * Returns whether this field is set.
+ * @return {boolean}
  */
-proto.EdaBuffer.prototype.clearDataList = function() {
-  return this.setDataList([]);
+proto.DeviceMessage.prototype.hasRequestError = function() {
+  return jspb.Message.getField(this, 10) != null;
 };
 
 
 /**
- * optional Timestamp timestamp = 2;
- * @return {?proto.Timestamp}
+ * optional TimeSyncStatus time_sync_status = 11;
+ * @return {?proto.TimeSyncStatus}
  */
-proto.EdaBuffer.prototype.getTimestamp = function() {
-  return /** @type{?proto.Timestamp} */ (
-    jspb.Message.getWrapperField(this, proto.Timestamp, 2));
+proto.DeviceMessage.prototype.getTimeSyncStatus = function() {
+  return /** @type{?proto.TimeSyncStatus} */ (
+    jspb.Message.getWrapperField(this, proto.TimeSyncStatus, 11));
 };
 
 
 /**
- * @param {?proto.Timestamp|undefined} value
- * @return {!proto.EdaBuffer} returns this
+ * @param {?proto.TimeSyncStatus|undefined} value
+ * @return {!proto.DeviceMessage} returns this
 */
-proto.EdaBuffer.prototype.setTimestamp = function(value) {
-  return jspb.Message.setWrapperField(this, 2, value);
+proto.DeviceMessage.prototype.setTimeSyncStatus = function(value) {
+  return jspb.Message.setOneofWrapperField(this, 11, proto.DeviceMessage.oneofGroups_[0], value);
 };
 
 
 /**
  * Clears the message field making it undefined.
- * @return {!proto.EdaBuffer} returns this
+ * @return {!proto.DeviceMessage} returns this
  */
-proto.EdaBuffer.prototype.clearTimestamp = function() {
-  return this.setTimestamp(undefined);
+proto.DeviceMessage.prototype.clearTimeSyncStatus = function() {
+  return this.setTimeSyncStatus(undefined);
 };
 
 
@@ -866,8 +7739,119 @@ proto.EdaBuffer.prototype.clearTimestamp = function() {
  * Returns whether this field is set.
  * @return {boolean}
  */
-proto.EdaBuffer.prototype.hasTimestamp = function() {
-  return jspb.Message.getField(this, 2) != null;
+proto.DeviceMessage.prototype.hasTimeSyncStatus = function() {
+  return jspb.Message.getField(this, 11) != null;
+};
+
+
+/**
+ * optional uint32 request_id = 16;
+ * @return {number}
+ */
+proto.DeviceMessage.prototype.getRequestId = function() {
+  return /** @type {number} */ (jspb.Message.getFieldWithDefault(this, 16, 0));
+};
+
+
+/**
+ * @param {number} value
+ * @return {!proto.DeviceMessage} returns this
+ */
+proto.DeviceMessage.prototype.setRequestId = function(value) {
+  return jspb.Message.setProto3IntField(this, 16, value);
+};
+
+
+
+/**
+ * @enum {number}
+ */
+proto.ImpedanceEncoding = {
+  IMPEDANCE_ENCODING_FLOAT: 0,
+  IMPEDANCE_ENCODING_HALF: 1
+};
+
+/**
+ * @enum {number}
+ */
+proto.OutputMode = {
+  OUTPUT_MODE_SPECTRA: 0,
+  OUTPUT_MODE_RAW_SAMPLES: 1
+};
+
+/**
+ * @enum {number}
+ */
+proto.OverrunPolicy = {
+  OVERRUN_POLICY_SKIP: 0,
+  OVERRUN_POLICY_BLOCK: 1
+};
+
+/**
+ * @enum {number}
+ */
+proto.LogAction = {
+  LOG_ACTION_STATUS: 0,
+  LOG_ACTION_DOWNLOAD: 1,
+  LOG_ACTION_ERASE: 2
+};
+
+/**
+ * @enum {number}
+ */
+proto.EnergySubsystem = {
+  ENERGY_SUBSYSTEM_CPU: 0,
+  ENERGY_SUBSYSTEM_RADIO: 1,
+  ENERGY_SUBSYSTEM_SAADC: 2
+};
+
+/**
+ * @enum {number}
+ */
+proto.CalibrationAction = {
+  CALIBRATION_ACTION_STATUS: 0,
+  CALIBRATION_ACTION_SET: 1,
+  CALIBRATION_ACTION_STORE: 2,
+  CALIBRATION_ACTION_ERASE: 3
+};
+
+/**
+ * @enum {number}
+ */
+proto.MeasurementAction = {
+  MEASUREMENT_ACTION_STATUS: 0,
+  MEASUREMENT_ACTION_START: 1,
+  MEASUREMENT_ACTION_STOP: 2
+};
+
+/**
+ * @enum {number}
+ */
+proto.MeasurementState = {
+  MEASUREMENT_STATE_IDLE: 0,
+  MEASUREMENT_STATE_RUNNING: 1,
+  MEASUREMENT_STATE_STOPPING: 2
 };
 
+/**
+ * @enum {number}
+ */
+proto.RequestErrorCode = {
+  REQUEST_ERROR_MALFORMED: 0,
+  REQUEST_ERROR_UNKNOWN: 1
+};
 
+/**
+ * @enum {number}
+ */
+proto.LatencyStage = {
+  LATENCY_STAGE_SAADC_WAIT: 0,
+  LATENCY_STAGE_SCALING: 1,
+  LATENCY_STAGE_TRANSFORM: 2,
+  LATENCY_STAGE_IMPEDANCE: 3,
+  LATENCY_STAGE_ENCODE: 4,
+  LATENCY_STAGE_COBS: 5,
+  LATENCY_STAGE_TX: 6,
+  LATENCY_STAGE_DSP_SLICE: 7,
+  LATENCY_STAGE_SINK: 8
+};